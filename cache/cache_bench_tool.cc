@@ -7,6 +7,7 @@
 #include <cinttypes>
 #include <cstddef>
 #include <cstdio>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <set>
@@ -130,6 +131,13 @@ DEFINE_bool(jemalloc_no_dump_allocator_limit_tcache_size,
             ROCKSDB_NAMESPACE::JemallocAllocatorOptions().limit_tcache_size,
             "JemallocNodumpAllocator::limit_tcache_size");
 
+DEFINE_bool(numa_aware, false,
+            "LRUCacheOptions::numa_aware. Per-node lookup stats are reported "
+            "when in effect.");
+
+DEFINE_bool(use_numa_allocator, false,
+            "Whether to use NewNumaMemoryAllocator()");
+
 // ## BEGIN stress_cache_key sub-tool options ##
 // See class StressCacheKey below.
 DEFINE_bool(stress_cache_key, false,
@@ -385,6 +393,14 @@ class CacheBench {
           FLAGS_jemalloc_no_dump_allocator_limit_tcache_size;
       Status s = NewJemallocNodumpAllocator(opts, &allocator);
       assert(s.ok());
+    } else if (FLAGS_use_numa_allocator) {
+      NumaAllocatorOptions opts;
+      opts.capacity = FLAGS_cache_size;
+      Status s = NewNumaMemoryAllocator(opts, &allocator);
+      if (!s.ok()) {
+        fprintf(stderr, "NUMA allocator: %s\n", s.ToString().c_str());
+        exit(1);
+      }
     }
     if (FLAGS_cache_type == "clock_cache") {
       fprintf(stderr, "Old clock cache implementation has been removed.\n");
@@ -416,6 +432,7 @@ class CacheBench {
                            0.5 /* high_pri_pool_ratio */);
       opts.hash_seed = BitwiseAnd(FLAGS_seed, INT32_MAX);
       opts.memory_allocator = allocator;
+      opts.numa_aware = FLAGS_numa_aware;
       ConfigureSecondaryCache(opts);
       cache_ = NewLRUCache(opts);
     } else {
@@ -558,12 +575,36 @@ class CacheBench {
           std::make_shared<StderrLogger>(InfoLogLevel::DEBUG_LEVEL);
       cache_->ReportProblems(logger);
     }
+    PrintNumaShardGroupStats();
     printf("%s", stats_report.c_str());
 
     return true;
   }
 
  private:
+  void PrintNumaShardGroupStats() {
+    if (!FLAGS_numa_aware || strcmp(cache_->Name(), "LRUCache") != 0) {
+      return;
+    }
+    auto stats =
+        static_cast<ShardedCacheBase*>(cache_.get())->GetNumaShardGroupStats();
+    if (stats.empty()) {
+      printf("\nNUMA-aware sharding not in effect (single NUMA node?)\n");
+      return;
+    }
+    printf("\nLookups by NUMA node group:\n");
+    for (size_t group = 0; group < stats.size(); ++group) {
+      const auto& g = stats[group];
+      double total = static_cast<double>(
+          std::max(g.local_hits + g.remote_hits + g.misses, uint64_t{1}));
+      printf("Node group %zu: local hits %" PRIu64
+             " (%.1f%%), remote hits %" PRIu64 " (%.1f%%), misses %" PRIu64
+             " (%.1f%%)\n",
+             group, g.local_hits, 100.0 * g.local_hits / total, g.remote_hits,
+             100.0 * g.remote_hits / total, g.misses, 100.0 * g.misses / total);
+    }
+  }
+
   std::shared_ptr<Cache> cache_;
   const uint64_t max_key_;
   // Cumulative thresholds in the space of a random uint64_t
@@ -649,6 +649,9 @@ void LRUCacheShard::AppendPrintableOptions(std::string& str) const {
 }
 
 LRUCache::LRUCache(const LRUCacheOptions& opts) : ShardedCache(opts) {
+  if (opts.numa_aware) {
+    InitNumaGroups();
+  }
   size_t per_shard = GetPerShardCapacity();
   MemoryAllocator* alloc = memory_allocator();
   InitShards([&](LRUCacheShard* cs) {
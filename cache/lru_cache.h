@@ -283,6 +283,14 @@ class ALIGN_AS(CACHE_LINE_SIZE) LRUCacheShard final : public CacheShardBase {
     return Lower32of64(GetSliceNPHash64(key, seed));
   }
 
+  // The hash table only uses the upper 32 - num_shard_bits bits of the hash,
+  // so the lower (sharding) bits can be freely steered.
+  static constexpr bool kSupportsHashSteering = true;
+  static inline HashVal SteerHash(HashCref hash, uint32_t shard_bits,
+                                  uint32_t shard_bits_mask) {
+    return (hash & ~shard_bits_mask) | (shard_bits & shard_bits_mask);
+  }
+
   // Separate from constructor so caller can easily make an array of LRUCache
   // if current usage is more than new capacity, the function will attempt to
   // free the needed space.
@@ -2723,6 +2723,190 @@ TEST_F(LRUCacheTest, InsertAfterReducingCapacity) {
   Insert("aaa", Cache::Priority::LOW, /*charge=*/3);
 }
 
+TEST_F(LRUCacheTest, NumaAwareSharding) {
+  // Simulate a host with two NUMA nodes
+  int current_node = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "ShardedCacheBase::InitNumaGroups:NumNodes",
+      [](void* arg) { *static_cast<int*>(arg) = 2; });
+  SyncPoint::GetInstance()->SetCallBack(
+      "ShardedCacheBase::GetCurrentNumaGroup:Node",
+      [&](void* arg) { *static_cast<int*>(arg) = current_node; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  LRUCacheOptions opts(/*capacity=*/1024 * 1024, /*num_shard_bits=*/2,
+                       /*strict_capacity_limit=*/false,
+                       /*high_pri_pool_ratio=*/0.0);
+  opts.numa_aware = true;
+  auto cache = opts.MakeSharedCache();
+  auto sharded = static_cast<ShardedCacheBase*>(cache.get());
+  ASSERT_EQ(sharded->GetNumNumaGroups(), 2U);
+
+  std::vector<std::string> keys;
+  for (int i = 0; i < 100; ++i) {
+    keys.push_back("key" + std::to_string(i));
+  }
+  // Insert everything from node 0, which should all land in node 0's shards
+  for (auto& key : keys) {
+    ASSERT_OK(cache->Insert(key, nullptr, &kNoopCacheItemHelper, 1));
+  }
+  auto lookup_all = [&]() {
+    for (auto& key : keys) {
+      Cache::Handle* h = cache->Lookup(key);
+      ASSERT_NE(h, nullptr);
+      cache->Release(h);
+    }
+  };
+  lookup_all();
+  current_node = 1;
+  lookup_all();
+  ASSERT_EQ(cache->Lookup("missing"), nullptr);
+
+  auto stats = sharded->GetNumaShardGroupStats();
+  ASSERT_EQ(stats.size(), 2U);
+  ASSERT_EQ(stats[0].local_hits, keys.size());
+  ASSERT_EQ(stats[0].remote_hits, 0U);
+  ASSERT_EQ(stats[0].misses, 0U);
+  ASSERT_EQ(stats[1].local_hits, 0U);
+  ASSERT_EQ(stats[1].remote_hits, keys.size());
+  ASSERT_EQ(stats[1].misses, 1U);
+
+  // Erase from node 1 finds the entries inserted from node 0
+  for (auto& key : keys) {
+    cache->Erase(key);
+  }
+  ASSERT_EQ(cache->GetUsage(), 0U);
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
+TEST_F(LRUCacheTest, NumaAwareShardingReplace) {
+  // Simulate a host with two NUMA nodes
+  int current_node = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "ShardedCacheBase::InitNumaGroups:NumNodes",
+      [](void* arg) { *static_cast<int*>(arg) = 2; });
+  SyncPoint::GetInstance()->SetCallBack(
+      "ShardedCacheBase::GetCurrentNumaGroup:Node",
+      [&](void* arg) { *static_cast<int*>(arg) = current_node; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  LRUCacheOptions opts(/*capacity=*/1024 * 1024, /*num_shard_bits=*/2,
+                       /*strict_capacity_limit=*/false,
+                       /*high_pri_pool_ratio=*/0.0);
+  opts.numa_aware = true;
+  opts.metadata_charge_policy = kDontChargeCacheMetadata;
+  auto cache = opts.MakeSharedCache();
+  ASSERT_EQ(static_cast<ShardedCacheBase*>(cache.get())->GetNumNumaGroups(),
+            2U);
+
+  // Insert the same key from both nodes, with different charges standing in
+  // for different values
+  ASSERT_OK(cache->Insert("key", nullptr, &kNoopCacheItemHelper, 1));
+  current_node = 1;
+  ASSERT_OK(cache->Insert("key", nullptr, &kNoopCacheItemHelper, 2));
+  ASSERT_EQ(cache->GetUsage(), 2U);
+
+  // Both nodes find the newer entry
+  for (int node : {0, 1}) {
+    current_node = node;
+    Cache::Handle* h = cache->Lookup("key");
+    ASSERT_NE(h, nullptr);
+    ASSERT_EQ(cache->GetCharge(h), 2U);
+    cache->Release(h);
+  }
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
+namespace {
+// The simulated NUMA node of the calling thread
+thread_local int numa_test_node = 0;
+}  // namespace
+
+TEST_F(LRUCacheTest, NumaAwareShardingConcurrentReplace) {
+  // Simulate a host with two NUMA nodes, with one thread on each
+  SyncPoint::GetInstance()->SetCallBack(
+      "ShardedCacheBase::InitNumaGroups:NumNodes",
+      [](void* arg) { *static_cast<int*>(arg) = 2; });
+  SyncPoint::GetInstance()->SetCallBack(
+      "ShardedCacheBase::GetCurrentNumaGroup:Node",
+      [](void* arg) { *static_cast<int*>(arg) = numa_test_node; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  LRUCacheOptions opts(/*capacity=*/1024 * 1024, /*num_shard_bits=*/2,
+                       /*strict_capacity_limit=*/false,
+                       /*high_pri_pool_ratio=*/0.0);
+  opts.numa_aware = true;
+  opts.metadata_charge_policy = kDontChargeCacheMetadata;
+  auto cache = opts.MakeSharedCache();
+
+  // Both nodes insert the same key at the same time, with charges standing in
+  // for different values (and erase it now and then). Whatever the
+  // interleaving, at most one entry for the key remains, which both nodes
+  // find, and it is never lost to a concurrent Insert from the other node.
+  for (int round = 0; round < 200; ++round) {
+    std::atomic<int> ready{0};
+    bool erase = round % 10 == 9;
+    auto writer = [&](int node) {
+      numa_test_node = node;
+      ready.fetch_add(1);
+      while (ready.load() < 2) {
+      }
+      if (erase && node == 1) {
+        cache->Erase("key");
+      } else {
+        ASSERT_OK(cache->Insert("key", nullptr, &kNoopCacheItemHelper,
+                                static_cast<size_t>(node + 1)));
+      }
+    };
+    port::Thread t0(writer, 0);
+    port::Thread t1(writer, 1);
+    t0.join();
+    t1.join();
+
+    size_t charges[2] = {0, 0};
+    for (int node : {0, 1}) {
+      numa_test_node = node;
+      Cache::Handle* h = cache->Lookup("key");
+      if (h != nullptr) {
+        charges[node] = cache->GetCharge(h);
+        cache->Release(h);
+      }
+    }
+    numa_test_node = 0;
+    ASSERT_EQ(charges[0], charges[1]) << "round " << round;
+    ASSERT_EQ(cache->GetUsage(), charges[0]) << "round " << round;
+    if (!erase) {
+      ASSERT_NE(charges[0], 0U) << "round " << round;
+    }
+  }
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
+TEST_F(LRUCacheTest, NumaAwareShardingSingleNode) {
+  SyncPoint::GetInstance()->SetCallBack(
+      "ShardedCacheBase::InitNumaGroups:NumNodes",
+      [](void* arg) { *static_cast<int*>(arg) = 1; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  LRUCacheOptions opts(/*capacity=*/1024, /*num_shard_bits=*/2,
+                       /*strict_capacity_limit=*/false,
+                       /*high_pri_pool_ratio=*/0.0);
+  opts.numa_aware = true;
+  auto cache = opts.MakeSharedCache();
+  auto sharded = static_cast<ShardedCacheBase*>(cache.get());
+  ASSERT_EQ(sharded->GetNumNumaGroups(), 1U);
+  ASSERT_TRUE(sharded->GetNumaShardGroupStats().empty());
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -12,9 +12,11 @@
 #include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "env/unique_id_gen.h"
 #include "rocksdb/env.h"
+#include "test_util/sync_point.h"
 #include "util/hash.h"
 #include "util/math.h"
 #include "util/mutexlock.h"
@@ -122,6 +124,9 @@ std::string ShardedCacheBase::GetPrintableOptions() const {
   snprintf(buffer, kBufferSize, "    memory_allocator : %s\n",
            memory_allocator() ? memory_allocator()->Name() : "None");
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "    numa_shard_groups : %u\n",
+           GetNumNumaGroups());
+  ret.append(buffer);
   AppendPrintableOptions(ret);
   return ret;
 }
@@ -138,6 +143,48 @@ int GetDefaultCacheShardBits(size_t capacity, size_t min_shard_size) {
   return num_shard_bits;
 }
 
+void ShardedCacheBase::InitNumaGroups() {
+  int num_nodes = port::NumNumaNodes();
+  TEST_SYNC_POINT_CALLBACK("ShardedCacheBase::InitNumaGroups:NumNodes",
+                           &num_nodes);
+  if (num_nodes <= 1) {
+    return;
+  }
+  numa_group_bits_ = std::min(
+      {FloorLog2(num_nodes), GetNumShardBits(), int{kMaxNumaGroupBits}});
+  numa_group_shift_ = GetNumShardBits() - numa_group_bits_;
+  if (numa_group_bits_ > 0) {
+    numa_lookup_counters_.reset(new CoreLocalArray<NumaLookupCounters>());
+    numa_key_mutexes_.reset(
+        new Striped<CacheAlignedWrapper<port::Mutex>>(GetNumShards()));
+  }
+}
+
+uint32_t ShardedCacheBase::GetCurrentNumaGroup() const {
+  int node = port::NumaNodeOfCpu();
+  TEST_SYNC_POINT_CALLBACK("ShardedCacheBase::GetCurrentNumaGroup:Node",
+                           &node);
+  return BottomNBits(static_cast<uint32_t>(node), numa_group_bits_);
+}
+
+std::vector<NumaShardGroupStats> ShardedCacheBase::GetNumaShardGroupStats()
+    const {
+  std::vector<NumaShardGroupStats> result;
+  if (numa_group_bits_ == 0) {
+    return result;
+  }
+  result.resize(GetNumNumaGroups());
+  for (size_t core = 0; core < numa_lookup_counters_->Size(); ++core) {
+    NumaLookupCounters* counters = numa_lookup_counters_->AccessAtCore(core);
+    for (size_t group = 0; group < result.size(); ++group) {
+      result[group].local_hits += counters->local_hits[group].LoadRelaxed();
+      result[group].remote_hits += counters->remote_hits[group].LoadRelaxed();
+      result[group].misses += counters->misses[group].LoadRelaxed();
+    }
+  }
+  return result;
+}
+
 int ShardedCacheBase::GetNumShardBits() const {
   return BitsSetToOne(shard_mask_);
 }
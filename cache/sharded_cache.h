@@ -11,11 +11,15 @@
 
 #include <atomic>
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "port/lang.h"
 #include "port/port.h"
 #include "rocksdb/advanced_cache.h"
+#include "util/atomic.h"
+#include "util/core_local.h"
 #include "util/hash.h"
 #include "util/mutexlock.h"
 
@@ -41,6 +45,15 @@ class CacheShardBase {
     return Lower32of64(hash);
   }
   void AppendPrintableOptions(std::string& /*str*/) const {}
+  // Whether an entry may be placed in a shard other than the one implied by
+  // its key, by rewriting the sharding bits of its hash with SteerHash(). This
+  // requires that nothing but shard selection depends on those bits. Used for
+  // NUMA-aware sharding.
+  static constexpr bool kSupportsHashSteering = false;
+  static inline HashVal SteerHash(HashCref hash, uint32_t /*shard_bits*/,
+                                  uint32_t /*shard_bits_mask*/) {
+    return hash;
+  }
 
   // Must be provided for concept CacheShard (TODO with C++20 support)
   /*
@@ -86,9 +99,22 @@ class CacheShardBase {
   const CacheMetadataChargePolicy metadata_charge_policy_;
 };
 
+// Lookup counts for one group of shards when NUMA-aware sharding is enabled.
+// A "local" hit was found in the group of the calling thread's NUMA node, a
+// "remote" hit in the group of another node.
+struct NumaShardGroupStats {
+  uint64_t local_hits = 0;
+  uint64_t remote_hits = 0;
+  uint64_t misses = 0;
+};
+
 // Portions of ShardedCache that do not depend on the template parameter
 class ShardedCacheBase : public Cache {
  public:
+  // At most 2^kMaxNumaGroupBits groups of shards for NUMA-aware sharding. On
+  // hosts with more NUMA nodes, nodes share groups.
+  static constexpr int kMaxNumaGroupBits = 3;
+
   explicit ShardedCacheBase(const ShardedCacheOptions& opts);
   virtual ~ShardedCacheBase() = default;
 
@@ -108,7 +134,27 @@ class ShardedCacheBase : public Cache {
 
   uint32_t GetHashSeed() const override { return hash_seed_; }
 
+  // Number of groups of shards, one per NUMA node, or 1 if NUMA-aware
+  // sharding is not in effect.
+  uint32_t GetNumNumaGroups() const { return uint32_t{1} << numa_group_bits_; }
+  // Lookup counts per NUMA node group (indexed by group). Empty if NUMA-aware
+  // sharding is not in effect.
+  std::vector<NumaShardGroupStats> GetNumaShardGroupStats() const;
+
  protected:  // fns
+  // Sets up NUMA-aware sharding for implementations supporting hash
+  // steering. Must be called (if at all) from the derived class constructor,
+  // before any cache operation. No effect on single-node hosts.
+  void InitNumaGroups();
+  // Group of shards for the NUMA node the calling thread is running on.
+  uint32_t GetCurrentNumaGroup() const;
+
+  struct ALIGN_AS(CACHE_LINE_SIZE) NumaLookupCounters {
+    RelaxedAtomic<uint64_t> local_hits[1 << kMaxNumaGroupBits];
+    RelaxedAtomic<uint64_t> remote_hits[1 << kMaxNumaGroupBits];
+    RelaxedAtomic<uint64_t> misses[1 << kMaxNumaGroupBits];
+  };
+
   virtual void AppendPrintableOptions(std::string& str) const = 0;
   size_t GetPerShardCapacity() const;
   size_t ComputePerShardCapacity(size_t capacity) const;
@@ -118,6 +164,16 @@ class ShardedCacheBase : public Cache {
   const uint32_t shard_mask_;
   const uint32_t hash_seed_;
 
+  // For NUMA-aware sharding: the top numa_group_bits_ bits of a shard index
+  // select the group of shards for a NUMA node. 0 when not in effect.
+  int numa_group_bits_ = 0;
+  int numa_group_shift_ = 0;
+  std::unique_ptr<CoreLocalArray<NumaLookupCounters>> numa_lookup_counters_;
+  // For NUMA-aware sharding: serializes Insert and Erase by key, so that
+  // inserting into one group and erasing the key from the other groups is
+  // atomic with respect to other writers of the key.
+  std::unique_ptr<Striped<CacheAlignedWrapper<port::Mutex>>> numa_key_mutexes_;
+
   // Dynamic configuration parameters, guarded by config_mutex_
   bool strict_capacity_limit_;
   size_t capacity_;
@@ -130,6 +186,13 @@ class ShardedCacheBase : public Cache {
 // so that the upper bits of the hash value can keep a stable ordering of
 // table entries even as the table grows (using more upper hash bits).
 // See CacheShardBase above for what is expected of the CacheShard parameter.
+//
+// With NUMA-aware sharding (see InitNumaGroups()), the shards are split into
+// one group per NUMA node. New entries are steered into the group of the
+// inserting thread's node, and lookups probe the local group before falling
+// back on the groups of remote nodes. An Insert replaces the entries for the
+// key in the other groups under a per-key (striped) mutex, so that only the
+// entry of the last Insert of a key remains.
 template <class CacheShard>
 class ShardedCache : public ShardedCacheBase {
  public:
@@ -181,6 +244,24 @@ class ShardedCache : public ShardedCacheBase {
     assert(helper);
     HashVal hash = CacheShard::ComputeHash(key, hash_seed_);
     auto h_out = reinterpret_cast<HandleImpl**>(handle);
+    if (numa_group_bits_ > 0) {
+      MutexLock l(&numa_key_mutexes_->Get(key, hash_seed_));
+      uint32_t local_group = GetCurrentNumaGroup();
+      HashVal steered = SteerToNumaGroup(hash, local_group);
+      Status s = GetShard(steered).Insert(key, steered, obj, helper, charge,
+                                          h_out, priority);
+      if (s.ok()) {
+        // Replace any entry inserted from another node, which lookups from
+        // that node would otherwise keep finding
+        for (uint32_t group = 0; group < GetNumNumaGroups(); ++group) {
+          if (group != local_group) {
+            steered = SteerToNumaGroup(hash, group);
+            GetShard(steered).Erase(key, steered);
+          }
+        }
+      }
+      return s;
+    }
     return GetShard(hash).Insert(key, hash, obj, helper, charge, h_out,
                                  priority);
   }
@@ -190,6 +271,9 @@ class ShardedCache : public ShardedCacheBase {
                            bool allow_uncharged) override {
     assert(helper);
     HashVal hash = CacheShard::ComputeHash(key, hash_seed_);
+    if (numa_group_bits_ > 0) {
+      hash = SteerToNumaGroup(hash, GetCurrentNumaGroup());
+    }
     HandleImpl* result = GetShard(hash).CreateStandalone(
         key, hash, obj, helper, charge, allow_uncharged);
     return static_cast<Handle*>(result);
@@ -200,6 +284,9 @@ class ShardedCache : public ShardedCacheBase {
                  Priority priority = Priority::LOW,
                  Statistics* stats = nullptr) override {
     HashVal hash = CacheShard::ComputeHash(key, hash_seed_);
+    if (numa_group_bits_ > 0) {
+      return NumaLookup(key, hash, helper, create_context, priority, stats);
+    }
     HandleImpl* result = GetShard(hash).Lookup(key, hash, helper,
                                                create_context, priority, stats);
     return static_cast<Handle*>(result);
@@ -207,6 +294,15 @@ class ShardedCache : public ShardedCacheBase {
 
   void Erase(const Slice& key) override {
     HashVal hash = CacheShard::ComputeHash(key, hash_seed_);
+    if (numa_group_bits_ > 0) {
+      // The entry could have been inserted from any node
+      MutexLock l(&numa_key_mutexes_->Get(key, hash_seed_));
+      for (uint32_t group = 0; group < GetNumNumaGroups(); ++group) {
+        HashVal steered = SteerToNumaGroup(hash, group);
+        GetShard(steered).Erase(key, steered);
+      }
+      return;
+    }
     GetShard(hash).Erase(key, hash);
   }
 
@@ -271,6 +367,52 @@ class ShardedCache : public ShardedCacheBase {
   }
 
  protected:
+  void InitNumaGroups() {
+    if constexpr (CacheShard::kSupportsHashSteering) {
+      ShardedCacheBase::InitNumaGroups();
+    }
+  }
+
+  HashVal SteerToNumaGroup(HashCref hash, uint32_t group) const {
+    assert(group < GetNumNumaGroups());
+    if constexpr (CacheShard::kSupportsHashSteering) {
+      uint32_t group_mask = GetNumNumaGroups() - 1;
+      return CacheShard::SteerHash(hash, group << numa_group_shift_,
+                                   group_mask << numa_group_shift_);
+    } else {
+      return hash;
+    }
+  }
+
+  Handle* NumaLookup(const Slice& key, HashCref hash,
+                     const CacheItemHelper* helper,
+                     CreateContext* create_context, Priority priority,
+                     Statistics* stats) {
+    uint32_t local_group = GetCurrentNumaGroup();
+    NumaLookupCounters* counters = numa_lookup_counters_->Access();
+    HashVal steered = SteerToNumaGroup(hash, local_group);
+    HandleImpl* result = GetShard(steered).Lookup(
+        key, steered, helper, create_context, priority, stats);
+    if (result != nullptr) {
+      counters->local_hits[local_group].FetchAddRelaxed(1);
+      return static_cast<Handle*>(result);
+    }
+    for (uint32_t group = 0; group < GetNumNumaGroups(); ++group) {
+      if (group == local_group) {
+        continue;
+      }
+      steered = SteerToNumaGroup(hash, group);
+      result = GetShard(steered).Lookup(key, steered, helper, create_context,
+                                        priority, stats);
+      if (result != nullptr) {
+        counters->remote_hits[local_group].FetchAddRelaxed(1);
+        return static_cast<Handle*>(result);
+      }
+    }
+    counters->misses[local_group].FetchAddRelaxed(1);
+    return nullptr;
+  }
+
   inline void ForEachShard(const std::function<void(CacheShard*)>& fn) {
     uint32_t num_shards = GetNumShards();
     for (uint32_t i = 0; i < num_shards; i++) {
@@ -23,6 +23,7 @@
 #include "options/cf_options.h"
 #include "options/options_helper.h"
 #include "rocksdb/slice.h"
+#include "rocksdb/sst_partitioner.h"
 #include "rocksdb/status.h"
 #include "test_util/sync_point.h"
 #include "trace_replay/io_tracer.h"
@@ -67,6 +68,11 @@ BlobFileBuilder::BlobFileBuilder(
       min_blob_size_(mutable_cf_options->min_blob_size),
       blob_file_size_(mutable_cf_options->blob_file_size),
       blob_compression_type_(mutable_cf_options->blob_compression_type),
+      blob_pre_compression_transform_(
+          mutable_cf_options->compression_opts.pre_compression_transform),
+      blob_pre_compression_element_size_(
+          mutable_cf_options->compression_opts.pre_compression_element_size),
+      blob_stored_compression_type_(blob_compression_type_),
       prepopulate_blob_cache_(mutable_cf_options->prepopulate_blob_cache),
       file_options_(file_options),
       write_options_(write_options),
@@ -92,6 +98,17 @@ BlobFileBuilder::BlobFileBuilder(
   assert(blob_file_paths_->empty());
   assert(blob_file_additions_);
   assert(blob_file_additions_->empty());
+
+  // The transform is recorded in the compression type of the blob file
+  // header and the blob indexes.
+  if (blob_compression_type_ != kNoCompression &&
+      blob_pre_compression_transform_ != PreCompressionTransform::kNone &&
+      IsSupportedPreCompressionElementSize(
+          blob_pre_compression_element_size_)) {
+    blob_stored_compression_type_ = MakeTransformedCompressionType(
+        blob_compression_type_, blob_pre_compression_transform_,
+        blob_pre_compression_element_size_);
+  }
 }
 
 BlobFileBuilder::~BlobFileBuilder() = default;
@@ -105,6 +122,18 @@ Status BlobFileBuilder::Add(const Slice& key, const Slice& value,
     return Status::OK();
   }
 
+  if (partitioner_) {
+    if (IsBlobFileOpen() &&
+        partitioner_->ShouldPartition(PartitionerRequest(
+            last_key_, key, blob_bytes_)) == kRequired) {
+      const Status s = CloseBlobFile();
+      if (!s.ok()) {
+        return s;
+      }
+    }
+    last_key_.assign(key.data(), key.size());
+  }
+
   {
     const Status s = OpenBlobFileIfNeeded();
     if (!s.ok()) {
@@ -151,11 +180,16 @@ Status BlobFileBuilder::Add(const Slice& key, const Slice& value,
   }
 
   BlobIndex::EncodeBlob(blob_index, blob_file_number, blob_offset, blob.size(),
-                        blob_compression_type_);
+                        blob_stored_compression_type_);
 
   return Status::OK();
 }
 
+void BlobFileBuilder::SetPartitioner(
+    std::unique_ptr<SstPartitioner> partitioner) {
+  partitioner_ = std::move(partitioner);
+}
+
 Status BlobFileBuilder::Finish() {
   if (!IsBlobFileOpen()) {
     return Status::OK();
@@ -232,8 +266,8 @@ Status BlobFileBuilder::OpenBlobFileIfNeeded() {
   constexpr bool has_ttl = false;
   constexpr ExpirationRange expiration_range;
 
-  BlobLogHeader header(column_family_id_, blob_compression_type_, has_ttl,
-                       expiration_range);
+  BlobLogHeader header(column_family_id_, blob_stored_compression_type_,
+                       has_ttl, expiration_range);
 
   {
     Status s = blob_log_writer->WriteHeader(*write_options_, header);
@@ -271,6 +305,15 @@ Status BlobFileBuilder::CompressBlobIfNeeded(
   CompressionInfo info(opts, context, CompressionDict::GetEmptyDict(),
                        blob_compression_type_);
 
+  std::string transformed;
+  if (blob_stored_compression_type_ != blob_compression_type_) {
+    transformed.resize(blob->size());
+    ApplyPreCompressionTransform(blob_pre_compression_transform_,
+                                 blob_pre_compression_element_size_,
+                                 blob->data(), blob->size(), &transformed[0]);
+  }
+  const Slice to_compress = transformed.empty() ? *blob : Slice(transformed);
+
   constexpr uint32_t compression_format_version = 2;
 
   bool success = false;
@@ -278,7 +321,7 @@ Status BlobFileBuilder::CompressBlobIfNeeded(
   {
     StopWatch stop_watch(immutable_options_->clock, immutable_options_->stats,
                          BLOB_DB_COMPRESSION_MICROS);
-    success = OLD_CompressData(*blob, info, compression_format_version,
+    success = OLD_CompressData(to_compress, info, compression_format_version,
                                compressed_blob);
   }
 
@@ -31,6 +31,7 @@ class Slice;
 class BlobLogWriter;
 class IOTracer;
 class BlobFileCompletionCallback;
+class SstPartitioner;
 
 class BlobFileBuilder {
  public:
@@ -73,6 +74,10 @@ class BlobFileBuilder {
   Status Finish();
   void Abandon(const Status& s);
 
+  // Starts a new blob file whenever `partitioner` requires a new file between
+  // the keys of two consecutive blobs, so blob files follow the partitions.
+  void SetPartitioner(std::unique_ptr<SstPartitioner> partitioner);
+
  private:
   bool IsBlobFileOpen() const;
   Status OpenBlobFileIfNeeded();
@@ -91,6 +96,10 @@ class BlobFileBuilder {
   uint64_t min_blob_size_;
   uint64_t blob_file_size_;
   CompressionType blob_compression_type_;
+  PreCompressionTransform blob_pre_compression_transform_;
+  uint32_t blob_pre_compression_element_size_;
+  // blob_compression_type_, with the transform (if any) encoded
+  CompressionType blob_stored_compression_type_;
   PrepopulateBlobCache prepopulate_blob_cache_;
   const FileOptions* file_options_;
   const WriteOptions* write_options_;
@@ -108,6 +117,9 @@ class BlobFileBuilder {
   std::unique_ptr<BlobLogWriter> writer_;
   uint64_t blob_count_;
   uint64_t blob_bytes_;
+  std::unique_ptr<SstPartitioner> partitioner_;
+  // User key of the last blob added, if partitioner_ is set
+  std::string last_key_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
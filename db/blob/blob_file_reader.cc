@@ -593,9 +593,12 @@ Status BlobFileReader::UncompressBlobIfNeeded(
     return Status::OK();
   }
 
-  UncompressionContext context(compression_type);
+  // A pre-compression transform (see BlobFileBuilder) is inverted after
+  // decompressing with the base compression type.
+  const CompressionType base_type = GetBaseCompressionType(compression_type);
+  UncompressionContext context(base_type);
   UncompressionInfo info(context, UncompressionDict::GetEmptyDict(),
-                         compression_type);
+                         base_type);
 
   size_t uncompressed_size = 0;
   constexpr uint32_t compression_format_version = 2;
@@ -617,6 +620,20 @@ Status BlobFileReader::UncompressBlobIfNeeded(
     return Status::Corruption("Unable to uncompress blob");
   }
 
+  if (base_type != compression_type) {
+    size_t element_size = 0;
+    const PreCompressionTransform transform =
+        GetPreCompressionTransform(compression_type, &element_size);
+    if (transform > PreCompressionTransform::kXorDelta) {
+      return Status::Corruption("Unknown pre-compression transform of blob");
+    }
+    CacheAllocationPtr untransformed =
+        AllocateBlock(uncompressed_size, allocator);
+    InvertPreCompressionTransform(transform, element_size, output.get(),
+                                  uncompressed_size, untransformed.get());
+    output = std::move(untransformed);
+  }
+
   result->reset(new BlobContents(std::move(output), uncompressed_size));
 
   return Status::OK();
@@ -20,6 +20,7 @@
 #include "db/blob/blob_source.h"
 #include "db/compaction/compaction_picker.h"
 #include "db/compaction/compaction_picker_fifo.h"
+#include "db/compaction/compaction_picker_hybrid.h"
 #include "db/compaction/compaction_picker_level.h"
 #include "db/compaction/compaction_picker_universal.h"
 #include "db/db_impl/db_impl.h"
@@ -35,6 +36,7 @@
 #include "options/options_helper.h"
 #include "port/port.h"
 #include "rocksdb/convenience.h"
+#include "rocksdb/memtablerep.h"
 #include "rocksdb/table.h"
 #include "table/merging_iterator.h"
 #include "util/autovector.h"
@@ -148,6 +150,22 @@ Status CheckCompressionSupported(const ColumnFamilyOptions& cf_options) {
     }
   }
 
+  for (const CompressionOptions* opts :
+       {&cf_options.compression_opts,
+        &cf_options.bottommost_compression_opts}) {
+    if (opts->pre_compression_transform != PreCompressionTransform::kNone &&
+        !IsSupportedPreCompressionElementSize(
+            opts->pre_compression_element_size)) {
+      return Status::InvalidArgument(
+          "pre_compression_element_size must be 1, 2, 4 or 8 with a "
+          "pre_compression_transform");
+    }
+    if (opts->adaptive_compression_budget_pct > 100) {
+      return Status::InvalidArgument(
+          "adaptive_compression_budget_pct must not exceed 100");
+    }
+  }
+
   if (!CompressionTypeSupported(cf_options.blob_compression_type)) {
     std::ostringstream oss;
     oss << "The specified blob compression type "
@@ -637,7 +655,11 @@ ColumnFamilyData::ColumnFamilyData(
     blob_source_.reset(new BlobSource(ioptions_, mutable_cf_options_, db_id,
                                       db_session_id, blob_file_cache_.get()));
 
-    if (ioptions_.compaction_style == kCompactionStyleLevel) {
+    if (ioptions_.compaction_style == kCompactionStyleLevel &&
+        ioptions_.level_compaction_l0_tiering_ratio > 0) {
+      compaction_picker_.reset(
+          new HybridCompactionPicker(ioptions_, &internal_comparator_));
+    } else if (ioptions_.compaction_style == kCompactionStyleLevel) {
       compaction_picker_.reset(
           new LevelCompactionPicker(ioptions_, &internal_comparator_));
     } else if (ioptions_.compaction_style == kCompactionStyleUniversal) {
@@ -1515,6 +1537,21 @@ Status ColumnFamilyData::ValidateOptions(
     }
   }
 
+  if (cf_options.memtable_factory) {
+    const auto* range_partitioned_opts =
+        cf_options.memtable_factory
+            ->GetOptions<RangePartitionedSkipListRepOptions>();
+    if (range_partitioned_opts != nullptr &&
+        range_partitioned_opts->point_index_bucket_count > 0 &&
+        (ucmp->timestamp_size() > 0 ||
+         ucmp->CanKeysWithDifferentByteContentsBeEqual())) {
+      return Status::NotSupported(
+          "Range partitioned skip list memtable point index requires a "
+          "comparator without user-defined timestamps that only considers "
+          "byte-identical keys equal.");
+    }
+  }
+
   if (cf_options.enable_blob_garbage_collection) {
     if (cf_options.blob_garbage_collection_age_cutoff < 0.0 ||
         cf_options.blob_garbage_collection_age_cutoff > 1.0) {
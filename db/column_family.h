@@ -28,6 +28,7 @@
 #include "rocksdb/options.h"
 #include "trace_replay/block_cache_tracer.h"
 #include "util/cast_util.h"
+#include "util/compression_dict_registry.h"
 #include "util/hash_containers.h"
 #include "util/thread_local.h"
 
@@ -415,6 +416,11 @@ class ColumnFamilyData {
   TableCache* table_cache() const { return table_cache_.get(); }
   BlobFileCache* blob_file_cache() const { return blob_file_cache_.get(); }
   BlobSource* blob_source() const { return blob_source_.get(); }
+  // Dictionaries shared by the table files of this column family, see
+  // CompressionOptions::use_shared_dict
+  CompressionDictRegistry* compression_dict_registry() {
+    return &compression_dict_registry_;
+  }
 
   // See documentation in compaction_picker.h
   // REQUIRES: DB mutex held
@@ -504,6 +510,14 @@ class ColumnFamilyData {
   void set_queued_for_compaction(bool value) { queued_for_compaction_ = value; }
   bool queued_for_flush() { return queued_for_flush_; }
   bool queued_for_compaction() { return queued_for_compaction_; }
+  // Bottommost compactions preempted since one last ran to completion (see
+  // DBOptions::preempt_bottommost_compactions)
+  int bottommost_compaction_preemptions() const {
+    return bottommost_compaction_preemptions_;
+  }
+  void set_bottommost_compaction_preemptions(int value) {
+    bottommost_compaction_preemptions_ = value;
+  }
 
   static std::pair<WriteStallCondition, WriteStallCause>
   GetWriteStallConditionAndCause(
@@ -642,6 +656,7 @@ class ColumnFamilyData {
   std::unique_ptr<TableCache> table_cache_;
   std::unique_ptr<BlobFileCache> blob_file_cache_;
   std::unique_ptr<BlobSource> blob_source_;
+  CompressionDictRegistry compression_dict_registry_;
 
   std::unique_ptr<InternalStats> internal_stats_;
 
@@ -686,6 +701,8 @@ class ColumnFamilyData {
   // DBImpl::compaction_queue_
   bool queued_for_compaction_;
 
+  int bottommost_compaction_preemptions_ = 0;
+
   uint64_t prev_compaction_needed_bytes_;
 
   // if the database was opened with 2pc enabled
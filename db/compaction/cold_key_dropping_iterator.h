@@ -0,0 +1,150 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "db/compaction/compaction.h"
+#include "db/dbformat.h"
+#include "rocksdb/comparator.h"
+#include "table/internal_iterator.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Wraps the input of a compaction with cold input files (see
+// Compaction::cold_input_files()), skipping all versions of the keys whose
+// latest version is in a cold file.
+//
+// The input files are told apart by sequence number, as the L0 files of a
+// FIFO compaction cover disjoint ranges of sequence numbers. Where ranges do
+// overlap (e.g. sequence numbers zeroed out by an earlier compaction), an
+// entry is only considered cold if no other file it could come from is. Range
+// tombstones are not affected. Only forward iteration is supported, as needed
+// by compaction.
+class ColdKeyDroppingIterator : public InternalIterator {
+ public:
+  ColdKeyDroppingIterator(InternalIterator* input, const Comparator* ucmp,
+                          const Compaction& compaction)
+      : input_(input), ucmp_(ucmp) {
+    for (size_t i = 0; i < compaction.num_input_levels(); ++i) {
+      for (const FileMetaData* f : *compaction.inputs(i)) {
+        const auto& cold_files = compaction.cold_input_files();
+        const bool cold = std::find(cold_files.begin(), cold_files.end(), f) !=
+                          cold_files.end();
+        files_.push_back({f->fd.smallest_seqno, f->fd.largest_seqno, cold});
+      }
+    }
+  }
+
+  bool Valid() const override { return input_->Valid(); }
+
+  void SeekToFirst() override {
+    input_->SeekToFirst();
+    has_user_key_ = false;
+    SkipColdKeys();
+  }
+
+  void SeekToLast() override {
+    assert(false);
+    status_ = Status::NotSupported("SeekToLast");
+  }
+
+  void Seek(const Slice& target) override {
+    input_->Seek(target);
+    has_user_key_ = false;
+    SkipColdKeys();
+  }
+
+  void SeekForPrev(const Slice& /*target*/) override {
+    assert(false);
+    status_ = Status::NotSupported("SeekForPrev");
+  }
+
+  void Next() override {
+    input_->Next();
+    SkipColdKeys();
+  }
+
+  void Prev() override {
+    assert(false);
+    status_ = Status::NotSupported("Prev");
+  }
+
+  Slice key() const override { return input_->key(); }
+
+  Slice value() const override { return input_->value(); }
+
+  Status status() const override {
+    return status_.ok() ? input_->status() : status_;
+  }
+
+  bool IsKeyPinned() const override { return input_->IsKeyPinned(); }
+
+  bool IsValuePinned() const override { return input_->IsValuePinned(); }
+
+  bool IsDeleteRangeSentinelKey() const override {
+    return input_->IsDeleteRangeSentinelKey();
+  }
+
+  // Number of entries skipped so far
+  uint64_t num_dropped() const { return num_dropped_; }
+
+ private:
+  struct InputFile {
+    SequenceNumber smallest_seqno;
+    SequenceNumber largest_seqno;
+    bool cold;
+  };
+
+  bool IsCold(SequenceNumber seq) const {
+    bool cold = false;
+    for (const InputFile& f : files_) {
+      if (seq >= f.smallest_seqno && seq <= f.largest_seqno) {
+        if (!f.cold) {
+          return false;
+        }
+        cold = true;
+      }
+    }
+    return cold;
+  }
+
+  void SkipColdKeys() {
+    while (input_->Valid() && !input_->IsDeleteRangeSentinelKey()) {
+      ParsedInternalKey ikey;
+      if (!ParseInternalKey(input_->key(), &ikey, false /* log_err_key */)
+               .ok()) {
+        // Leave reporting the corruption to the compaction iterator
+        return;
+      }
+      if (!has_user_key_ || ucmp_->CompareWithoutTimestamp(
+                                ikey.user_key, user_key_) != 0) {
+        // Latest version of a new key
+        user_key_.assign(ikey.user_key.data(), ikey.user_key.size());
+        has_user_key_ = true;
+        dropping_ = IsCold(ikey.sequence);
+      }
+      if (!dropping_) {
+        return;
+      }
+      ++num_dropped_;
+      input_->Next();
+    }
+  }
+
+  InternalIterator* input_;
+  const Comparator* const ucmp_;
+  std::vector<InputFile> files_;
+  std::string user_key_;
+  bool has_user_key_ = false;
+  bool dropping_ = false;
+  uint64_t num_dropped_ = 0;
+  Status status_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
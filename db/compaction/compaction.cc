@@ -487,6 +487,16 @@ bool Compaction::SupportsPerKeyPlacement() const {
 
 int Compaction::GetProximalLevel() const { return proximal_level_; }
 
+Temperature Compaction::GetOutputTemperature(bool is_proximal_level) const {
+  const Temperature last_level_temp =
+      mutable_cf_options_.last_level_temperature;
+  if (last_level_temp != Temperature::kUnknown && is_last_level() &&
+      !is_proximal_level) {
+    return last_level_temp;
+  }
+  return output_temperature_;
+}
+
 // smallest_key and largest_key include timestamps if user-defined timestamp is
 // enabled.
 bool Compaction::OverlapProximalLevelOutputRange(
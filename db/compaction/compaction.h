@@ -278,6 +278,17 @@ class Compaction {
     is_trivial_move_ = trivial_move;
   }
 
+  // For a FIFO compaction retaining recently read data (see
+  // CompactionOptionsFIFO::min_reads_to_retain), the input files that were
+  // not read enough to be retained. Keys whose latest version is in one of
+  // these files are dropped from the output.
+  void set_cold_input_files(std::vector<const FileMetaData*> files) {
+    cold_input_files_ = std::move(files);
+  }
+  const std::vector<const FileMetaData*>& cold_input_files() const {
+    return cold_input_files_;
+  }
+
   // Used when allow_trivial_move option is set in
   // Universal compaction. Returns true, if the input files
   // are non-overlapping and can be trivially moved.
@@ -412,6 +423,11 @@ class Compaction {
 
   Temperature output_temperature() const { return output_temperature_; }
 
+  // Temperature of the output files written to the output level, or to the
+  // proximal level if `is_proximal_level`. `last_level_temperature`, when
+  // set, supersedes `output_temperature()` for the last level.
+  Temperature GetOutputTemperature(bool is_proximal_level) const;
+
   uint32_t max_subcompactions() const { return max_subcompactions_; }
 
   bool enable_blob_garbage_collection() const {
@@ -592,6 +608,8 @@ class Compaction {
   // compaction
   bool is_trivial_move_;
 
+  std::vector<const FileMetaData*> cold_input_files_;
+
   // Does input compression match the output compression?
   bool InputCompressionMatchesOutput() const;
 
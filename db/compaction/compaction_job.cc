@@ -22,6 +22,7 @@
 #include "db/blob/blob_file_builder.h"
 #include "db/builder.h"
 #include "db/compaction/clipping_iterator.h"
+#include "db/compaction/cold_key_dropping_iterator.h"
 #include "db/compaction/compaction_state.h"
 #include "db/db_impl/db_impl.h"
 #include "db/dbformat.h"
@@ -33,6 +34,8 @@
 #include "db/range_del_aggregator.h"
 #include "db/version_edit.h"
 #include "db/version_set.h"
+#include "file/async_writable_file.h"
+#include "file/file_util.h"
 #include "file/filename.h"
 #include "file/read_write_util.h"
 #include "file/sst_file_manager_impl.h"
@@ -142,7 +145,8 @@ CompactionJob::CompactionJob(
     const std::string& db_id, const std::string& db_session_id,
     std::string full_history_ts_low, std::string trim_ts,
     BlobFileCompletionCallback* blob_callback, int* bg_compaction_scheduled,
-    int* bg_bottom_compaction_scheduled)
+    int* bg_bottom_compaction_scheduled,
+    CompressionThreadPool* compression_pool)
     : compact_(new CompactionState(compaction)),
       internal_stats_(compaction->compaction_reason(), 1),
       db_options_(db_options),
@@ -182,7 +186,8 @@ CompactionJob::CompactionJob(
       blob_callback_(blob_callback),
       extra_num_subcompaction_threads_reserved_(0),
       bg_compaction_scheduled_(bg_compaction_scheduled),
-      bg_bottom_compaction_scheduled_(bg_bottom_compaction_scheduled) {
+      bg_bottom_compaction_scheduled_(bg_bottom_compaction_scheduled),
+      compression_pool_(compression_pool) {
   assert(job_stats_ != nullptr);
   assert(log_buffer_ != nullptr);
   assert(job_context->snapshot_context_initialized);
@@ -625,9 +630,16 @@ void CompactionJob::GenSubcompactionBoundaries() {
     return;
   }
 
+  // Ranges beyond one per thread are taken by whichever thread is free first
+  // (see Run())
+  const uint64_t num_planned_ranges =
+      num_planned_subcompactions *
+      std::max(uint32_t{1},
+               mutable_db_options_copy_.subcompaction_ranges_per_thread);
+
   // Group the ranges into subcompactions
   uint64_t target_range_size = std::max(
-      total_size / num_planned_subcompactions,
+      total_size / num_planned_ranges,
       MaxFileSizeForLevel(
           c->mutable_cf_options(), out_lvl,
           c->immutable_options().compaction_style, base_level,
@@ -647,15 +659,17 @@ void CompactionJob::GenSubcompactionBoundaries() {
       num_actual_subcompactions++;
       boundaries_.push_back(anchor.user_key);
     }
-    if (num_actual_subcompactions == num_planned_subcompactions) {
+    if (num_actual_subcompactions == num_planned_ranges) {
       break;
     }
   }
   TEST_SYNC_POINT_CALLBACK("CompactionJob::GenSubcompactionBoundaries:1",
                            &num_actual_subcompactions);
   // Shrink extra subcompactions resources when extra resrouces are acquired
+  const uint64_t num_threads =
+      std::min(num_actual_subcompactions, num_planned_subcompactions);
   ShrinkSubcompactionResources(
-      std::min((int)(num_planned_subcompactions - num_actual_subcompactions),
+      std::min((int)(num_planned_subcompactions - num_threads),
                extra_num_subcompaction_threads_reserved_));
 }
 
@@ -666,22 +680,35 @@ Status CompactionJob::Run() {
   log_buffer_->FlushBufferToLog();
   LogCompaction();
 
-  const size_t num_threads = compact_->sub_compact_states.size();
-  assert(num_threads > 0);
+  const size_t num_subcompactions = compact_->sub_compact_states.size();
+  assert(num_subcompactions > 0);
+  // There can be more subcompactions than threads with
+  // subcompaction_ranges_per_thread > 1
+  const size_t num_threads = std::min(
+      num_subcompactions, static_cast<size_t>(GetSubcompactionsLimit()));
   const uint64_t start_micros = db_options_.clock->NowMicros();
   compact_->compaction->GetOrInitInputTableProperties();
 
+  // Each thread starts with the subcompaction of its own index, then takes
+  // the next one not yet taken until there are none left
+  std::atomic<size_t> next_subcompaction(num_threads);
+  auto process_subcompactions = [&](size_t first) {
+    for (size_t i = first; i < num_subcompactions;
+         i = next_subcompaction.fetch_add(1, std::memory_order_relaxed)) {
+      ProcessKeyValueCompaction(&compact_->sub_compact_states[i]);
+    }
+  };
+
   // Launch a thread for each of subcompactions 1...num_threads-1
   std::vector<port::Thread> thread_pool;
   thread_pool.reserve(num_threads - 1);
-  for (size_t i = 1; i < compact_->sub_compact_states.size(); i++) {
-    thread_pool.emplace_back(&CompactionJob::ProcessKeyValueCompaction, this,
-                             &compact_->sub_compact_states[i]);
+  for (size_t i = 1; i < num_threads; i++) {
+    thread_pool.emplace_back(process_subcompactions, i);
   }
 
   // Always schedule the first subcompaction (whether or not there are also
   // others) in the current thread to be efficient with resources
-  ProcessKeyValueCompaction(compact_->sub_compact_states.data());
+  process_subcompactions(0);
 
   // Wait for all other threads (if there are any) to finish execution
   for (auto& thread : thread_pool) {
@@ -1192,6 +1219,9 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
   read_options.fill_cache = false;
   read_options.rate_limiter_priority = GetRateLimiterPriority();
   read_options.io_activity = Env::IOActivity::kCompaction;
+  read_options.async_io =
+      mutable_db_options_copy_.compaction_async_io &&
+      CheckFSFeatureSupport(fs_.get(), FSSupportedOps::kAsyncIO);
   // Compaction iterators shouldn't be confined to a single prefix.
   // Compactions use Seek() for
   // (a) concurrent compactions,
@@ -1281,6 +1311,15 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
     input = blob_counter.get();
   }
 
+  // Above the blob counter, so that references to blobs from dropped keys
+  // count as garbage
+  std::unique_ptr<ColdKeyDroppingIterator> cold_key_dropper;
+  if (!sub_compact->compaction->cold_input_files().empty()) {
+    cold_key_dropper = std::make_unique<ColdKeyDroppingIterator>(
+        input, cfd->user_comparator(), *sub_compact->compaction);
+    input = cold_key_dropper.get();
+  }
+
   std::unique_ptr<InternalIterator> trim_history_iter;
   if (ts_sz > 0 && !trim_ts_.empty()) {
     trim_history_iter = std::make_unique<HistoryTrimmingIterator>(
@@ -1340,6 +1379,13 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
                 BlobFileCreationReason::kCompaction, &blob_file_paths,
                 sub_compact->Current().GetBlobFileAdditionsPtr())
           : nullptr);
+  if (blob_file_builder && sub_compact->compaction->output_level() != 0) {
+    std::unique_ptr<SstPartitioner> blob_partitioner =
+        sub_compact->compaction->CreateSstPartitioner();
+    if (blob_partitioner && blob_partitioner->PartitionBlobFiles()) {
+      blob_file_builder->SetPartitioner(std::move(blob_partitioner));
+    }
+  }
 
   TEST_SYNC_POINT("CompactionJob::Run():Inprogress");
   TEST_SYNC_POINT_CALLBACK("CompactionJob::Run():PausingManualCompaction:1",
@@ -1391,6 +1437,8 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
       "CompactionJob::ProcessKeyValueCompaction()::Processing",
       static_cast<void*>(const_cast<Compaction*>(sub_compact->compaction)));
   uint64_t last_cpu_micros = prev_cpu_micros;
+  const bool value_transformer =
+      cfd->ioptions().compaction_value_transformer != nullptr;
   while (status.ok() && !cfd->IsDropped() && c_iter->Valid()) {
     // Invariant: c_iter.status() is guaranteed to be OK if c_iter->Valid()
     // returns true.
@@ -1443,8 +1491,13 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
     // and `close_file_func`.
     // TODO: it would be better to have the compaction file open/close moved
     // into `CompactionOutputs` which has the output file information.
-    status = sub_compact->AddToOutput(*c_iter, use_proximal_output,
-                                      open_file_func, close_file_func);
+    if (value_transformer) {
+      status = sub_compact->AddToTransformBatch(
+          *c_iter, use_proximal_output, open_file_func, close_file_func);
+    } else {
+      status = sub_compact->AddToOutput(*c_iter, use_proximal_output,
+                                        open_file_func, close_file_func);
+    }
     if (!status.ok()) {
       break;
     }
@@ -1475,6 +1528,11 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
       c_iter->HasNumInputEntryScanned();
   sub_compact->compaction_job_stats.num_input_records =
       c_iter->NumInputEntryScanned();
+  if (cold_key_dropper) {
+    // Entries of cold keys never reach the compaction iterator
+    sub_compact->compaction_job_stats.num_input_records +=
+        cold_key_dropper->num_dropped();
+  }
   sub_compact->compaction_job_stats.num_blobs_read =
       c_iter_stats.num_blobs_read;
   sub_compact->compaction_job_stats.total_blob_bytes_read =
@@ -1525,6 +1583,9 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
   if (status.ok()) {
     status = c_iter->status();
   }
+  if (status.ok() && value_transformer) {
+    status = sub_compact->FlushTransformBatch(open_file_func, close_file_func);
+  }
 
   // Call FinishCompactionOutputFile() even if status is not ok: it needs to
   // close the output files. Open file function is also passed, in case there's
@@ -1950,15 +2011,8 @@ Status CompactionJob::OpenCompactionOutputFile(SubcompactionState* sub_compact,
 
   // Pass temperature of the last level files to FileSystem.
   FileOptions fo_copy = file_options_;
-  Temperature temperature = sub_compact->compaction->output_temperature();
-  Temperature last_level_temp =
-      sub_compact->compaction->mutable_cf_options().last_level_temperature;
-  // Here last_level_temperature supersedes default_write_temperature, when
-  // enabled and applicable
-  if (last_level_temp != Temperature::kUnknown &&
-      sub_compact->compaction->is_last_level() && !outputs.IsProximalLevel()) {
-    temperature = last_level_temp;
-  }
+  Temperature temperature =
+      sub_compact->compaction->GetOutputTemperature(outputs.IsProximalLevel());
   fo_copy.temperature = temperature;
   fo_copy.write_hint = write_hint_;
 
@@ -2052,6 +2106,13 @@ Status CompactionJob::OpenCompactionOutputFile(SubcompactionState* sub_compact,
   FileTypeSet tmp_set = db_options_.checksum_handoff_file_types;
   writable_file->SetPreallocationBlockSize(static_cast<size_t>(
       sub_compact->compaction->OutputFilePreallocationSize()));
+  if (mutable_db_options_copy_.compaction_async_io &&
+      !writable_file->use_direct_io()) {
+    // The file system writes one buffer of WritableFileWriter while the
+    // compaction fills the next
+    writable_file = NewAsyncWritableFile(std::move(writable_file),
+                                         2 /* max_buffers_in_flight */);
+  }
   const auto& listeners =
       sub_compact->compaction->immutable_options().listeners;
   outputs.AssignFileWriter(new WritableFileWriter(
@@ -2074,6 +2135,8 @@ Status CompactionJob::OpenCompactionOutputFile(SubcompactionState* sub_compact,
       0 /* oldest_key_time */, current_time, db_id_, db_session_id_,
       sub_compact->compaction->max_output_file_size(), file_number,
       proximal_after_seqno_ /*last_level_inclusive_max_seqno_threshold*/);
+  tboptions.compression_pool = compression_pool_;
+  tboptions.compression_dict_registry = cfd->compression_dict_registry();
 
   outputs.NewBuilder(tboptions);
 
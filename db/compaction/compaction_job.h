@@ -49,6 +49,7 @@ namespace ROCKSDB_NAMESPACE {
 
 class Arena;
 class CompactionState;
+class CompressionThreadPool;
 class ErrorHandler;
 class MemTable;
 class SnapshotChecker;
@@ -162,7 +163,8 @@ class CompactionJob {
                 std::string full_history_ts_low = "", std::string trim_ts = "",
                 BlobFileCompletionCallback* blob_callback = nullptr,
                 int* bg_compaction_scheduled = nullptr,
-                int* bg_bottom_compaction_scheduled = nullptr);
+                int* bg_bottom_compaction_scheduled = nullptr,
+                CompressionThreadPool* compression_pool = nullptr);
 
   virtual ~CompactionJob();
 
@@ -349,6 +351,8 @@ class CompactionJob {
   int* bg_compaction_scheduled_;
   int* bg_bottom_compaction_scheduled_;
 
+  CompressionThreadPool* compression_pool_;
+
   // Stores the sequence number to time mapping gathered from all input files
   // it also collects the smallest_seqno -> oldest_ancester_time from the SST.
   SeqnoToTimeMapping seqno_to_time_mapping_;
@@ -229,9 +229,8 @@ uint64_t CompactionOutputs::GetCurrentKeyGrandparentOverlappedBytes(
   return overlapped_bytes;
 }
 
-bool CompactionOutputs::ShouldStopBefore(const CompactionIterator& c_iter) {
-  assert(c_iter.Valid());
-  const Slice& internal_key = c_iter.key();
+bool CompactionOutputs::ShouldStopBefore(const Slice& internal_key,
+                                         const Slice& user_key) {
 #ifndef NDEBUG
   bool should_stop = false;
   std::pair<bool*, const Slice> p{&should_stop, internal_key};
@@ -266,7 +265,7 @@ bool CompactionOutputs::ShouldStopBefore(const CompactionIterator& c_iter) {
 
   // If there's user defined partitioner, check that first
   if (partitioner_ && partitioner_->ShouldPartition(PartitionerRequest(
-                          last_key_for_partitioner_, c_iter.user_key(),
+                          last_key_for_partitioner_, user_key,
                           current_output_file_size_)) == kRequired) {
     return true;
   }
@@ -356,20 +355,19 @@ bool CompactionOutputs::ShouldStopBefore(const CompactionIterator& c_iter) {
 }
 
 Status CompactionOutputs::AddToOutput(
-    const CompactionIterator& c_iter,
+    const Slice& key, const ParsedInternalKey& ikey, const Slice& user_key,
+    const Slice& value, bool is_range_del, const Status& input_status,
     const CompactionFileOpenFunc& open_file_func,
     const CompactionFileCloseFunc& close_file_func) {
   Status s;
-  bool is_range_del = c_iter.IsDeleteRangeSentinelKey();
   if (is_range_del && compaction_->bottommost_level()) {
     // We don't consider range tombstone for bottommost level since:
     // 1. there is no grandparent and hence no overlap to consider
     // 2. range tombstone may be dropped at bottommost level.
     return s;
   }
-  const Slice& key = c_iter.key();
-  if (ShouldStopBefore(c_iter) && HasBuilder()) {
-    s = close_file_func(*this, c_iter.InputStatus(), key);
+  if (ShouldStopBefore(key, user_key) && HasBuilder()) {
+    s = close_file_func(*this, input_status, key);
     if (!s.ok()) {
       return s;
     }
@@ -397,8 +395,7 @@ Status CompactionOutputs::AddToOutput(
   // c_iter may emit range deletion keys, so update `last_key_for_partitioner_`
   // here before returning below when `is_range_del` is true
   if (partitioner_) {
-    last_key_for_partitioner_.assign(c_iter.user_key().data_,
-                                     c_iter.user_key().size_);
+    last_key_for_partitioner_.assign(user_key.data_, user_key.size_);
   }
 
   if (UNLIKELY(is_range_del)) {
@@ -406,7 +403,6 @@ Status CompactionOutputs::AddToOutput(
   }
 
   assert(builder_ != nullptr);
-  const Slice& value = c_iter.value();
   s = current_output().validator.Add(key, value);
   if (!s.ok()) {
     return s;
@@ -424,7 +420,6 @@ Status CompactionOutputs::AddToOutput(
     return s;
   }
 
-  const ParsedInternalKey& ikey = c_iter.ikey();
   if (ikey.type == kTypeValuePreferredSeqno) {
     SequenceNumber preferred_seqno = ParsePackedValueForSeqno(value);
     smallest_preferred_seqno_ =
@@ -218,7 +218,7 @@ class CompactionOutputs {
 
   // Returns true iff we should stop building the current output
   // before processing the current key in compaction iterator.
-  bool ShouldStopBefore(const CompactionIterator& c_iter);
+  bool ShouldStopBefore(const Slice& internal_key, const Slice& user_key);
 
   void Cleanup() {
     if (builder_ != nullptr) {
@@ -249,6 +249,20 @@ class CompactionOutputs {
   // Add current key from compaction_iterator to the output file. If needed
   // close and open new compaction output with the functions provided.
   Status AddToOutput(const CompactionIterator& c_iter,
+                     const CompactionFileOpenFunc& open_file_func,
+                     const CompactionFileCloseFunc& close_file_func) {
+    assert(c_iter.Valid());
+    return AddToOutput(c_iter.key(), c_iter.ikey(), c_iter.user_key(),
+                       c_iter.value(), c_iter.IsDeleteRangeSentinelKey(),
+                       c_iter.InputStatus(), open_file_func, close_file_func);
+  }
+
+  // Same as above for a key/value the compaction_iterator produced earlier.
+  // `user_key` and `input_status` are its `user_key()` and `InputStatus()` at
+  // that time.
+  Status AddToOutput(const Slice& key, const ParsedInternalKey& ikey,
+                     const Slice& user_key, const Slice& value,
+                     bool is_range_del, const Status& input_status,
                      const CompactionFileOpenFunc& open_file_func,
                      const CompactionFileCloseFunc& close_file_func);
 
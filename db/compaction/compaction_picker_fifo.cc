@@ -9,6 +9,7 @@
 
 #include "db/compaction/compaction_picker_fifo.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <string>
 #include <vector>
@@ -231,6 +232,16 @@ Compaction* FIFOCompactionPicker::PickSizeCompaction(
   inputs.emplace_back();
   inputs[0].level = last_level;
 
+  if (last_level == 0 &&
+      mutable_cf_options.compaction_options_fifo.min_reads_to_retain > 0) {
+    Compaction* c = PickSizeCompactionRetainingReadFiles(
+        cf_name, mutable_cf_options, mutable_db_options, vstorage, total_size,
+        log_buffer);
+    if (c != nullptr) {
+      return c;
+    }
+  }
+
   if (last_level == 0) {
     // In L0, right-most files are the oldest files.
     for (auto ritr = last_level_files.rbegin(); ritr != last_level_files.rend();
@@ -305,6 +316,70 @@ Compaction* FIFOCompactionPicker::PickSizeCompaction(
   return c;
 }
 
+// Picks the oldest L0 files as PickSizeCompaction() does, except that the
+// files read at least min_reads_to_retain times are given a second chance.
+// Their keys are retained by compacting the picked files together, dropping
+// the keys last written to the other, cold, files. As the retained data still
+// counts towards max_table_files_size, files are picked until dropping the
+// cold ones is enough. Returns nullptr if no file qualifies for retention, or
+// if the retained data alone would exceed max_table_files_size, leaving it to
+// PickSizeCompaction() to delete the oldest files as usual.
+Compaction* FIFOCompactionPicker::PickSizeCompactionRetainingReadFiles(
+    const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+    const MutableDBOptions& mutable_db_options, VersionStorageInfo* vstorage,
+    uint64_t total_size, LogBuffer* log_buffer) {
+  const CompactionOptionsFIFO& fifo_options =
+      mutable_cf_options.compaction_options_fifo;
+  const std::vector<FileMetaData*>& level0_files = vstorage->LevelFiles(0);
+
+  std::vector<CompactionInputFiles> inputs;
+  inputs.emplace_back();
+  inputs[0].level = 0;
+  std::vector<const FileMetaData*> cold_files;
+  // In L0, right-most files are the oldest files.
+  for (auto ritr = level0_files.rbegin(); ritr != level0_files.rend(); ++ritr) {
+    FileMetaData* f = *ritr;
+    if (f->being_compacted) {
+      return nullptr;
+    }
+    inputs[0].files.push_back(f);
+    if (f->stats.num_reads_sampled.load(std::memory_order_relaxed) <
+        fifo_options.min_reads_to_retain) {
+      cold_files.push_back(f);
+      total_size -= f->fd.file_size;
+      if (total_size <= fifo_options.max_table_files_size) {
+        break;
+      }
+    }
+  }
+  if (total_size > fifo_options.max_table_files_size ||
+      cold_files.size() == inputs[0].files.size()) {
+    return nullptr;
+  }
+
+  ROCKS_LOG_BUFFER(log_buffer,
+                   "[%s] FIFO compaction: retaining keys of %" ROCKSDB_PRIszt
+                   " recently read file(s) while dropping %" ROCKSDB_PRIszt
+                   " file(s)",
+                   cf_name.c_str(), inputs[0].files.size() - cold_files.size(),
+                   cold_files.size());
+  // Back to L0 order, newest first
+  std::reverse(inputs[0].files.begin(), inputs[0].files.end());
+  Compaction* c = new Compaction(
+      vstorage, ioptions_, mutable_cf_options, mutable_db_options,
+      std::move(inputs), 0, 16 * 1024 * 1024 /* output file size limit */,
+      0 /* max compaction bytes, not applicable */, 0 /* output path ID */,
+      mutable_cf_options.compression, mutable_cf_options.compression_opts,
+      mutable_cf_options.default_write_temperature,
+      0 /* max_subcompactions */, {}, /* earliest_snapshot */ std::nullopt,
+      /* snapshot_checker */ nullptr, /* is manual */ false,
+      /* trim_ts */ "", vstorage->CompactionScore(0),
+      /* is deletion compaction */ false,
+      /* l0_files_might_overlap */ true, CompactionReason::kFIFOMaxSize);
+  c->set_cold_input_files(std::move(cold_files));
+  return c;
+}
+
 Compaction* FIFOCompactionPicker::PickTemperatureChangeCompaction(
     const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
     const MutableDBOptions& mutable_db_options, VersionStorageInfo* vstorage,
@@ -0,0 +1,232 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "db/compaction/compaction_picker_hybrid.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "db/version_edit.h"
+#include "logging/log_buffer.h"
+#include "logging/logging.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+std::vector<HybridCompactionPicker::L0KeyRange>
+HybridCompactionPicker::GetL0KeyRanges(VersionStorageInfo* vstorage) const {
+  const std::vector<FileMetaData*>& level_files = vstorage->LevelFiles(0);
+  std::vector<size_t> by_smallest_key;
+  for (size_t i = 0; i < level_files.size(); i++) {
+    if (!level_files[i]->being_compacted) {
+      by_smallest_key.push_back(i);
+    }
+  }
+  std::sort(by_smallest_key.begin(), by_smallest_key.end(),
+            [&](size_t a, size_t b) {
+              return icmp_->Compare(level_files[a]->smallest,
+                                    level_files[b]->smallest) < 0;
+            });
+
+  // Sweep the files by smallest key, starting a new range at each gap
+  const Comparator* ucmp = icmp_->user_comparator();
+  std::vector<L0KeyRange> ranges;
+  std::vector<size_t> range_of_file(level_files.size());
+  std::vector<uint64_t> oldest_creation_time;
+  for (size_t i : by_smallest_key) {
+    FileMetaData* f = level_files[i];
+    if (ranges.empty() ||
+        ucmp->CompareWithoutTimestamp(f->smallest.user_key(),
+                                      ranges.back().largest.user_key()) > 0) {
+      ranges.emplace_back();
+      ranges.back().files.level = 0;
+      ranges.back().smallest = f->smallest;
+      ranges.back().largest = f->largest;
+      oldest_creation_time.push_back(kUnknownFileCreationTime);
+    } else if (icmp_->Compare(f->largest, ranges.back().largest) > 0) {
+      ranges.back().largest = f->largest;
+    }
+    ranges.back().bytes += f->compensated_file_size;
+    const uint64_t creation_time = f->TryGetFileCreationTime();
+    if (creation_time != kUnknownFileCreationTime &&
+        (oldest_creation_time.back() == kUnknownFileCreationTime ||
+         creation_time < oldest_creation_time.back())) {
+      oldest_creation_time.back() = creation_time;
+    }
+    range_of_file[i] = ranges.size() - 1;
+  }
+  // Keep the files of each range in L0 order
+  for (size_t i = 0; i < level_files.size(); i++) {
+    if (!level_files[i]->being_compacted) {
+      ranges[range_of_file[i]].files.files.push_back(level_files[i]);
+    }
+  }
+
+  int64_t now = 0;
+  if (!ioptions_.clock->GetCurrentTime(&now).ok()) {
+    now = 0;
+  }
+  for (size_t i = 0; i < ranges.size(); i++) {
+    // Files of unknown age count as just created
+    uint64_t age_secs = 1;
+    if (oldest_creation_time[i] != kUnknownFileCreationTime &&
+        static_cast<uint64_t>(now) > oldest_creation_time[i]) {
+      age_secs = static_cast<uint64_t>(now) - oldest_creation_time[i];
+    }
+    ranges[i].write_rate = static_cast<double>(ranges[i].bytes) / age_secs;
+  }
+  std::stable_sort(ranges.begin(), ranges.end(),
+                   [](const L0KeyRange& a, const L0KeyRange& b) {
+                     return a.write_rate > b.write_rate;
+                   });
+  return ranges;
+}
+
+Compaction* HybridCompactionPicker::PickL0KeyRangeCompaction(
+    const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+    const MutableDBOptions& mutable_db_options, VersionStorageInfo* vstorage,
+    LogBuffer* log_buffer, std::vector<FileMetaData*>* held_back_files) {
+  // Only take over when leveled compaction would compact L0 first
+  if (vstorage->CompactionScoreLevel(0) != 0 ||
+      vstorage->CompactionScore(0) < 1) {
+    return nullptr;
+  }
+  const int base_level = vstorage->base_level();
+  if (base_level <= 0 || IsLevel0CompactionInProgress()) {
+    return nullptr;
+  }
+  // Holding back merged ranges leaves files in L0 for as long as their key
+  // range stays tiered. Stop once L0 gets within one compaction trigger of
+  // slowing down writes, so that leveled picking drains it in time.
+  const bool hold_back_merged_ranges =
+      vstorage->NumLevelFiles(0) +
+          mutable_cf_options.level0_file_num_compaction_trigger <
+      mutable_cf_options.level0_slowdown_writes_trigger;
+
+  for (L0KeyRange& range : GetL0KeyRanges(vstorage)) {
+    std::vector<FileMetaData*> base_level_files;
+    vstorage->GetOverlappingInputs(base_level, &range.smallest,
+                                   &range.largest, &base_level_files);
+    uint64_t base_level_bytes = 0;
+    for (FileMetaData* f : base_level_files) {
+      base_level_bytes += f->fd.GetFileSize();
+    }
+    const bool tiered =
+        static_cast<double>(base_level_bytes) >
+            ioptions_.level_compaction_l0_tiering_ratio * range.bytes &&
+        range.bytes < mutable_cf_options.max_compaction_bytes;
+
+    int output_level;
+    std::vector<CompactionInputFiles> inputs;
+    std::vector<FileMetaData*> grandparents;
+    if (tiered) {
+      if (range.files.size() < 2) {
+        if (!hold_back_merged_ranges) {
+          continue;
+        }
+        // Already merged; wait for more data to arrive in the range
+        held_back_files->insert(held_back_files->end(),
+                                range.files.files.begin(),
+                                range.files.files.end());
+        continue;
+      }
+      output_level = 0;
+      inputs.push_back(std::move(range.files));
+    } else {
+      output_level = base_level;
+      CompactionInputFiles start_level_inputs = std::move(range.files);
+      CompactionInputFiles output_level_inputs;
+      output_level_inputs.level = output_level;
+      int parent_index = -1;
+      if (!GetOverlappingL0Files(vstorage, &start_level_inputs, output_level,
+                                 &parent_index) ||
+          !SetupOtherInputs(cf_name, mutable_cf_options, vstorage,
+                            &start_level_inputs, &output_level_inputs,
+                            &parent_index, /*base_index=*/-1)) {
+        continue;
+      }
+      GetGrandparents(vstorage, start_level_inputs, output_level_inputs,
+                      &grandparents);
+      inputs.push_back(std::move(start_level_inputs));
+      if (!output_level_inputs.empty()) {
+        inputs.push_back(std::move(output_level_inputs));
+      }
+      if (FilesRangeOverlapWithCompaction(
+              inputs, output_level,
+              Compaction::EvaluateProximalLevel(vstorage, mutable_cf_options,
+                                                ioptions_, 0, output_level))) {
+        continue;
+      }
+    }
+
+    ROCKS_LOG_BUFFER(log_buffer,
+                     "[%s] Hybrid: %s compaction of %" ROCKSDB_PRIszt
+                     " L0 files, %" PRIu64 " bytes overlapping %" PRIu64
+                     " bytes in L%d, write rate %.0f bytes/s",
+                     cf_name.c_str(), tiered ? "tiered" : "leveled",
+                     inputs[0].size(), range.bytes, base_level_bytes,
+                     base_level, range.write_rate);
+    const bool l0_files_might_overlap =
+        inputs.size() > 1 || inputs[0].size() > 1;
+    Compaction* c = new Compaction(
+        vstorage, ioptions_, mutable_cf_options, mutable_db_options,
+        std::move(inputs), output_level,
+        MaxFileSizeForLevel(mutable_cf_options, output_level,
+                            ioptions_.compaction_style, base_level,
+                            ioptions_.level_compaction_dynamic_level_bytes),
+        mutable_cf_options.max_compaction_bytes,
+        GetPathId(ioptions_, mutable_cf_options, output_level),
+        GetCompressionType(vstorage, mutable_cf_options, output_level,
+                           base_level),
+        GetCompressionOptions(mutable_cf_options, vstorage, output_level),
+        mutable_cf_options.default_write_temperature,
+        /* max_subcompactions */ 0, std::move(grandparents),
+        /* earliest_snapshot */ std::nullopt, /* snapshot_checker */ nullptr,
+        /* is_manual */ false, /* trim_ts */ "", vstorage->CompactionScore(0),
+        /* deletion_compaction */ false, l0_files_might_overlap,
+        CompactionReason::kLevelL0FilesNum);
+    RegisterCompaction(c);
+    vstorage->ComputeCompactionScore(ioptions_, mutable_cf_options);
+    return c;
+  }
+  return nullptr;
+}
+
+Compaction* HybridCompactionPicker::PickCompaction(
+    const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+    const MutableDBOptions& mutable_db_options,
+    const std::vector<SequenceNumber>& existing_snapshots,
+    const SnapshotChecker* snapshot_checker, VersionStorageInfo* vstorage,
+    LogBuffer* log_buffer) {
+  std::vector<FileMetaData*> held_back_files;
+  Compaction* c = PickL0KeyRangeCompaction(cf_name, mutable_cf_options,
+                                           mutable_db_options, vstorage,
+                                           log_buffer, &held_back_files);
+  if (c != nullptr) {
+    return c;
+  }
+
+  // Hide the held back files from leveled picking, which would otherwise merge
+  // them into the base level along with the rest of L0
+  for (FileMetaData* f : held_back_files) {
+    assert(!f->being_compacted);
+    f->being_compacted = true;
+  }
+  c = LevelCompactionPicker::PickCompaction(
+      cf_name, mutable_cf_options, mutable_db_options, existing_snapshots,
+      snapshot_checker, vstorage, log_buffer);
+  for (FileMetaData* f : held_back_files) {
+    f->being_compacted = false;
+  }
+  if (c != nullptr && !held_back_files.empty()) {
+    // The scores computed for the picked compaction saw the held back files
+    // as being compacted
+    vstorage->ComputeCompactionScore(ioptions_, mutable_cf_options);
+  }
+  return c;
+}
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,51 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include "db/compaction/compaction_picker_level.h"
+
+namespace ROCKSDB_NAMESPACE {
+// Picking compactions for leveled compaction with
+// `level_compaction_l0_tiering_ratio` set. L0 is compacted per key range,
+// merging the L0 files of a range among themselves (tiered) when merging them
+// into the base level would rewrite too many base level bytes per L0 byte, and
+// into the base level (leveled) otherwise. Everything else is picked as in
+// LevelCompactionPicker.
+class HybridCompactionPicker : public LevelCompactionPicker {
+ public:
+  HybridCompactionPicker(const ImmutableOptions& ioptions,
+                         const InternalKeyComparator* icmp)
+      : LevelCompactionPicker(ioptions, icmp) {}
+  Compaction* PickCompaction(
+      const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+      const MutableDBOptions& mutable_db_options,
+      const std::vector<SequenceNumber>& existing_snapshots,
+      const SnapshotChecker* snapshot_checker, VersionStorageInfo* vstorage,
+      LogBuffer* log_buffer) override;
+
+ private:
+  // A group of mutually overlapping L0 files
+  struct L0KeyRange {
+    CompactionInputFiles files;
+    InternalKey smallest;
+    InternalKey largest;
+    uint64_t bytes = 0;
+    // Bytes per second written to the range, estimated from the creation time
+    // of its oldest L0 file
+    double write_rate = 0;
+  };
+
+  // Returns the L0 key ranges, with the highest write rate first
+  std::vector<L0KeyRange> GetL0KeyRanges(VersionStorageInfo* vstorage) const;
+
+  // Returns nullptr if no key range can be compacted. The files of tiered key
+  // ranges left in L0 to wait for more data are added to `held_back_files`.
+  Compaction* PickL0KeyRangeCompaction(
+      const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+      const MutableDBOptions& mutable_db_options, VersionStorageInfo* vstorage,
+      LogBuffer* log_buffer, std::vector<FileMetaData*>* held_back_files);
+};
+}  // namespace ROCKSDB_NAMESPACE
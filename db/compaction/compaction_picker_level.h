@@ -28,6 +28,11 @@ class LevelCompactionPicker : public CompactionPicker {
       VersionStorageInfo* vstorage, LogBuffer* log_buffer) override;
 
   bool NeedsCompaction(const VersionStorageInfo* vstorage) const override;
+
+  // Pick a path ID to place a newly generated file, with its level
+  static uint32_t GetPathId(const ImmutableCFOptions& ioptions,
+                            const MutableCFOptions& mutable_cf_options,
+                            int level);
 };
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -9,6 +9,7 @@
 
 #include "db/compaction/compaction.h"
 #include "db/compaction/compaction_picker_fifo.h"
+#include "db/compaction/compaction_picker_hybrid.h"
 #include "db/compaction/compaction_picker_level.h"
 #include "db/compaction/compaction_picker_universal.h"
 #include "db/compaction/file_pri.h"
@@ -1123,6 +1124,60 @@ TEST_F(CompactionPickerTest, NeedsCompactionFIFO) {
   }
 }
 
+TEST_F(CompactionPickerTest, FIFORetainRecentlyReadFiles) {
+  const uint64_t kFileSize = 100000;
+  fifo_options_.max_table_files_size = kFileSize * 5 / 2;
+  fifo_options_.min_reads_to_retain = 5;
+  mutable_cf_options_.compaction_options_fifo = fifo_options_;
+  mutable_cf_options_.level0_file_num_compaction_trigger = 100;
+  auto copiedIOptions = ioptions_;
+  copiedIOptions.compaction_style = kCompactionStyleFIFO;
+
+  for (bool oldest_read : {false, true}) {
+    // A fresh picker, as the compaction picked in the previous round is still
+    // registered as running
+    FIFOCompactionPicker fifo_compaction_picker(copiedIOptions, &icmp_);
+    NewVersionStorage(1, kCompactionStyleFIFO);
+    // Newest first
+    Add(0, 4U, "100", "200", kFileSize, 0, 400, 499);
+    Add(0, 3U, "100", "200", kFileSize, 0, 300, 399);
+    Add(0, 2U, "100", "200", kFileSize, 0, 200, 299);
+    Add(0, 1U, "100", "200", kFileSize, 0, 100, 199);
+    if (oldest_read) {
+      file_map_[1].first->stats.num_reads_sampled = 10;
+    }
+    file_map_[4].first->stats.num_reads_sampled = 10;
+    UpdateVersionStorageInfo();
+
+    ASSERT_TRUE(fifo_compaction_picker.NeedsCompaction(vstorage_.get()));
+    std::unique_ptr<Compaction> compaction(
+        fifo_compaction_picker.PickCompaction(
+            cf_name_, mutable_cf_options_, mutable_db_options_,
+            /*existing_snapshots=*/{}, /* snapshot_checker */ nullptr,
+            vstorage_.get(), &log_buffer_));
+    ASSERT_TRUE(compaction.get() != nullptr);
+    ASSERT_EQ(compaction->compaction_reason(), CompactionReason::kFIFOMaxSize);
+    if (oldest_read) {
+      // The oldest file is retained by compacting it with the two next
+      // oldest, which are enough to drop
+      ASSERT_FALSE(compaction->deletion_compaction());
+      ASSERT_EQ(0, compaction->output_level());
+      ASSERT_EQ(3U, compaction->num_input_files(0));
+      ASSERT_EQ(3U, compaction->input(0, 0)->fd.GetNumber());
+      ASSERT_EQ(2U, compaction->input(0, 1)->fd.GetNumber());
+      ASSERT_EQ(1U, compaction->input(0, 2)->fd.GetNumber());
+      ASSERT_EQ(2U, compaction->cold_input_files().size());
+      ASSERT_EQ(2U, compaction->cold_input_files()[0]->fd.GetNumber());
+      ASSERT_EQ(3U, compaction->cold_input_files()[1]->fd.GetNumber());
+    } else {
+      // Nothing worth retaining among the oldest files
+      ASSERT_TRUE(compaction->deletion_compaction());
+      ASSERT_EQ(2U, compaction->num_input_files(0));
+      ASSERT_TRUE(compaction->cold_input_files().empty());
+    }
+  }
+}
+
 TEST_F(CompactionPickerTest, FIFOToCold1) {
   // Test fallback behavior from newest_key_time to oldest_ancestor_time
   for (bool newestKeyTimeKnown : {false, true}) {
@@ -4558,6 +4613,132 @@ TEST_F(CompactionPickerTest, IntraL0WhenL0IsSmall) {
   }
 }
 
+TEST_F(CompactionPickerTest, HybridTieredL0KeyRange) {
+  ioptions_.level_compaction_l0_tiering_ratio = 2;
+  mutable_cf_options_.level0_file_num_compaction_trigger = 4;
+  mutable_cf_options_.max_compaction_bytes = 1000000;
+  NewVersionStorage(6, kCompactionStyleLevel);
+  // Hot key range, overlapping 10 times its size in L1
+  Add(0, 1U, "100", "200", 1000, 0, 40, 41);
+  Add(0, 2U, "100", "150", 1000, 0, 30, 31);
+  Add(0, 3U, "150", "200", 1000, 0, 20, 21);
+  // Cold key range, overlapping about its size in L1
+  Add(0, 4U, "500", "900", 1000, 0, 10, 11);
+  Add(1, 5U, "100", "200", 30000);
+  Add(1, 6U, "500", "900", 1000);
+  UpdateVersionStorageInfo();
+
+  HybridCompactionPicker compaction_picker(ioptions_, &icmp_);
+  std::unique_ptr<Compaction> compaction(compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, mutable_db_options_,
+      /*existing_snapshots=*/{}, /* snapshot_checker */ nullptr,
+      vstorage_.get(), &log_buffer_));
+  ASSERT_TRUE(compaction.get() != nullptr);
+  ASSERT_EQ(CompactionReason::kLevelL0FilesNum,
+            compaction->compaction_reason());
+  // The hot key range is merged within L0
+  ASSERT_EQ(1U, compaction->num_input_levels());
+  ASSERT_EQ(0, compaction->output_level());
+  ASSERT_EQ(3U, compaction->num_input_files(0));
+  for (size_t i = 0; i < compaction->num_input_files(0); i++) {
+    ASSERT_NE(4U, compaction->input(0, i)->fd.GetNumber());
+  }
+}
+
+TEST_F(CompactionPickerTest, HybridLeveledL0KeyRange) {
+  ioptions_.level_compaction_l0_tiering_ratio = 2;
+  mutable_cf_options_.level0_file_num_compaction_trigger = 4;
+  mutable_cf_options_.max_compaction_bytes = 1000000;
+  NewVersionStorage(6, kCompactionStyleLevel);
+  // Hot key range, already merged within L0
+  Add(0, 1U, "100", "200", 3000, 0, 40, 41);
+  // Cold key range, overlapping less than its size in L1
+  Add(0, 2U, "500", "900", 1000, 0, 30, 31);
+  Add(0, 3U, "500", "700", 1000, 0, 20, 21);
+  Add(0, 4U, "700", "900", 1000, 0, 10, 11);
+  Add(1, 5U, "100", "200", 30000);
+  Add(1, 6U, "500", "900", 1000);
+  UpdateVersionStorageInfo();
+
+  HybridCompactionPicker compaction_picker(ioptions_, &icmp_);
+  std::unique_ptr<Compaction> compaction(compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, mutable_db_options_,
+      /*existing_snapshots=*/{}, /* snapshot_checker */ nullptr,
+      vstorage_.get(), &log_buffer_));
+  ASSERT_TRUE(compaction.get() != nullptr);
+  // The cold key range is merged into L1, the hot one stays in L0
+  ASSERT_EQ(2U, compaction->num_input_levels());
+  ASSERT_EQ(1, compaction->output_level());
+  ASSERT_EQ(3U, compaction->num_input_files(0));
+  for (size_t i = 0; i < compaction->num_input_files(0); i++) {
+    ASSERT_NE(1U, compaction->input(0, i)->fd.GetNumber());
+  }
+  ASSERT_EQ(1U, compaction->num_input_files(1));
+  ASSERT_EQ(6U, compaction->input(1, 0)->fd.GetNumber());
+}
+
+TEST_F(CompactionPickerTest, HybridHoldsBackMergedTieredL0KeyRanges) {
+  ioptions_.level_compaction_l0_tiering_ratio = 2;
+  mutable_cf_options_.level0_file_num_compaction_trigger = 4;
+  mutable_cf_options_.max_compaction_bytes = 1000000;
+  NewVersionStorage(6, kCompactionStyleLevel);
+  // Hot key ranges, each already merged within L0 and overlapping 10 times
+  // its size in L1
+  Add(0, 1U, "100", "200", 1000, 0, 40, 41);
+  Add(0, 2U, "300", "400", 1000, 0, 30, 31);
+  Add(0, 3U, "500", "600", 1000, 0, 20, 21);
+  Add(0, 4U, "700", "800", 1000, 0, 10, 11);
+  Add(1, 5U, "100", "200", 10000);
+  Add(1, 6U, "300", "400", 10000);
+  Add(1, 7U, "500", "600", 10000);
+  Add(1, 8U, "700", "800", 10000);
+  UpdateVersionStorageInfo();
+  ASSERT_EQ(0, vstorage_->CompactionScoreLevel(0));
+  ASSERT_GE(vstorage_->CompactionScore(0), 1);
+
+  HybridCompactionPicker compaction_picker(ioptions_, &icmp_);
+  std::unique_ptr<Compaction> compaction(compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, mutable_db_options_,
+      /*existing_snapshots=*/{}, /* snapshot_checker */ nullptr,
+      vstorage_.get(), &log_buffer_));
+  // Nothing is merged into L1 until more data arrives in a range
+  ASSERT_TRUE(compaction.get() == nullptr);
+  for (FileMetaData* f : vstorage_->LevelFiles(0)) {
+    ASSERT_FALSE(f->being_compacted);
+  }
+}
+
+TEST_F(CompactionPickerTest, HybridMergesHeldBackL0KeyRangesNearStall) {
+  ioptions_.level_compaction_l0_tiering_ratio = 2;
+  mutable_cf_options_.level0_file_num_compaction_trigger = 4;
+  mutable_cf_options_.level0_slowdown_writes_trigger = 12;
+  mutable_cf_options_.max_compaction_bytes = 1000000;
+  NewVersionStorage(6, kCompactionStyleLevel);
+  // Hot key ranges, each already merged within L0 and overlapping 10 times
+  // its size in L1, with L0 one compaction trigger from slowing down writes
+  for (uint32_t i = 0; i < 8; i++) {
+    const std::string smallest = std::to_string(100 + i * 100);
+    const std::string largest = std::to_string(150 + i * 100);
+    const SequenceNumber seqno = 100 - i * 10;
+    Add(0, i + 1, smallest.c_str(), largest.c_str(), 1000, 0, seqno,
+        seqno + 1);
+    Add(1, i + 11, smallest.c_str(), largest.c_str(), 10000);
+  }
+  UpdateVersionStorageInfo();
+
+  HybridCompactionPicker compaction_picker(ioptions_, &icmp_);
+  std::unique_ptr<Compaction> compaction(compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, mutable_db_options_,
+      /*existing_snapshots=*/{}, /* snapshot_checker */ nullptr,
+      vstorage_.get(), &log_buffer_));
+  // Leveled picking merges L0 into L1
+  ASSERT_TRUE(compaction.get() != nullptr);
+  ASSERT_EQ(CompactionReason::kLevelL0FilesNum,
+            compaction->compaction_reason());
+  ASSERT_EQ(2U, compaction->num_input_levels());
+  ASSERT_EQ(1, compaction->output_level());
+}
+
 TEST_F(CompactionPickerTest, UniversalMaxReadAmpLargeDB) {
   ioptions_.compaction_style = kCompactionStyleUniversal;
   ioptions_.num_levels = 50;
@@ -8,6 +8,7 @@
 
 #include <algorithm>
 
+#include "rocksdb/slice_transform.h"
 #include "rocksdb/utilities/customizable_util.h"
 #include "rocksdb/utilities/object_registry.h"
 #include "rocksdb/utilities/options_type.h"
@@ -20,6 +21,14 @@ static std::unordered_map<std::string, OptionTypeInfo>
           OptionTypeFlags::kNone}},
 };
 
+static std::unordered_map<std::string, OptionTypeInfo>
+    sst_prefix_type_info = {
+        {"prefix_extractor",
+         OptionTypeInfo::AsCustomSharedPtr<const SliceTransform>(
+             0, OptionVerificationType::kByNameAllowNull,
+             OptionTypeFlags::kAllowNull)},
+};
+
 SstPartitionerFixedPrefixFactory::SstPartitionerFixedPrefixFactory(size_t len)
     : len_(len) {
   RegisterOptions("Length", &len_, &sst_fixed_prefix_type_info);
@@ -56,6 +65,48 @@ std::shared_ptr<SstPartitionerFactory> NewSstPartitionerFixedPrefixFactory(
   return std::make_shared<SstPartitionerFixedPrefixFactory>(prefix_len);
 }
 
+Slice SstPartitionerPrefix::GetPrefix(const Slice& user_key) const {
+  if (!prefix_extractor_->InDomain(user_key)) {
+    return Slice();
+  }
+  return prefix_extractor_->Transform(user_key);
+}
+
+PartitionerResult SstPartitionerPrefix::ShouldPartition(
+    const PartitionerRequest& request) {
+  return GetPrefix(*request.prev_user_key)
+                     .compare(GetPrefix(*request.current_user_key)) != 0
+             ? kRequired
+             : kNotRequired;
+}
+
+bool SstPartitionerPrefix::CanDoTrivialMove(const Slice& smallest_user_key,
+                                            const Slice& largest_user_key) {
+  return ShouldPartition(PartitionerRequest(smallest_user_key, largest_user_key,
+                                            0)) == kNotRequired;
+}
+
+SstPartitionerPrefixFactory::SstPartitionerPrefixFactory(
+    std::shared_ptr<const SliceTransform> prefix_extractor)
+    : prefix_extractor_(std::move(prefix_extractor)) {
+  RegisterOptions("PrefixExtractor", &prefix_extractor_, &sst_prefix_type_info);
+}
+
+std::unique_ptr<SstPartitioner> SstPartitionerPrefixFactory::CreatePartitioner(
+    const SstPartitioner::Context& /* context */) const {
+  if (prefix_extractor_ == nullptr) {
+    return nullptr;
+  }
+  return std::unique_ptr<SstPartitioner>(
+      new SstPartitionerPrefix(prefix_extractor_.get()));
+}
+
+std::shared_ptr<SstPartitionerFactory> NewSstPartitionerPrefixFactory(
+    std::shared_ptr<const SliceTransform> prefix_extractor) {
+  return std::make_shared<SstPartitionerPrefixFactory>(
+      std::move(prefix_extractor));
+}
+
 namespace {
 static int RegisterSstPartitionerFactories(ObjectLibrary& library,
                                            const std::string& /*arg*/) {
@@ -67,6 +118,14 @@ static int RegisterSstPartitionerFactories(ObjectLibrary& library,
         guard->reset(new SstPartitionerFixedPrefixFactory(0));
         return guard->get();
       });
+  library.AddFactory<SstPartitionerFactory>(
+      SstPartitionerPrefixFactory::kClassName(),
+      [](const std::string& /*uri*/,
+         std::unique_ptr<SstPartitionerFactory>* guard,
+         std::string* /* errmsg */) {
+        guard->reset(new SstPartitionerPrefixFactory(nullptr));
+        return guard->get();
+      });
   return 1;
 }
 }  // namespace
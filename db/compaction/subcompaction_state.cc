@@ -115,4 +115,113 @@ Status SubcompactionState::AddToOutput(
   return current_outputs_->AddToOutput(iter, open_file_func, close_file_func);
 }
 
+Status SubcompactionState::AddToTransformBatch(
+    const CompactionIterator& iter, bool use_proximal_output,
+    const CompactionFileOpenFunc& open_file_func,
+    const CompactionFileCloseFunc& close_file_func) {
+  const CompactionValueTransformer* transformer =
+      compaction->immutable_options().compaction_value_transformer.get();
+  assert(transformer != nullptr);
+  Status s;
+  // All keys of a batch go to the same output level
+  if (transform_batch_size_ > 0 &&
+      use_proximal_output != transform_batch_proximal_) {
+    s = FlushTransformBatch(open_file_func, close_file_func);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  if (transform_batch_size_ == transform_batch_.size()) {
+    transform_batch_.emplace_back();
+  }
+  BufferedEntry& entry = transform_batch_[transform_batch_size_++];
+  entry.key.assign(iter.key().data(), iter.key().size());
+  entry.user_key.assign(iter.user_key().data(), iter.user_key().size());
+  entry.value.assign(iter.value().data(), iter.value().size());
+  entry.is_range_del = iter.IsDeleteRangeSentinelKey();
+  transform_batch_proximal_ = use_proximal_output;
+  transform_batch_input_status_ = iter.InputStatus();
+
+  if (transform_batch_size_ >= transformer->GetMaxBatchSize()) {
+    s = FlushTransformBatch(open_file_func, close_file_func);
+  }
+  return s;
+}
+
+Status SubcompactionState::FlushTransformBatch(
+    const CompactionFileOpenFunc& open_file_func,
+    const CompactionFileCloseFunc& close_file_func) {
+  if (transform_batch_size_ == 0) {
+    return Status::OK();
+  }
+  const size_t batch_size = transform_batch_size_;
+  transform_batch_size_ = 0;
+
+  // Only plain values are passed to the transformer
+  size_t num_entries = 0;
+  transform_entry_batch_index_.clear();
+  for (size_t i = 0; i < batch_size; i++) {
+    const BufferedEntry& entry = transform_batch_[i];
+    if (entry.is_range_del ||
+        ExtractValueType(entry.key) != ValueType::kTypeValue) {
+      continue;
+    }
+    if (num_entries == transform_entries_.size()) {
+      transform_entries_.emplace_back();
+    }
+    CompactionValueTransformer::Entry& transform_entry =
+        transform_entries_[num_entries++];
+    transform_entry.key = ExtractUserKey(entry.key);
+    transform_entry.value = entry.value;
+    transform_entry.value_changed = false;
+    transform_entry_batch_index_.push_back(i);
+  }
+  transform_entries_.resize(num_entries);
+
+  Status s;
+  if (num_entries > 0) {
+    CompactionValueTransformer::Context context;
+    context.column_family_id = compaction->column_family_data()->GetID();
+    context.output_level = transform_batch_proximal_
+                               ? compaction->GetProximalLevel()
+                               : compaction->output_level();
+    context.output_temperature =
+        compaction->GetOutputTemperature(transform_batch_proximal_);
+    context.is_bottommost_level =
+        compaction->bottommost_level() && !transform_batch_proximal_;
+    context.is_manual_compaction = compaction->is_manual_compaction();
+    s = compaction->immutable_options().compaction_value_transformer->Transform(
+        context, &transform_entries_);
+    if (s.ok() && transform_entries_.size() != num_entries) {
+      s = Status::InvalidArgument(
+          "CompactionValueTransformer changed the number of entries");
+    }
+    if (!s.ok()) {
+      return s;
+    }
+    for (size_t i = 0; i < num_entries; i++) {
+      if (transform_entries_[i].value_changed) {
+        transform_batch_[transform_entry_batch_index_[i]].value.swap(
+            transform_entries_[i].new_value);
+      }
+    }
+  }
+
+  current_outputs_ = transform_batch_proximal_ ? &proximal_level_outputs_
+                                               : &compaction_outputs_;
+  for (size_t i = 0; i < batch_size && s.ok(); i++) {
+    const BufferedEntry& entry = transform_batch_[i];
+    SequenceNumber seq;
+    ValueType type;
+    UnPackSequenceAndType(ExtractInternalKeyFooter(entry.key), &seq, &type);
+    const ParsedInternalKey ikey(ExtractUserKey(entry.key), seq, type);
+    s = current_outputs_->AddToOutput(entry.key, ikey, entry.user_key,
+                                      entry.value, entry.is_range_del,
+                                      transform_batch_input_status_,
+                                      open_file_func, close_file_func);
+  }
+  return s;
+}
+
 }  // namespace ROCKSDB_NAMESPACE
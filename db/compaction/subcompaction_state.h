@@ -11,6 +11,8 @@
 #pragma once
 
 #include <optional>
+#include <string>
+#include <vector>
 
 #include "db/blob/blob_file_addition.h"
 #include "db/blob/blob_garbage_meter.h"
@@ -20,6 +22,7 @@
 #include "db/internal_stats.h"
 #include "db/output_validator.h"
 #include "db/range_del_aggregator.h"
+#include "rocksdb/compaction_value_transformer.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -146,6 +149,8 @@ class SubcompactionState {
     current_outputs_ = state.current_outputs_ == &state.proximal_level_outputs_
                            ? &proximal_level_outputs_
                            : &compaction_outputs_;
+    // Only moved before the compaction runs
+    assert(state.transform_batch_size_ == 0);
   }
 
   // Add all the new files from this compaction to version_edit
@@ -201,6 +206,21 @@ class SubcompactionState {
                      const CompactionFileOpenFunc& open_file_func,
                      const CompactionFileCloseFunc& close_file_func);
 
+  // Used instead of AddToOutput() when `compaction_value_transformer` is set.
+  // Copies the compaction_iterator key/value into a batch, and once the batch
+  // is full, or the next key goes to the other output group, flushes it with
+  // FlushTransformBatch().
+  Status AddToTransformBatch(const CompactionIterator& iter,
+                             bool use_proximal_output,
+                             const CompactionFileOpenFunc& open_file_func,
+                             const CompactionFileCloseFunc& close_file_func);
+
+  // Pass the plain values in the batch to `compaction_value_transformer` and
+  // add all the keys in the batch to their output group. Needs to be called
+  // before CloseCompactionFiles().
+  Status FlushTransformBatch(const CompactionFileOpenFunc& open_file_func,
+                             const CompactionFileCloseFunc& close_file_func);
+
   // Close all compaction output files, both output_to_proximal_level outputs
   // and normal outputs.
   Status CloseCompactionFiles(const Status& curr_status,
@@ -229,6 +249,23 @@ class SubcompactionState {
   CompactionOutputs proximal_level_outputs_;
   CompactionOutputs* current_outputs_ = &compaction_outputs_;
   std::unique_ptr<CompactionRangeDelAggregator> range_del_agg_;
+
+  // A compaction_iterator key/value waiting in the transform batch
+  struct BufferedEntry {
+    std::string key;
+    std::string user_key;
+    std::string value;
+    bool is_range_del = false;
+  };
+  // The first `transform_batch_size_` entries are in the batch. The rest keep
+  // their buffers for reuse.
+  std::vector<BufferedEntry> transform_batch_;
+  size_t transform_batch_size_ = 0;
+  bool transform_batch_proximal_ = false;
+  Status transform_batch_input_status_;
+  std::vector<CompactionValueTransformer::Entry> transform_entries_;
+  // Index into `transform_batch_` of each of `transform_entries_`
+  std::vector<size_t> transform_entry_batch_index_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
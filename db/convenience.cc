@@ -8,6 +8,7 @@
 
 #include "db/convenience_impl.h"
 #include "db/db_impl/db_impl.h"
+#include "test_util/sync_point.h"
 #include "util/cast_util.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -41,6 +42,52 @@ Status DeleteFilesInRanges(DB* db, ColumnFamilyHandle* column_family,
       ->DeleteFilesInRanges(column_family, ranges, n, include_end);
 }
 
+Status DeleteRangeByDroppingFiles(DB* db, ColumnFamilyHandle* column_family,
+                                  const WriteOptions& write_options,
+                                  const Slice& begin, const Slice& end) {
+  const Comparator* ucmp = column_family->GetComparator();
+  if (ucmp->timestamp_size() > 0) {
+    return Status::NotSupported(
+        "DeleteRangeByDroppingFiles() does not support user-defined "
+        "timestamps");
+  }
+  if (ucmp->Compare(begin, end) > 0) {
+    return Status::InvalidArgument("end key comes before start key");
+  }
+  auto db_impl = static_cast_with_check<DBImpl>(db->GetRootDB());
+  RangeOpt range(begin, end);
+  // Files are only dropped without a range tombstone if all files with keys
+  // in the range are dropped. Otherwise a dropped file could hold a newer
+  // version or a point tombstone of a key in a kept file, which would be
+  // exposed again, so the range tombstone has to be written first.
+  Status s = db_impl->DeleteFilesInRanges(column_family, &range, 1,
+                                          /*include_end=*/false,
+                                          /*all_or_nothing=*/true);
+  if (s.IsIncomplete()) {
+    s = db->DeleteRange(write_options, column_family, begin, end);
+    if (s.ok()) {
+      s = db_impl->DeleteFilesInRanges(column_family, &range, 1,
+                                       /*include_end=*/false);
+      TEST_SYNC_POINT("DeleteRangeByDroppingFiles:FilesDropped");
+    }
+    return s;
+  }
+  if (!s.ok()) {
+    return s;
+  }
+  TEST_SYNC_POINT("DeleteRangeByDroppingFiles:FilesDropped");
+
+  ReadOptions read_options;
+  read_options.iterate_upper_bound = &end;
+  read_options.fill_cache = false;
+  std::unique_ptr<Iterator> iter(db->NewIterator(read_options, column_family));
+  iter->Seek(begin);
+  if (iter->Valid()) {
+    return db->DeleteRange(write_options, column_family, begin, end);
+  }
+  return iter->status();
+}
+
 Status VerifySstFileChecksum(const Options& options,
                              const EnvOptions& env_options,
                              const std::string& file_path) {
@@ -2007,6 +2007,71 @@ INSTANTIATE_TEST_CASE_P(DBBlockCacheKeyTest, DBBlockCacheKeyTest,
                         ::testing::Combine(::testing::Bool(),
                                            ::testing::Bool()));
 
+TEST_F(DBBlockCacheTest, AdaptiveMetadataPinning) {
+  Options options = CurrentOptions();
+  options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+  options.disable_auto_compactions = true;
+  BlockBasedTableOptions table_options;
+  table_options.block_cache = NewLRUCache(1 << 20 /* capacity */);
+  table_options.cache_index_and_filter_blocks = true;
+  table_options.metadata_cache_options.top_level_index_pinning =
+      PinningTier::kNone;
+  table_options.metadata_cache_options.partition_pinning = PinningTier::kNone;
+  table_options.metadata_cache_options.unpartitioned_pinning =
+      PinningTier::kNone;
+  table_options.adaptive_metadata_pinning_budget = 64 << 10;
+  table_options.filter_policy.reset(NewBloomFilterPolicy(10));
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  // L0 files with disjoint key ranges, enough of them for point lookups to
+  // only read the file whose range covers the key
+  const int kNumKeysPerFile = 100;
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < kNumKeysPerFile; ++j) {
+      ASSERT_OK(Put(Key(i * kNumKeysPerFile + j), "value"));
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_EQ(4, NumTableFilesAtLevel(0));
+
+  // Returns whether reading from the file with keys starting at `first` misses
+  // the filter and index in the cache, once unpinned blocks are dropped
+  auto metadata_misses = [&](int first) {
+    table_options.block_cache->EraseUnRefEntries();
+    uint64_t filter_misses =
+        TestGetTickerCount(options, BLOCK_CACHE_FILTER_MISS);
+    uint64_t index_misses = TestGetTickerCount(options, BLOCK_CACHE_INDEX_MISS);
+    EXPECT_EQ("value", Get(Key(first)));
+    bool filter_missed =
+        TestGetTickerCount(options, BLOCK_CACHE_FILTER_MISS) > filter_misses;
+    bool index_missed =
+        TestGetTickerCount(options, BLOCK_CACHE_INDEX_MISS) > index_misses;
+    EXPECT_EQ(filter_missed, index_missed);
+    return filter_missed;
+  };
+
+  // Nothing is pinned before tables are read enough
+  ASSERT_TRUE(metadata_misses(0));
+  ASSERT_TRUE(metadata_misses(kNumKeysPerFile));
+
+  // Read the first file heavily
+  for (int i = 0; i < 4000; ++i) {
+    ASSERT_EQ("value", Get(Key(i % kNumKeysPerFile)));
+  }
+  ASSERT_GT(table_options.block_cache->GetPinnedUsage(), 0);
+  ASSERT_FALSE(metadata_misses(0));
+  ASSERT_TRUE(metadata_misses(kNumKeysPerFile));
+  ASSERT_TRUE(metadata_misses(2 * kNumKeysPerFile));
+
+  // Move the working set to the second file, until the first goes cold
+  for (int i = 0; i < 20000; ++i) {
+    ASSERT_EQ("value", Get(Key(kNumKeysPerFile + i % kNumKeysPerFile)));
+  }
+  ASSERT_TRUE(metadata_misses(0));
+  ASSERT_FALSE(metadata_misses(kNumKeysPerFile));
+}
+
 class DBBlockCachePinningTest
     : public DBTestBase,
       public testing::WithParamInterface<
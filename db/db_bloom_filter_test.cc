@@ -9,6 +9,7 @@
 
 #include <cstring>
 #include <iomanip>
+#include <set>
 #include <sstream>
 #include <string>
 
@@ -3649,6 +3650,83 @@ class FixedSuffix4Transform : public SliceTransform {
 // one of the old obsolete, unnecessary axioms of prefix extraction:
 // * key.starts_with(prefix(key))
 // This axiom is not really needed, and we validate that here.
+TEST_F(DBBloomFilterTest, RangeFilterSeek) {
+  for (bool partition_filters : {false, true}) {
+    SCOPED_TRACE("partition_filters=" + std::to_string(partition_filters));
+    Options options = CurrentOptions();
+    options.disable_auto_compactions = true;
+    options.statistics = CreateDBStatistics();
+    BlockBasedTableOptions bbto;
+    bbto.filter_policy.reset(NewRangeFilterPolicy(10));
+    if (partition_filters) {
+      bbto.partition_filters = true;
+      bbto.index_type = BlockBasedTableOptions::IndexType::kTwoLevelIndexSearch;
+      bbto.block_size = 128;
+      bbto.metadata_block_size = 128;
+    }
+    options.table_factory.reset(NewBlockBasedTableFactory(bbto));
+    DestroyAndReopen(options);
+
+    // Keys for (session, layer, block), with every third layer present in
+    // each session
+    auto make_key = [](int session, int layer, int block) {
+      char buf[32];
+      snprintf(buf, sizeof(buf), "%04d/%04d/%04d", session, layer, block);
+      return std::string(buf);
+    };
+    std::set<std::string> keys;
+    for (int session = 0; session < 20; ++session) {
+      for (int layer = session % 3; layer < 30; layer += 3) {
+        for (int block = 0; block < 4; ++block) {
+          keys.insert(make_key(session, layer, block));
+          ASSERT_OK(Put(make_key(session, layer, block), "val"));
+        }
+      }
+    }
+    ASSERT_OK(Flush());
+
+    // Scan each session for ranges of two layers, about a third of them
+    // empty
+    uint64_t num_empty = 0;
+    for (int session = 0; session < 20; ++session) {
+      for (int layer = 0; layer < 30; ++layer) {
+        std::string lower = make_key(session, layer, 0);
+        std::string upper = make_key(session, layer + 2, 0);
+        Slice upper_bound(upper);
+        ReadOptions read_options;
+        read_options.iterate_upper_bound = &upper_bound;
+        std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+        iter->Seek(lower);
+        ASSERT_OK(iter->status());
+        auto expected = keys.lower_bound(lower);
+        if (expected != keys.end() && *expected < upper) {
+          ASSERT_TRUE(iter->Valid());
+          ASSERT_EQ(*expected, iter->key());
+        } else {
+          ASSERT_FALSE(iter->Valid());
+          ++num_empty;
+        }
+      }
+    }
+    ASSERT_GT(num_empty, 0);
+    // Range filters may have false positives but rule out most empty ranges
+    uint64_t num_filtered =
+        TestGetTickerCount(options, NON_LAST_LEVEL_SEEK_FILTERED);
+    ASSERT_LE(num_filtered, num_empty);
+    ASSERT_GT(num_filtered, num_empty / 2);
+    ASSERT_EQ(TestGetTickerCount(options, NON_LAST_LEVEL_SEEK_FILTER_MATCH),
+              20 * 30 - num_filtered);
+
+    // Not checked without an upper bound
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+    iter->Seek(make_key(0, 1, 0));
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(make_key(0, 3, 0), iter->key());
+    ASSERT_EQ(TestGetTickerCount(options, NON_LAST_LEVEL_SEEK_FILTERED),
+              num_filtered);
+  }
+}
+
 TEST_F(DBBloomFilterTest, WeirdPrefixExtractorWithFilter1) {
   BlockBasedTableOptions bbto;
   bbto.filter_policy.reset(ROCKSDB_NAMESPACE::NewBloomFilterPolicy(10));
@@ -9,6 +9,7 @@
 
 #include "db/db_test_util.h"
 #include "port/stack_trace.h"
+#include "rocksdb/compaction_value_transformer.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -1045,6 +1046,82 @@ TEST_F(DBTestCompactionFilter, DropKeyWithSingleDelete) {
   }
 }
 
+// Keeps the first half of the values written to the bottommost level
+class TruncateBottommostTransformer : public CompactionValueTransformer {
+ public:
+  const char* Name() const override { return "TruncateBottommostTransformer"; }
+
+  Status Transform(const Context& context,
+                   std::vector<Entry>* entries) const override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    EXPECT_LE(entries->size(), GetMaxBatchSize());
+    output_levels_.push_back(context.output_level);
+    num_entries_ += entries->size();
+    if (context.is_bottommost_level) {
+      for (Entry& entry : *entries) {
+        entry.new_value.assign(entry.value.data(), entry.value.size() / 2);
+        entry.value_changed = true;
+      }
+    }
+    return Status::OK();
+  }
+
+  size_t GetMaxBatchSize() const override { return 16; }
+
+  mutable std::mutex mutex_;
+  mutable std::vector<int> output_levels_;
+  mutable size_t num_entries_ = 0;
+};
+
+TEST_F(DBTestCompactionFilter, CompactionValueTransformer) {
+  auto transformer = std::make_shared<TruncateBottommostTransformer>();
+  Options options = CurrentOptions();
+  options.num_levels = 3;
+  options.level_compaction_dynamic_level_bytes = false;
+  options.disable_auto_compactions = true;
+  options.compaction_value_transformer = transformer;
+  DestroyAndReopen(options);
+
+  ASSERT_OK(Put("key000", "old_value"));
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(2);
+
+  for (int i = 0; i < 100; i++) {
+    char key[10];
+    snprintf(key, sizeof(key), "key%03d", i);
+    ASSERT_OK(Put(key, "value" + std::to_string(1000 + i)));
+  }
+  ASSERT_OK(Delete("key050"));
+  ASSERT_OK(Flush());
+  // Flushes are not transformed
+  ASSERT_EQ(transformer->num_entries_, 0);
+
+  // L0 -> L1 overlaps key000 in L2
+  ASSERT_OK(dbfull()->TEST_CompactRange(0, nullptr, nullptr, nullptr,
+                                        /*disallow_trivial_move=*/true));
+  ASSERT_EQ("0,1,1", FilesPerLevel());
+  ASSERT_EQ(transformer->num_entries_, 99);
+  ASSERT_GE(transformer->output_levels_.size(), 7);
+  for (int level : transformer->output_levels_) {
+    ASSERT_EQ(level, 1);
+  }
+  ASSERT_EQ("value1000", Get("key000"));
+  ASSERT_EQ("value1099", Get("key099"));
+
+  // Into the bottommost level
+  transformer->output_levels_.clear();
+  transformer->num_entries_ = 0;
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ("0,0,1", FilesPerLevel());
+  ASSERT_EQ(transformer->num_entries_, 99);
+  for (int level : transformer->output_levels_) {
+    ASSERT_EQ(level, 2);
+  }
+  ASSERT_EQ("valu", Get("key000"));
+  ASSERT_EQ("valu", Get("key099"));
+  ASSERT_EQ("NOT_FOUND", Get("key050"));
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -729,6 +729,187 @@ TEST_F(DBCompactionTest, CompactRangeBottomPri) {
   SyncPoint::GetInstance()->DisableProcessing();
 }
 
+TEST_F(DBCompactionTest, PreemptBottommostCompaction) {
+  Options options = CurrentOptions();
+  options.num_levels = 3;
+  options.compression = kNoCompression;
+  options.level_compaction_dynamic_level_bytes = false;
+  options.max_bytes_for_level_base = 100 << 10;
+  options.level0_file_num_compaction_trigger = 2;
+  options.level0_slowdown_writes_trigger = 2;
+  // A single compaction slot
+  options.max_background_jobs = 2;
+  options.preempt_bottommost_compactions = true;
+  options.disable_auto_compactions = true;
+  options.statistics = CreateDBStatistics();
+  DestroyAndReopen(options);
+
+  Random rnd(301);
+  std::vector<std::string> values(150);
+  auto write_file = [&]() {
+    for (int k = 0; k < 150; k++) {
+      values[k] = rnd.RandomString(1000);
+      ASSERT_OK(Put(Key(k), values[k]));
+    }
+    FlushOptions flush_options;
+    flush_options.allow_write_stall = true;
+    ASSERT_OK(db_->Flush(flush_options));
+  };
+  write_file();
+  MoveFilesToLevel(2);
+  write_file();
+  MoveFilesToLevel(1);
+  ASSERT_EQ("0,1,1", FilesPerLevel());
+
+  // The L1->L2 compaction holds the slot until it is preempted
+  SyncPoint::GetInstance()->LoadDependency(
+      {{"DBImpl::BackgroundCompaction:NonTrivial:BeforeRun",
+        "DBCompactionTest::PreemptBottommostCompaction:Running"},
+       {"DBImpl::MaybePreemptBottommostCompaction:Preempt",
+        "CompactionJob::Run():Start"}});
+  SyncPoint::GetInstance()->EnableProcessing();
+  ASSERT_OK(dbfull()->SetOptions({{"disable_auto_compactions", "false"}}));
+  TEST_SYNC_POINT("DBCompactionTest::PreemptBottommostCompaction:Running");
+
+  // The second L0 file slows down writes, and the L0 compaction has a higher
+  // score than the L1->L2 compaction
+  write_file();
+  write_file();
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  ASSERT_EQ(1, options.statistics->getTickerCount(COMPACTION_PREEMPTED));
+  ASSERT_EQ("0,0,1", FilesPerLevel());
+  for (int k = 0; k < 150; k++) {
+    ASSERT_EQ(values[k], Get(Key(k)));
+  }
+}
+
+TEST_F(DBCompactionTest, PreemptBottommostCompactionRepeatedly) {
+  Options options = CurrentOptions();
+  options.num_levels = 3;
+  options.compression = kNoCompression;
+  options.level_compaction_dynamic_level_bytes = false;
+  options.max_bytes_for_level_base = 100 << 10;
+  options.level0_file_num_compaction_trigger = 2;
+  options.level0_slowdown_writes_trigger = 2;
+  // A single compaction slot
+  options.max_background_jobs = 2;
+  options.preempt_bottommost_compactions = true;
+  options.disable_auto_compactions = true;
+  options.statistics = CreateDBStatistics();
+  DestroyAndReopen(options);
+
+  Random rnd(301);
+  std::vector<std::string> values(150);
+  auto write_file = [&]() {
+    for (int k = 0; k < 150; k++) {
+      values[k] = rnd.RandomString(1000);
+      ASSERT_OK(Put(Key(k), values[k]));
+    }
+    FlushOptions flush_options;
+    flush_options.allow_write_stall = true;
+    ASSERT_OK(db_->Flush(flush_options));
+  };
+  write_file();
+  MoveFilesToLevel(2);
+  write_file();
+  MoveFilesToLevel(1);
+  ASSERT_EQ("0,1,1", FilesPerLevel());
+
+  // Each of the first bottommost compactions is about to run when enough L0
+  // files are written to slow down writes, which would preempt every one of
+  // them
+  constexpr int kUrgentRounds = 3;
+  int output_level = 0;
+  int bottommost_runs = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::BackgroundCompaction:NonTrivial",
+      [&](void* arg) { output_level = *static_cast<int*>(arg); });
+  SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::BackgroundCompaction:NonTrivial:BeforeRun", [&](void*) {
+        if (output_level == 2 && bottommost_runs++ < kUrgentRounds) {
+          write_file();
+          write_file();
+        }
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+  ASSERT_OK(dbfull()->SetOptions({{"disable_auto_compactions", "false"}}));
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  // Only two in a row were preempted, then one completed
+  ASSERT_GT(bottommost_runs, kUrgentRounds);
+  ASSERT_EQ(2, options.statistics->getTickerCount(COMPACTION_PREEMPTED));
+  ASSERT_EQ("0,0,1", FilesPerLevel());
+  for (int k = 0; k < 150; k++) {
+    ASSERT_EQ(values[k], Get(Key(k)));
+  }
+}
+
+TEST_F(DBCompactionTest, PreemptBottommostCompactionSkipsBottomPool) {
+  Options options = CurrentOptions();
+  options.num_levels = 3;
+  options.compression = kNoCompression;
+  options.level_compaction_dynamic_level_bytes = false;
+  options.max_bytes_for_level_base = 100 << 10;
+  options.level0_file_num_compaction_trigger = 2;
+  options.level0_slowdown_writes_trigger = 2;
+  options.max_background_jobs = 2;
+  options.preempt_bottommost_compactions = true;
+  options.disable_auto_compactions = true;
+  options.statistics = CreateDBStatistics();
+  DestroyAndReopen(options);
+  env_->SetBackgroundThreads(1, Env::Priority::BOTTOM);
+
+  Random rnd(301);
+  std::vector<std::string> values(150);
+  auto write_file = [&]() {
+    for (int k = 0; k < 150; k++) {
+      values[k] = rnd.RandomString(1000);
+      ASSERT_OK(Put(Key(k), values[k]));
+    }
+    FlushOptions flush_options;
+    flush_options.allow_write_stall = true;
+    ASSERT_OK(db_->Flush(flush_options));
+  };
+  write_file();
+  MoveFilesToLevel(2);
+  write_file();
+  MoveFilesToLevel(1);
+  ASSERT_EQ("0,1,1", FilesPerLevel());
+
+  // The L1->L2 compaction is forwarded to the BOTTOM pool, where it waits
+  // until writes are slowed down by L0
+  SyncPoint::GetInstance()->LoadDependency(
+      {{"DBImpl::BackgroundCompaction:NonTrivial:BeforeRun",
+        "DBCompactionTest::PreemptBottommostCompactionSkipsBottomPool:"
+        "Running"},
+       {"DBCompactionTest::PreemptBottommostCompactionSkipsBottomPool:"
+        "Stalled",
+        "CompactionJob::Run():Start"}});
+  SyncPoint::GetInstance()->EnableProcessing();
+  ASSERT_OK(dbfull()->SetOptions({{"disable_auto_compactions", "false"}}));
+  TEST_SYNC_POINT(
+      "DBCompactionTest::PreemptBottommostCompactionSkipsBottomPool:Running");
+  write_file();
+  write_file();
+  ASSERT_TRUE(dbfull()->TEST_write_controler().NeedsDelay());
+  TEST_SYNC_POINT(
+      "DBCompactionTest::PreemptBottommostCompactionSkipsBottomPool:Stalled");
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+  env_->SetBackgroundThreads(0, Env::Priority::BOTTOM);
+
+  ASSERT_EQ(0, options.statistics->getTickerCount(COMPACTION_PREEMPTED));
+  for (int k = 0; k < 150; k++) {
+    ASSERT_EQ(values[k], Get(Key(k)));
+  }
+}
+
 TEST_F(DBCompactionTest, DisableStatsUpdateReopen) {
   uint64_t db_size[3];
   for (int test = 0; test < 2; ++test) {
@@ -1101,6 +1282,111 @@ TEST_F(DBCompactionTest, CompactionSstPartitioner) {
   ASSERT_EQ("B", Get("bbbb1"));
 }
 
+TEST_F(DBCompactionTest, CompactionSstPartitionByPrefix) {
+  Options options = CurrentOptions();
+  options.enable_blob_files = true;
+  options.min_blob_size = 10;
+  // Have the compaction rewrite all blobs written by the flush
+  options.enable_blob_garbage_collection = true;
+  options.blob_garbage_collection_age_cutoff = 1.0;
+  options.sst_partitioner_factory = NewSstPartitionerPrefixFactory(
+      std::shared_ptr<const SliceTransform>(NewFixedPrefixTransform(4)));
+  DestroyAndReopen(options);
+
+  // Three sessions, with a blob value and an inlined value per key
+  for (int session = 1; session <= 3; session++) {
+    for (int k = 0; k < 10; k++) {
+      const std::string key = "s00" + std::to_string(session) + Key(k);
+      ASSERT_OK(Put(key + "b", std::string(100, 'v')));
+      ASSERT_OK(Put(key + "i", "v"));
+    }
+  }
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+
+  // Each session has its own table file and blob file
+  std::vector<LiveFileMetaData> files;
+  db_->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(3, files.size());
+  for (const auto& file : files) {
+    ASSERT_EQ(file.smallestkey.substr(0, 4), file.largestkey.substr(0, 4));
+  }
+  ColumnFamilyMetaData cf_meta;
+  db_->GetColumnFamilyMetaData(&cf_meta);
+  ASSERT_EQ(3, cf_meta.blob_files.size());
+  for (const auto& blob_file : cf_meta.blob_files) {
+    ASSERT_EQ(10, blob_file.total_blob_count);
+  }
+
+  // The files of the session are dropped without writing a range tombstone
+  ASSERT_OK(DeleteRangeByDroppingFiles(db_, db_->DefaultColumnFamily(),
+                                       WriteOptions(), "s002", "s003"));
+  files.clear();
+  db_->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(2, files.size());
+  ASSERT_OK(Flush());
+  ASSERT_EQ(0, NumTableFilesAtLevel(0));
+  ASSERT_EQ("NOT_FOUND", Get("s002" + Key(0) + "b"));
+  ASSERT_EQ(std::string(100, 'v'), Get("s001" + Key(0) + "b"));
+  ASSERT_EQ("v", Get("s003" + Key(9) + "i"));
+
+  // A key left in the memtable is covered by a range tombstone
+  ASSERT_OK(Put("s001" + Key(10) + "i", "v"));
+  ASSERT_OK(DeleteRangeByDroppingFiles(db_, db_->DefaultColumnFamily(),
+                                       WriteOptions(), "s001", "s002"));
+  files.clear();
+  db_->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(1, files.size());
+  ASSERT_EQ("NOT_FOUND", Get("s001" + Key(10) + "i"));
+  ASSERT_EQ("NOT_FOUND", Get("s001" + Key(0) + "i"));
+  ASSERT_OK(Flush());
+  ASSERT_EQ(1, NumTableFilesAtLevel(0));
+  ASSERT_EQ("v", Get("s003" + Key(9) + "i"));
+}
+
+TEST_F(DBCompactionTest, DeleteRangeByDroppingFilesOverLowerLevels) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  DestroyAndReopen(options);
+
+  // Older data in a file extending past the range
+  ASSERT_OK(Put("a", "va"));
+  ASSERT_OK(Put("b5", "old"));
+  ASSERT_OK(Put("b6", "old"));
+  ASSERT_OK(Put("c", "vc"));
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(6);
+  // A deletion and an overwrite in a file entirely in the range
+  ASSERT_OK(Delete("b5"));
+  ASSERT_OK(Put("b6", "new"));
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(5);
+  ASSERT_EQ("NOT_FOUND", Get("b5"));
+  ASSERT_EQ("new", Get("b6"));
+
+  // The old values must not be exposed once the upper file is dropped
+  std::vector<std::string> seen;
+  SyncPoint::GetInstance()->SetCallBack(
+      "DeleteRangeByDroppingFiles:FilesDropped", [&](void* /*arg*/) {
+        seen.push_back(Get("b5"));
+        seen.push_back(Get("b6"));
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+  ASSERT_OK(DeleteRangeByDroppingFiles(db_, db_->DefaultColumnFamily(),
+                                       WriteOptions(), "b", "c"));
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+  ASSERT_EQ(seen, std::vector<std::string>({"NOT_FOUND", "NOT_FOUND"}));
+
+  ASSERT_EQ(0, NumTableFilesAtLevel(5));
+  ASSERT_EQ(1, NumTableFilesAtLevel(6));
+  Reopen(options);
+  ASSERT_EQ("NOT_FOUND", Get("b5"));
+  ASSERT_EQ("NOT_FOUND", Get("b6"));
+  ASSERT_EQ("va", Get("a"));
+  ASSERT_EQ("vc", Get("c"));
+}
+
 TEST_F(DBCompactionTest, CompactionSstPartitionWithManualCompaction) {
   Options options = CurrentOptions();
   options.compaction_style = kCompactionStyleLevel;
@@ -10560,6 +10846,69 @@ TEST_F(DBCompactionTest, NumberOfSubcompactions) {
   }
 }
 
+TEST_F(DBCompactionTest, SubcompactionRangesPerThread) {
+  // Tests that the extra subcompactions are shared among max_subcompactions
+  // threads
+  class SubCompactionEventListener : public EventListener {
+   public:
+    void OnSubcompactionBegin(const SubcompactionJobInfo&) override {
+      std::lock_guard<std::mutex> lock(mutex_);
+      thread_ids_.insert(std::this_thread::get_id());
+      max_running_ = std::max(++running_, max_running_);
+    }
+    void OnSubcompactionCompleted(const SubcompactionJobInfo&) override {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --running_;
+      ++finished_;
+    }
+    std::mutex mutex_;
+    std::set<std::thread::id> thread_ids_;
+    int running_ = 0;
+    int max_running_ = 0;
+    int finished_ = 0;
+  };
+  Options options = CurrentOptions();
+  options.compaction_style = kCompactionStyleLevel;
+  options.compression = kNoCompression;
+  options.target_file_size_base = 100 << 10;  // 100KB
+  options.level0_file_num_compaction_trigger = 2;
+  options.max_subcompactions = 2;
+  options.subcompaction_ranges_per_thread = 4;
+  auto listener = std::make_shared<SubCompactionEventListener>();
+  options.listeners.emplace_back(listener);
+  DestroyAndReopen(options);
+
+  // ~1MB in two files to avoid trivial move, as in NumberOfSubcompactions
+  Random rnd(301);
+  std::map<std::string, std::string> expected;
+  for (int file = 0; file < 2; ++file) {
+    for (int key = file; key < 2000; key += 2) {
+      expected[Key(key)] = rnd.RandomString(500);
+      ASSERT_OK(Put(Key(key), expected[Key(key)]));
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+
+  ASSERT_EQ(listener->finished_, 8);
+  ASSERT_LE(listener->max_running_, 2);
+  ASSERT_LE(listener->thread_ids_.size(), 2);
+  // Outputs are in key order
+  ASSERT_EQ(0, NumTableFilesAtLevel(0));
+  for (const auto& [key, value] : expected) {
+    ASSERT_EQ(value, Get(key));
+  }
+  std::vector<LiveFileMetaData> files;
+  db_->GetLiveFilesMetaData(&files);
+  std::sort(files.begin(), files.end(),
+            [](const LiveFileMetaData& a, const LiveFileMetaData& b) {
+              return a.smallestkey < b.smallestkey;
+            });
+  for (size_t i = 1; i < files.size(); ++i) {
+    ASSERT_LT(files[i - 1].largestkey, files[i].smallestkey);
+  }
+}
+
 TEST_F(DBCompactionTest, VerifyInputRecordCount) {
   Options options = CurrentOptions();
   options.compaction_style = kCompactionStyleLevel;
@@ -108,6 +108,11 @@ class CompactedDBImpl : public DBImpl {
     return Status::NotSupported("Not supported in compacted db mode.");
   }
 
+  Status ReserveFileNumbers(uint64_t /*num*/,
+                            uint64_t* /*first_file_number*/) override {
+    return Status::NotSupported("Not supported in compacted db mode.");
+  }
+
   using DB::CreateColumnFamilyWithImport;
   Status CreateColumnFamilyWithImport(
       const ColumnFamilyOptions& /*options*/,
@@ -13,6 +13,7 @@
 #include <alloca.h>
 #endif
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstdio>
 #include <map>
@@ -54,6 +55,7 @@
 #include "db/table_properties_collector.h"
 #include "db/transaction_log_impl.h"
 #include "db/version_set.h"
+#include "db/wide/wide_columns_helper.h"
 #include "db/write_batch_internal.h"
 #include "db/write_callback.h"
 #include "env/unique_id_gen.h"
@@ -273,6 +275,10 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname,
   if (write_buffer_manager_) {
     wbm_stall_.reset(new WBMStallInterface());
   }
+  if (!read_only && immutable_db_options_.compression_threads > 0) {
+    compression_thread_pool_.reset(new CompressionThreadPool(
+        static_cast<size_t>(immutable_db_options_.compression_threads)));
+  }
 }
 
 Status DBImpl::Resume() {
@@ -515,6 +521,12 @@ Status DBImpl::CloseHelper() {
   }
   mutex_.Unlock();
 
+  if (wal_writer_thread_.joinable()) {
+    wal_writer_thread_started_.store(false, std::memory_order_relaxed);
+    write_thread_.StopWalWriterQueue();
+    wal_writer_thread_.join();
+  }
+
   // Below check is added as recovery_error_ is not checked and it causes crash
   // in DBSSTTest.DBWithMaxSpaceAllowedWithBlobFiles when space limit is
   // reached.
@@ -1556,9 +1568,13 @@ IOStatus DBImpl::SyncWalImpl(bool include_current_wal,
 
     maybe_active_number = cur_wal_number_;
     up_to_number =
-        include_current_wal ? maybe_active_number : maybe_active_number - 1;
+        include_current_wal ? newest_wal_number_ : maybe_active_number - 1;
 
-    while (logs_.front().number <= up_to_number && logs_.front().IsSyncing()) {
+    // With more than one WAL stream, SyncWalStreams() might be syncing WALs
+    // other than the head of logs_.
+    while (std::any_of(logs_.begin(), logs_.end(), [&](LogWriterNumber& log) {
+      return log.number <= up_to_number && log.IsSyncing();
+    })) {
       wal_sync_cv_.Wait();
     }
     // First check that logs are safe to sync in background.
@@ -1604,7 +1620,7 @@ IOStatus DBImpl::SyncWalImpl(bool include_current_wal,
         log->file()->reset_seen_error();
       }
       if (log->get_log_number() >= maybe_active_number) {
-        assert(log->get_log_number() == maybe_active_number);
+        assert(log->get_log_number() <= up_to_number);
         io_s = log->file()->SyncWithoutFlush(opts,
                                              immutable_db_options_.use_fsync);
       } else {
@@ -1774,14 +1790,14 @@ Status DBImpl::UnlockWAL() {
 void DBImpl::MarkLogsSynced(uint64_t up_to, bool synced_dir,
                             VersionEdit* synced_wals) {
   wal_write_mutex_.AssertHeld();
-  if (synced_dir && cur_wal_number_ == up_to) {
+  if (synced_dir && up_to >= cur_wal_number_) {
     wal_dir_synced_ = true;
   }
   for (auto it = logs_.begin(); it != logs_.end() && it->number <= up_to;) {
     auto& wal = *it;
     assert(wal.IsSyncing());
 
-    if (wal.number < logs_.back().number) {
+    if (wal.number < cur_wal_number_) {
       // Inactive WAL
       if (immutable_db_options_.track_and_verify_wals_in_manifest &&
           wal.GetPreSyncSize() > 0) {
@@ -1804,7 +1820,7 @@ void DBImpl::MarkLogsSynced(uint64_t up_to, bool synced_dir,
         ++it;
       }
     } else {
-      assert(wal.number == logs_.back().number);
+      assert(wal.number <= newest_wal_number_);
       // Active WAL
       wal.FinishSync();
       ++it;
@@ -1823,6 +1839,93 @@ void DBImpl::MarkLogsNotSynced(uint64_t up_to) {
   wal_sync_cv_.SignalAll();
 }
 
+IOStatus DBImpl::SyncWalStreams(const WriteOptions& write_options,
+                                SequenceNumber seq) {
+  assert(immutable_db_options_.num_wal_streams > 1);
+  IOOptions opts;
+  IOStatus io_s = WritableFileWriter::PrepareIOOptions(write_options, opts);
+  if (!io_s.ok()) {
+    return io_s;
+  }
+  wal_write_mutex_.Lock();
+  while (io_s.ok()) {
+    LogWriterNumber* to_sync = nullptr;
+    bool wait_for_sync = false;
+    for (auto& log : logs_) {
+      if (log.first_unsynced_seq > seq) {
+        continue;
+      }
+      if (!log.IsSyncing()) {
+        to_sync = &log;
+        break;
+      }
+      wait_for_sync = true;
+    }
+    if (to_sync == nullptr) {
+      if (!wait_for_sync) {
+        break;
+      }
+      // Another thread is syncing a WAL we need; its sync might cover our
+      // records.
+      wal_sync_cv_.Wait();
+      continue;
+    }
+    // Entries of logs_ that are getting synced are neither removed nor
+    // closed, but logs_ can be modified while we do not hold the mutex.
+    const uint64_t number = to_sync->number;
+    log::Writer* const writer = to_sync->writer;
+    to_sync->PrepareForSync();
+    to_sync->first_seq_added_during_sync = kMaxSequenceNumber;
+    const bool need_wal_dir_sync = !wal_dir_synced_;
+    wal_write_mutex_.Unlock();
+
+    // A closed WAL has been fully synced.
+    if (writer->file()) {
+      StopWatch sw(immutable_db_options_.clock, stats_, WAL_FILE_SYNC_MICROS);
+      RecordTick(stats_, WAL_FILE_SYNCED);
+      io_s = writer->file()->SyncWithoutFlush(opts,
+                                              immutable_db_options_.use_fsync);
+    }
+    if (io_s.ok() && need_wal_dir_sync) {
+      io_s = directories_.GetWalDir()->FsyncWithDirOptions(
+          IOOptions(), nullptr,
+          DirFsyncOptions(DirFsyncOptions::FsyncReason::kNewFileSynced));
+    }
+    TEST_SYNC_POINT("DBImpl::SyncWalStreams:AfterSync");
+
+    wal_write_mutex_.Lock();
+    LogWriterNumber* log = FindLogWriterNumber(number);
+    assert(log != nullptr);
+    if (io_s.ok()) {
+      log->first_unsynced_seq = log->first_seq_added_during_sync;
+      if (need_wal_dir_sync && number >= cur_wal_number_) {
+        wal_dir_synced_ = true;
+      }
+    }
+    log->FinishSync();
+    wal_sync_cv_.SignalAll();
+  }
+  wal_write_mutex_.Unlock();
+
+  if (!io_s.ok()) {
+    ROCKS_LOG_ERROR(immutable_db_options_.info_log, "WAL Sync error %s",
+                    io_s.ToString().c_str());
+    WALIOStatusCheck(io_s);
+  }
+  return io_s;
+}
+
+DBImpl::LogWriterNumber* DBImpl::FindLogWriterNumber(uint64_t number) {
+  wal_write_mutex_.AssertHeld();
+  // The newest WALs are the ones looked up most often.
+  for (auto it = logs_.rbegin(); it != logs_.rend(); ++it) {
+    if (it->number == number) {
+      return &*it;
+    }
+  }
+  return nullptr;
+}
+
 SequenceNumber DBImpl::GetLatestSequenceNumber() const {
   return versions_->LastSequence();
 }
@@ -2541,6 +2644,14 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
         if (get_impl_options.value) {
           size = get_impl_options.value->size();
         } else if (get_impl_options.columns) {
+          if (read_options.wide_column_projection) {
+            const Status project_s = WideColumnsHelper::ProjectColumns(
+                *read_options.wide_column_projection,
+                get_impl_options.columns);
+            if (!project_s.ok()) {
+              s = project_s;
+            }
+          }
           size = get_impl_options.columns->serialized_size();
         }
       } else {
@@ -3271,6 +3382,13 @@ Status DBImpl::MultiGetImpl(
         bytes_read += key->value->size();
       } else {
         assert(key->columns);
+        if (read_options.wide_column_projection) {
+          const Status project_s = WideColumnsHelper::ProjectColumns(
+              *read_options.wide_column_projection, key->columns);
+          if (!project_s.ok()) {
+            *(key->s) = project_s;
+          }
+        }
         bytes_read += key->columns->serialized_size();
       }
 
@@ -4882,6 +5000,10 @@ Status DBImpl::GetUpdatesSince(
         "This API is not yet compatible with write-prepared/write-unprepared "
         "transactions");
   }
+  if (immutable_db_options_.num_wal_streams > 1) {
+    return Status::NotSupported(
+        "This API is not compatible with more than one WAL stream");
+  }
   if (seq > versions_->LastSequence()) {
     return Status::NotFound("Requested sequence not yet written in the db");
   }
@@ -4890,7 +5012,7 @@ Status DBImpl::GetUpdatesSince(
 
 Status DBImpl::DeleteFilesInRanges(ColumnFamilyHandle* column_family,
                                    const RangeOpt* ranges, size_t n,
-                                   bool include_end) {
+                                   bool include_end, bool all_or_nothing) {
   // TODO: plumb Env::IOActivity, Env::IOPriority
   const ReadOptions read_options;
   const WriteOptions write_options;
@@ -4927,6 +5049,11 @@ Status DBImpl::DeleteFilesInRanges(ColumnFamilyHandle* column_family,
     for (const auto& range : ukey_ranges) {
       auto begin = range.start.has_value() ? &range.start.value() : nullptr;
       auto end = range.limit.has_value() ? &range.limit.value() : nullptr;
+      if (all_or_nothing && !vstorage->LevelFiles(0).empty() &&
+          vstorage->OverlapInLevel(0, begin, end)) {
+        status = Status::Incomplete("L0 files overlap the range");
+        break;
+      }
       for (int i = 1; i < cfd->NumberLevels(); i++) {
         if (vstorage->LevelFiles(i).empty() ||
             !vstorage->OverlapInLevel(i, begin, end)) {
@@ -4950,13 +5077,13 @@ Status DBImpl::DeleteFilesInRanges(ColumnFamilyHandle* column_family,
         vstorage->GetCleanInputsWithinInterval(
             i, begin_key, end_key, &level_files, -1 /* hint_index */,
             nullptr /* file_index */);
+        // Files of the level in the range that are dropped
+        size_t num_dropped = 0;
         FileMetaData* level_file;
         for (uint32_t j = 0; j < level_files.size(); j++) {
           level_file = level_files[j];
-          if (level_file->being_compacted) {
-            continue;
-          }
-          if (deleted_files.find(level_file) != deleted_files.end()) {
+          if (level_file->being_compacted &&
+              deleted_files.find(level_file) == deleted_files.end()) {
             continue;
           }
           if (!include_end && end != nullptr &&
@@ -4964,12 +5091,36 @@ Status DBImpl::DeleteFilesInRanges(ColumnFamilyHandle* column_family,
                                              *end) == 0)) {
             continue;
           }
+          ++num_dropped;
+          if (deleted_files.find(level_file) != deleted_files.end()) {
+            continue;
+          }
           edit.SetColumnFamily(cfd->GetID());
           edit.DeleteFile(i, level_file->fd.GetNumber());
           deleted_files.insert(level_file);
           level_file->being_compacted = true;
         }
+        if (all_or_nothing) {
+          std::vector<FileMetaData*> overlapping_files;
+          vstorage->GetOverlappingInputs(i, begin_key, end_key,
+                                         &overlapping_files);
+          if (num_dropped < overlapping_files.size()) {
+            status = Status::Incomplete(
+                "Files overlapping the range would be kept");
+            break;
+          }
+        }
+      }
+      if (!status.ok()) {
+        break;
+      }
+    }
+    if (!status.ok()) {
+      for (auto* deleted_file : deleted_files) {
+        deleted_file->being_compacted = false;
       }
+      job_context.Clean();
+      return status;
     }
     if (!deleted_files.empty()) {
       vstorage->ComputeCompactionScore(cfd->ioptions(),
@@ -6157,6 +6308,16 @@ Status DBImpl::IngestExternalFiles(
   return status;
 }
 
+Status DBImpl::ReserveFileNumbers(uint64_t num, uint64_t* first_file_number) {
+  if (num == 0 || first_file_number == nullptr) {
+    return Status::InvalidArgument(
+        "ReserveFileNumbers() needs a positive number of file numbers and "
+        "non-null first_file_number");
+  }
+  *first_file_number = versions_->ReserveFileNumbers(num);
+  return Status::OK();
+}
+
 Status DBImpl::CreateColumnFamilyWithImport(
     const ColumnFamilyOptions& options, const std::string& column_family_name,
     const ImportColumnFamilyOptions& import_options,
@@ -65,6 +65,7 @@
 #include "rocksdb/write_buffer_manager.h"
 #include "table/merging_iterator.h"
 #include "util/autovector.h"
+#include "util/compression_thread_pool.h"
 #include "util/hash.h"
 #include "util/repeatable_thread.h"
 #include "util/stop_watch.h"
@@ -553,9 +554,13 @@ class DBImpl : public DB {
       SequenceNumber seq_number, std::unique_ptr<TransactionLogIterator>* iter,
       const TransactionLogIterator::ReadOptions& read_options =
           TransactionLogIterator::ReadOptions()) override;
+  // With all_or_nothing, drops no file and returns Incomplete() if some file
+  // overlapping a range would be kept (L0 files, files being compacted and
+  // files not entirely in the range).
   Status DeleteFilesInRanges(ColumnFamilyHandle* column_family,
                              const RangeOpt* ranges, size_t n,
-                             bool include_end = true);
+                             bool include_end = true,
+                             bool all_or_nothing = false);
 
   void GetLiveFilesMetaData(std::vector<LiveFileMetaData>* metadata) override;
 
@@ -589,6 +594,9 @@ class DBImpl : public DB {
   Status IngestExternalFiles(
       const std::vector<IngestExternalFileArg>& args) override;
 
+  Status ReserveFileNumbers(uint64_t num,
+                            uint64_t* first_file_number) override;
+
   using DB::CreateColumnFamilyWithImport;
   Status CreateColumnFamilyWithImport(
       const ColumnFamilyOptions& options, const std::string& column_family_name,
@@ -1583,6 +1591,23 @@ class DBImpl : public DB {
                             bool disable_memtable = false,
                             uint64_t* seq_used = nullptr);
 
+  // The WAL part of PipelinedWriteImpl for the batch group led by w, which
+  // must be in STATE_GROUP_LEADER. placeholder_leader is true if w is the
+  // placeholder writer of the WAL writer thread.
+  void PipelinedWriteGroupToWAL(const WriteOptions& write_options,
+                                WriteThread::Writer* w, uint64_t* wal_used,
+                                bool placeholder_leader);
+
+  // Main loop of wal_writer_thread_. Writes the WAL for the writers queued by
+  // WriteThread::JoinWalWriterQueue until the queue is stopped.
+  void WalWriterThreadLoop();
+
+  // Starts wal_writer_thread_ if DBOptions::enable_wal_writer_thread is set.
+  // Called at the end of a successful DB::Open(), after recovery, so that no
+  // failure path of Open() leaves the thread running. Writes during Open()
+  // join the batch group themselves.
+  void MaybeStartWalWriterThread();
+
   // Write only to memtables without joining any write queue
   Status UnorderedWriteMemtable(const WriteOptions& write_options,
                                 WriteBatch* my_batch, WriteCallback* callback,
@@ -1746,6 +1771,7 @@ class DBImpl : public DB {
   friend class WriteUnpreparedTransactionTest_RecoveryTest_Test;
   friend class CompactionServiceTest_PreservedOptionsLocalCompaction_Test;
   friend class CompactionServiceTest_PreservedOptionsRemoteCompaction_Test;
+  friend class DBWriteTestUnparameterized_WalWriterThread_Test;
 #endif
 
   struct CompactionState;
@@ -1835,10 +1861,27 @@ class DBImpl : public DB {
       attempt_truncate_size = size;
     }
 
+    // Only tracked with more than one WAL stream; see SyncWalStreams().
+    void AddedRecord(SequenceNumber seq) {
+      if (first_unsynced_seq == kMaxSequenceNumber) {
+        first_unsynced_seq = seq;
+      }
+      if (getting_synced && first_seq_added_during_sync == kMaxSequenceNumber) {
+        first_seq_added_during_sync = seq;
+      }
+    }
+
     uint64_t number;
     // Visual Studio doesn't support deque's member to be noncopyable because
     // of a std::unique_ptr as a member.
     log::Writer* writer;  // own
+    // Starting sequence number of the oldest record that might not be synced
+    // yet, kMaxSequenceNumber if there is none.
+    SequenceNumber first_unsynced_seq = kMaxSequenceNumber;
+    // Starting sequence number of the oldest record added since the last
+    // PrepareForSync() by SyncWalStreams(), kMaxSequenceNumber if there is
+    // none. Such a record might not be covered by that sync.
+    SequenceNumber first_seq_added_during_sync = kMaxSequenceNumber;
 
    private:
     // true for some prefix of logs_
@@ -2085,6 +2128,16 @@ class DBImpl : public DB {
                          bool* corrupted_wal_found,
                          RecoveryContext* recovery_ctx);
 
+  // Replays the WALs of all streams when the MANIFEST records more than one
+  // WAL stream, merging their records by sequence number. Replay stops at the
+  // first sequence number missing from the streams, as for corruption.
+  Status ProcessMergedLogFiles(
+      const std::vector<uint64_t>& wal_numbers, uint64_t min_wal_number,
+      bool is_retry, bool read_only, int job_id, SequenceNumber* next_sequence,
+      bool* stop_replay_for_corruption, bool* stop_replay_by_wal_filter,
+      uint64_t* corrupted_wal_number, bool* corrupted_wal_found,
+      std::unordered_map<int, VersionEdit>* version_edits, bool* flushed);
+
   Status ProcessLogFile(
       uint64_t wal_number, uint64_t min_wal_number, bool is_retry,
       bool read_only, int job_id, SequenceNumber* next_sequence,
@@ -2387,6 +2440,11 @@ class DBImpl : public DB {
 
   void MaybeScheduleFlushOrCompaction();
 
+  // Stops one of preemptible_compactions_ if writes are stalled and
+  // `flush_waiting` or a queued compaction is needed to relieve L0. See
+  // DBOptions::preempt_bottommost_compactions.
+  void MaybePreemptBottommostCompaction(bool flush_waiting);
+
   struct FlushRequest {
     FlushReason flush_reason;
     // A map from column family to flush to largest memtable id to persist for
@@ -2517,6 +2575,17 @@ class DBImpl : public DB {
   // WALs with log number up to up_to are not synced successfully.
   void MarkLogsNotSynced(uint64_t up_to);
 
+  // With more than one WAL stream, syncs the WALs holding records with
+  // starting sequence number up to seq that might not be synced yet, i.e.
+  // makes all writes up to seq durable. Syncs of different WALs may run in
+  // parallel from different threads.
+  IOStatus SyncWalStreams(const WriteOptions& write_options,
+                          SequenceNumber seq);
+
+  // Returns the logs_ entry of the given WAL, or nullptr if it is not in
+  // logs_. REQUIRES: wal_write_mutex_ held
+  LogWriterNumber* FindLogWriterNumber(uint64_t number);
+
   SnapshotImpl* GetSnapshotImpl(bool is_write_conflict_boundary,
                                 bool lock = true);
 
@@ -2601,6 +2670,32 @@ class DBImpl : public DB {
                      const PredecessorWALInfo& predecessor_wal_info,
                      log::Writer** new_log);
 
+  // Creates the WALs of all but the first stream of a new WAL generation when
+  // DBOptions::num_wal_streams > 1, allocating their file numbers. Writers
+  // created are returned in new_logs even on failure. Then writes a marker
+  // for first_seq, the sequence number of the first write of the generation,
+  // to first_log, the WAL of the first stream, and syncs it together with
+  // the WAL directory, so that recovery knows where the generation starts.
+  IOStatus CreateWalStreams(const WriteOptions& write_options,
+                            size_t preallocate_block_size,
+                            log::Writer* first_log, SequenceNumber first_seq,
+                            std::vector<log::Writer*>* new_logs);
+
+  // With more than one WAL stream, appends to log_writer a marker record
+  // stating that the sequence numbers from seq to next_seq - 1 are not in
+  // any WAL record, e.g. because they were consumed by file ingestion, and
+  // that all WAL records before seq are in earlier records. Recovery takes
+  // any other gap in the sequence numbers of the WAL records as lost
+  // records. REQUIRES: write group leader, or WAL not in logs_ yet
+  IOStatus WriteWalStreamsMarker(const WriteOptions& write_options,
+                                 log::Writer* log_writer, SequenceNumber seq,
+                                 SequenceNumber next_seq);
+
+  // Returns true and the sequence number following the marker in next_seq if
+  // record was written by WriteWalStreamsMarker().
+  static bool DecodeWalStreamsMarker(const Slice& record,
+                                     SequenceNumber* next_seq);
+
   // Validate self-consistency of DB options
   static Status ValidateOptions(const DBOptions& db_options);
   // Validate self-consistency of DB options and its consistency with cf options
@@ -2778,6 +2873,23 @@ class DBImpl : public DB {
   // from the same write_thread_ without any locks.
   uint64_t cur_wal_number_ = 0;
 
+  // Number of the newest WAL. Unless DBOptions::num_wal_streams > 1, this is
+  // cur_wal_number_. Otherwise the WALs numbered from cur_wal_number_ to
+  // newest_wal_number_ are the current generation of WALs, one per stream,
+  // and are the last num_wal_streams entries of logs_ and alive_wal_files_.
+  // Same synchronization as cur_wal_number_.
+  uint64_t newest_wal_number_ = 0;
+
+  // Stream of the next write batch group if DBOptions::num_wal_streams > 1.
+  // Only accessed by the write group leader.
+  size_t next_wal_stream_ = 0;
+
+  // If DBOptions::num_wal_streams > 1, the sequence number following the last
+  // one in a WAL record of the current session. A write group starting at a
+  // different sequence number writes a marker first, see
+  // WriteWalStreamsMarker(). Same synchronization as next_wal_stream_.
+  SequenceNumber wal_streams_next_seq_ = 0;
+
   // Log files that we can recycle. Must be protected by db mutex_.
   std::deque<uint64_t> wal_recycle_files_;
 
@@ -2924,6 +3036,12 @@ class DBImpl : public DB {
   // in 2PC to batch the prepares separately from the serial commit.
   WriteThread nonmem_write_thread_;
 
+  // Writes the WAL for the pipelined writers if
+  // DBOptions::enable_wal_writer_thread is set.
+  port::Thread wal_writer_thread_;
+  // Whether pipelined writers queue for wal_writer_thread_
+  std::atomic<bool> wal_writer_thread_started_{false};
+
   WriteController write_controller_;
 
   // Size of the last batch group. In slowdown mode, next write needs to
@@ -3007,6 +3125,19 @@ class DBImpl : public DB {
   // stores the number of compactions are currently running
   int num_running_compactions_ = 0;
 
+  // Once this many bottommost compactions of a column family in a row were
+  // preempted, the next one runs to completion, so that they are not starved
+  // by a steady stream of urgent work.
+  static constexpr int kMaxBottommostCompactionPreemptions = 2;
+
+  struct PreemptibleCompaction {
+    Compaction* compaction;
+    // Passed to the CompactionJob as its cancellation flag
+    std::atomic<bool>* preempted;
+  };
+  // The running compactions that can be preempted, in the order they started
+  std::list<PreemptibleCompaction> preemptible_compactions_;
+
   // number of background memtable flush jobs, submitted to the HIGH pool
   int bg_flush_scheduled_ = 0;
 
@@ -3146,6 +3277,10 @@ class DBImpl : public DB {
 
   BlobFileCompletionCallback blob_callback_;
 
+  // Shared by flushes and compactions for compressing data blocks, see
+  // DBOptions::compression_threads. nullptr if not enabled.
+  std::unique_ptr<CompressionThreadPool> compression_thread_pool_;
+
   // Pointer to WriteBufferManager stalling interface.
   std::unique_ptr<StallInterface> wbm_stall_;
 
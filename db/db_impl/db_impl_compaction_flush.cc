@@ -215,7 +215,8 @@ Status DBImpl::FlushMemTableToOutputFile(
       &event_logger_, mutable_cf_options.report_bg_io_stats,
       true /* sync_output_directory */, true /* write_manifest */, thread_pri,
       io_tracer_, cfd->GetSuperVersion()->ShareSeqnoToTimeMapping(), db_id_,
-      db_session_id_, cfd->GetFullHistoryTsLow(), &blob_callback_);
+      db_session_id_, cfd->GetFullHistoryTsLow(), &blob_callback_,
+      compression_thread_pool_.get());
   FileMetaData file_meta;
 
   Status s;
@@ -481,7 +482,8 @@ Status DBImpl::AtomicFlushMemTablesToOutputFiles(
         false /* sync_output_directory */, false /* write_manifest */,
         thread_pri, io_tracer_,
         cfd->GetSuperVersion()->ShareSeqnoToTimeMapping(), db_id_,
-        db_session_id_, cfd->GetFullHistoryTsLow(), &blob_callback_));
+        db_session_id_, cfd->GetFullHistoryTsLow(), &blob_callback_,
+        compression_thread_pool_.get()));
   }
 
   std::vector<FileMetaData> file_meta(num_cfs);
@@ -1525,7 +1527,7 @@ Status DBImpl::CompactFilesImpl(
       kManualCompactionCanceledFalse_, db_id_, db_session_id_,
       c->column_family_data()->GetFullHistoryTsLow(), c->trim_ts(),
       &blob_callback_, &bg_compaction_scheduled_,
-      &bg_bottom_compaction_scheduled_);
+      &bg_bottom_compaction_scheduled_, compression_thread_pool_.get());
 
   // Creating a compaction influences the compaction score because the score
   // takes running compactions into account (by skipping files that are already
@@ -2910,6 +2912,49 @@ void DBImpl::MaybeScheduleFlushOrCompaction() {
     env_->Schedule(&DBImpl::BGWorkCompaction, ca, Env::Priority::LOW, this,
                    &DBImpl::UnscheduleCompactionCallback);
   }
+
+  MaybePreemptBottommostCompaction(is_flush_pool_empty &&
+                                   unscheduled_flushes_ > 0);
+}
+
+void DBImpl::MaybePreemptBottommostCompaction(bool flush_waiting) {
+  mutex_.AssertHeld();
+  if (!mutable_db_options_.preempt_bottommost_compactions ||
+      preemptible_compactions_.empty() ||
+      (!write_controller_.IsStopped() && !write_controller_.NeedsDelay())) {
+    return;
+  }
+  for (const PreemptibleCompaction& pc : preemptible_compactions_) {
+    if (pc.preempted->load(std::memory_order_relaxed)) {
+      // Wait for the compaction being preempted to give up its slot
+      return;
+    }
+  }
+  // The most recently started one has the least work to lose
+  for (auto it = preemptible_compactions_.rbegin();
+       it != preemptible_compactions_.rend(); ++it) {
+    bool urgent = flush_waiting;
+    for (ColumnFamilyData* cfd : compaction_queue_) {
+      if (urgent) {
+        break;
+      }
+      VersionStorageInfo* vstorage = cfd->current()->storage_info();
+      if (vstorage->l0_delay_trigger_count() <
+          cfd->GetLatestMutableCFOptions().level0_slowdown_writes_trigger) {
+        continue;
+      }
+      // Once its input files are released, a preempted compaction of the
+      // same column family would be picked again unless L0 scores higher
+      urgent = cfd != it->compaction->column_family_data() ||
+               (vstorage->CompactionScoreLevel(0) == 0 &&
+                vstorage->CompactionScore(0) > it->compaction->score());
+    }
+    if (urgent) {
+      TEST_SYNC_POINT("DBImpl::MaybePreemptBottommostCompaction:Preempt");
+      it->preempted->store(true, std::memory_order_release);
+      return;
+    }
+  }
 }
 
 DBImpl::BGJobLimits DBImpl::GetBGJobLimits() const {
@@ -3730,6 +3775,8 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
 
   IOStatus io_s;
   bool compaction_released = false;
+  // Set by MaybePreemptBottommostCompaction()
+  std::atomic<bool> compaction_preempted{false};
   if (!c) {
     // Nothing to do
     ROCKS_LOG_BUFFER(log_buffer, "Compaction nothing to do");
@@ -4134,6 +4181,21 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
     InitSnapshotContext(job_context);
     assert(is_snapshot_supported_ || snapshots_.empty());
 
+    // Only automatic compactions that leave L0 alone can be preempted. The
+    // cancellation flag used for pausing manual compactions stops them. A
+    // compaction in the BOTTOM pool is not holding a slot that the urgent
+    // work could run in.
+    std::list<PreemptibleCompaction>::iterator preemptible_elem =
+        preemptible_compactions_.end();
+    if (!is_manual && mutable_db_options_.preempt_bottommost_compactions &&
+        thread_pri == Env::Priority::LOW && c->start_level() > 0 &&
+        c->bottommost_level() &&
+        c->column_family_data()->bottommost_compaction_preemptions() <
+            kMaxBottommostCompactionPreemptions) {
+      preemptible_elem = preemptible_compactions_.insert(
+          preemptible_compactions_.end(), {c.get(), &compaction_preempted});
+    }
+
     CompactionJob compaction_job(
         job_context->job_id, c.get(), immutable_db_options_,
         mutable_db_options_, file_options_for_compaction_, versions_.get(),
@@ -4145,10 +4207,12 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
         c->mutable_cf_options().report_bg_io_stats, dbname_,
         &compaction_job_stats, thread_pri, io_tracer_,
         is_manual ? manual_compaction->canceled
-                  : kManualCompactionCanceledFalse_,
+        : preemptible_elem != preemptible_compactions_.end()
+            ? compaction_preempted
+            : kManualCompactionCanceledFalse_,
         db_id_, db_session_id_, c->column_family_data()->GetFullHistoryTsLow(),
         c->trim_ts(), &blob_callback_, &bg_compaction_scheduled_,
-        &bg_bottom_compaction_scheduled_);
+        &bg_bottom_compaction_scheduled_, compression_thread_pool_.get());
     compaction_job.Prepare(std::nullopt /*subcompact to be computed*/);
 
     std::unique_ptr<std::list<uint64_t>::iterator> min_options_file_number_elem;
@@ -4166,6 +4230,13 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
     compaction_job.Run().PermitUncheckedError();
     TEST_SYNC_POINT("DBImpl::BackgroundCompaction:NonTrivial:AfterRun");
     mutex_.Lock();
+    if (preemptible_elem != preemptible_compactions_.end()) {
+      preemptible_compactions_.erase(preemptible_elem);
+    }
+    if (!is_manual && c->start_level() > 0 && c->bottommost_level() &&
+        !compaction_preempted.load(std::memory_order_relaxed)) {
+      c->column_family_data()->set_bottommost_compaction_preemptions(0);
+    }
 
     if (immutable_db_options().compaction_service != nullptr) {
       ReleaseOptionsFileNumber(min_options_file_number_elem);
@@ -4222,8 +4293,26 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
                                 compaction_job_stats, job_context->job_id);
   }
 
-  if (status.ok() || status.IsCompactionTooLarge() ||
-      status.IsManualCompactionPaused()) {
+  if (c != nullptr && !is_manual && status.IsManualCompactionPaused() &&
+      compaction_preempted.load(std::memory_order_relaxed)) {
+    RecordTick(stats_, COMPACTION_PREEMPTED);
+    ROCKS_LOG_BUFFER(log_buffer,
+                     "[%s] [JOB %d] Compaction preempted by urgent flush or "
+                     "L0 compaction",
+                     c->column_family_data()->GetName().c_str(),
+                     job_context->job_id);
+    // Pick the input files again once the urgent work is scheduled
+    auto cfd = c->column_family_data();
+    cfd->set_bottommost_compaction_preemptions(
+        cfd->bottommost_compaction_preemptions() + 1);
+    cfd->current()->storage_info()->ComputeCompactionScore(
+        c->immutable_options(), c->mutable_cf_options());
+    if (!cfd->queued_for_compaction()) {
+      AddToCompactionQueue(cfd);
+    }
+    status = Status::OK();
+  } else if (status.ok() || status.IsCompactionTooLarge() ||
+             status.IsManualCompactionPaused()) {
     // Done
   } else if (status.IsColumnFamilyDropped() || status.IsShutdownInProgress()) {
     // Ignore compaction errors found during shutting down
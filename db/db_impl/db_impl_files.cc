@@ -585,8 +585,10 @@ void DBImpl::PurgeObsoleteFiles(JobContext& state, bool schedule_only) {
         }
         break;
       case kBlobFile:
+        // A blob file being ingested keeps a number reserved for it
         keep = number >= state.min_pending_output ||
-               (blob_live_set.find(number) != blob_live_set.end());
+               (blob_live_set.find(number) != blob_live_set.end()) ||
+               versions_->IsFileNumberReserved(number);
         if (!keep) {
           files_to_del.insert(number);
         }
@@ -25,6 +25,7 @@
 #include "rocksdb/table.h"
 #include "rocksdb/wal_filter.h"
 #include "test_util/sync_point.h"
+#include "util/coding.h"
 #include "util/rate_limiter_impl.h"
 #include "util/string_util.h"
 #include "util/udt_util.h"
@@ -277,6 +278,37 @@ Status DBImpl::ValidateOptions(const DBOptions& db_options) {
         "atomic_flush is incompatible with enable_pipelined_write");
   }
 
+  if (db_options.enable_wal_writer_thread &&
+      !db_options.enable_pipelined_write) {
+    return Status::InvalidArgument(
+        "enable_wal_writer_thread requires enable_pipelined_write");
+  }
+
+  if (db_options.num_wal_streams == 0) {
+    return Status::InvalidArgument("num_wal_streams must be greater than 0");
+  }
+
+  if (db_options.num_wal_streams > 1) {
+    if (db_options.enable_pipelined_write || db_options.unordered_write ||
+        db_options.two_write_queues || db_options.allow_2pc) {
+      return Status::InvalidArgument(
+          "num_wal_streams > 1 is incompatible with enable_pipelined_write, "
+          "unordered_write, two_write_queues and allow_2pc");
+    }
+    if (db_options.manual_wal_flush || db_options.allow_mmap_writes ||
+        db_options.recycle_log_file_num > 0) {
+      return Status::InvalidArgument(
+          "num_wal_streams > 1 is incompatible with manual_wal_flush, "
+          "allow_mmap_writes and recycle_log_file_num > 0");
+    }
+    if (db_options.track_and_verify_wals_in_manifest ||
+        db_options.track_and_verify_wals) {
+      return Status::InvalidArgument(
+          "num_wal_streams > 1 is incompatible with "
+          "track_and_verify_wals_in_manifest and track_and_verify_wals");
+    }
+  }
+
   if (db_options.use_direct_io_for_flush_and_compaction &&
       0 == db_options.writable_file_max_buffer_size) {
     return Status::InvalidArgument(
@@ -690,6 +722,16 @@ Status DBImpl::Recover(
   }
   assert(!s.ok() || !db_id_.empty());
   ROCKS_LOG_INFO(immutable_db_options_.info_log, "DB ID: %s\n", db_id_.c_str());
+  if (s.ok() && !read_only && recovery_ctx &&
+      versions_->num_wal_streams() != immutable_db_options_.num_wal_streams) {
+    // Recovery replays the WALs according to the number of streams recorded
+    // here, so record it before writing WALs with a different number.
+    VersionEdit edit;
+    edit.SetNumWalStreams(
+        static_cast<uint32_t>(immutable_db_options_.num_wal_streams));
+    recovery_ctx->UpdateVersionEdits(
+        versions_->GetColumnFamilySet()->GetDefault(), edit);
+  }
   if (s.ok() && !read_only) {
     s = MaybeUpdateNextFileNumber(recovery_ctx);
   }
@@ -1202,24 +1244,34 @@ Status DBImpl::ProcessLogFiles(
   uint64_t corrupted_wal_number = kMaxSequenceNumber;
   PredecessorWALInfo predecessor_wal_info;
 
-  for (auto wal_number : wal_numbers) {
-    // Detecting early break on the next iteration after `wal_number` has been
-    // advanced since this `wal_number` doesn't affect follow-up handling after
-    // breaking out of the for loop.
-    if (!status.ok()) {
-      break;
-    }
-    SequenceNumber prev_next_sequence = *next_sequence;
-    if (status.ok()) {
-      status = ProcessLogFile(
-          wal_number, min_wal_number, is_retry, read_only, job_id,
-          next_sequence, &stop_replay_for_corruption,
-          &stop_replay_by_wal_filter, &corrupted_wal_number,
-          corrupted_wal_found, version_edits, &flushed, predecessor_wal_info);
-    }
-    if (status.ok()) {
-      status = CheckSeqnoNotSetBackDuringRecovery(prev_next_sequence,
-                                                  *next_sequence);
+  // The WALs were written with the number of streams last recorded in the
+  // MANIFEST, whatever num_wal_streams is now.
+  if (versions_->num_wal_streams() > 1) {
+    status = ProcessMergedLogFiles(
+        wal_numbers, min_wal_number, is_retry, read_only, job_id, next_sequence,
+        &stop_replay_for_corruption, &stop_replay_by_wal_filter,
+        &corrupted_wal_number, corrupted_wal_found, version_edits, &flushed);
+  } else {
+    for (auto wal_number : wal_numbers) {
+      // Detecting early break on the next iteration after `wal_number` has
+      // been advanced since this `wal_number` doesn't affect follow-up
+      // handling after breaking out of the for loop.
+      if (!status.ok()) {
+        break;
+      }
+      SequenceNumber prev_next_sequence = *next_sequence;
+      if (status.ok()) {
+        status = ProcessLogFile(
+            wal_number, min_wal_number, is_retry, read_only, job_id,
+            next_sequence, &stop_replay_for_corruption,
+            &stop_replay_by_wal_filter, &corrupted_wal_number,
+            corrupted_wal_found, version_edits, &flushed,
+            predecessor_wal_info);
+      }
+      if (status.ok()) {
+        status = CheckSeqnoNotSetBackDuringRecovery(prev_next_sequence,
+                                                    *next_sequence);
+      }
     }
   }
 
@@ -1235,6 +1287,221 @@ Status DBImpl::ProcessLogFiles(
   return status;
 }
 
+Status DBImpl::ProcessMergedLogFiles(
+    const std::vector<uint64_t>& wal_numbers, uint64_t min_wal_number,
+    bool is_retry, bool read_only, int job_id, SequenceNumber* next_sequence,
+    bool* stop_replay_for_corruption, bool* stop_replay_by_wal_filter,
+    uint64_t* corrupted_wal_number, bool* corrupted_wal_found,
+    std::unordered_map<int, VersionEdit>* version_edits, bool* flushed) {
+  assert(stop_replay_for_corruption);
+  assert(stop_replay_by_wal_filter);
+
+  // The read state of one WAL. Records of different streams interleave by
+  // sequence number, so all WALs are read concurrently and the record with
+  // the smallest sequence number among their next records is replayed next.
+  struct WalStream {
+    uint64_t wal_number = 0;
+    std::string fname;
+    Status status;  // Set by reporter on corruption
+    bool old_log_record = false;
+    DBOpenLogRecordReadReporter reporter;
+    std::unique_ptr<log::Reader> reader;
+    std::string scratch;
+    Slice record;
+    uint64_t record_checksum = 0;
+    SequenceNumber last_seqno_observed = 0;
+    bool has_record = false;
+  };
+
+  Status status;
+  const UnorderedMap<uint32_t, size_t>& running_ts_sz =
+      versions_->GetRunningColumnFamiliesTimestampSize();
+  // The reporter and reader of a stream keep pointers into it.
+  std::vector<std::unique_ptr<WalStream>> streams;
+
+  auto handle_read_error = [&](WalStream& stream) {
+    if (stream.status.ok() && !stream.old_log_record) {
+      return Status::OK();
+    }
+    Status s = HandleNonOkStatusOrOldLogRecord(
+        stream.wal_number, next_sequence, stream.status, stream.reporter,
+        &stream.old_log_record, stop_replay_for_corruption,
+        corrupted_wal_number, corrupted_wal_found);
+    // Handle each error once
+    stream.status = Status::OK();
+    stream.old_log_record = false;
+    return s;
+  };
+  auto read_next = [&](WalStream& stream) {
+    stream.has_record =
+        stream.reader->ReadRecord(&stream.record, &stream.scratch,
+                                  immutable_db_options_.wal_recovery_mode,
+                                  &stream.record_checksum) &&
+        stream.status.ok();
+    // Corruption stops replay at this stream's position, unless the next
+    // records of the other streams continue the sequence.
+    return stream.has_record ? Status::OK() : handle_read_error(stream);
+  };
+
+  for (auto wal_number : wal_numbers) {
+    if (wal_number < min_wal_number) {
+      ROCKS_LOG_INFO(immutable_db_options_.info_log,
+                     "Skipping log #%" PRIu64
+                     " since it is older than min log to keep #%" PRIu64,
+                     wal_number, min_wal_number);
+      continue;
+    }
+    SetupLogFileProcessing(wal_number);
+    streams.emplace_back(new WalStream());
+    WalStream& stream = *streams.back();
+    stream.wal_number = wal_number;
+    stream.fname = LogFileName(immutable_db_options_.GetWalDir(), wal_number);
+    status = InitializeLogReader(
+        wal_number, is_retry, stream.fname, *stop_replay_for_corruption,
+        min_wal_number, PredecessorWALInfo() /* predecessor_wal_info */,
+        &stream.old_log_record, &stream.status, &stream.reporter,
+        stream.reader);
+    if (!status.ok()) {
+      return status;
+    }
+    if (stream.reader == nullptr) {
+      streams.pop_back();
+      continue;
+    }
+  }
+
+  TEST_SYNC_POINT_CALLBACK("DBImpl::RecoverLogFiles:BeforeReadWal",
+                           /*cb_arg=*/nullptr);
+  for (auto& stream : streams) {
+    status = read_next(*stream);
+    if (!status.ok()) {
+      return status;
+    }
+  }
+
+  // The sequence number the next record has to start at, unless a marker
+  // written by WriteWalStreamsMarker() says otherwise. kMaxSequenceNumber
+  // until the first record.
+  SequenceNumber expected_seqno = kMaxSequenceNumber;
+  while (!*stop_replay_by_wal_filter) {
+    WalStream* next = nullptr;
+    SequenceNumber next_seqno = kMaxSequenceNumber;
+    for (auto& stream : streams) {
+      if (!stream->has_record) {
+        continue;
+      }
+      // Records too small to hold a sequence number are reported as
+      // corruption by ProcessLogRecord(); do that first.
+      SequenceNumber seqno = stream->record.size() < WriteBatchInternal::kHeader
+                                 ? 0
+                                 : DecodeFixed64(stream->record.data());
+      if (next == nullptr || seqno < next_seqno) {
+        next = stream.get();
+        next_seqno = seqno;
+      }
+    }
+    if (next == nullptr) {
+      break;
+    }
+
+    SequenceNumber marker_next_seqno = 0;
+    const bool is_marker =
+        DecodeWalStreamsMarker(next->record, &marker_next_seqno);
+    if (next->record.size() >= WriteBatchInternal::kHeader) {
+      if (expected_seqno == kMaxSequenceNumber) {
+        // Normally the marker starting the oldest WAL generation, which is
+        // synced before any write goes to the generation.
+        expected_seqno = next_seqno;
+      } else if (next_seqno > expected_seqno) {
+        // The streams are appended to and synced independently, so after a
+        // crash some can end before records that others have successors of.
+        // Replaying the successors would recover writes without some earlier
+        // ones.
+        ROCKS_LOG_WARN(immutable_db_options_.info_log,
+                       "Records of sequence numbers %" PRIu64 " to %" PRIu64
+                       " are missing from the WALs before log #%" PRIu64,
+                       expected_seqno, next_seqno - 1, next->wal_number);
+        const WALRecoveryMode mode = immutable_db_options_.wal_recovery_mode;
+        if (mode == WALRecoveryMode::kAbsoluteConsistency) {
+          return Status::Corruption(
+              "Records missing from WAL streams before log #" +
+              std::to_string(next->wal_number));
+        }
+        if (mode != WALRecoveryMode::kSkipAnyCorruptedRecords) {
+          *stop_replay_for_corruption = true;
+          *corrupted_wal_number = next->wal_number;
+          if (mode == WALRecoveryMode::kPointInTimeRecovery &&
+              corrupted_wal_found != nullptr) {
+            *corrupted_wal_found = true;
+          }
+          break;
+        }
+      }
+    }
+    if (is_marker) {
+      // Markers hold no writes.
+      expected_seqno = std::max(expected_seqno, marker_next_seqno);
+      status = read_next(*next);
+      if (!status.ok()) {
+        return status;
+      }
+      continue;
+    }
+    if (next->record.size() >= WriteBatchInternal::kHeader) {
+      expected_seqno = std::max(
+          expected_seqno,
+          next_seqno + DecodeFixed32(next->record.data() + 8 /* count */));
+    }
+
+    auto logFileDropped = [this, next]() {
+      uint64_t bytes;
+      if (env_->GetFileSize(next->fname, &bytes).ok()) {
+        auto info_log = immutable_db_options_.info_log.get();
+        ROCKS_LOG_WARN(info_log, "%s: dropping %d bytes", next->fname.c_str(),
+                       static_cast<int>(bytes));
+      }
+    };
+    SequenceNumber prev_next_sequence = *next_sequence;
+    status = ProcessLogRecord(
+        next->record, next->reader, running_ts_sz, next->wal_number,
+        next->fname, read_only, job_id, logFileDropped, &next->reporter,
+        &next->record_checksum, &next->last_seqno_observed, next_sequence,
+        stop_replay_for_corruption, &next->status, stop_replay_by_wal_filter,
+        version_edits, flushed);
+    if (!status.ok()) {
+      return status;
+    }
+    status =
+        CheckSeqnoNotSetBackDuringRecovery(prev_next_sequence, *next_sequence);
+    if (!status.ok()) {
+      // Sequence number being set back indicates a serious software bug, the
+      // DB should not be opened in this case.
+      return status;
+    }
+    if (*stop_replay_for_corruption) {
+      break;
+    }
+    status = read_next(*next);
+    if (!status.ok()) {
+      return status;
+    }
+  }
+
+  for (auto& stream : streams) {
+    ROCKS_LOG_INFO(immutable_db_options_.info_log,
+                   "Recovered to log #%" PRIu64 " next seq #%" PRIu64,
+                   stream->wal_number, *next_sequence);
+    // Errors reported while processing the last record of a stream
+    status = handle_read_error(*stream);
+    if (!status.ok()) {
+      return status;
+    }
+  }
+
+  FinishLogFileProcessing(status, next_sequence);
+  return status;
+}
+
 Status DBImpl::ProcessLogFile(
     uint64_t wal_number, uint64_t min_wal_number, bool is_retry, bool read_only,
     int job_id, SequenceNumber* next_sequence, bool* stop_replay_for_corruption,
@@ -1810,7 +2077,13 @@ Status DBImpl::MaybeFlushFinalMemtableOrRestoreActiveLogFiles(
         // If flush happened in the middle of recovery (e.g. due to memtable
         // being full), we flush at the end. Otherwise we'll need to record
         // where we were on last flush, which make the logic complicated.
-        if (flushed || !immutable_db_options_.avoid_flush_during_recovery) {
+        // With more than one WAL stream now or in the WALs, flush so that
+        // no recovered WAL outlives this recovery. Otherwise the next
+        // recovery would replay WALs written with different numbers of
+        // streams, or with sequence numbers taken without WAL records.
+        if (flushed || !immutable_db_options_.avoid_flush_during_recovery ||
+            immutable_db_options_.num_wal_streams > 1 ||
+            versions_->num_wal_streams() > 1) {
           status = WriteLevel0TableForRecovery(job_id, cfd, cfd->mem(), edit);
           if (!status.ok()) {
             // Recovery failed
@@ -2372,6 +2645,52 @@ IOStatus DBImpl::CreateWAL(const WriteOptions& write_options,
   return io_s;
 }
 
+IOStatus DBImpl::CreateWalStreams(const WriteOptions& write_options,
+                                  size_t preallocate_block_size,
+                                  log::Writer* first_log,
+                                  SequenceNumber first_seq,
+                                  std::vector<log::Writer*>* new_logs) {
+  assert(first_log != nullptr);
+  assert(new_logs != nullptr);
+  assert(new_logs->empty());
+  if (immutable_db_options_.num_wal_streams == 1) {
+    return IOStatus::OK();
+  }
+  IOStatus io_s;
+  for (size_t i = 1; i < immutable_db_options_.num_wal_streams && io_s.ok();
+       ++i) {
+    log::Writer* new_log = nullptr;
+    // Streams are never recycled and predecessor WAL info is not tracked
+    // with more than one stream.
+    io_s = CreateWAL(write_options, versions_->NewFileNumber(),
+                     0 /*recycle_log_number*/, preallocate_block_size,
+                     PredecessorWALInfo() /* predecessor_wal_info */, &new_log);
+    if (new_log != nullptr) {
+      new_logs->push_back(new_log);
+    }
+  }
+  // Without a durable start of the oldest WAL generation, recovery could not
+  // tell whether its first records are lost. That costs a WAL and directory
+  // sync per generation.
+  if (io_s.ok()) {
+    io_s = WriteWalStreamsMarker(write_options, first_log, first_seq,
+                                 first_seq);
+  }
+  if (io_s.ok()) {
+    IOOptions opts;
+    io_s = WritableFileWriter::PrepareIOOptions(write_options, opts);
+    if (io_s.ok()) {
+      io_s = first_log->file()->Sync(opts, immutable_db_options_.use_fsync);
+    }
+  }
+  if (io_s.ok()) {
+    io_s = directories_.GetWalDir()->FsyncWithDirOptions(
+        IOOptions(), nullptr,
+        DirFsyncOptions(DirFsyncOptions::FsyncReason::kNewFileSynced));
+  }
+  return io_s;
+}
+
 void DBImpl::TrackExistingDataFiles(
     const std::vector<std::string>& existing_data_files) {
   TrackOrUntrackFiles(existing_data_files, /*track=*/true);
@@ -2471,6 +2790,12 @@ Status DBImpl::Open(const DBOptions& db_options, const std::string& dbname,
                         preallocate_block_size,
                         PredecessorWALInfo() /* predecessor_wal_info */,
                         &new_log);
+    std::vector<log::Writer*> new_stream_logs;
+    if (s.ok()) {
+      s = impl->CreateWalStreams(write_options, preallocate_block_size, new_log,
+                                 impl->versions_->LastSequence() + 1,
+                                 &new_stream_logs);
+    }
     if (s.ok()) {
       // Prevent log files created by previous instance from being recycled.
       // They might be in alive_log_file_, and might get recycled otherwise.
@@ -2479,13 +2804,26 @@ Status DBImpl::Open(const DBOptions& db_options, const std::string& dbname,
     if (s.ok()) {
       InstrumentedMutexLock wl(&impl->wal_write_mutex_);
       impl->cur_wal_number_ = new_log_number;
+      impl->newest_wal_number_ = new_log_number;
+      impl->wal_streams_next_seq_ = impl->versions_->LastSequence() + 1;
       assert(new_log != nullptr);
       assert(impl->logs_.empty());
       impl->logs_.emplace_back(new_log_number, new_log);
+      for (log::Writer* stream_log : new_stream_logs) {
+        impl->newest_wal_number_ = stream_log->get_log_number();
+        impl->logs_.emplace_back(impl->newest_wal_number_, stream_log);
+      }
+    } else {
+      for (log::Writer* stream_log : new_stream_logs) {
+        delete stream_log;
+      }
     }
 
     if (s.ok()) {
       impl->alive_wal_files_.emplace_back(impl->cur_wal_number_);
+      for (size_t i = 1; i < impl->logs_.size(); ++i) {
+        impl->alive_wal_files_.emplace_back(impl->logs_[i].number);
+      }
       // In WritePrepared there could be gap in sequence numbers. This breaks
       // the trick we use in kPointInTimeRecovery which assumes the first seq in
       // the log right after the corrupted log is one larger than the last seq
@@ -2700,6 +3038,7 @@ Status DBImpl::Open(const DBOptions& db_options, const std::string& dbname,
   }
   impl->options_mutex_.Unlock();
   if (s.ok()) {
+    impl->MaybeStartWalWriterThread();
     *dbptr = std::move(impl);
   } else {
     for (auto* h : *handles) {
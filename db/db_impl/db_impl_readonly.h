@@ -129,6 +129,11 @@ class DBImplReadOnly : public DBImpl {
     return Status::NotSupported("Not supported operation in read only mode.");
   }
 
+  Status ReserveFileNumbers(uint64_t /*num*/,
+                            uint64_t* /*first_file_number*/) override {
+    return Status::NotSupported("Not supported operation in read only mode.");
+  }
+
   using DB::CreateColumnFamilyWithImport;
   Status CreateColumnFamilyWithImport(
       const ColumnFamilyOptions& /*options*/,
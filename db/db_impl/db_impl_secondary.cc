@@ -9,6 +9,7 @@
 
 #include "db/arena_wrapped_db_iter.h"
 #include "db/merge_context.h"
+#include "db/wide/wide_columns_helper.h"
 #include "logging/auto_roll_logger.h"
 #include "logging/logging.h"
 #include "monitoring/perf_context_imp.h"
@@ -86,6 +87,10 @@ Status DBImplSecondary::FindAndRecoverLogFiles(
     JobContext* job_context) {
   assert(nullptr != cfds_changed);
   assert(nullptr != job_context);
+  if (versions_->num_wal_streams() > 1) {
+    return Status::NotSupported(
+        "Secondary instance does not support more than one WAL stream");
+  }
   Status s;
   std::vector<uint64_t> logs;
   s = FindNewLogNumbers(&logs);
@@ -478,6 +483,10 @@ Status DBImplSecondary::GetImpl(const ReadOptions& read_options,
     if (get_impl_options.value) {
       size = get_impl_options.value->size();
     } else if (get_impl_options.columns) {
+      if (s.ok() && read_options.wide_column_projection) {
+        s = WideColumnsHelper::ProjectColumns(
+            *read_options.wide_column_projection, get_impl_options.columns);
+      }
       size = get_impl_options.columns->serialized_size();
     } else if (get_impl_options.merge_operands) {
       *get_impl_options.number_of_operands =
@@ -790,6 +799,12 @@ Status DB::OpenAsSecondary(
     std::vector<ColumnFamilyHandle*>* handles, std::unique_ptr<DB>* dbptr) {
   *dbptr = nullptr;
 
+  if (db_options.num_wal_streams > 1) {
+    // Tailing the WALs would need to merge the streams by sequence number.
+    return Status::NotSupported(
+        "Secondary instance does not support more than one WAL stream");
+  }
+
   DBOptions tmp_opts(db_options);
   Status s;
   if (nullptr == tmp_opts.info_log) {
@@ -1057,6 +1072,8 @@ Status DB::OpenAndCompact(
       cf.options.table_factory = override_options.table_factory;
       cf.options.sst_partitioner_factory =
           override_options.sst_partitioner_factory;
+      cf.options.compaction_value_transformer =
+          override_options.compaction_value_transformer;
       cf.options.table_properties_collector_factories =
           override_options.table_properties_collector_factories;
 
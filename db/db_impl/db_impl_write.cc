@@ -17,6 +17,7 @@
 #include "options/options_helper.h"
 #include "test_util/sync_point.h"
 #include "util/cast_util.h"
+#include "util/coding.h"
 
 namespace ROCKSDB_NAMESPACE {
 // Convenience methods
@@ -459,6 +460,16 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
     return Status::NotSupported(
         "seq_per_batch currently does not honor post_memtable_callback");
   }
+  if (seq_per_batch_ && immutable_db_options_.num_wal_streams > 1) {
+    return Status::NotSupported(
+        "seq_per_batch is not compatible with more than one WAL stream");
+  }
+  if (write_options.disableWAL && immutable_db_options_.num_wal_streams > 1) {
+    // Recovery would take the sequence numbers of such writes for lost WAL
+    // records.
+    return Status::NotSupported(
+        "disableWAL is not compatible with more than one WAL stream");
+  }
   if (my_batch->HasDeleteRange() && immutable_db_options_.row_cache) {
     return Status::NotSupported(
         "DeleteRange is not compatible with row cache.");
@@ -604,6 +615,10 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
       *seq_used = w.sequence;
     }
     // write is complete and leader has updated sequence
+    if (w.FinalStatus().ok() && write_options.sync &&
+        immutable_db_options_.num_wal_streams > 1) {
+      return SyncWalStreams(write_options, w.sequence);
+    }
     return w.FinalStatus();
   }
   // else we are the leader of the write batch group
@@ -764,10 +779,29 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
         assert(wal_context.wal_file_number_size);
         wal_context.prev_size = wal_context.writer->file()->GetFileSize();
         PERF_TIMER_GUARD(write_wal_time);
-        io_s = WriteGroupToWAL(write_group, wal_context.writer, wal_used,
-                               wal_context.need_wal_sync,
-                               wal_context.need_wal_dir_sync, last_sequence + 1,
-                               *wal_context.wal_file_number_size);
+        const bool wal_streams = immutable_db_options_.num_wal_streams > 1;
+        if (wal_streams && wal_streams_next_seq_ != last_sequence + 1) {
+          // Sequence numbers were consumed without a WAL record since the
+          // last write group.
+          io_s = WriteWalStreamsMarker(write_options, wal_context.writer,
+                                       wal_streams_next_seq_,
+                                       last_sequence + 1);
+        }
+        if (io_s.ok()) {
+          io_s = WriteGroupToWAL(write_group, wal_context.writer, wal_used,
+                                 wal_context.need_wal_sync,
+                                 wal_context.need_wal_dir_sync,
+                                 last_sequence + 1,
+                                 *wal_context.wal_file_number_size);
+        }
+        if (io_s.ok() && wal_streams) {
+          wal_streams_next_seq_ = last_sequence + 1 + seq_inc;
+          InstrumentedMutexLock l(&wal_write_mutex_);
+          LogWriterNumber* log =
+              FindLogWriterNumber(wal_context.wal_file_number_size->number);
+          assert(log != nullptr);
+          log->AddedRecord(last_sequence + 1);
+        }
       }
     } else {
       if (status.ok() && !write_options.disableWAL) {
@@ -954,8 +988,10 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
     if (!w.status.ok()) {
       if (wal_context.prev_size < SIZE_MAX) {
         InstrumentedMutexLock l(&wal_write_mutex_);
-        if (logs_.back().number == wal_context.wal_file_number_size->number) {
-          logs_.back().SetAttemptTruncateSize(wal_context.prev_size);
+        LogWriterNumber* log =
+            FindLogWriterNumber(wal_context.wal_file_number_size->number);
+        if (log != nullptr && log->number >= cur_wal_number_) {
+          log->SetAttemptTruncateSize(wal_context.prev_size);
         }
       }
       HandleMemTableInsertFailure(w.status);
@@ -966,6 +1002,12 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
   if (status.ok()) {
     status = w.FinalStatus();
   }
+  if (status.ok() && write_options.sync &&
+      immutable_db_options_.num_wal_streams > 1) {
+    // Syncing after the write group lets the next groups, written to other
+    // streams, proceed and be synced in parallel.
+    status = SyncWalStreams(write_options, w.sequence);
+  }
   return status;
 }
 
@@ -977,124 +1019,30 @@ Status DBImpl::PipelinedWriteImpl(const WriteOptions& write_options,
   PERF_TIMER_GUARD(write_pre_and_post_process_time);
   StopWatch write_sw(immutable_db_options_.clock, stats_, DB_WRITE);
 
-  WriteContext write_context;
-
   WriteThread::Writer w(write_options, my_batch, callback, user_write_cb,
                         log_ref, disable_memtable, /*_batch_cnt=*/0,
                         /*_pre_release_callback=*/nullptr);
-  write_thread_.JoinBatchGroup(&w);
+  if (wal_writer_thread_started_.load(std::memory_order_acquire) &&
+      !w.no_slowdown) {
+    // Writers that may not wait cannot queue for the WAL writer thread,
+    // which could be blocked by a write stall.
+    write_thread_.JoinWalWriterQueue(&w);
+  } else {
+    write_thread_.JoinBatchGroup(&w);
+  }
   TEST_SYNC_POINT("DBImplWrite::PipelinedWriteImpl:AfterJoinBatchGroup");
   if (w.state == WriteThread::STATE_GROUP_LEADER) {
-    WriteThread::WriteGroup wal_write_group;
     if (w.callback && !w.callback->AllowWriteBatching()) {
       write_thread_.WaitForMemTableWriters();
     }
-    WalContext wal_context(!write_options.disableWAL && write_options.sync);
-    // PreprocessWrite does its own perf timing.
     PERF_TIMER_STOP(write_pre_and_post_process_time);
-    w.status = PreprocessWrite(write_options, &wal_context, &write_context);
+    PipelinedWriteGroupToWAL(write_options, &w, wal_used,
+                             /*placeholder_leader=*/false);
     PERF_TIMER_START(write_pre_and_post_process_time);
-
-    // This can set non-OK status if callback fail.
-    last_batch_group_size_ =
-        write_thread_.EnterAsBatchGroupLeader(&w, &wal_write_group);
-    const SequenceNumber current_sequence =
-        write_thread_.UpdateLastSequence(versions_->LastSequence()) + 1;
-    size_t total_count = 0;
-    size_t total_byte_size = 0;
-
-    if (w.status.ok()) {
-      SequenceNumber next_sequence = current_sequence;
-      for (auto* writer : wal_write_group) {
-        assert(writer);
-        if (writer->CheckCallback(this)) {
-          if (writer->ShouldWriteToMemtable()) {
-            writer->sequence = next_sequence;
-            size_t count = WriteBatchInternal::Count(writer->batch);
-            total_byte_size = WriteBatchInternal::AppendedByteSize(
-                total_byte_size, WriteBatchInternal::ByteSize(writer->batch));
-            next_sequence += count;
-            total_count += count;
-          }
-        }
-      }
-      // TODO: this use of operator bool on `tracer_` can avoid unnecessary lock
-      // grabs but does not seem thread-safe.
-      if (tracer_) {
-        InstrumentedMutexLock lock(&trace_mutex_);
-        if (tracer_ != nullptr && tracer_->IsWriteOrderPreserved()) {
-          for (auto* writer : wal_write_group) {
-            if (writer->CallbackFailed()) {
-              // When optimisitc txn conflict checking fails, we should
-              // not record to trace.
-              continue;
-            }
-            // TODO: maybe handle the tracing status?
-            tracer_->Write(writer->batch).PermitUncheckedError();
-          }
-        }
-      }
-      if (w.disable_wal) {
-        has_unpersisted_data_.store(true, std::memory_order_relaxed);
-      }
-      write_thread_.UpdateLastSequence(current_sequence + total_count - 1);
-    }
-
-    auto stats = default_cf_internal_stats_;
-    stats->AddDBStats(InternalStats::kIntStatsNumKeysWritten, total_count);
-    RecordTick(stats_, NUMBER_KEYS_WRITTEN, total_count);
-    stats->AddDBStats(InternalStats::kIntStatsBytesWritten, total_byte_size);
-    RecordTick(stats_, BYTES_WRITTEN, total_byte_size);
-    RecordInHistogram(stats_, BYTES_PER_WRITE, total_byte_size);
-
-    PERF_TIMER_STOP(write_pre_and_post_process_time);
-
-    IOStatus io_s;
-    io_s.PermitUncheckedError();  // Allow io_s to be uninitialized
-
-    if (w.status.ok() && !write_options.disableWAL) {
-      PERF_TIMER_GUARD(write_wal_time);
-      stats->AddDBStats(InternalStats::kIntStatsWriteDoneBySelf, 1);
-      RecordTick(stats_, WRITE_DONE_BY_SELF, 1);
-      if (wal_write_group.size > 1) {
-        stats->AddDBStats(InternalStats::kIntStatsWriteDoneByOther,
-                          wal_write_group.size - 1);
-        RecordTick(stats_, WRITE_DONE_BY_OTHER, wal_write_group.size - 1);
-      }
-      assert(wal_context.wal_file_number_size);
-      WalFileNumberSize& wal_file_number_size =
-          *(wal_context.wal_file_number_size);
-      io_s = WriteGroupToWAL(wal_write_group, wal_context.writer, wal_used,
-                             wal_context.need_wal_sync,
-                             wal_context.need_wal_dir_sync, current_sequence,
-                             wal_file_number_size);
-      w.status = io_s;
-    }
-
-    if (!io_s.ok()) {
-      // Check WriteToWAL status
-      WALIOStatusCheck(io_s);
-    } else if (!w.CallbackFailed()) {
-      WriteStatusCheck(w.status);
-    }
-
-    VersionEdit synced_wals;
-    if (wal_context.need_wal_sync) {
-      InstrumentedMutexLock l(&wal_write_mutex_);
-      if (w.status.ok()) {
-        MarkLogsSynced(cur_wal_number_, wal_context.need_wal_dir_sync,
-                       &synced_wals);
-      } else {
-        MarkLogsNotSynced(cur_wal_number_);
-      }
-    }
-    if (w.status.ok() && synced_wals.IsWalAddition()) {
-      InstrumentedMutexLock l(&mutex_);
-      // TODO: plumb Env::IOActivity, Env::IOPriority
-      const ReadOptions read_options;
-      w.status = ApplyWALToManifest(read_options, write_options, &synced_wals);
-    }
-    write_thread_.ExitAsBatchGroupLeader(wal_write_group, w.status);
+  } else if (wal_used != nullptr) {
+    // Written to the WAL by the leader of the group, which may be the WAL
+    // writer thread
+    *wal_used = w.wal_used;
   }
 
   // NOTE: the memtable_write_group is declared before the following
@@ -1166,6 +1114,172 @@ Status DBImpl::PipelinedWriteImpl(const WriteOptions& write_options,
   return w.FinalStatus();
 }
 
+void DBImpl::PipelinedWriteGroupToWAL(const WriteOptions& write_options,
+                                      WriteThread::Writer* w,
+                                      uint64_t* wal_used,
+                                      bool placeholder_leader) {
+  PERF_TIMER_GUARD(write_pre_and_post_process_time);
+  WriteContext write_context;
+  WriteThread::WriteGroup wal_write_group;
+  WalContext wal_context(!write_options.disableWAL && write_options.sync);
+  // PreprocessWrite does its own perf timing.
+  PERF_TIMER_STOP(write_pre_and_post_process_time);
+  w->status = PreprocessWrite(write_options, &wal_context, &write_context);
+  PERF_TIMER_START(write_pre_and_post_process_time);
+
+  // This can set non-OK status if callback fail.
+  last_batch_group_size_ =
+      write_thread_.EnterAsBatchGroupLeader(w, &wal_write_group);
+  const SequenceNumber current_sequence =
+      write_thread_.UpdateLastSequence(versions_->LastSequence()) + 1;
+  size_t total_count = 0;
+  size_t total_byte_size = 0;
+
+  if (w->status.ok()) {
+    SequenceNumber next_sequence = current_sequence;
+    for (auto* writer : wal_write_group) {
+      assert(writer);
+      if (writer->CheckCallback(this)) {
+        if (writer->ShouldWriteToMemtable()) {
+          writer->sequence = next_sequence;
+          size_t count = WriteBatchInternal::Count(writer->batch);
+          total_byte_size = WriteBatchInternal::AppendedByteSize(
+              total_byte_size, WriteBatchInternal::ByteSize(writer->batch));
+          next_sequence += count;
+          total_count += count;
+        }
+      }
+    }
+    // TODO: this use of operator bool on `tracer_` can avoid unnecessary lock
+    // grabs but does not seem thread-safe.
+    if (tracer_) {
+      InstrumentedMutexLock lock(&trace_mutex_);
+      if (tracer_ != nullptr && tracer_->IsWriteOrderPreserved()) {
+        for (auto* writer : wal_write_group) {
+          if (writer->CallbackFailed() ||
+              (placeholder_leader && writer == w)) {
+            // When optimisitc txn conflict checking fails, we should
+            // not record to trace.
+            continue;
+          }
+          // TODO: maybe handle the tracing status?
+          tracer_->Write(writer->batch).PermitUncheckedError();
+        }
+      }
+    }
+    if (w->disable_wal) {
+      has_unpersisted_data_.store(true, std::memory_order_relaxed);
+    }
+    write_thread_.UpdateLastSequence(current_sequence + total_count - 1);
+  }
+
+  auto stats = default_cf_internal_stats_;
+  stats->AddDBStats(InternalStats::kIntStatsNumKeysWritten, total_count);
+  RecordTick(stats_, NUMBER_KEYS_WRITTEN, total_count);
+  stats->AddDBStats(InternalStats::kIntStatsBytesWritten, total_byte_size);
+  RecordTick(stats_, BYTES_WRITTEN, total_byte_size);
+  RecordInHistogram(stats_, BYTES_PER_WRITE, total_byte_size);
+
+  PERF_TIMER_STOP(write_pre_and_post_process_time);
+
+  IOStatus io_s;
+  io_s.PermitUncheckedError();  // Allow io_s to be uninitialized
+
+  // The placeholder leader of the WAL writer thread has nothing to write by
+  // itself, so skip the WAL if none of the queued writers joined its group.
+  if (w->status.ok() && !write_options.disableWAL &&
+      !(placeholder_leader && wal_write_group.size == 1)) {
+    PERF_TIMER_GUARD(write_wal_time);
+    if (!placeholder_leader) {
+      stats->AddDBStats(InternalStats::kIntStatsWriteDoneBySelf, 1);
+      RecordTick(stats_, WRITE_DONE_BY_SELF, 1);
+    }
+    if (wal_write_group.size > 1) {
+      stats->AddDBStats(InternalStats::kIntStatsWriteDoneByOther,
+                        wal_write_group.size - 1);
+      RecordTick(stats_, WRITE_DONE_BY_OTHER, wal_write_group.size - 1);
+    }
+    assert(wal_context.wal_file_number_size);
+    WalFileNumberSize& wal_file_number_size =
+        *(wal_context.wal_file_number_size);
+    io_s = WriteGroupToWAL(wal_write_group, wal_context.writer, wal_used,
+                           wal_context.need_wal_sync,
+                           wal_context.need_wal_dir_sync, current_sequence,
+                           wal_file_number_size);
+    w->status = io_s;
+  }
+
+  if (!io_s.ok()) {
+    // Check WriteToWAL status
+    WALIOStatusCheck(io_s);
+  } else if (!w->CallbackFailed()) {
+    WriteStatusCheck(w->status);
+  }
+
+  VersionEdit synced_wals;
+  if (wal_context.need_wal_sync) {
+    InstrumentedMutexLock l(&wal_write_mutex_);
+    if (w->status.ok()) {
+      MarkLogsSynced(cur_wal_number_, wal_context.need_wal_dir_sync,
+                     &synced_wals);
+    } else {
+      MarkLogsNotSynced(cur_wal_number_);
+    }
+  }
+  if (w->status.ok() && synced_wals.IsWalAddition()) {
+    InstrumentedMutexLock l(&mutex_);
+    // TODO: plumb Env::IOActivity, Env::IOPriority
+    const ReadOptions read_options;
+    w->status = ApplyWALToManifest(read_options, write_options, &synced_wals);
+  }
+  write_thread_.ExitAsBatchGroupLeader(wal_write_group, w->status);
+}
+
+namespace {
+// Callback of the placeholder writer of the WAL writer thread. It keeps other
+// leaders from taking the placeholder into their groups.
+class WalWriterThreadCallback : public WriteCallback {
+ public:
+  Status Callback(DB* /*db*/) override { return Status::OK(); }
+
+  bool AllowWriteBatching() override { return false; }
+};
+}  // namespace
+
+void DBImpl::MaybeStartWalWriterThread() {
+  if (immutable_db_options_.enable_pipelined_write &&
+      immutable_db_options_.enable_wal_writer_thread) {
+    assert(!wal_writer_thread_.joinable());
+    wal_writer_thread_ = port::Thread([this]() { WalWriterThreadLoop(); });
+    wal_writer_thread_started_.store(true, std::memory_order_release);
+  }
+}
+
+void DBImpl::WalWriterThreadLoop() {
+  WalWriterThreadCallback callback;
+  WriteBatch placeholder_batch;
+  while (write_thread_.WaitForWalWriterQueue()) {
+    // Lead a batch group with a placeholder writer that does not write to
+    // the memtable, and take the queued writers into it. The queued writers
+    // then continue as memtable writers on their own threads.
+    WriteThread::Writer w(WriteOptions(), &placeholder_batch, &callback,
+                          /*_user_write_cb=*/nullptr, /*_log_ref=*/0,
+                          /*_disable_memtable=*/true);
+    write_thread_.JoinBatchGroup(&w);
+    assert(w.state == WriteThread::STATE_GROUP_LEADER);
+    TEST_SYNC_POINT("DBImpl::WalWriterThreadLoop:BeforeLink");
+    write_thread_.LinkWalWriterQueue(&w);
+    WriteOptions write_options;
+    write_options.sync = w.sync;
+    write_options.disableWAL = w.disable_wal;
+    write_options.rate_limiter_priority = w.rate_limiter_priority;
+    write_options.protection_bytes_per_key = w.protection_bytes_per_key;
+    PipelinedWriteGroupToWAL(write_options, &w, /*wal_used=*/nullptr,
+                             /*placeholder_leader=*/true);
+    assert(w.state == WriteThread::STATE_COMPLETED);
+  }
+}
+
 Status DBImpl::UnorderedWriteMemtable(const WriteOptions& write_options,
                                       WriteBatch* my_batch,
                                       WriteCallback* callback, uint64_t log_ref,
@@ -1574,7 +1688,10 @@ Status DBImpl::PreprocessWrite(const WriteOptions& write_options,
     }
   }
   InstrumentedMutexLock l(&wal_write_mutex_);
-  if (status.ok() && wal_context->need_wal_sync) {
+  const size_t num_wal_streams = immutable_db_options_.num_wal_streams;
+  // With more than one WAL stream, sync writes are synced by SyncWalStreams()
+  // after the write group.
+  if (status.ok() && wal_context->need_wal_sync && num_wal_streams == 1) {
     // Wait until the parallel syncs are finished. Any sync process has to sync
     // the front log too so it is enough to check the status of front()
     // We do a while loop since wal_sync_cv_ is signalled when any sync is
@@ -1596,10 +1713,24 @@ Status DBImpl::PreprocessWrite(const WriteOptions& write_options,
   } else {
     wal_context->need_wal_sync = false;
   }
-  wal_context->writer = logs_.back().writer;
   wal_context->need_wal_dir_sync =
       wal_context->need_wal_dir_sync && !wal_dir_synced_;
-  wal_context->wal_file_number_size = std::addressof(alive_wal_files_.back());
+  if (num_wal_streams > 1) {
+    assert(logs_.size() >= num_wal_streams);
+    assert(alive_wal_files_.size() >= num_wal_streams);
+    const size_t stream = next_wal_stream_++ % num_wal_streams;
+    auto& log = logs_[logs_.size() - num_wal_streams + stream];
+    auto& wal_file_number_size =
+        alive_wal_files_[alive_wal_files_.size() - num_wal_streams + stream];
+    assert(log.number == wal_file_number_size.number);
+    assert(log.number >= cur_wal_number_);
+    wal_context->writer = log.writer;
+    wal_context->wal_file_number_size = std::addressof(wal_file_number_size);
+  } else {
+    wal_context->writer = logs_.back().writer;
+    wal_context->wal_file_number_size =
+        std::addressof(alive_wal_files_.back());
+  }
 
   return status;
 }
@@ -1688,8 +1819,8 @@ IOStatus DBImpl::WriteToWAL(const WriteBatch& merged_batch,
     wal_write_mutex_.Unlock();
   }
   if (wal_used != nullptr) {
-    *wal_used = cur_wal_number_;
-    assert(*wal_used == wal_file_number_size.number);
+    *wal_used = wal_file_number_size.number;
+    assert(*wal_used == log_writer->get_log_number());
   }
   wals_total_size_.FetchAddRelaxed(log_entry.size());
   wal_file_number_size.AddSize(*log_size);
@@ -1698,6 +1829,60 @@ IOStatus DBImpl::WriteToWAL(const WriteBatch& merged_batch,
   return io_s;
 }
 
+namespace {
+// Prefix of the LogData blob of a WAL streams marker, see
+// DBImpl::WriteWalStreamsMarker()
+constexpr char kWalStreamsMarkerPrefix[] = "rocksdb.wal_streams.next_seq:";
+}  // anonymous namespace
+
+IOStatus DBImpl::WriteWalStreamsMarker(const WriteOptions& write_options,
+                                       log::Writer* log_writer,
+                                       SequenceNumber seq,
+                                       SequenceNumber next_seq) {
+  assert(immutable_db_options_.num_wal_streams > 1);
+  assert(seq <= next_seq);
+  // An empty write batch, so that it is a valid record for any reader. It
+  // takes no sequence number.
+  std::string blob(kWalStreamsMarkerPrefix);
+  PutFixed64(&blob, next_seq);
+  WriteBatch marker;
+  IOStatus io_s = status_to_io_status(marker.PutLogData(blob));
+  if (!io_s.ok()) {
+    return io_s;
+  }
+  WriteBatchInternal::SetSequence(&marker, seq);
+  Slice log_entry = WriteBatchInternal::Contents(&marker);
+  io_s = log_writer->AddRecord(write_options, log_entry, seq);
+  if (io_s.ok()) {
+    wals_total_size_.FetchAddRelaxed(log_entry.size());
+  }
+  return io_s;
+}
+
+bool DBImpl::DecodeWalStreamsMarker(const Slice& record,
+                                    SequenceNumber* next_seq) {
+  assert(next_seq != nullptr);
+  if (record.size() <= WriteBatchInternal::kHeader ||
+      DecodeFixed32(record.data() + 8) != 0 /* count */) {
+    return false;
+  }
+  Slice input(record.data() + WriteBatchInternal::kHeader,
+              record.size() - WriteBatchInternal::kHeader);
+  Slice blob;
+  if (input[0] != static_cast<char>(kTypeLogData)) {
+    return false;
+  }
+  input.remove_prefix(1);
+  const Slice prefix(kWalStreamsMarkerPrefix);
+  if (!GetLengthPrefixedSlice(&input, &blob) || !input.empty() ||
+      blob.size() != prefix.size() + sizeof(uint64_t) ||
+      !blob.starts_with(prefix)) {
+    return false;
+  }
+  *next_seq = DecodeFixed64(blob.data() + prefix.size());
+  return true;
+}
+
 IOStatus DBImpl::WriteGroupToWAL(const WriteThread::WriteGroup& write_group,
                                  log::Writer* log_writer, uint64_t* wal_used,
                                  bool need_wal_sync, bool need_wal_dir_sync,
@@ -1717,10 +1902,10 @@ IOStatus DBImpl::WriteGroupToWAL(const WriteThread::WriteGroup& write_group,
   }
 
   if (merged_batch == write_group.leader->batch) {
-    write_group.leader->wal_used = cur_wal_number_;
+    write_group.leader->wal_used = wal_file_number_size.number;
   } else if (write_with_wal > 1) {
     for (auto writer : write_group) {
-      writer->wal_used = cur_wal_number_;
+      writer->wal_used = wal_file_number_size.number;
     }
   }
 
@@ -2498,6 +2683,8 @@ Status DBImpl::SwitchMemtable(ColumnFamilyData* cfd, WriteContext* context,
   const WriteOptions write_options;
 
   log::Writer* new_log = nullptr;
+  // WALs of the other streams if DBOptions::num_wal_streams > 1
+  std::vector<log::Writer*> new_stream_logs;
   MemTable* new_mem = nullptr;
   IOStatus io_s;
 
@@ -2564,6 +2751,12 @@ Status DBImpl::SwitchMemtable(ColumnFamilyData* cfd, WriteContext* context,
     // of mutable_cf_options.write_buffer_size.
     io_s = CreateWAL(write_options, new_log_number, recycle_log_number,
                      preallocate_block_size, info, &new_log);
+    if (io_s.ok()) {
+      // The write thread is held, so no write takes a sequence number until
+      // the new WALs are in place.
+      io_s = CreateWalStreams(write_options, preallocate_block_size, new_log,
+                              versions_->LastSequence() + 1, &new_stream_logs);
+    }
     if (s.ok()) {
       s = io_s;
     }
@@ -2627,10 +2820,17 @@ Status DBImpl::SwitchMemtable(ColumnFamilyData* cfd, WriteContext* context,
     }
     if (s.ok()) {
       cur_wal_number_ = new_log_number;
+      newest_wal_number_ = new_log_number;
+      wal_streams_next_seq_ = versions_->LastSequence() + 1;
       wal_empty_ = true;
       wal_dir_synced_ = false;
       logs_.emplace_back(cur_wal_number_, new_log);
       alive_wal_files_.emplace_back(cur_wal_number_);
+      for (log::Writer* stream_log : new_stream_logs) {
+        newest_wal_number_ = stream_log->get_log_number();
+        logs_.emplace_back(newest_wal_number_, stream_log);
+        alive_wal_files_.emplace_back(newest_wal_number_);
+      }
     }
   }
 
@@ -2639,6 +2839,9 @@ Status DBImpl::SwitchMemtable(ColumnFamilyData* cfd, WriteContext* context,
     assert(creating_new_log);
     delete new_mem;
     delete new_log;
+    for (log::Writer* stream_log : new_stream_logs) {
+      delete stream_log;
+    }
     context->superversion_context.new_superversion.reset();
     // We may have lost data from the WritableFileBuffer in-memory buffer for
     // the current log, so treat it as a fatal error and set bg_error
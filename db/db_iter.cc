@@ -61,6 +61,7 @@ DBIter::DBIter(Env* _env, const ReadOptions& read_options,
       num_internal_keys_skipped_(0),
       iterate_lower_bound_(read_options.iterate_lower_bound),
       iterate_upper_bound_(read_options.iterate_upper_bound),
+      wide_column_projection_(read_options.wide_column_projection),
       cfh_(cfh),
       timestamp_ub_(read_options.timestamp),
       timestamp_lb_(read_options.iter_start_ts),
@@ -301,6 +302,10 @@ bool DBIter::SetValueAndColumnsFromEntity(Slice slice) {
     value_ = WideColumnsHelper::GetDefaultColumn(wide_columns_);
   }
 
+  if (wide_column_projection_) {
+    WideColumnsHelper::ProjectColumns(*wide_column_projection_, wide_columns_);
+  }
+
   return true;
 }
 
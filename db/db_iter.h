@@ -12,6 +12,7 @@
 #include <string>
 
 #include "db/db_impl/db_impl.h"
+#include "db/wide/wide_columns_helper.h"
 #include "memory/arena.h"
 #include "options/cf_options.h"
 #include "rocksdb/db.h"
@@ -371,6 +372,10 @@ class DBIter final : public Iterator {
 
     value_ = slice;
     wide_columns_.emplace_back(kDefaultWideColumnName, slice);
+    if (wide_column_projection_) {
+      WideColumnsHelper::ProjectColumns(*wide_column_projection_,
+                                        wide_columns_);
+    }
   }
 
   bool SetValueAndColumnsFromBlobImpl(const Slice& user_key,
@@ -485,6 +490,8 @@ class DBIter final : public Iterator {
   uint64_t num_internal_keys_skipped_;
   const Slice* iterate_lower_bound_;
   const Slice* iterate_upper_bound_;
+  // Columns to expose, see `ReadOptions::wide_column_projection`
+  const std::vector<Slice>* wide_column_projection_;
 
   // The prefix of the seek key. It is only used when prefix_same_as_start_
   // is true and prefix extractor is not null. In Next() or Prev(), current keys
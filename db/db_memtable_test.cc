@@ -424,6 +424,177 @@ TEST_F(DBMemTableTest, IntegrityChecks) {
     ASSERT_FALSE(iter->Valid());
   }
 }
+
+TEST_F(DBMemTableTest, RangePartitionedSkipList) {
+  for (bool use_point_index : {false, true}) {
+    for (bool learn_boundaries : {false, true}) {
+      SCOPED_TRACE("use_point_index=" + std::to_string(use_point_index) +
+                   " learn_boundaries=" + std::to_string(learn_boundaries));
+      Options options = CurrentOptions();
+      options.allow_concurrent_memtable_write = true;
+      RangePartitionedSkipListRepOptions rep_opts;
+      if (!learn_boundaries) {
+        // Out of order, and including a boundary with no keys after it
+        rep_opts.partition_boundaries = {"key03", "key01", "key02", "zzz"};
+      }
+      rep_opts.point_index_bucket_count = use_point_index ? 1024 : 0;
+      options.memtable_factory.reset(
+          NewRangePartitionedSkipListRepFactory(rep_opts));
+      DestroyAndReopen(options);
+
+      const int kNumThreads = 4;
+      const int kKeysPerThread = 2500;
+      auto key = [](int i) {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "key%05d", i);
+        return std::string(buf);
+      };
+      auto write_all = [&](const std::string& value_prefix) {
+        std::vector<port::Thread> threads;
+        for (int t = 0; t < kNumThreads; ++t) {
+          threads.emplace_back([&, t]() {
+            for (int i = t; i < kNumThreads * kKeysPerThread;
+                 i += kNumThreads) {
+              ASSERT_OK(Put(key(i), value_prefix + std::to_string(i)));
+            }
+          });
+        }
+        for (auto& thread : threads) {
+          thread.join();
+        }
+      };
+      write_all("v1_");
+      if (learn_boundaries) {
+        // Boundaries are learned when the memtable becomes immutable
+        ASSERT_OK(Flush());
+        write_all("v1_");
+      }
+      const Snapshot* snapshot = db_->GetSnapshot();
+      write_all("v2_");
+      ASSERT_OK(Delete(key(7)));
+
+      for (int i = 0; i < kNumThreads * kKeysPerThread; ++i) {
+        if (i == 7) {
+          ASSERT_EQ("NOT_FOUND", Get(key(i)));
+        } else {
+          ASSERT_EQ("v2_" + std::to_string(i), Get(key(i)));
+        }
+        ASSERT_EQ("v1_" + std::to_string(i), Get(key(i), snapshot));
+      }
+      ASSERT_EQ("NOT_FOUND", Get("key"));
+      ASSERT_EQ("NOT_FOUND", Get("key02"));
+      ASSERT_EQ("NOT_FOUND", Get("zzzz"));
+
+      // Ordered iteration across partitions, in both directions
+      std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+      int expected = 0;
+      for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++expected) {
+        if (expected == 7) {
+          ++expected;
+        }
+        ASSERT_EQ(key(expected), iter->key().ToString());
+      }
+      ASSERT_OK(iter->status());
+      ASSERT_EQ(kNumThreads * kKeysPerThread, expected);
+      for (iter->SeekToLast(); iter->Valid(); iter->Prev()) {
+        --expected;
+        if (expected == 7) {
+          --expected;
+        }
+        ASSERT_EQ(key(expected), iter->key().ToString());
+      }
+      ASSERT_OK(iter->status());
+      ASSERT_EQ(0, expected);
+
+      iter->Seek("key05");
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(key(5000), iter->key().ToString());
+      iter->SeekForPrev("key05");
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(key(4999), iter->key().ToString());
+      iter->Seek("zz");
+      ASSERT_FALSE(iter->Valid());
+      ASSERT_OK(iter->status());
+      iter.reset();
+      db_->ReleaseSnapshot(snapshot);
+    }
+  }
+}
+
+TEST_F(DBMemTableTest, RangePartitionedSkipListPointIndexRequirements) {
+  Options options = CurrentOptions();
+  options.comparator = BytewiseComparatorWithU64Ts();
+  RangePartitionedSkipListRepOptions rep_opts;
+  rep_opts.point_index_bucket_count = 1024;
+  options.memtable_factory.reset(
+      NewRangePartitionedSkipListRepFactory(rep_opts));
+  ASSERT_TRUE(TryReopen(options).IsNotSupported());
+
+  // The point index is off by default
+  options.memtable_factory.reset(NewRangePartitionedSkipListRepFactory());
+  Destroy(options);
+  ASSERT_OK(TryReopen(options));
+}
+
+TEST_F(DBMemTableTest, RangePartitionedSkipListSmallWriteBuffer) {
+  Options options = CurrentOptions();
+  options.memtable_factory.reset(NewRangePartitionedSkipListRepFactory());
+  options.write_buffer_size = 1 << 20;
+  options.disable_auto_compactions = true;
+  DestroyAndReopen(options);
+
+  // A few hundred KB of writes fit in a single memtable
+  const int kNumKeys = 1000;
+  for (int i = 0; i < kNumKeys; ++i) {
+    ASSERT_OK(Put(Key(i), std::string(100, 'v')));
+  }
+  ASSERT_OK(dbfull()->TEST_WaitForFlushMemTable());
+  ASSERT_EQ(0, NumTableFilesAtLevel(0));
+
+  ASSERT_OK(Flush());
+  ASSERT_EQ(1, NumTableFilesAtLevel(0));
+  for (int i = 0; i < kNumKeys; ++i) {
+    ASSERT_EQ(std::string(100, 'v'), Get(Key(i)));
+  }
+}
+
+TEST_F(DBMemTableTest, RangePartitionedSkipListMemoryUsage) {
+  InternalKeyComparator icmp(BytewiseComparator());
+  MemTable::KeyComparator cmp(icmp);
+  Arena arena;
+  std::unique_ptr<MemTableRepFactory> factory(
+      NewRangePartitionedSkipListRepFactory());
+  std::unique_ptr<MemTableRep> rep(
+      factory->CreateMemTableRep(cmp, &arena, nullptr, nullptr));
+  const size_t empty_usage = rep->ApproximateMemoryUsage();
+  ASSERT_GT(empty_usage, 0);
+
+  // About one in 256 inserted keys is sampled for learning boundaries
+  const int kNumKeys = 100000;
+  for (int i = 0; i < kNumKeys; ++i) {
+    InternalKey ikey(Key(i), i + 1, kTypeValue);
+    Slice encoded = ikey.Encode();
+    char* buf = nullptr;
+    KeyHandle handle =
+        rep->Allocate(VarintLength(encoded.size()) + encoded.size(), &buf);
+    char* p = EncodeVarint32(buf, static_cast<uint32_t>(encoded.size()));
+    memcpy(p, encoded.data(), encoded.size());
+    rep->Insert(handle);
+  }
+  const size_t sampled_usage = rep->ApproximateMemoryUsage();
+  ASSERT_GT(sampled_usage, empty_usage + 100 * Key(0).size());
+
+  // The samples are released once boundaries are learned
+  rep->MarkReadOnly();
+  ASSERT_EQ(empty_usage, rep->ApproximateMemoryUsage());
+
+  // The next memtable holds the learned boundaries and its partitions
+  std::unique_ptr<MemTableRep> next_rep(
+      factory->CreateMemTableRep(cmp, &arena, nullptr, nullptr));
+  ASSERT_GT(next_rep->ApproximateMemoryUsage(),
+            empty_usage + 15 * Key(0).size());
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
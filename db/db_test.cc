@@ -4188,6 +4188,52 @@ TEST_F(DBTest, FIFOCompactionStyleWithCompactionAndDelete) {
   }
 }
 
+TEST_F(DBTest, FIFOCompactionRetainsRecentlyReadFiles) {
+  Options options;
+  options.compaction_style = kCompactionStyleFIFO;
+  options.write_buffer_size = 1 << 20;
+  options.compaction_options_fifo.max_table_files_size = 10 << 20;
+  options.compaction_options_fifo.min_reads_to_retain = 1;
+  options.compression = kNoCompression;
+  options.create_if_missing = true;
+  options = CurrentOptions(options);
+  DestroyAndReopen(options);
+
+  // Four files of ~100KB, with distinct keys
+  Random rnd(301);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 100; j++) {
+      ASSERT_OK(Put(Key(i * 100 + j), rnd.RandomString(1000)));
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_EQ(NumTableFilesAtLevel(0), 4);
+
+  // Keep reading the oldest file, enough for its reads to be sampled
+  for (int n = 0; n < 200; n++) {
+    for (int j = 0; j < 100; j++) {
+      ASSERT_NE("NOT_FOUND", Get(Key(j)));
+    }
+  }
+
+  // Dropping the two next oldest files is enough to meet the new limit
+  ASSERT_OK(dbfull()->SetOptions(
+      {{"compaction_options_fifo",
+        "{max_table_files_size=256000;min_reads_to_retain=1;}"}}));
+  ASSERT_OK(Put(Key(1000), "v"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+
+  ASSERT_EQ(NumTableFilesAtLevel(0), 3);
+  for (int j = 0; j < 100; j++) {
+    ASSERT_NE("NOT_FOUND", Get(Key(j)));
+    ASSERT_EQ("NOT_FOUND", Get(Key(100 + j)));
+    ASSERT_EQ("NOT_FOUND", Get(Key(200 + j)));
+    ASSERT_NE("NOT_FOUND", Get(Key(300 + j)));
+  }
+  ASSERT_EQ("v", Get(Key(1000)));
+}
+
 // Check that FIFO-with-TTL is not supported with max_open_files != -1.
 // Github issue #8014
 TEST_F(DBTest, FIFOCompactionWithTTLAndMaxOpenFilesTest) {
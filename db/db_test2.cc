@@ -1883,6 +1883,145 @@ TEST_F(DBTest2, CompressionOptions) {
   }
 }
 
+TEST_F(DBTest2, AdaptiveCompressionBudgetPctValidation) {
+  Options options = CurrentOptions();
+  options.compression_opts.adaptive_compression_budget_pct = 101;
+  ASSERT_TRUE(TryReopen(options).IsInvalidArgument());
+  options.compression_opts.adaptive_compression_budget_pct = 0;
+  options.bottommost_compression_opts.adaptive_compression_budget_pct = 101;
+  options.bottommost_compression_opts.enabled = true;
+  ASSERT_TRUE(TryReopen(options).IsInvalidArgument());
+
+  options.bottommost_compression_opts.adaptive_compression_budget_pct = 100;
+  DestroyAndReopen(options);
+  ASSERT_OK(dbfull()->SetOptions(
+      {{"compression_opts", "{adaptive_compression_budget_pct=100}"}}));
+  ASSERT_TRUE(
+      dbfull()
+          ->SetOptions(
+              {{"compression_opts", "{adaptive_compression_budget_pct=101}"}})
+          .IsInvalidArgument());
+  ASSERT_EQ(100, dbfull()
+                     ->GetOptions()
+                     .compression_opts.adaptive_compression_budget_pct);
+}
+
+TEST_F(DBTest2, PreCompressionTransform) {
+  // Table files transforming data blocks are covered by
+  // BlockBasedTableTest.PreCompressionTransform; this covers the DB: blob
+  // files and option validation.
+  std::vector<CompressionType> compressions = GetSupportedCompressions();
+  if (compressions.empty()) {
+    ROCKSDB_GTEST_SKIP("Test requires compression support");
+    return;
+  }
+  // Every other value goes to a blob file
+  std::vector<std::string> values;
+  for (int i = 0; i < 20; i++) {
+    std::vector<float> floats(i % 2 == 0 ? 1001 : 2001);
+    for (size_t j = 0; j < floats.size(); j++) {
+      floats[j] = 1000.0f + static_cast<float>(i * 2000 + j) / 64;
+    }
+    values.emplace_back(reinterpret_cast<const char*>(floats.data()),
+                        floats.size() * sizeof(float) - 1);
+  }
+
+  for (CompressionType compression : compressions) {
+    SCOPED_TRACE(CompressionTypeToString(compression));
+    Options options = CurrentOptions();
+    BlockBasedTableOptions table_options;
+    table_options.format_version = 7;
+    options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+    options.compression = compression;
+    options.compression_opts.pre_compression_transform =
+        PreCompressionTransform::kXorDelta;
+    options.compression_opts.pre_compression_element_size = 4;
+    options.enable_blob_files = true;
+    options.min_blob_size = 6000;
+    options.blob_compression_type = compression;
+    DestroyAndReopen(options);
+
+    for (size_t i = 0; i < values.size(); i++) {
+      ASSERT_OK(Put(Key(static_cast<int>(i)), values[i]));
+    }
+    ASSERT_OK(Flush());
+
+    // The transform is recorded with the data, so reading does not depend
+    // on the options
+    options.compression_opts.pre_compression_transform =
+        PreCompressionTransform::kNone;
+    Reopen(options);
+    for (size_t i = 0; i < values.size(); i++) {
+      ASSERT_EQ(values[i], Get(Key(static_cast<int>(i))));
+    }
+  }
+
+  Options options = CurrentOptions();
+  options.compression_opts.pre_compression_transform =
+      PreCompressionTransform::kByteShuffle;
+  options.compression_opts.pre_compression_element_size = 3;
+  ASSERT_TRUE(TryReopen(options).IsInvalidArgument());
+  // Requires format_version 7
+  BlockBasedTableOptions table_options;
+  table_options.format_version = 6;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  options.compression_opts.pre_compression_element_size = 4;
+  ASSERT_TRUE(TryReopen(options).IsInvalidArgument());
+}
+
+TEST_F(DBTest2, SharedCompressionDict) {
+  // Building tables with a shared dictionary is covered by
+  // BlockBasedTableTest.SharedCompressionDict; this covers the flushes and
+  // compactions of a column family sharing its registry.
+  if (!ZSTD_Supported()) {
+    ROCKSDB_GTEST_SKIP("Test requires ZSTD support");
+    return;
+  }
+  Options options = CurrentOptions();
+  options.compression = kZSTD;
+  options.compression_opts.max_dict_bytes = 4096;
+  options.compression_opts.use_shared_dict = true;
+  options.disable_auto_compactions = true;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 1024;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  auto get_dict_ids = [&]() {
+    TablePropertiesCollection props;
+    EXPECT_OK(db_->GetPropertiesOfAllTables(&props));
+    std::map<std::string, uint64_t> ids;
+    for (const auto& file_props : props) {
+      ids[file_props.first] = file_props.second->compression_dict_id;
+    }
+    std::vector<uint64_t> result;
+    for (const auto& id : ids) {
+      result.push_back(id.second);
+    }
+    return result;
+  };
+
+  Random rnd(301);
+  for (int file = 0; file < 3; file++) {
+    for (int i = 0; i < 100; i++) {
+      ASSERT_OK(Put(Key(file * 100 + i),
+                    "value" + std::to_string(i % 7) + rnd.RandomString(8) +
+                        std::string(40, 'a' + i % 5)));
+    }
+    ASSERT_OK(Flush());
+  }
+  std::vector<uint64_t> ids = get_dict_ids();
+  ASSERT_EQ(ids.size(), 3);
+  ASSERT_NE(ids[1], 0);
+  ASSERT_EQ(ids[1], ids[2]);
+
+  // Compaction uses the dictionary trained by the flushes
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  std::vector<uint64_t> compacted_ids = get_dict_ids();
+  ASSERT_EQ(compacted_ids.size(), 1);
+  ASSERT_EQ(compacted_ids[0], ids[1]);
+}
+
 TEST_F(DBTest2, CompressionManagerWrapper) {
   // Test that we can use a custom CompressionManager to wrap the built-in
   // CompressionManager, thus adopting a custom *strategy* based on existing
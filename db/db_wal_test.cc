@@ -1473,6 +1473,199 @@ TEST_F(DBWALTest, SyncMultipleLogs) {
   ASSERT_OK(dbfull()->SyncWAL());
 }
 
+TEST_F(DBWALTest, WalStreams) {
+  constexpr size_t kNumStreams = 4;
+  constexpr int kNumThreads = 4;
+  constexpr int kWritesPerThread = 100;
+
+  Options options = CurrentOptions();
+  options.num_wal_streams = kNumStreams;
+  options.write_buffer_size = 64 << 10;
+  DestroyAndReopen(options);
+
+  VectorWalPtr wal_files;
+  ASSERT_OK(dbfull()->GetSortedWalFiles(wal_files));
+  ASSERT_EQ(kNumStreams, wal_files.size());
+
+  // Consecutive write groups go to different streams, so recovery has to
+  // merge them by sequence number to get the latest value.
+  for (int i = 0; i < 20; ++i) {
+    ASSERT_OK(Put("key", "v" + std::to_string(i)));
+  }
+
+  std::vector<port::Thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      Random rnd(301 + t);
+      for (int i = 0; i < kWritesPerThread; ++i) {
+        WriteOptions wo;
+        wo.sync = (i % 2) == 0;
+        ASSERT_OK(db_->Put(wo, Key(t * kWritesPerThread + i),
+                           rnd.RandomString(1000)));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  std::vector<std::string> values;
+  for (int i = 0; i < kNumThreads * kWritesPerThread; ++i) {
+    values.push_back(Get(Key(i)));
+  }
+
+  // File ingestion takes a sequence number without a WAL record when the
+  // file overlaps the DB; that must not stop recovery of the writes after it.
+  const std::string external_file = dbname_ + "/ingested.sst";
+  {
+    SstFileWriter sst_file_writer(EnvOptions(), options);
+    ASSERT_OK(sst_file_writer.Open(external_file));
+    ASSERT_OK(sst_file_writer.Put("ingested", "v"));
+    ASSERT_OK(sst_file_writer.Put("key", "v19"));
+    ASSERT_OK(sst_file_writer.Finish());
+  }
+  ASSERT_OK(db_->IngestExternalFile({external_file}, IngestExternalFileOptions()));
+  ASSERT_OK(Put("after_ingestion", "v"));
+  SequenceNumber last_sequence = db_->GetLatestSequenceNumber();
+
+  // Recovery replays the WALs of several generations and flushes memtables
+  // in between. The number of streams recorded in the MANIFEST, not the one
+  // reopened with, tells how to replay the WALs.
+  std::string last_value = "v19";
+  for (size_t num_streams : {kNumStreams, size_t{2}, size_t{1}, kNumStreams}) {
+    options.num_wal_streams = num_streams;
+    Reopen(options);
+    ASSERT_EQ(last_value, Get("key"));
+    ASSERT_EQ("v", Get("ingested"));
+    ASSERT_EQ("v", Get("after_ingestion"));
+    for (int i = 0; i < kNumThreads * kWritesPerThread; ++i) {
+      ASSERT_EQ(values[i], Get(Key(i)));
+    }
+    ASSERT_EQ(last_sequence, db_->GetLatestSequenceNumber());
+
+    last_value = "v" + std::to_string(num_streams);
+    for (int i = 0; i < 10; ++i) {
+      ASSERT_OK(Put("key", last_value));
+    }
+    last_sequence = db_->GetLatestSequenceNumber();
+  }
+
+  std::unique_ptr<TransactionLogIterator> iter;
+  ASSERT_TRUE(db_->GetUpdatesSince(0, &iter).IsNotSupported());
+  WriteOptions no_wal;
+  no_wal.disableWAL = true;
+  ASSERT_TRUE(db_->Put(no_wal, "key", "v").IsNotSupported());
+
+  options.num_wal_streams = 0;
+  ASSERT_TRUE(TryReopen(options).IsInvalidArgument());
+  options.num_wal_streams = kNumStreams;
+  options.enable_pipelined_write = true;
+  ASSERT_TRUE(TryReopen(options).IsInvalidArgument());
+  options.enable_pipelined_write = false;
+  options.manual_wal_flush = true;
+  ASSERT_TRUE(TryReopen(options).IsInvalidArgument());
+}
+
+TEST_F(DBWALTest, WalStreamsTruncatedStream) {
+  constexpr size_t kNumStreams = 4;
+  constexpr int kNumKeys = 20;
+  constexpr int kFirstLostKey = 10;
+
+  Options options = CurrentOptions();
+  options.num_wal_streams = kNumStreams;
+  DestroyAndReopen(options);
+
+  VectorWalPtr wal_files;
+  ASSERT_OK(dbfull()->GetSortedWalFiles(wal_files));
+  ASSERT_EQ(kNumStreams, wal_files.size());
+  auto get_wal_sizes = [&]() {
+    std::vector<uint64_t> sizes;
+    for (const auto& wal_file : wal_files) {
+      uint64_t size = 0;
+      EXPECT_OK(env_->GetFileSize(
+          LogFileName(dbname_, wal_file->LogNumber()), &size));
+      sizes.push_back(size);
+    }
+    return sizes;
+  };
+
+  // Each write is its own write group, so the writes go to all streams.
+  std::string lost_wal;
+  uint64_t lost_wal_size = 0;
+  for (int i = 0; i < kNumKeys; ++i) {
+    const std::vector<uint64_t> sizes_before = get_wal_sizes();
+    ASSERT_OK(Put(Key(i), "v"));
+    if (i == kFirstLostKey) {
+      const std::vector<uint64_t> sizes_after = get_wal_sizes();
+      for (size_t j = 0; j < wal_files.size(); ++j) {
+        if (sizes_after[j] != sizes_before[j]) {
+          lost_wal = LogFileName(dbname_, wal_files[j]->LogNumber());
+          lost_wal_size = sizes_before[j];
+        }
+      }
+    }
+  }
+  ASSERT_FALSE(lost_wal.empty());
+  Close();
+
+  // Simulate a stream losing its unsynced tail while the other streams kept
+  // later writes.
+  ASSERT_OK(test::TruncateFile(env_, lost_wal, lost_wal_size));
+
+  options.wal_recovery_mode = WALRecoveryMode::kAbsoluteConsistency;
+  ASSERT_TRUE(TryReopen(options).IsCorruption());
+
+  // Only the writes before the first lost one are recovered.
+  options.wal_recovery_mode = WALRecoveryMode::kPointInTimeRecovery;
+  Reopen(options);
+  for (int i = 0; i < kNumKeys; ++i) {
+    ASSERT_EQ(i < kFirstLostKey ? "v" : "NOT_FOUND", Get(Key(i)));
+  }
+  ASSERT_OK(Put(Key(kNumKeys), "v"));
+  Reopen(options);
+  ASSERT_EQ("v", Get(Key(kNumKeys)));
+  ASSERT_EQ("NOT_FOUND", Get(Key(kFirstLostKey)));
+}
+
+TEST_F(DBWALTest, WalStreamsSync) {
+  constexpr size_t kNumStreams = 4;
+
+  std::unique_ptr<FaultInjectionTestEnv> fault_env(
+      new FaultInjectionTestEnv(env_));
+  Options options = CurrentOptions();
+  options.env = fault_env.get();
+  options.num_wal_streams = kNumStreams;
+  options.statistics = CreateDBStatistics();
+  DestroyAndReopen(options);
+
+  WriteOptions sync_wo;
+  sync_wo.sync = true;
+  for (int i = 0; i < 8; ++i) {
+    ASSERT_OK(Put(Key(i), "v"));
+  }
+  ASSERT_EQ(0, options.statistics->getTickerCount(WAL_FILE_SYNCED));
+  // A sync write makes all earlier writes durable, so it syncs every stream.
+  ASSERT_OK(Put(Key(8), "v", sync_wo));
+  ASSERT_EQ(kNumStreams,
+            options.statistics->getTickerCount(WAL_FILE_SYNCED));
+  // Now only the stream written by the next sync write has unsynced records.
+  ASSERT_OK(Put(Key(9), "v", sync_wo));
+  ASSERT_EQ(kNumStreams + 1,
+            options.statistics->getTickerCount(WAL_FILE_SYNCED));
+  ASSERT_OK(Put(Key(10), "v"));
+
+  // Simulate a crash losing unsynced data.
+  fault_env->SetFilesystemActive(false);
+  Close();
+  fault_env->ResetState();
+  Reopen(options);
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ("v", Get(Key(i)));
+  }
+  ASSERT_EQ("NOT_FOUND", Get(Key(10)));
+  // Destroy DB before destruct fault_env.
+  Destroy(options);
+}
+
 TEST_F(DBWALTest, DISABLED_RecycleMultipleWalsCrash) {
   Options options = CurrentOptions();
   options.max_write_buffer_number = 5;
@@ -493,6 +493,131 @@ TEST_F(DBWriteTestUnparameterized, PipelinedWriteRace) {
   ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->ClearAllCallBacks();
 }
 
+TEST_F(DBWriteTestUnparameterized, WalWriterThread) {
+  Options options = GetDefaultOptions();
+  options.create_if_missing = true;
+  options.enable_pipelined_write = true;
+  options.enable_wal_writer_thread = true;
+  options.statistics = CreateDBStatistics();
+  DestroyAndReopen(options);
+
+  std::atomic<int> leader_count{0};
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "WriteThread::LinkWalWriterQueue:End",
+      [&](void* /*arg*/) { leader_count++; });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+
+  constexpr int kNumThreads = 8;
+  constexpr int kNumKeysPerThread = 200;
+  std::vector<port::Thread> threads;
+  for (int t = 0; t < kNumThreads; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < kNumKeysPerThread; i++) {
+        WriteOptions wo;
+        // Mix in sync writes, which make the whole group sync.
+        wo.sync = (i % 50) == 0;
+        std::string key = "key" + std::to_string(t * kNumKeysPerThread + i);
+        ASSERT_OK(dbfull()->Put(wo, key, "value" + std::to_string(i)));
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  // All the writes were queued, so the WAL writer thread wrote all of them.
+  constexpr int kNumKeys = kNumThreads * kNumKeysPerThread;
+  ASSERT_EQ(kNumKeys, options.statistics->getTickerCount(WRITE_DONE_BY_OTHER));
+  ASSERT_EQ(0, options.statistics->getTickerCount(WRITE_DONE_BY_SELF));
+  ASSERT_GT(leader_count.load(), 0);
+  ASSERT_LE(leader_count.load(), kNumKeys);
+
+  // A write that must not wait bypasses the queue.
+  WriteOptions no_slowdown;
+  no_slowdown.no_slowdown = true;
+  ASSERT_OK(dbfull()->Put(no_slowdown, "no_slowdown", "value"));
+  ASSERT_EQ(1, options.statistics->getTickerCount(WRITE_DONE_BY_SELF));
+
+  ASSERT_EQ(static_cast<SequenceNumber>(kNumKeys + 1),
+            dbfull()->GetLatestSequenceNumber());
+
+  // Queued writes report the WAL the WAL writer thread wrote them to
+  ASSERT_OK(dbfull()->TEST_SwitchWAL());
+  WriteBatch batch;
+  ASSERT_OK(batch.Put("wal_used", "value"));
+  uint64_t wal_used = 0;
+  ASSERT_OK(dbfull()->WriteImpl(WriteOptions(), &batch, /*callback=*/nullptr,
+                                /*user_write_cb=*/nullptr, &wal_used));
+  ASSERT_EQ(dbfull()->TEST_LogfileNumber(), wal_used);
+  ASSERT_EQ(kNumKeys + 1,
+            options.statistics->getTickerCount(WRITE_DONE_BY_OTHER));
+
+  // Recover all the writes from the WAL.
+  Reopen(options);
+  for (int k = 0; k < kNumKeys; k++) {
+    ASSERT_EQ("value" + std::to_string(k % kNumKeysPerThread),
+              Get("key" + std::to_string(k)));
+  }
+  ASSERT_EQ("value", Get("no_slowdown"));
+
+  options.enable_pipelined_write = false;
+  ASSERT_TRUE(TryReopen(options).IsInvalidArgument());
+}
+
+TEST_F(DBWriteTestUnparameterized, WalWriterThreadGroupsQueuedWriters) {
+  Options options = GetDefaultOptions();
+  options.create_if_missing = true;
+  options.enable_pipelined_write = true;
+  options.enable_wal_writer_thread = true;
+  options.statistics = CreateDBStatistics();
+  DestroyAndReopen(options);
+
+  // The WAL writer thread takes the queue only once all the writers are in
+  std::atomic<int> num_queued{0};
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->LoadDependency(
+      {{"DBWriteTestUnparameterized::WalWriterThreadGroupsQueuedWriters:"
+        "AllQueued",
+        "DBImpl::WalWriterThreadLoop:BeforeLink"}});
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "WriteThread::JoinWalWriterQueue:Wait",
+      [&](void* /*arg*/) { num_queued++; });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+
+  // Together well under max_write_batch_group_size_bytes, but each more than
+  // the growth allowed for a small leading write
+  constexpr int kNumThreads = 8;
+  const std::string value(100 << 10, 'v');
+  std::vector<port::Thread> threads;
+  for (int t = 0; t < kNumThreads; t++) {
+    threads.emplace_back([&, t]() {
+      ASSERT_OK(dbfull()->Put(WriteOptions(), "key" + std::to_string(t),
+                              value));
+    });
+  }
+  while (num_queued.load() < kNumThreads) {
+    env_->SleepForMicroseconds(1000);
+  }
+  TEST_SYNC_POINT(
+      "DBWriteTestUnparameterized::WalWriterThreadGroupsQueuedWriters:"
+      "AllQueued");
+  for (auto& t : threads) {
+    t.join();
+  }
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  // All of them were written in the group of the WAL writer thread, rather
+  // than left over to lead groups of their own
+  ASSERT_EQ(kNumThreads,
+            options.statistics->getTickerCount(WRITE_DONE_BY_OTHER));
+  ASSERT_EQ(0, options.statistics->getTickerCount(WRITE_DONE_BY_SELF));
+  for (int t = 0; t < kNumThreads; t++) {
+    ASSERT_EQ(value, Get("key" + std::to_string(t)));
+  }
+}
+
 TEST_P(DBWriteTest, ManualWalFlushInEffect) {
   Options options = GetOptions();
   Reopen(options);
@@ -263,6 +263,133 @@ TEST_F(ExternalSSTFileBasicTest, Basic) {
   DestroyAndRecreateExternalSSTFilesDir();
 }
 
+TEST_F(ExternalSSTFileBasicTest, IngestWithBlobFile) {
+  Options options = CurrentOptions();
+  options.min_blob_size = 16;
+  DestroyAndReopen(options);
+
+  // Values of at least min_blob_size bytes go to the blob file
+  uint64_t blob_file_number = 0;
+  ASSERT_OK(db_->ReserveFileNumbers(1, &blob_file_number));
+  SstFileWriter sst_file_writer(EnvOptions(), options);
+  std::string file1 = sst_files_dir_ + "file1.sst";
+  ASSERT_OK(sst_file_writer.OpenWithBlobFile(file1, blob_file_number));
+  for (int k = 0; k < 100; k++) {
+    ASSERT_OK(sst_file_writer.Put(
+        Key(k), k % 2 == 0 ? "small" : Key(k) + std::string(100, 'v')));
+  }
+  ExternalSstFileInfo file1_info;
+  ASSERT_OK(sst_file_writer.Finish(&file1_info));
+  ASSERT_EQ(file1_info.blob_file_number, blob_file_number);
+  ASSERT_EQ(file1_info.blob_file_path,
+            BlobFileName(dbname_ + "_sst_files", blob_file_number));
+  ASSERT_OK(env_->FileExists(file1_info.blob_file_path));
+
+  // The blob file number is taken by the first ingestion
+  IngestExternalFileOptions ifo;
+  ASSERT_OK(db_->IngestExternalFile({file1}, ifo));
+  ASSERT_TRUE(db_->IngestExternalFile({file1}, ifo).IsInvalidArgument());
+
+  auto verify = [&]() {
+    for (int k = 0; k < 100; k++) {
+      ASSERT_EQ(k % 2 == 0 ? "small" : Key(k) + std::string(100, 'v'),
+                Get(Key(k)));
+    }
+    std::vector<LiveFileMetaData> metadata;
+    db_->GetLiveFilesMetaData(&metadata);
+    ASSERT_EQ(1, metadata.size());
+    ColumnFamilyMetaData cf_meta;
+    db_->GetColumnFamilyMetaData(&cf_meta);
+    ASSERT_EQ(1, cf_meta.blob_files.size());
+    ASSERT_EQ(blob_file_number, cf_meta.blob_files[0].blob_file_number);
+    ASSERT_EQ(50, cf_meta.blob_files[0].total_blob_count);
+  };
+  verify();
+  Reopen(options);
+  verify();
+
+  // New files are numbered after the ingested blob file
+  std::vector<LiveFileMetaData> metadata;
+  db_->GetLiveFilesMetaData(&metadata);
+  ASSERT_EQ(1, metadata.size());
+  const uint64_t ingested_file_number = metadata[0].file_number;
+  ASSERT_OK(Put(Key(100), "val"));
+  ASSERT_OK(Flush());
+  metadata.clear();
+  db_->GetLiveFilesMetaData(&metadata);
+  ASSERT_EQ(2, metadata.size());
+  for (const auto& meta : metadata) {
+    if (meta.file_number != ingested_file_number) {
+      ASSERT_GT(meta.file_number, blob_file_number);
+    }
+  }
+
+  // Compaction rewrites the blob references
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  for (int k = 0; k < 100; k++) {
+    ASSERT_EQ(k % 2 == 0 ? "small" : Key(k) + std::string(100, 'v'),
+              Get(Key(k)));
+  }
+
+  DestroyAndRecreateExternalSSTFilesDir();
+}
+
+TEST_F(ExternalSSTFileBasicTest, IngestWithBlobFileReservedNumbers) {
+  Options options = CurrentOptions();
+  options.min_blob_size = 16;
+  DestroyAndReopen(options);
+
+  uint64_t first_file_number = 0;
+  ASSERT_OK(db_->ReserveFileNumbers(2, &first_file_number));
+  auto write_file = [&](const std::string& file, uint64_t blob_file_number,
+                        int start) {
+    SstFileWriter sst_file_writer(EnvOptions(), options);
+    ASSERT_OK(sst_file_writer.OpenWithBlobFile(file, blob_file_number));
+    for (int k = start; k < start + 10; k++) {
+      ASSERT_OK(sst_file_writer.Put(Key(k), Key(k) + std::string(100, 'v')));
+    }
+    ASSERT_OK(sst_file_writer.Finish());
+  };
+
+  // Numbers that are not reserved are rejected
+  const std::string file1 = sst_files_dir_ + "file1.sst";
+  write_file(file1, dbfull()->TEST_Current_Next_FileNo() + 100, 0);
+  ASSERT_TRUE(db_->IngestExternalFile({file1}, IngestExternalFileOptions())
+                  .IsInvalidArgument());
+
+  // The DB creates files between the ingestions, which use reserved numbers
+  write_file(file1, first_file_number, 0);
+  ASSERT_OK(db_->IngestExternalFile({file1}, IngestExternalFileOptions()));
+  ASSERT_OK(Put(Key(100), "val"));
+  ASSERT_OK(Flush());
+
+  // A failed ingestion gives the number back
+  const std::string file2 = sst_files_dir_ + "file2.sst";
+  write_file(file2, first_file_number + 1, 5);
+  IngestExternalFileOptions ifo;
+  ifo.fail_if_not_bottommost_level = true;
+  ASSERT_NOK(db_->IngestExternalFile({file2}, ifo));
+  write_file(file2, first_file_number + 1, 20);
+  ASSERT_OK(db_->IngestExternalFile({file2}, IngestExternalFileOptions()));
+
+  auto verify = [&]() {
+    for (int k = 0; k < 30; k++) {
+      ASSERT_EQ(k < 10 || k >= 20 ? Key(k) + std::string(100, 'v')
+                                  : "NOT_FOUND",
+                Get(Key(k)));
+    }
+    ASSERT_EQ("val", Get(Key(100)));
+    ColumnFamilyMetaData cf_meta;
+    db_->GetColumnFamilyMetaData(&cf_meta);
+    ASSERT_EQ(2, cf_meta.blob_files.size());
+  };
+  verify();
+  Reopen(options);
+  verify();
+
+  DestroyAndRecreateExternalSSTFilesDir();
+}
+
 TEST_F(ExternalSSTFileBasicTest, AlignedBufferedWrite) {
   class AlignedWriteFS : public FileSystemWrapper {
    public:
@@ -11,9 +11,11 @@
 #include <unordered_set>
 #include <vector>
 
+#include "db/blob/blob_log_format.h"
 #include "db/db_impl/db_impl.h"
 #include "db/version_edit.h"
 #include "file/file_util.h"
+#include "file/filename.h"
 #include "file/random_access_file_reader.h"
 #include "logging/logging.h"
 #include "table/merging_iterator.h"
@@ -65,6 +67,13 @@ Status ExternalSstFileIngestionJob::Prepare(
       return Status::Corruption("Generated table have corrupted keys");
     }
 
+    if (!file_to_ingest.external_blob_file_path.empty()) {
+      status = PrepareIngestedBlobFile(&file_to_ingest);
+      if (!status.ok()) {
+        return status;
+      }
+    }
+
     files_to_ingest_.emplace_back(std::move(file_to_ingest));
   }
 
@@ -223,6 +232,15 @@ Status ExternalSstFileIngestionJob::Prepare(
     f.file_checksum = kUnknownFileChecksum;
     f.file_checksum_func_name = kUnknownFileChecksumFuncName;
     ingestion_path_ids.insert(f.fd.GetPathId());
+
+    if (!f.external_blob_file_path.empty()) {
+      status = IngestBlobFile(&f);
+      if (!status.ok()) {
+        break;
+      }
+      // Blob files always go to the first path
+      ingestion_path_ids.insert(0);
+    }
   }
 
   TEST_SYNC_POINT("ExternalSstFileIngestionJob::BeforeSyncDir");
@@ -621,7 +639,8 @@ Status ExternalSstFileIngestionJob::AssignLevelsForOneBatch(
         file->fd.GetNumber(), file->fd.GetPathId(), file->fd.GetFileSize(),
         file->smallest_internal_key, file->largest_internal_key,
         file->assigned_seqno, file->assigned_seqno, false,
-        file->file_temperature, kInvalidBlobFileNumber, oldest_ancester_time,
+        file->file_temperature, file->blob_file_addition.GetBlobFileNumber(),
+        oldest_ancester_time,
         current_time,
         ingestion_options_.ingest_behind
             ? kReservedEpochNumberForFileIngestedBehind
@@ -631,6 +650,9 @@ Status ExternalSstFileIngestionJob::AssignLevelsForOneBatch(
     f_metadata.temperature = file->file_temperature;
     f_metadata.marked_for_compaction = marked_for_compaction;
     edit_.AddFile(file->picked_level, f_metadata);
+    if (!file->internal_blob_file_path.empty()) {
+      edit_.AddBlobFile(file->blob_file_addition);
+    }
 
     *batch_uppermost_level =
         std::min(*batch_uppermost_level, file->picked_level);
@@ -769,6 +791,12 @@ void ExternalSstFileIngestionJob::UpdateStats() {
 
 void ExternalSstFileIngestionJob::Cleanup(const Status& status) {
   IOOptions io_opts;
+  for (IngestedFileInfo& f : files_to_ingest_) {
+    if (!f.external_blob_file_path.empty()) {
+      versions_->ReleaseReservedFileNumber(
+          f.blob_file_addition.GetBlobFileNumber(), status.ok());
+    }
+  }
   if (!status.ok()) {
     // We failed to add the files to the database
     // remove all the files we copied
@@ -786,6 +814,16 @@ void ExternalSstFileIngestionJob::Cleanup(const Status& status) {
             "file link : %s",
             f.external_file_path.c_str(), s.ToString().c_str());
       }
+      if (!f.external_blob_file_path.empty()) {
+        s = fs_->DeleteFile(f.external_blob_file_path, io_opts, nullptr);
+        if (!s.ok()) {
+          ROCKS_LOG_WARN(
+              db_options_.info_log,
+              "%s was added to DB successfully but failed to remove original "
+              "file link : %s",
+              f.external_blob_file_path.c_str(), s.ToString().c_str());
+        }
+      }
     }
   }
 }
@@ -802,6 +840,15 @@ void ExternalSstFileIngestionJob::DeleteInternalFiles() {
                      "AddFile() clean up for file %s failed : %s",
                      f.internal_file_path.c_str(), s.ToString().c_str());
     }
+    if (f.internal_blob_file_path.empty()) {
+      continue;
+    }
+    s = fs_->DeleteFile(f.internal_blob_file_path, io_opts, nullptr);
+    if (!s.ok()) {
+      ROCKS_LOG_WARN(db_options_.info_log,
+                     "AddFile() clean up for file %s failed : %s",
+                     f.internal_blob_file_path.c_str(), s.ToString().c_str());
+    }
   }
 }
 
@@ -910,6 +957,21 @@ Status ExternalSstFileIngestionJob::SanityCheckTableProperties(
                                    " is not supported");
   }
 
+  auto blob_iter =
+      uprops.find(ExternalSstFilePropertyNames::kBlobFileAddition);
+  if (blob_iter != uprops.end()) {
+    Slice input(blob_iter->second);
+    Status s = file_to_ingest->blob_file_addition.DecodeFrom(&input);
+    if (!s.ok()) {
+      return s;
+    }
+    // Written next to the external file by SstFileWriter
+    const size_t dir_end = external_file.find_last_of('/');
+    file_to_ingest->external_blob_file_path = BlobFileName(
+        dir_end == std::string::npos ? "." : external_file.substr(0, dir_end),
+        file_to_ingest->blob_file_addition.GetBlobFileNumber());
+  }
+
   file_to_ingest->cf_id = static_cast<uint32_t>(props->column_family_id);
   // This assignment works fine even though `table_reader` may later be reset,
   // since that will not affect how table properties are parsed, and this
@@ -1394,6 +1456,80 @@ bool ExternalSstFileIngestionJob::IngestedFileFitInLevel(
   return true;
 }
 
+Status ExternalSstFileIngestionJob::PrepareIngestedBlobFile(
+    IngestedFileInfo* file_to_ingest) {
+  const std::string& path = file_to_ingest->external_blob_file_path;
+  std::unique_ptr<FSSequentialFile> file;
+  IOStatus io_s =
+      fs_->NewSequentialFile(path, FileOptions(env_options_), &file, nullptr);
+  if (!io_s.ok()) {
+    return io_s;
+  }
+  std::string scratch(BlobLogHeader::kSize, '\0');
+  Slice header_slice;
+  io_s = file->Read(BlobLogHeader::kSize, IOOptions(), &header_slice,
+                    scratch.data(), nullptr);
+  if (!io_s.ok()) {
+    return io_s;
+  }
+  BlobLogHeader header;
+  Status s = header.DecodeFrom(header_slice);
+  if (!s.ok()) {
+    return s;
+  }
+  if (header.column_family_id != cfd_->GetID()) {
+    return Status::InvalidArgument(
+        "Blob file " + path + " was written for column family " +
+        std::to_string(header.column_family_id) + " but is ingested into " +
+        cfd_->GetName());
+  }
+
+  // The external file refers to its blob values by the blob file number, so
+  // the number has to be unused in the DB and must not be handed out later.
+  const uint64_t blob_file_number =
+      file_to_ingest->blob_file_addition.GetBlobFileNumber();
+  if (!versions_->TryReserveFileNumber(blob_file_number)) {
+    return Status::InvalidArgument(
+        "Blob file number " + std::to_string(blob_file_number) +
+        " of " + path +
+        " may already be in use. Blob files must be numbered with file "
+        "numbers reserved by DB::ReserveFileNumbers()");
+  }
+  return Status::OK();
+}
+
+Status ExternalSstFileIngestionJob::IngestBlobFile(
+    IngestedFileInfo* file_to_ingest) {
+  const std::string& path_outside_db = file_to_ingest->external_blob_file_path;
+  const std::string path_inside_db =
+      BlobFileName(cfd_->ioptions().cf_paths.front().path,
+                   file_to_ingest->blob_file_addition.GetBlobFileNumber());
+  Status status;
+  if (file_to_ingest->copy_file) {
+    status = CopyFile(fs_.get(), path_outside_db, Temperature::kUnknown,
+                      path_inside_db, Temperature::kUnknown, 0,
+                      db_options_.use_fsync, io_tracer_);
+  } else {
+    status =
+        fs_->LinkFile(path_outside_db, path_inside_db, IOOptions(), nullptr);
+    if (status.ok()) {
+      std::unique_ptr<FSWritableFile> file_to_sync;
+      Status s = fs_->ReopenWritableFile(path_inside_db, env_options_,
+                                         &file_to_sync, nullptr);
+      if (!s.IsNotSupported()) {
+        status = s;
+        if (status.ok()) {
+          status = SyncIngestedFile(file_to_sync.get());
+        }
+      }
+    }
+  }
+  if (status.ok()) {
+    file_to_ingest->internal_blob_file_path = path_inside_db;
+  }
+  return status;
+}
+
 template <typename TWritableFile>
 Status ExternalSstFileIngestionJob::SyncIngestedFile(TWritableFile* file) {
   assert(file != nullptr);
@@ -8,6 +8,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include "db/blob/blob_file_addition.h"
 #include "db/column_family.h"
 #include "db/internal_stats.h"
 #include "db/snapshot_impl.h"
@@ -180,6 +181,11 @@ struct IngestedFileInfo : public KeyRangeInfo {
   // the user key's format in the external file matches the column family's
   // setting.
   bool user_defined_timestamps_persisted = true;
+  // The companion blob file written by SstFileWriter::OpenWithBlobFile(), if
+  // any. It is ingested with the number the external file references it by.
+  BlobFileAddition blob_file_addition;
+  std::string external_blob_file_path;
+  std::string internal_blob_file_path;
 };
 
 // A batch of files.
@@ -369,6 +375,14 @@ class ExternalSstFileIngestionJob {
   template <typename TWritableFile>
   Status SyncIngestedFile(TWritableFile* file);
 
+  // Check the companion blob file of `file_to_ingest` and take its file
+  // number for the DB
+  Status PrepareIngestedBlobFile(IngestedFileInfo* file_to_ingest);
+
+  // Copy or link the companion blob file of `file_to_ingest` into the DB, the
+  // same way as the external file
+  Status IngestBlobFile(IngestedFileInfo* file_to_ingest);
+
   // Create equivalent `Compaction` objects to this file ingestion job
   // , which will be used to check range conflict with other ongoing
   // compactions.
@@ -100,7 +100,8 @@ FlushJob::FlushJob(
     Env::Priority thread_pri, const std::shared_ptr<IOTracer>& io_tracer,
     std::shared_ptr<const SeqnoToTimeMapping> seqno_to_time_mapping,
     const std::string& db_id, const std::string& db_session_id,
-    std::string full_history_ts_low, BlobFileCompletionCallback* blob_callback)
+    std::string full_history_ts_low, BlobFileCompletionCallback* blob_callback,
+    CompressionThreadPool* compression_pool)
     : dbname_(dbname),
       db_id_(db_id),
       db_session_id_(db_session_id),
@@ -132,6 +133,7 @@ FlushJob::FlushJob(
       clock_(db_options_.clock),
       full_history_ts_low_(std::move(full_history_ts_low)),
       blob_callback_(blob_callback),
+      compression_pool_(compression_pool),
       seqno_to_time_mapping_(std::move(seqno_to_time_mapping)) {
   assert(job_context->snapshot_context_initialized);
   // Update the thread status to indicate flush.
@@ -994,6 +996,15 @@ Status FlushJob::WriteLevel0Table() {
           preclude_last_level_min_seqno_ == kMaxSequenceNumber
               ? preclude_last_level_min_seqno_
               : std::min(earliest_snapshot_, preclude_last_level_min_seqno_));
+      tboptions.compression_pool = compression_pool_;
+      tboptions.compression_dict_registry = cfd_->compression_dict_registry();
+      // Let the flush take compression threads from compactions when L0 is
+      // getting close to slowing down writes.
+      const int slowdown_trigger =
+          mutable_cf_options_.level0_slowdown_writes_trigger;
+      tboptions.compression_urgent =
+          slowdown_trigger > 0 &&
+          2 * base_->storage_info()->NumLevelFiles(0) >= slowdown_trigger;
       s = BuildTable(
           dbname_, versions_, db_options_, tboptions, file_options_,
           cfd_->table_cache(), iter.get(), std::move(range_del_iters), &meta_,
@@ -53,6 +53,7 @@ class Version;
 class VersionEdit;
 class VersionSet;
 class Arena;
+class CompressionThreadPool;
 
 class FlushJob {
  public:
@@ -73,7 +74,8 @@ class FlushJob {
            std::shared_ptr<const SeqnoToTimeMapping> seqno_to_time_mapping,
            const std::string& db_id = "", const std::string& db_session_id = "",
            std::string full_history_ts_low = "",
-           BlobFileCompletionCallback* blob_callback = nullptr);
+           BlobFileCompletionCallback* blob_callback = nullptr,
+           CompressionThreadPool* compression_pool = nullptr);
 
   ~FlushJob();
 
@@ -213,6 +215,7 @@ class FlushJob {
 
   const std::string full_history_ts_low_;
   BlobFileCompletionCallback* blob_callback_;
+  CompressionThreadPool* compression_pool_;
 
   // Shared copy of DB's seqno to time mapping stored in SuperVersion. The
   // ownership is shared with this FlushJob when it's created.
@@ -1450,6 +1450,7 @@ bool InternalStats::HandleEstimateTableReadersMem(uint64_t* value,
   *value = (version == nullptr)
                ? 0
                : version->GetMemoryUsageByTableReaders(read_options);
+  *value += cfd_->compression_dict_registry()->ApproximateMemoryUsage();
   return true;
 }
 
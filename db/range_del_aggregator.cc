@@ -184,6 +184,12 @@ ForwardRangeDelIterator::ForwardRangeDelIterator(
       inactive_iters_(StartKeyMinComparator(icmp)) {}
 
 bool ForwardRangeDelIterator::ShouldDelete(const ParsedInternalKey& parsed) {
+  if (cached_window_valid_ &&
+      (!cached_window_bounded_ ||
+       icmp_->Compare(parsed, cached_window_end_) < 0)) {
+    return cached_window_seq_ > parsed.sequence;
+  }
+
   // Move active iterators that end before parsed.
   while (!active_iters_.empty() &&
          icmp_->Compare((*active_iters_.top())->end_key(), parsed) <= 0) {
@@ -206,9 +212,26 @@ bool ForwardRangeDelIterator::ShouldDelete(const ParsedInternalKey& parsed) {
     assert(active_iters_.size() == active_seqnums_.size());
   }
 
-  return active_seqnums_.empty()
-             ? false
-             : (*active_seqnums_.begin())->seq() > parsed.sequence;
+  UpdateCachedWindow();
+  return cached_window_seq_ > parsed.sequence;
+}
+
+void ForwardRangeDelIterator::UpdateCachedWindow() {
+  cached_window_valid_ = true;
+  cached_window_seq_ =
+      active_seqnums_.empty() ? 0 : (*active_seqnums_.begin())->seq();
+  cached_window_bounded_ = !active_iters_.empty() || !inactive_iters_.empty();
+  if (!active_iters_.empty()) {
+    cached_window_end_ = (*active_iters_.top())->end_key();
+    if (!inactive_iters_.empty()) {
+      ParsedInternalKey next_start = inactive_iters_.top()->start_key();
+      if (icmp_->Compare(next_start, cached_window_end_) < 0) {
+        cached_window_end_ = next_start;
+      }
+    }
+  } else if (!inactive_iters_.empty()) {
+    cached_window_end_ = inactive_iters_.top()->start_key();
+  }
 }
 
 void ForwardRangeDelIterator::Invalidate() {
@@ -216,6 +239,7 @@ void ForwardRangeDelIterator::Invalidate() {
   active_iters_.clear();
   active_seqnums_.clear();
   inactive_iters_.clear();
+  cached_window_valid_ = false;
 }
 
 ReverseRangeDelIterator::ReverseRangeDelIterator(
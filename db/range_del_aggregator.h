@@ -122,6 +122,13 @@ struct StartKeyMinComparator {
   const InternalKeyComparator* icmp;
 };
 
+// Checks keys in increasing order against the range tombstones added to it.
+// Only compaction and flush check keys this way (through
+// RangeDelAggregator::ShouldDelete() from CompactionIterator and
+// MergeHelper), so the cached tombstone window below speeds up those only.
+// Reads do not use it: MergingIterator applies range tombstones itself and
+// skips each covered range with one Seek(), and point lookups use
+// MaxCoveringTombstoneSeqnum().
 class ForwardRangeDelIterator {
  public:
   explicit ForwardRangeDelIterator(const InternalKeyComparator* icmp);
@@ -134,6 +141,7 @@ class ForwardRangeDelIterator {
     iter->Seek(parsed.user_key);
     PushIter(iter, parsed);
     assert(active_iters_.size() == active_seqnums_.size());
+    cached_window_valid_ = false;
   }
 
   size_t UnusedIdx() const { return unused_idx_; }
@@ -192,11 +200,26 @@ class ForwardRangeDelIterator {
     return iter;
   }
 
+  // Records the first key at which the set of active tombstones can change,
+  // i.e. the smallest end key of an active tombstone or start key of an
+  // inactive one.
+  void UpdateCachedWindow();
+
   const InternalKeyComparator* icmp_;
   size_t unused_idx_;
   ActiveSeqSet active_seqnums_;
   BinaryHeap<ActiveSeqSet::const_iterator, EndKeyMinComparator> active_iters_;
   BinaryHeap<TruncatedRangeDelIterator*, StartKeyMinComparator> inactive_iters_;
+
+  // Keys before `cached_window_end_` are covered by the same tombstones as the
+  // last key passed to ShouldDelete(), so a run of keys between two tombstone
+  // boundaries is checked against `cached_window_seq_` (0 if no tombstone is
+  // active) without touching the heaps. The window is unbounded once all
+  // iterators are consumed.
+  bool cached_window_valid_ = false;
+  bool cached_window_bounded_ = false;
+  ParsedInternalKey cached_window_end_;
+  SequenceNumber cached_window_seq_ = 0;
 };
 
 class ReverseRangeDelIterator {
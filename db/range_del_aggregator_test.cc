@@ -536,6 +536,39 @@ TEST_F(RangeDelAggregatorTest, MultipleTruncatedItersInAggregatorSameLevel) {
                                            {"zz", "zzz", false}});
 }
 
+TEST_F(RangeDelAggregatorTest, ShouldDeleteRunOfKeys) {
+  std::vector<std::vector<RangeTombstone>> range_dels_list = {
+      {{"b", "d", 10}, {"f", "h", 20}}, {{"c", "g", 15}}, {{"e", "f", 5}}};
+  auto fragment_lists = MakeFragmentedTombstoneLists(range_dels_list);
+  ReadRangeDelAggregator range_del_agg(&bytewise_icmp, kMaxSequenceNumber);
+  for (const auto& fragment_list : fragment_lists) {
+    std::unique_ptr<FragmentedRangeTombstoneIterator> input_iter(
+        new FragmentedRangeTombstoneIterator(fragment_list.get(), bytewise_icmp,
+                                             kMaxSequenceNumber));
+    range_del_agg.AddTombstones(std::move(input_iter));
+  }
+
+  // Check every key of a dense run, most of which fall between the same two
+  // tombstone boundaries as the key before them.
+  const std::vector<std::string> user_keys = {"a", "b", "bb", "c", "cc", "d",
+                                              "e", "ee", "f", "g", "h", "i"};
+  std::vector<ShouldDeleteTestCase> test_cases;
+  for (const auto& user_key : user_keys) {
+    for (SequenceNumber seq : {25, 18, 12, 7, 1}) {
+      bool covered = false;
+      for (const auto& range_dels : range_dels_list) {
+        for (const auto& range_del : range_dels) {
+          covered |= range_del.start_key_.compare(user_key) <= 0 &&
+                     range_del.end_key_.compare(user_key) > 0 &&
+                     range_del.seq_ > seq;
+        }
+      }
+      test_cases.push_back({InternalValue(user_key, seq), covered});
+    }
+  }
+  VerifyShouldDelete(&range_del_agg, test_cases);
+}
+
 TEST_F(RangeDelAggregatorTest, CompactionAggregatorNoSnapshots) {
   auto fragment_lists = MakeFragmentedTombstoneLists(
       {{{"a", "e", 10}, {"c", "g", 8}},
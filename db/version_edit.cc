@@ -288,6 +288,13 @@ bool VersionEdit::EncodeTo(std::string* dst,
     char p = static_cast<char>(persist_user_defined_timestamps_);
     PutLengthPrefixedSlice(dst, Slice(&p, 1));
   }
+
+  if (has_num_wal_streams_) {
+    PutVarint32(dst, kNumWalStreams);
+    std::string varint_num_wal_streams;
+    PutVarint32(&varint_num_wal_streams, num_wal_streams_);
+    PutLengthPrefixedSlice(dst, varint_num_wal_streams);
+  }
   return true;
 }
 
@@ -767,6 +774,15 @@ Status VersionEdit::DecodeFrom(const Slice& src) {
         }
         break;
 
+      case kNumWalStreams:
+        if (!GetLengthPrefixedSlice(&input, &str) ||
+            !GetVarint32(&str, &num_wal_streams_) || num_wal_streams_ == 0) {
+          msg = "num_wal_streams";
+        } else {
+          has_num_wal_streams_ = true;
+        }
+        break;
+
       default:
         if (tag & kTagSafeIgnoreMask) {
           // Tag from future which can be safely ignored.
@@ -813,6 +829,10 @@ std::string VersionEdit::DebugString(bool hex_key) const {
     r.append("\n  PersistUserDefinedTimestamps: ");
     r.append(persist_user_defined_timestamps_ ? "true" : "false");
   }
+  if (has_num_wal_streams_) {
+    r.append("\n  NumWalStreams: ");
+    AppendNumberTo(&r, num_wal_streams_);
+  }
   if (has_log_number_) {
     r.append("\n  LogNumber: ");
     AppendNumberTo(&r, log_number_);
@@ -947,6 +967,9 @@ std::string VersionEdit::DebugJSON(int edit_num, bool hex_key) const {
   if (has_comparator_) {
     jw << "Comparator" << comparator_;
   }
+  if (has_num_wal_streams_) {
+    jw << "NumWalStreams" << num_wal_streams_;
+  }
   if (has_log_number_) {
     jw << "LogNumber" << log_number_;
   }
@@ -72,6 +72,7 @@ enum Tag : uint32_t {
   kWalAddition2,
   kWalDeletion2,
   kPersistUserDefinedTimestamps,
+  kNumWalStreams,
 };
 
 enum NewFileCustomTag : uint32_t {
@@ -473,6 +474,15 @@ class VersionEdit {
     return persist_user_defined_timestamps_;
   }
 
+  // Number of WAL streams (DBOptions::num_wal_streams) the WALs written after
+  // this edit use. Only recorded when it changes.
+  void SetNumWalStreams(uint32_t num_wal_streams) {
+    has_num_wal_streams_ = true;
+    num_wal_streams_ = num_wal_streams;
+  }
+  bool HasNumWalStreams() const { return has_num_wal_streams_; }
+  uint32_t GetNumWalStreams() const { return num_wal_streams_; }
+
   void SetLogNumber(uint64_t num) {
     has_log_number_ = true;
     log_number_ = num;
@@ -786,6 +796,8 @@ class VersionEdit {
   bool has_min_log_number_to_keep_ = false;
   bool has_last_sequence_ = false;
   bool has_persist_user_defined_timestamps_ = false;
+  bool has_num_wal_streams_ = false;
+  uint32_t num_wal_streams_ = 1;
 
   // Compaction cursors for round-robin compaction policy
   CompactCursors compact_cursors_;
@@ -563,6 +563,9 @@ Status VersionEditHandler::ExtractInfoFromVersionEdit(ColumnFamilyData* cfd,
     version_set_->db_id_ = edit.GetDbId();
     version_edit_params_.SetDBId(edit.GetDbId());
   }
+  if (edit.HasNumWalStreams()) {
+    version_set_->num_wal_streams_ = edit.GetNumWalStreams();
+  }
   if (cfd != nullptr) {
     if (edit.HasLogNumber()) {
       if (cfd->GetLogNumber() > edit.GetLogNumber()) {
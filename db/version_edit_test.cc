@@ -616,6 +616,20 @@ TEST_F(VersionEditTest, FullHistoryTsLow) {
   TestEncodeDecode(edit);
 }
 
+TEST_F(VersionEditTest, NumWalStreams) {
+  VersionEdit edit;
+  ASSERT_FALSE(edit.HasNumWalStreams());
+  edit.SetNumWalStreams(4);
+  TestEncodeDecode(edit);
+
+  std::string encoded;
+  ASSERT_TRUE(edit.EncodeTo(&encoded, 0 /* ts_sz */));
+  VersionEdit decoded;
+  ASSERT_OK(decoded.DecodeFrom(encoded));
+  ASSERT_TRUE(decoded.HasNumWalStreams());
+  ASSERT_EQ(4, decoded.GetNumWalStreams());
+}
+
 // Tests that if RocksDB is downgraded, the new types of VersionEdits
 // that have a tag larger than kTagSafeIgnoreMask can be safely ignored.
 TEST_F(VersionEditTest, IgnorableTags) {
@@ -646,6 +660,7 @@ TEST_F(VersionEditTest, IgnorableTags) {
   edit.SetNextFile(kNextFileNumber);
   // Add more ignorable entries.
   edit.SetFullHistoryTsLow("ts");
+  edit.SetNumWalStreams(4);
   // Add unignorable entry.
   edit.SetColumnFamily(kColumnFamilyId);
 
@@ -658,6 +673,7 @@ TEST_F(VersionEditTest, IgnorableTags) {
   // Check that all ignorable entries are ignored.
   ASSERT_FALSE(decoded.HasDbId());
   ASSERT_FALSE(decoded.HasFullHistoryTsLow());
+  ASSERT_FALSE(decoded.HasNumWalStreams());
   ASSERT_FALSE(decoded.IsWalAddition());
   ASSERT_FALSE(decoded.IsWalDeletion());
   ASSERT_TRUE(decoded.GetWalAdditions().empty());
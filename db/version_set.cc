@@ -74,6 +74,7 @@
 #include "util/cast_util.h"
 #include "util/coding.h"
 #include "util/coro_utils.h"
+#include "util/mutexlock.h"
 #include "util/stop_watch.h"
 #include "util/string_util.h"
 #include "util/user_comparator_wrapper.h"
@@ -5280,6 +5281,7 @@ void VersionSet::Reset() {
   db_id_.clear();
   next_file_number_.store(2);
   min_log_number_to_keep_.store(0);
+  num_wal_streams_ = 1;
   manifest_file_number_ = 0;
   options_file_number_ = 0;
   pending_manifest_file_number_ = 0;
@@ -6090,6 +6092,9 @@ Status VersionSet::LogAndApplyHelper(ColumnFamilyData* cfd,
     edit->SetPrevLogNumber(prev_log_number_);
   }
   edit->SetNextFile(next_file_number_.load());
+  if (edit->HasNumWalStreams()) {
+    num_wal_streams_ = edit->GetNumWalStreams();
+  }
   if (edit->HasLastSequence() && edit->GetLastSequence() > *max_last_sequence) {
     *max_last_sequence = edit->GetLastSequence();
   } else {
@@ -6672,6 +6677,20 @@ Status VersionSet::WriteCurrentStateToManifest(
     }
   }
 
+  if (num_wal_streams_ > 1) {
+    VersionEdit edit_for_wal_streams;
+    edit_for_wal_streams.SetNumWalStreams(num_wal_streams_);
+    std::string wal_streams_record;
+    if (!edit_for_wal_streams.EncodeTo(&wal_streams_record)) {
+      return Status::Corruption("Unable to Encode VersionEdit:" +
+                                edit_for_wal_streams.DebugString(true));
+    }
+    io_s = log->AddRecord(write_options, wal_streams_record);
+    if (!io_s.ok()) {
+      return io_s;
+    }
+  }
+
   // Save WALs.
   if (!wal_additions.GetWalAdditions().empty()) {
     TEST_SYNC_POINT_CALLBACK("VersionSet::WriteCurrentStateToManifest:SaveWal",
@@ -7334,6 +7353,56 @@ void VersionSet::GetObsoleteFiles(std::vector<ObsoleteFileInfo>* files,
   obsolete_manifests_.swap(*manifest_filenames);
 }
 
+uint64_t VersionSet::ReserveFileNumbers(uint64_t n) {
+  assert(n > 0);
+  MutexLock l(&reserved_file_numbers_mutex_);
+  const uint64_t first = FetchAddFileNumber(n);
+  reserved_file_numbers_.emplace(first, first + n);
+  return first;
+}
+
+bool VersionSet::TryReserveFileNumber(uint64_t number) {
+  MutexLock l(&reserved_file_numbers_mutex_);
+  // Find the reserved run holding `number`, if any, and split it
+  auto it = reserved_file_numbers_.upper_bound(number);
+  if (it == reserved_file_numbers_.begin()) {
+    return false;
+  }
+  --it;
+  const uint64_t first = it->first;
+  const uint64_t end = it->second;
+  if (number >= end) {
+    return false;
+  }
+  reserved_file_numbers_.erase(it);
+  if (first < number) {
+    reserved_file_numbers_.emplace(first, number);
+  }
+  if (number + 1 < end) {
+    reserved_file_numbers_.emplace(number + 1, end);
+  }
+  taken_file_numbers_.insert(number);
+  return true;
+}
+
+void VersionSet::ReleaseReservedFileNumber(uint64_t number, bool used) {
+  MutexLock l(&reserved_file_numbers_mutex_);
+  const size_t erased = taken_file_numbers_.erase(number);
+  assert(erased == 1);
+  if (erased == 1 && !used) {
+    reserved_file_numbers_.emplace(number, number + 1);
+  }
+}
+
+bool VersionSet::IsFileNumberReserved(uint64_t number) {
+  MutexLock l(&reserved_file_numbers_mutex_);
+  if (taken_file_numbers_.count(number) > 0) {
+    return true;
+  }
+  auto it = reserved_file_numbers_.upper_bound(number);
+  return it != reserved_file_numbers_.begin() && number < (--it)->second;
+}
+
 uint64_t VersionSet::GetObsoleteSstFilesSize() const {
   uint64_t ret = 0;
   for (auto& f : obsolete_files_) {
@@ -1353,6 +1353,10 @@ class VersionSet {
     return min_log_number_to_keep_.load();
   }
 
+  // Number of WAL streams of the WALs written since the last recorded change,
+  // as recorded by VersionEdit::SetNumWalStreams(). 1 if never recorded.
+  uint32_t num_wal_streams() const { return num_wal_streams_; }
+
   bool unchanging() const { return unchanging_; }
 
   // Allocate and return a new file number
@@ -1363,6 +1367,25 @@ class VersionSet {
     return next_file_number_.fetch_add(n);
   }
 
+  // Set aside `n` consecutive file numbers for files created outside of the
+  // DB, and return the first of them. They can be taken with
+  // TryReserveFileNumber() until the DB is closed.
+  uint64_t ReserveFileNumbers(uint64_t n);
+
+  // Take `number`, set aside by ReserveFileNumbers(), for a file created
+  // outside of the DB. Returns false if `number` is not reserved or already
+  // taken. A taken number must be given back with ReleaseReservedFileNumber().
+  bool TryReserveFileNumber(uint64_t number);
+
+  // Give back a number taken by TryReserveFileNumber(), once the file is
+  // added to the DB or, if `used` is false, deleted. An unused number can be
+  // taken again.
+  void ReleaseReservedFileNumber(uint64_t number, bool used);
+
+  // Whether `number` is set aside for or taken by a file created outside of
+  // the DB, which is not live yet but must not be deleted
+  bool IsFileNumberReserved(uint64_t number);
+
   // Return the last sequence number.
   uint64_t LastSequence() const {
     return last_sequence_.load(std::memory_order_acquire);
@@ -1658,9 +1681,18 @@ class VersionSet {
   std::string db_id_;
   const ImmutableDBOptions* const db_options_;
   std::atomic<uint64_t> next_file_number_;
+  // Guards reserved_file_numbers_ and taken_file_numbers_
+  port::Mutex reserved_file_numbers_mutex_;
+  // The runs of file numbers set aside by ReserveFileNumbers() and not taken
+  // yet, mapping the first number of each run to the end of the run
+  std::map<uint64_t, uint64_t> reserved_file_numbers_;
+  // The numbers taken by TryReserveFileNumber() and not released yet
+  std::set<uint64_t> taken_file_numbers_;
   // Any WAL number smaller than this should be ignored during recovery,
   // and is qualified for being deleted.
   std::atomic<uint64_t> min_log_number_to_keep_ = {0};
+  // Written by LogAndApply() and recovery, read by WriteCurrentStateToManifest()
+  uint32_t num_wal_streams_ = 1;
   uint64_t manifest_file_number_;
   uint64_t options_file_number_;
   uint64_t options_file_size_;
@@ -1794,6 +1794,131 @@ TEST_F(DBWideBasicTest, PinnableWideColumnsMove) {
   test_move(/* fill_cache*/ true);
 }
 
+TEST_F(DBWideBasicTest, WideColumnProjection) {
+  // Small metadata columns stored next to a large payload
+  const std::string payload(1000, 'x');
+
+  constexpr char first_key[] = "first";
+  const WideColumns first_columns{{kDefaultWideColumnName, "hello"},
+                                  {"meta", "foo"},
+                                  {"payload", payload}};
+
+  constexpr char second_key[] = "second";
+  const WideColumns second_columns{{"meta", "bar"}, {"payload", payload}};
+
+  constexpr char third_key[] = "third";
+  constexpr char third_value[] = "baz";
+
+  constexpr size_t num_keys = 3;
+  const std::array<Slice, num_keys> keys{{first_key, second_key, third_key}};
+
+  const std::vector<Slice> projection{"meta", "missing"};
+  const std::array<WideColumns, num_keys> expected_columns{
+      {WideColumns{{"meta", "foo"}}, WideColumns{{"meta", "bar"}},
+       WideColumns{}}};
+
+  auto verify = [&]() {
+    ReadOptions read_options;
+    read_options.wide_column_projection = &projection;
+
+    for (size_t i = 0; i < num_keys; ++i) {
+      PinnableWideColumns result;
+      ASSERT_OK(db_->GetEntity(read_options, db_->DefaultColumnFamily(),
+                               keys[i], &result));
+      ASSERT_EQ(result.columns(), expected_columns[i]);
+    }
+
+    {
+      // The default column is still available to Get()
+      PinnableSlice result;
+      ASSERT_OK(db_->Get(read_options, db_->DefaultColumnFamily(), first_key,
+                         &result));
+      ASSERT_EQ(result, "hello");
+    }
+
+    {
+      std::array<PinnableWideColumns, num_keys> results;
+      std::array<Status, num_keys> statuses;
+
+      db_->MultiGetEntity(read_options, db_->DefaultColumnFamily(), num_keys,
+                          keys.data(), results.data(), statuses.data());
+
+      for (size_t i = 0; i < num_keys; ++i) {
+        ASSERT_OK(statuses[i]);
+        ASSERT_EQ(results[i].columns(), expected_columns[i]);
+      }
+    }
+
+    {
+      std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+
+      size_t i = 0;
+      for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++i) {
+        ASSERT_EQ(iter->key(), keys[i]);
+        ASSERT_EQ(iter->columns(), expected_columns[i]);
+      }
+      ASSERT_OK(iter->status());
+      ASSERT_EQ(i, num_keys);
+
+      for (iter->SeekToLast(); iter->Valid(); iter->Prev()) {
+        --i;
+        ASSERT_EQ(iter->key(), keys[i]);
+        ASSERT_EQ(iter->columns(), expected_columns[i]);
+      }
+      ASSERT_OK(iter->status());
+      ASSERT_EQ(i, 0);
+    }
+
+    // Reads without a projection see all columns
+    {
+      PinnableWideColumns result;
+      ASSERT_OK(db_->GetEntity(ReadOptions(), db_->DefaultColumnFamily(),
+                               first_key, &result));
+      ASSERT_EQ(result.columns(), first_columns);
+    }
+
+    {
+      std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+
+      iter->SeekToLast();
+      iter->Prev();
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_OK(iter->status());
+      ASSERT_EQ(iter->key(), second_key);
+      ASSERT_EQ(iter->columns(), second_columns);
+
+      iter->Prev();
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_OK(iter->status());
+      ASSERT_EQ(iter->key(), first_key);
+      ASSERT_EQ(iter->columns(), first_columns);
+    }
+  };
+
+  for (bool columnar_entities : {false, true}) {
+    Options options = CurrentOptions();
+    BlockBasedTableOptions table_options;
+    table_options.data_block_columnar_entities = columnar_entities;
+    options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+    DestroyAndReopen(options);
+
+    ASSERT_OK(db_->PutEntity(WriteOptions(), db_->DefaultColumnFamily(),
+                             first_key, first_columns));
+    ASSERT_OK(db_->PutEntity(WriteOptions(), db_->DefaultColumnFamily(),
+                             second_key, second_columns));
+    ASSERT_OK(db_->Put(WriteOptions(), db_->DefaultColumnFamily(), third_key,
+                       third_value));
+
+    // Try reading from memtable
+    verify();
+
+    // Try reading from storage
+    ASSERT_OK(Flush());
+
+    verify();
+  }
+}
+
 TEST_F(DBWideBasicTest, SanityChecks) {
   constexpr char foo[] = "foo";
   constexpr char bar[] = "bar";
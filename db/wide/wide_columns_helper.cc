@@ -30,6 +30,36 @@ void WideColumnsHelper::DumpWideColumns(const WideColumns& columns,
   os.flags(orig_flags);
 }
 
+void WideColumnsHelper::ProjectColumns(const std::vector<Slice>& projection,
+                                       WideColumns& columns) {
+  columns.erase(std::remove_if(columns.begin(), columns.end(),
+                               [&projection](const WideColumn& column) {
+                                 return std::find(projection.begin(),
+                                                  projection.end(),
+                                                  column.name()) ==
+                                        projection.end();
+                               }),
+                columns.end());
+}
+
+Status WideColumnsHelper::ProjectColumns(const std::vector<Slice>& projection,
+                                         PinnableWideColumns* columns) {
+  assert(columns);
+  WideColumns projected = columns->columns();
+  ProjectColumns(projection, projected);
+  if (projected.size() == columns->columns().size()) {
+    return Status::OK();
+  }
+  std::string value;
+  const Status s = WideColumnSerialization::Serialize(projected, value);
+  if (!s.ok()) {
+    return s;
+  }
+  // The value may be pinned by the block it was read from
+  columns->Reset();
+  return columns->SetWideColumnValue(std::move(value));
+}
+
 Status WideColumnsHelper::DumpSliceAsWideColumns(const Slice& value,
                                                  std::ostream& os, bool hex) {
   WideColumns columns;
@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <cassert>
 #include <ostream>
+#include <vector>
 
 #include "rocksdb/rocksdb_namespace.h"
 #include "rocksdb/wide_columns.h"
@@ -43,6 +44,16 @@ class WideColumnsHelper {
               });
   }
 
+  // Removes the columns not named in `projection` (see
+  // `ReadOptions::wide_column_projection`).
+  static void ProjectColumns(const std::vector<Slice>& projection,
+                             WideColumns& columns);
+
+  // Same as above for a query result. If any column is removed, the
+  // remaining ones are re-serialized into `columns`.
+  static Status ProjectColumns(const std::vector<Slice>& projection,
+                               PinnableWideColumns* columns);
+
   template <typename Iterator>
   static Iterator Find(Iterator begin, Iterator end, const Slice& column_name) {
     assert(std::is_sorted(begin, end,
@@ -5,6 +5,7 @@
 
 #include "db/write_thread.h"
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -28,6 +29,8 @@ WriteThread::WriteThread(const ImmutableDBOptions& db_options)
           db_options.max_write_batch_group_size_bytes),
       newest_writer_(nullptr),
       newest_memtable_writer_(nullptr),
+      newest_wal_queue_writer_(nullptr),
+      wal_queue_waiting_(false),
       last_sequence_(0),
       write_stall_dummy_(),
       stall_mu_(),
@@ -437,6 +440,107 @@ void WriteThread::JoinBatchGroup(Writer* w) {
   }
 }
 
+static WriteThread::AdaptationContext jwwq_ctx("JoinWalWriterQueue");
+void WriteThread::JoinWalWriterQueue(Writer* w) {
+  assert(enable_pipelined_write_);
+  assert(w->batch != nullptr);
+  assert(w->state == STATE_INIT);
+  assert(!w->no_slowdown);
+
+  Writer* newest = newest_wal_queue_writer_.load(std::memory_order_relaxed);
+  do {
+    w->link_older = newest;
+  } while (!newest_wal_queue_writer_.compare_exchange_weak(newest, w));
+
+  w->CheckWriteEnqueuedCallback();
+
+  // Pairs with the store to wal_queue_waiting_ before the WAL writer thread
+  // checks for an empty queue, so that one of the two sees the other.
+  if (wal_queue_waiting_.load()) {
+    std::lock_guard<std::mutex> guard(wal_queue_mu_);
+    wal_queue_cv_.notify_one();
+  }
+
+  TEST_SYNC_POINT_CALLBACK("WriteThread::JoinWalWriterQueue:Wait", w);
+  AwaitState(w,
+             STATE_GROUP_LEADER | STATE_MEMTABLE_WRITER_LEADER |
+                 STATE_PARALLEL_MEMTABLE_CALLER |
+                 STATE_PARALLEL_MEMTABLE_WRITER | STATE_COMPLETED,
+             &jwwq_ctx);
+}
+
+bool WriteThread::WaitForWalWriterQueue() {
+  if (newest_wal_queue_writer_.load(std::memory_order_acquire) != nullptr) {
+    return true;
+  }
+  std::unique_lock<std::mutex> lock(wal_queue_mu_);
+  wal_queue_waiting_.store(true);
+  while (newest_wal_queue_writer_.load() == nullptr && !wal_queue_stopped_) {
+    wal_queue_cv_.wait(lock);
+  }
+  wal_queue_waiting_.store(false, std::memory_order_relaxed);
+  return newest_wal_queue_writer_.load(std::memory_order_acquire) != nullptr;
+}
+
+void WriteThread::StopWalWriterQueue() {
+  std::lock_guard<std::mutex> guard(wal_queue_mu_);
+  wal_queue_stopped_ = true;
+  wal_queue_cv_.notify_one();
+}
+
+size_t WriteThread::LinkWalWriterQueue(Writer* leader) {
+  assert(leader->link_older == nullptr);
+  Writer* newest =
+      newest_wal_queue_writer_.exchange(nullptr, std::memory_order_acquire);
+  if (newest == nullptr) {
+    return 0;
+  }
+
+  // The queue is linked from newest to oldest. Create the newer links, and
+  // find the oldest writer.
+  size_t count = 1;
+  size_t bytes = WriteBatchInternal::ByteSize(newest->batch);
+  newest->link_newer = nullptr;
+  Writer* oldest = newest;
+  while (oldest->link_older != nullptr) {
+    oldest->link_older->link_newer = oldest;
+    oldest = oldest->link_older;
+    bytes += WriteBatchInternal::ByteSize(oldest->batch);
+    ++count;
+  }
+  leader->queued_bytes = bytes;
+
+  leader->sync = false;
+  leader->disable_wal = oldest->disable_wal;
+  leader->rate_limiter_priority = oldest->rate_limiter_priority;
+  leader->protection_bytes_per_key = oldest->protection_bytes_per_key;
+  if (!leader->disable_wal) {
+    for (Writer* w = oldest; w != nullptr; w = w->link_newer) {
+      if (w->sync) {
+        leader->sync = true;
+        break;
+      }
+    }
+  }
+
+  // Graft the queued writers between leader and any writers that have
+  // linked themselves behind leader. Only a leader modifies links of writers
+  // already in the list, so this is safe like grafting the r_list in
+  // EnterAsBatchGroupLeader.
+  oldest->link_older = leader;
+  leader->link_newer = oldest;
+  Writer* head = leader;
+  if (!newest_writer_.compare_exchange_strong(head, newest)) {
+    while (head->link_older != leader) {
+      head = head->link_older;
+    }
+    head->link_older = newest;
+    newest->link_newer = head;
+  }
+  TEST_SYNC_POINT_CALLBACK("WriteThread::LinkWalWriterQueue:End", leader);
+  return count;
+}
+
 size_t WriteThread::EnterAsBatchGroupLeader(Writer* leader,
                                             WriteGroup* write_group) {
   assert(leader->link_older == nullptr);
@@ -447,11 +551,14 @@ size_t WriteThread::EnterAsBatchGroupLeader(Writer* leader,
 
   // Allow the group to grow up to a maximum size, but if the
   // original write is small, limit the growth so we do not slow
-  // down the small write too much.
+  // down the small write too much. The nearly empty batch of a WAL writer
+  // thread placeholder does not count as small if it has writers queued
+  // behind it, which are all waiting for this group anyway.
+  const size_t leading_size = std::max(size, leader->queued_bytes);
   size_t max_size = max_write_batch_group_size_bytes;
   const uint64_t min_batch_size_bytes = max_write_batch_group_size_bytes / 8;
-  if (size <= min_batch_size_bytes) {
-    max_size = size + min_batch_size_bytes;
+  if (leading_size <= min_batch_size_bytes) {
+    max_size = leading_size + min_batch_size_bytes;
   }
 
   leader->write_group = write_group;
@@ -150,6 +150,10 @@ class WriteThread {
 
     bool ingest_wbwi;
 
+    // For the placeholder leader of the WAL writer thread, the total size of
+    // the batches of the writers LinkWalWriterQueue moved behind it
+    size_t queued_bytes;
+
     Writer()
         : batch(nullptr),
           sync(false),
@@ -170,7 +174,8 @@ class WriteThread {
           write_group(nullptr),
           sequence(kMaxSequenceNumber),
           link_older(nullptr),
-          link_newer(nullptr) {}
+          link_newer(nullptr),
+          queued_bytes(0) {}
 
     Writer(const WriteOptions& write_options, WriteBatch* _batch,
            WriteCallback* _callback, UserWriteCallback* _user_write_cb,
@@ -200,7 +205,8 @@ class WriteThread {
           sequence(kMaxSequenceNumber),
           link_older(nullptr),
           link_newer(nullptr),
-          ingest_wbwi(_ingest_wbwi) {}
+          ingest_wbwi(_ingest_wbwi),
+          queued_bytes(0) {}
 
     ~Writer() {
       if (made_waitable) {
@@ -318,6 +324,37 @@ class WriteThread {
   // Writer* w:        Writer to be executed as part of a batch group
   void JoinBatchGroup(Writer* w);
 
+  // Used instead of JoinBatchGroup when the dedicated WAL writer thread is
+  // enabled (DBOptions::enable_wal_writer_thread). Pushes w onto a lock-free
+  // queue served by that thread rather than competing to lead a batch group,
+  // and waits for the same states as JoinBatchGroup. The WAL writer thread
+  // normally writes the WAL for w, so that w continues as a memtable writer,
+  // but w can still become STATE_GROUP_LEADER if it was not compatible with
+  // the WAL writer thread's group.
+  //
+  // The db mutex SHOULD NOT be held when calling this function, because
+  // it will block.
+  void JoinWalWriterQueue(Writer* w);
+
+  // Called by the WAL writer thread. Blocks until writers have been queued by
+  // JoinWalWriterQueue, and returns true, or until StopWalWriterQueue has
+  // been called and no writers are left, and returns false.
+  bool WaitForWalWriterQueue();
+
+  // Wakes up the WAL writer thread to exit once the queue is empty.
+  void StopWalWriterQueue();
+
+  // Called by the WAL writer thread while leading a batch group with leader,
+  // before EnterAsBatchGroupLeader. Moves all writers queued by
+  // JoinWalWriterQueue into the writer list right behind leader, oldest
+  // first, and adjusts the options of leader to those of the oldest queued
+  // writer so that they are batched together. Any sync write among them
+  // makes leader sync, so that its group is synced once. Writers not fitting
+  // in the group stay in the writer list and are led by their own threads.
+  // The group may grow as if the queued writers had led it (see
+  // Writer::queued_bytes). Returns the number of writers moved.
+  size_t LinkWalWriterQueue(Writer* leader);
+
   // Constructs a write batch group led by leader, which should be a
   // Writer passed to JoinBatchGroup on the current thread.
   //
@@ -436,6 +473,19 @@ class WriteThread {
   // write is enabled.
   std::atomic<Writer*> newest_memtable_writer_;
 
+  // Points to the newest writer queued for the WAL writer thread, linked
+  // through link_older. Only the WAL writer thread can remove elements,
+  // adding can be done lock-free by anybody.
+  std::atomic<Writer*> newest_wal_queue_writer_;
+
+  // Mutex and condvar for the WAL writer thread to block on an empty queue.
+  // Writers only take the mutex to wake it up if it announced that it is
+  // about to block.
+  std::mutex wal_queue_mu_;
+  std::condition_variable wal_queue_cv_;
+  std::atomic<bool> wal_queue_waiting_;
+  bool wal_queue_stopped_ = false;
+
   // The last sequence that have been consumed by a writer. The sequence
   // is not necessary visible to reads because the writer can be ongoing.
   SequenceNumber last_sequence_;
@@ -96,7 +96,9 @@ DECLARE_int32(threads);
 DECLARE_int32(ttl);
 DECLARE_int32(value_size_mult);
 DECLARE_int32(compaction_readahead_size);
+DECLARE_bool(compaction_async_io);
 DECLARE_bool(enable_pipelined_write);
+DECLARE_bool(enable_wal_writer_thread);
 DECLARE_bool(verify_before_write);
 DECLARE_bool(histogram);
 DECLARE_bool(destroy_db_initially);
@@ -153,8 +155,11 @@ DECLARE_bool(decouple_partitioned_filters);
 DECLARE_int32(top_level_index_pinning);
 DECLARE_int32(partition_pinning);
 DECLARE_int32(unpartitioned_pinning);
+DECLARE_uint64(adaptive_metadata_pinning_budget);
 DECLARE_string(cache_type);
 DECLARE_uint64(subcompactions);
+DECLARE_uint32(subcompaction_ranges_per_thread);
+DECLARE_bool(preempt_bottommost_compactions);
 DECLARE_uint64(periodic_compaction_seconds);
 DECLARE_string(daily_offpeak_time_utc);
 DECLARE_uint64(compaction_ttl);
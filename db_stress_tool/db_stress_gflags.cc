@@ -126,8 +126,14 @@ DEFINE_int32(value_size_mult, 8,
 
 DEFINE_int32(compaction_readahead_size, 0, "Compaction readahead size");
 
+DEFINE_bool(compaction_async_io, false,
+            "Read ahead compaction inputs with async IO");
+
 DEFINE_bool(enable_pipelined_write, false, "Pipeline WAL/memtable writes");
 
+DEFINE_bool(enable_wal_writer_thread, false,
+            "Write the WAL from a dedicated thread with pipelined writes");
+
 DEFINE_bool(verify_before_write, false, "Verify before write");
 
 DEFINE_bool(histogram, false, "Print histogram of operation timings");
@@ -389,12 +395,29 @@ DEFINE_int32(
     "Type of pinning for unpartitioned metadata blocks (see `enum PinningTier` "
     "in table.h)");
 
+DEFINE_uint64(
+    adaptive_metadata_pinning_budget,
+    ROCKSDB_NAMESPACE::BlockBasedTableOptions()
+        .adaptive_metadata_pinning_budget,
+    "Budget for pinning the metadata blocks of the most frequently accessed "
+    "tables (see `BlockBasedTableOptions::adaptive_metadata_pinning_budget`)");
+
 DEFINE_string(cache_type, "lru_cache", "Type of block cache.");
 
 DEFINE_uint64(subcompactions, 1,
               "Maximum number of subcompactions to divide L0-L1 compactions "
               "into.");
 
+DEFINE_uint32(subcompaction_ranges_per_thread,
+              ROCKSDB_NAMESPACE::Options().subcompaction_ranges_per_thread,
+              "Number of key ranges per subcompaction thread to split "
+              "compactions into.");
+
+DEFINE_bool(preempt_bottommost_compactions,
+            ROCKSDB_NAMESPACE::Options().preempt_bottommost_compactions,
+            "Preempt bottommost compactions for urgent flushes and L0 "
+            "compactions during write stalls.");
+
 DEFINE_uint64(periodic_compaction_seconds, 1000,
               "Files older than this value will be picked up for compaction.");
 DEFINE_string(daily_offpeak_time_utc, "",
@@ -298,6 +298,8 @@ bool StressTest::BuildOptionsTable() {
            std::to_string(options_.write_buffer_size / 8),
        }},
       {"memtable_huge_page_size", {"0", std::to_string(2 * 1024 * 1024)}},
+      {"memtable_use_transparent_huge_pages", {"false", "true"}},
+      {"memtable_prefault_arena", {"false", "true"}},
       {"strict_max_successive_merges", {"false", "true"}},
       {"inplace_update_num_locks", {"100", "200", "300"}},
       // TODO: re-enable once internal task T124324915 is fixed.
@@ -3994,6 +3996,8 @@ void InitializeOptionsFromFlags(
       static_cast<PinningTier>(FLAGS_partition_pinning);
   block_based_options.metadata_cache_options.unpartitioned_pinning =
       static_cast<PinningTier>(FLAGS_unpartitioned_pinning);
+  block_based_options.adaptive_metadata_pinning_budget =
+      static_cast<size_t>(FLAGS_adaptive_metadata_pinning_budget);
   block_based_options.checksum = checksum_type_e;
   block_based_options.block_size = FLAGS_block_size;
   block_based_options.cache_usage_options.options_overrides.insert(
@@ -4098,6 +4102,7 @@ void InitializeOptionsFromFlags(
   options.env = db_stress_env;
   options.use_fsync = FLAGS_use_fsync;
   options.compaction_readahead_size = FLAGS_compaction_readahead_size;
+  options.compaction_async_io = FLAGS_compaction_async_io;
   options.allow_mmap_reads = FLAGS_mmap_read;
   options.allow_mmap_writes = FLAGS_mmap_write;
   options.use_direct_reads = FLAGS_use_direct_reads;
@@ -4137,6 +4142,9 @@ void InitializeOptionsFromFlags(
   }
   options.max_manifest_file_size = FLAGS_max_manifest_file_size;
   options.max_subcompactions = static_cast<uint32_t>(FLAGS_subcompactions);
+  options.subcompaction_ranges_per_thread =
+      FLAGS_subcompaction_ranges_per_thread;
+  options.preempt_bottommost_compactions = FLAGS_preempt_bottommost_compactions;
   options.allow_concurrent_memtable_write =
       FLAGS_allow_concurrent_memtable_write;
   options.experimental_mempurge_threshold =
@@ -4147,6 +4155,7 @@ void InitializeOptionsFromFlags(
       static_cast<unsigned int>(FLAGS_stats_dump_period_sec);
   options.ttl = FLAGS_compaction_ttl;
   options.enable_pipelined_write = FLAGS_enable_pipelined_write;
+  options.enable_wal_writer_thread = FLAGS_enable_wal_writer_thread;
   options.enable_write_thread_adaptive_yield =
       FLAGS_enable_write_thread_adaptive_yield;
   options.compaction_options_universal.size_ratio = FLAGS_universal_size_ratio;
@@ -0,0 +1,219 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "file/async_writable_file.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+
+#include "port/port.h"
+#include "rocksdb/file_system.h"
+
+namespace ROCKSDB_NAMESPACE {
+namespace {
+class AsyncWritableFile : public FSWritableFileOwnerWrapper {
+ public:
+  AsyncWritableFile(std::unique_ptr<FSWritableFile>&& file,
+                    size_t max_buffers_in_flight)
+      : FSWritableFileOwnerWrapper(std::move(file)),
+        max_buffers_in_flight_(std::max<size_t>(max_buffers_in_flight, 1)),
+        thread_([this] { BackgroundAppend(); }) {}
+
+  AsyncWritableFile(const AsyncWritableFile&) = delete;
+  AsyncWritableFile& operator=(const AsyncWritableFile&) = delete;
+
+  ~AsyncWritableFile() override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+    status_.PermitUncheckedError();
+  }
+
+  IOStatus Append(const Slice& data, const IOOptions& options,
+                  IODebugContext* /*dbg*/) override {
+    return Enqueue(data, options, nullptr);
+  }
+
+  IOStatus Append(const Slice& data, const IOOptions& options,
+                  const DataVerificationInfo& verification_info,
+                  IODebugContext* /*dbg*/) override {
+    return Enqueue(data, options, &verification_info);
+  }
+
+  IOStatus PositionedAppend(const Slice& data, uint64_t offset,
+                            const IOOptions& options,
+                            IODebugContext* dbg) override {
+    IOStatus s = WaitForAppends();
+    return s.ok() ? target()->PositionedAppend(data, offset, options, dbg) : s;
+  }
+
+  IOStatus PositionedAppend(const Slice& data, uint64_t offset,
+                            const IOOptions& options,
+                            const DataVerificationInfo& verification_info,
+                            IODebugContext* dbg) override {
+    IOStatus s = WaitForAppends();
+    return s.ok() ? target()->PositionedAppend(data, offset, options,
+                                               verification_info, dbg)
+                  : s;
+  }
+
+  IOStatus Truncate(uint64_t size, const IOOptions& options,
+                    IODebugContext* dbg) override {
+    IOStatus s = WaitForAppends();
+    return s.ok() ? target()->Truncate(size, options, dbg) : s;
+  }
+
+  IOStatus Close(const IOOptions& options, IODebugContext* dbg) override {
+    IOStatus s = WaitForAppends();
+    IOStatus close_s = target()->Close(options, dbg);
+    return s.ok() ? close_s : s;
+  }
+
+  IOStatus Flush(const IOOptions& options, IODebugContext* dbg) override {
+    IOStatus s = WaitForAppends();
+    return s.ok() ? target()->Flush(options, dbg) : s;
+  }
+
+  IOStatus Sync(const IOOptions& options, IODebugContext* dbg) override {
+    IOStatus s = WaitForAppends();
+    return s.ok() ? target()->Sync(options, dbg) : s;
+  }
+
+  IOStatus Fsync(const IOOptions& options, IODebugContext* dbg) override {
+    IOStatus s = WaitForAppends();
+    return s.ok() ? target()->Fsync(options, dbg) : s;
+  }
+
+  // Sync() waits for appends of the writing thread
+  bool IsSyncThreadSafe() const override { return false; }
+
+  void SetIOPriority(Env::IOPriority pri) override {
+    target()->SetIOPriority(pri);
+  }
+
+  Env::IOPriority GetIOPriority() override {
+    return target()->GetIOPriority();
+  }
+
+  uint64_t GetFileSize(const IOOptions& options,
+                       IODebugContext* dbg) override {
+    WaitForAppends().PermitUncheckedError();
+    return target()->GetFileSize(options, dbg);
+  }
+
+  IOStatus InvalidateCache(size_t offset, size_t length) override {
+    IOStatus s = WaitForAppends();
+    return s.ok() ? target()->InvalidateCache(offset, length) : s;
+  }
+
+  IOStatus RangeSync(uint64_t offset, uint64_t nbytes,
+                     const IOOptions& options, IODebugContext* dbg) override {
+    IOStatus s = WaitForAppends();
+    return s.ok() ? target()->RangeSync(offset, nbytes, options, dbg) : s;
+  }
+
+  IOStatus Allocate(uint64_t offset, uint64_t len, const IOOptions& options,
+                    IODebugContext* dbg) override {
+    IOStatus s = WaitForAppends();
+    return s.ok() ? target()->Allocate(offset, len, options, dbg) : s;
+  }
+
+ private:
+  struct PendingAppend {
+    std::string data;
+    IOOptions options;
+    bool has_checksum = false;
+    std::string checksum;
+  };
+
+  IOStatus Enqueue(const Slice& data, const IOOptions& options,
+                   const DataVerificationInfo* verification_info) {
+    PendingAppend append;
+    append.data.assign(data.data(), data.size());
+    append.options = options;
+    if (verification_info != nullptr) {
+      append.has_checksum = true;
+      append.checksum = verification_info->checksum.ToString();
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] {
+      return !status_.ok() || pending_.size() < max_buffers_in_flight_;
+    });
+    if (!status_.ok()) {
+      return status_;
+    }
+    pending_.push_back(std::move(append));
+    lock.unlock();
+    cv_.notify_all();
+    return IOStatus::OK();
+  }
+
+  // Returns the first error of the appends so far
+  IOStatus WaitForAppends() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return pending_.empty() && !appending_; });
+    return status_;
+  }
+
+  void BackgroundAppend() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      cv_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+      if (pending_.empty()) {
+        // Stopping
+        return;
+      }
+      PendingAppend append = std::move(pending_.front());
+      pending_.pop_front();
+      appending_ = true;
+      lock.unlock();
+      // Let the writer queue the next buffer while this one is written
+      cv_.notify_all();
+      IOStatus s;
+      if (append.has_checksum) {
+        DataVerificationInfo verification_info;
+        verification_info.checksum = Slice(append.checksum);
+        s = target()->Append(append.data, append.options, verification_info,
+                             nullptr);
+      } else {
+        s = target()->Append(append.data, append.options, nullptr);
+      }
+      lock.lock();
+      appending_ = false;
+      if (!s.ok()) {
+        if (status_.ok()) {
+          status_ = s;
+        }
+        // Nothing after a failed append can be written
+        pending_.clear();
+      }
+      cv_.notify_all();
+    }
+  }
+
+  const size_t max_buffers_in_flight_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<PendingAppend> pending_;
+  bool appending_ = false;
+  bool stopping_ = false;
+  IOStatus status_;
+  // Last, so that it starts with the members above initialized
+  port::Thread thread_;
+};
+}  // namespace
+
+std::unique_ptr<FSWritableFile> NewAsyncWritableFile(
+    std::unique_ptr<FSWritableFile>&& file, size_t max_buffers_in_flight) {
+  return std::make_unique<AsyncWritableFile>(std::move(file),
+                                             max_buffers_in_flight);
+}
+}  // namespace ROCKSDB_NAMESPACE
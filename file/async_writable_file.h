@@ -0,0 +1,26 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+#include <memory>
+
+#include "rocksdb/rocksdb_namespace.h"
+
+namespace ROCKSDB_NAMESPACE {
+class FSWritableFile;
+
+// NewAsyncWritableFile provides a wrapper over FSWritableFile that hands
+// appended data to a background thread, which appends it to `file` in order.
+// Up to `max_buffers_in_flight` appends are queued before Append() waits, so
+// the writer (e.g. a compaction filling the next WritableFileWriter buffer)
+// keeps working while the file system writes the previous ones. Other
+// operations, such as Flush(), Sync() and Close(), first wait for the queued
+// appends. An error from a background append is returned by the next
+// operation. Not for use with direct I/O, whose buffers are positioned and
+// aligned by the caller. Used for compaction outputs with
+// DBOptions::compaction_async_io.
+std::unique_ptr<FSWritableFile> NewAsyncWritableFile(
+    std::unique_ptr<FSWritableFile>&& file, size_t max_buffers_in_flight);
+}  // namespace ROCKSDB_NAMESPACE
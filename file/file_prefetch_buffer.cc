@@ -158,6 +158,8 @@ Status FilePrefetchBuffer::ReadAsync(BufferInfo* buf, const IOOptions& opts,
   if (s.ok()) {
     if (usage_ == FilePrefetchBufferUsage::kUserScanPrefetch) {
       RecordTick(stats_, PREFETCH_BYTES, read_len);
+    } else if (usage_ == FilePrefetchBufferUsage::kCompactionPrefetch) {
+      RecordInHistogram(stats_, COMPACTION_PREFETCH_BYTES, read_len);
     }
     buf->async_read_in_progress_ = true;
   }
@@ -775,12 +777,6 @@ bool FilePrefetchBuffer::TryReadFromCache(const IOOptions& opts,
 bool FilePrefetchBuffer::TryReadFromCacheUntracked(
     const IOOptions& opts, RandomAccessFileReader* reader, uint64_t offset,
     size_t n, Slice* result, Status* status, bool for_compaction) {
-  // We disallow async IO for compaction reads since they are performed in
-  // the background anyways and are less latency sensitive compared to
-  // user-initiated reads
-  (void)for_compaction;
-  assert(!for_compaction || num_buffers_ == 1);
-
   if (track_min_offset_ && offset < min_offset_read_) {
     min_offset_read_ = static_cast<size_t>(offset);
   }
@@ -393,6 +393,121 @@ TEST_P(PrefetchTest, Basic) {
   Close();
 }
 
+TEST_P(PrefetchTest, CompactionAsyncIO) {
+  // File system supporting async IO even without io_uring, by completing
+  // ReadAsync() requests synchronously like the default implementation
+  class SyncReadAsyncFS : public FileSystemWrapper {
+   public:
+    explicit SyncReadAsyncFS(const std::shared_ptr<FileSystem>& _target)
+        : FileSystemWrapper(_target) {}
+    const char* Name() const override { return "SyncReadAsyncFS"; }
+
+    IOStatus NewRandomAccessFile(const std::string& fname,
+                                 const FileOptions& opts,
+                                 std::unique_ptr<FSRandomAccessFile>* result,
+                                 IODebugContext* dbg) override {
+      class WrappedRandomAccessFile : public FSRandomAccessFileOwnerWrapper {
+       public:
+        explicit WrappedRandomAccessFile(
+            std::unique_ptr<FSRandomAccessFile>& file)
+            : FSRandomAccessFileOwnerWrapper(std::move(file)) {}
+
+        IOStatus ReadAsync(FSReadRequest& req, const IOOptions& opts,
+                           std::function<void(FSReadRequest&, void*)> cb,
+                           void* cb_arg, void** io_handle,
+                           IOHandleDeleter* del_fn,
+                           IODebugContext* dbg) override {
+          return FSRandomAccessFile::ReadAsync(req, opts, cb, cb_arg,
+                                               io_handle, del_fn, dbg);
+        }
+      };
+
+      std::unique_ptr<FSRandomAccessFile> file;
+      IOStatus s = target()->NewRandomAccessFile(fname, opts, &file, dbg);
+      if (s.ok()) {
+        result->reset(new WrappedRandomAccessFile(file));
+      }
+      return s;
+    }
+
+    void SupportedOps(int64_t& supported_ops) override {
+      supported_ops = 1 << FSSupportedOps::kAsyncIO;
+    }
+  };
+
+  // First param is if the wrapped mockFS supports prefetch or not, which
+  // async IO compaction reads should not use
+  bool support_prefetch =
+      std::get<0>(GetParam()) &&
+      test::IsPrefetchSupported(env_->GetFileSystem(), dbname_);
+  std::shared_ptr<MockFS> mock_fs =
+      std::make_shared<MockFS>(env_->GetFileSystem(), support_prefetch);
+  std::shared_ptr<FileSystem> fs =
+      std::make_shared<SyncReadAsyncFS>(mock_fs);
+
+  // Second param is if directIO is enabled or not
+  bool use_direct_io = std::get<1>(GetParam());
+
+  std::unique_ptr<Env> env(new CompositeEnvWrapper(env_, fs));
+  Options options;
+  SetGenericOptions(env.get(), use_direct_io, options);
+  options.statistics = CreateDBStatistics();
+  options.compaction_async_io = true;
+  options.compaction_readahead_size = 32 * 1024;
+
+  int read_async_count = 0;
+  SyncPoint::GetInstance()->SetCallBack("FilePrefetchBuffer::ReadAsync",
+                                        [&](void*) { read_async_count++; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  Status s = TryReopen(options);
+  if (use_direct_io && (s.IsNotSupported() || s.IsInvalidArgument())) {
+    // If direct IO is not supported, skip the test
+    return;
+  } else {
+    ASSERT_OK(s);
+  }
+
+  // Two overlapping files, large enough for several readahead windows each
+  const int kNumKeys = 2000;
+  Random rnd(301);
+  for (const char* prefix : {"key1", "key2"}) {
+    WriteBatch batch;
+    for (int i = 0; i < kNumKeys; i++) {
+      ASSERT_OK(batch.Put(BuildKey(i), prefix + rnd.RandomString(100)));
+    }
+    ASSERT_OK(db_->Write(WriteOptions(), &batch));
+    ASSERT_OK(db_->Flush(FlushOptions()));
+  }
+  ASSERT_EQ(0, read_async_count);
+  mock_fs->ClearPrefetchCount();
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ("0,1", FilesPerLevel());
+
+  ASSERT_GT(read_async_count, 0);
+  HistogramData compaction_prefetch_bytes;
+  options.statistics->histogramData(COMPACTION_PREFETCH_BYTES,
+                                    &compaction_prefetch_bytes);
+  ASSERT_GT(compaction_prefetch_bytes.count, read_async_count);
+  // Only the output file's tail is prefetched through the file system
+  ASSERT_LE(mock_fs->GetPrefetchCount(), 1);
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  auto iter = std::unique_ptr<Iterator>(db_->NewIterator(ReadOptions()));
+  int num_keys = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    ASSERT_TRUE(iter->value().starts_with("key2"));
+    num_keys++;
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(num_keys, kNumKeys);
+  iter.reset();
+  Close();
+}
+
 class PrefetchTailTest : public PrefetchTest {
  public:
   bool SupportPrefetch() const {
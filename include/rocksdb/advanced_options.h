@@ -130,6 +130,26 @@ struct CompactionOptionsFIFO {
   // not be used. The minmum buffer size must be at least 4KiB
   uint64_t trivial_copy_buffer_size = 4096;
 
+  // EXPERIMENTAL
+  // When not 0, size-based deletion of the oldest files gives a second chance
+  // to recently read data, for using the DB as a cache of which only the
+  // working set should be retained. Among the oldest files picked for
+  // deletion, those read at least this many times since they were written (as
+  // estimated by read sampling, see `SstFileMetaData::num_reads_sampled`) are
+  // considered hot. If some of the picked files are hot, rather than deleting
+  // all of them, they are compacted together keeping only the keys whose
+  // latest version is in a hot file, and dropping the others without writing
+  // tombstones. Blob files referenced only by dropped keys become garbage.
+  // The compaction output starts out unread, so it is deleted the next time it
+  // is picked unless read again meanwhile. If all the picked files are hot,
+  // they are deleted as usual, so that max_table_files_size is still
+  // enforced. TTL-based deletion is not affected.
+  //
+  // Only applies when all files are in L0.
+  //
+  // Default: 0 (disabled)
+  uint64_t min_reads_to_retain = 0;
+
   CompactionOptionsFIFO() : max_table_files_size(1 * 1024 * 1024 * 1024) {}
   CompactionOptionsFIFO(uint64_t _max_table_files_size, bool _allow_compaction)
       : max_table_files_size(_max_table_files_size),
@@ -360,6 +380,32 @@ struct AdvancedColumnFamilyOptions {
   // Dynamically changeable through SetOptions() API
   size_t memtable_huge_page_size = 0;
 
+  // If true, the arena used by the memtable allocates its blocks with mmap,
+  // aligned to huge pages and advised to use transparent huge pages
+  // (MADV_HUGEPAGE), which reduces TLB misses on inserts and reads. Unlike
+  // memtable_huge_page_size, no huge pages need to be reserved, but
+  // transparent huge pages must be enabled as "madvise" or "always" in
+  // /sys/kernel/mm/transparent_hugepage/enabled. Only takes effect on
+  // platforms supporting MADV_HUGEPAGE, and when arena_block_size is at least
+  // 2MB; arena blocks are rounded up to a multiple of 2MB. If
+  // memtable_huge_page_size is also set, huge page TLB is tried first.
+  //
+  // Default: false
+  //
+  // Dynamically changeable through SetOptions() API
+  bool memtable_use_transparent_huge_pages = false;
+
+  // If true, each arena block of the memtable is faulted in as soon as it is
+  // allocated, and a new memtable allocates its first block when it is
+  // created rather than on the first insert. This moves page faults off the
+  // write path, at the cost of a memtable using one arena block of memory
+  // (see arena_block_size) even while it is empty.
+  //
+  // Default: false
+  //
+  // Dynamically changeable through SetOptions() API
+  bool memtable_prefault_arena = false;
+
   // If non-nullptr, memtable will use the specified function to extract
   // prefixes for keys, and for each prefix maintain a hint of insert location
   // to reduce CPU usage for inserting keys with the prefix. Keys out of
@@ -558,6 +604,24 @@ struct AdvancedColumnFamilyOptions {
   // Default: true
   bool level_compaction_dynamic_level_bytes = true;
 
+  // EXPERIMENTAL
+  // For leveled compaction only. If positive, L0 is compacted per key range,
+  // where a key range is a group of mutually overlapping L0 files, choosing
+  // between leveled and tiered merging for each range. A range whose L0 data
+  // overlaps more than `level_compaction_l0_tiering_ratio` times as many
+  // bytes in the base level is merged within L0 instead of into the base
+  // level, deferring the base level rewrite until enough data accumulated to
+  // amortize it. Other ranges are compacted into the base level as usual.
+  // Ranges with the highest write rate, estimated from the creation times of
+  // their L0 files, are compacted first.
+  //
+  // This suits workloads mixing a small, frequently overwritten key range,
+  // which gets deduplicated in L0 rather than repeatedly rewriting its base
+  // level files, with a large, cold key range.
+  //
+  // Default: 0 (disabled)
+  double level_compaction_l0_tiering_ratio = 0;
+
   // Default: 10.
   //
   // Dynamically changeable through SetOptions() API
@@ -243,6 +243,20 @@ struct LRUCacheOptions : public ShardedCacheOptions {
   // -DROCKSDB_DEFAULT_TO_ADAPTIVE_MUTEX, false otherwise.
   bool use_adaptive_mutex = kDefaultToAdaptiveMutex;
 
+  // EXPERIMENTAL: If true, on a host with multiple NUMA nodes the shards are
+  // split into one group per node. An entry is inserted into a shard of the
+  // group for the NUMA node the inserting thread runs on, replacing any entry
+  // for the key in the groups of other nodes, and lookups probe the local
+  // group first, falling back on the groups of remote nodes. This keeps most
+  // hits node-local when threads on each node have their own working set, at
+  // the cost of extra probes on inserts and misses. Pair with a node-local
+  // memory_allocator (see NewNumaMemoryAllocator()) so that entry memory is
+  // also node-local.
+  //
+  // Only in effect when RocksDB is built with NUMA support and
+  // num_shard_bits gives each node at least one shard; no effect otherwise.
+  bool numa_aware = false;
+
   LRUCacheOptions() {}
   LRUCacheOptions(size_t _capacity, int _num_shard_bits,
                   bool _strict_capacity_limit, double _high_pri_pool_ratio,
@@ -0,0 +1,91 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rocksdb/customizable.h"
+#include "rocksdb/rocksdb_namespace.h"
+#include "rocksdb/slice.h"
+#include "rocksdb/status.h"
+#include "rocksdb/types.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// CompactionValueTransformer rewrites the values written by compaction in
+// batches, knowing which level and temperature they are written to. Unlike
+// CompactionFilter, which is called for one key at a time, it is handed a
+// vector of entries, so it can amortize per-call overhead, run vectorized
+// kernels over the whole batch or spread the work over its own threads before
+// returning. It can be used, for example, to store data with less precision
+// or at a lower resolution once it reaches the last level.
+//
+// Only plain values (written with Put) are passed to the transformer. Other
+// entries, e.g. deletions, merge operands, wide-column entities and values
+// stored in blob files, are written unchanged. The transformer cannot drop
+// entries or change keys; use a CompactionFilter for that. When both are
+// configured, the transformer sees the values left by the compaction filter.
+//
+// A single instance is shared by all compactions of the column family, so
+// Transform() may be called from different threads concurrently and must be
+// thread-safe.
+//
+// Exceptions MUST NOT propagate out of overridden functions into RocksDB,
+// because RocksDB is not exception-safe. This could cause undefined behavior
+// including data loss, unreported corruption, deadlocks, and more.
+class CompactionValueTransformer : public Customizable {
+ public:
+  // Where the entries of a batch are written to. All entries of a batch go to
+  // the same level.
+  struct Context {
+    uint32_t column_family_id = 0;
+    // Level of the output files
+    int output_level = 0;
+    // Temperature the output files are created with
+    Temperature output_temperature = Temperature::kUnknown;
+    // Whether no older data for the keys exists below `output_level`
+    bool is_bottommost_level = false;
+    // Whether the compaction was requested by the user
+    bool is_manual_compaction = false;
+  };
+
+  struct Entry {
+    // The user key, including the timestamp if user-defined timestamps are
+    // enabled
+    Slice key;
+    Slice value;
+    // To change the value, assign the new value to `new_value` and set
+    // `value_changed`. The new value may have a different size. `new_value`
+    // may hold data from a previous batch and is only read if `value_changed`.
+    std::string new_value;
+    bool value_changed = false;
+  };
+
+  ~CompactionValueTransformer() override {}
+  static const char* Type() { return "CompactionValueTransformer"; }
+  static Status CreateFromString(
+      const ConfigOptions& config_options, const std::string& value,
+      std::shared_ptr<CompactionValueTransformer>* result);
+
+  // Returns a name that identifies this transformer.
+  const char* Name() const override = 0;
+
+  // Called with up to GetMaxBatchSize() entries in key order. Entries whose
+  // `value_changed` is left false are written as they are. A non-OK status
+  // fails the compaction.
+  virtual Status Transform(const Context& context,
+                           std::vector<Entry>* entries) const = 0;
+
+  // The number of compaction output entries buffered before calling
+  // Transform(). Larger batches amortize more overhead but hold more entries
+  // in memory per running subcompaction.
+  virtual size_t GetMaxBatchSize() const { return 256; }
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,18 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+#pragma once
+
+#include "rocksdb/rocksdb_namespace.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Runs a compaction scheduled through a CompactionService, as a worker of
+// NewLocalCompactionService(). Run with --help for the arguments.
+class CompactionWorkerTool {
+ public:
+  int Run(int argc, char const* const* argv);
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -33,6 +33,25 @@ enum CompressionType : unsigned char {
   kDisableCompressionOption = 0xff,
 };
 
+// EXPERIMENTAL
+// A reversible transform of a block's data before compressing it, for data
+// made of fixed-size numeric elements such as arrays of floats or quantized
+// tensors, which compress poorly as is because the bytes of the elements are
+// interleaved. See CompressionOptions::pre_compression_transform.
+enum class PreCompressionTransform : unsigned char {
+  kNone = 0x0,
+  // Groups together the first bytes of all the elements, then the second
+  // bytes, etc. (like the blosc "shuffle" filter), e.g. making the exponent
+  // bytes of floats form long, mostly repeating runs.
+  kByteShuffle = 0x1,
+  // Byte shuffle, followed by a transpose of the bits of each 16 bytes, for
+  // data with few varying bits in each byte (like blosc "bitshuffle").
+  kBitShuffle = 0x2,
+  // Replaces each element with its XOR with the previous element, followed
+  // by byte shuffle, for slowly varying floating point values.
+  kXorDelta = 0x3,
+};
+
 // Compression options for different compression algorithms like Zlib
 struct CompressionOptions {
   // ==> BEGIN options that can be set by deprecated configuration syntax, <==
@@ -170,6 +189,51 @@ struct CompressionOptions {
   // decompression.
   bool checksum = false;
 
+  // EXPERIMENTAL
+  // When non-zero, the compression of each data block is chosen adaptively
+  // instead of always using the configured compression type. A cheap sampled
+  // estimate of each block's compressibility is taken first, and blocks not
+  // expected to meet max_compressed_bytes_per_kb are stored uncompressed
+  // without attempting compression. The configured type is used for at most
+  // this percentage of the bytes of the remaining data blocks, and a fast
+  // type (LZ4, or else Snappy, if supported) for the rest, bounding the CPU
+  // spent on a strong but slow compression such as ZSTD. 100 only skips the
+  // blocks estimated incompressible. Values above 100 are rejected. The number of data blocks stored with
+  // each compression type is recorded in the table property
+  // "rocksdb.data.block.compression.counts". Ignored when dictionary
+  // compression is used (max_dict_bytes > 0).
+  uint32_t adaptive_compression_budget_pct = 0;
+
+  // EXPERIMENTAL
+  // A transform applied to each data block before compressing it, for values
+  // of fixed-size numeric elements of `pre_compression_element_size` bytes
+  // (1, 2, 4 or 8; e.g. 2 for fp16 data). Index, filter and meta blocks are
+  // not transformed. The transform is recorded with the compression type in
+  // each block trailer (and in the header of blob files, which also use these
+  // two options), so readers invert it regardless of the current options.
+  // Requires BlockBasedTableOptions::format_version >= 7 (so that older
+  // RocksDB versions refuse the files) and the built-in compressions, and is
+  // not applied with dictionary compression.
+  PreCompressionTransform pre_compression_transform =
+      PreCompressionTransform::kNone;
+  uint32_t pre_compression_element_size = 4;
+
+  // EXPERIMENTAL
+  // With dictionary compression (max_dict_bytes > 0), share trained
+  // dictionaries among the table files of the column family built by flushes
+  // and compactions, instead of training one for each file from its own
+  // buffered data blocks. Such files sample some of their data blocks, and a
+  // new dictionary is trained in the background whenever zstd_max_train_bytes
+  // (or max_dict_bytes) of samples are collected. Files are compressed with
+  // the latest dictionary as they are built, so no data blocks are buffered,
+  // and files built before the first dictionary is trained use none. Each
+  // file still stores the dictionary it uses, and records its ID in the
+  // "rocksdb.compression.dict.id" table property. Dictionaries are kept per
+  // compression config, so e.g. files using bottommost_compression_opts share
+  // their own. Readers share the digested form of identical dictionaries
+  // among files, accounted in "rocksdb.estimate-table-readers-mem".
+  bool use_shared_dict = false;
+
   // A convenience function for setting max_compressed_bytes_per_kb based on a
   // minimum acceptable compression ratio (uncompressed size over compressed
   // size).
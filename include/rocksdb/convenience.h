@@ -454,6 +454,21 @@ Status DeleteFilesInRanges(DB* db, ColumnFamilyHandle* column_family,
                            const RangeOpt* ranges, size_t n,
                            bool include_end = true);
 
+// Deletes the keys in [begin, end) like DB::DeleteRange(), but also drops
+// the files entirely in the range with DeleteFilesInRanges(), so their space
+// is reclaimed without compaction. If all files with keys in the range can be
+// dropped (none in L0, being compacted or extending past the range), they are
+// dropped first and a range tombstone is only written if keys in the range
+// remain afterwards in the memtables. Otherwise the range tombstone is written
+// before dropping files. Keeping the ranges deleted this way in files of
+// their own, e.g. with NewSstPartitionerPrefixFactory() and one range per
+// prefix, lets most deletions complete without leaving a range tombstone.
+// As with DeleteFilesInRanges(), snapshots before the delete might not see
+// the data in the range. User-defined timestamps are not supported.
+Status DeleteRangeByDroppingFiles(DB* db, ColumnFamilyHandle* column_family,
+                                  const WriteOptions& write_options,
+                                  const Slice& begin, const Slice& end);
+
 // DEPRECATED
 struct RangePtr {
   // In case of user_defined timestamp, if enabled, `start` and `limit` should
@@ -1255,7 +1255,9 @@ class DB {
 
     //  "rocksdb.estimate-table-readers-mem" - returns estimated memory used for
     //      reading SST tables, excluding memory used in block cache (e.g.,
-    //      filter and index blocks).
+    //      filter and index blocks). Includes the compression dictionaries
+    //      shared among the SST files of the column family (see
+    //      CompressionOptions::use_shared_dict).
     static const std::string kEstimateTableReadersMem;
 
     //  "rocksdb.is-file-deletions-enabled" - returns 0 if deletion of obsolete
@@ -2005,6 +2007,16 @@ class DB {
   virtual Status IngestExternalFiles(
       const std::vector<IngestExternalFileArg>& args) = 0;
 
+  // Reserves `num` consecutive file numbers, starting at `*first_file_number`,
+  // for blob files written by SstFileWriter::OpenWithBlobFile(). The DB does
+  // not use them for its own files, and each of them can be taken by one
+  // ingested blob file until the DB is closed. A number is given back if the
+  // ingestion fails.
+  virtual Status ReserveFileNumbers(uint64_t /*num*/,
+                                    uint64_t* /*first_file_number*/) {
+    return Status::NotSupported("ReserveFileNumbers not implemented.");
+  }
+
   // CreateColumnFamilyWithImport() will create a new column family with
   // column_family_name and import external SST files specified in `metadata`
   // into this column family.
@@ -209,4 +209,28 @@ const FilterPolicy* NewBloomFilterPolicy(
 FilterPolicy* NewRibbonFilterPolicy(double bloom_equivalent_bits_per_key,
                                     int bloom_before_level = 0);
 
+// A filter policy for tables mostly read with short range scans, such as
+// "any key in [a, b)?" queries that do not line up with a prefix_extractor.
+// Along with a Bloom filter for point queries (bloom_equivalent_bits_per_key
+// as in NewBloomFilterPolicy), each filter stores the shortest prefixes
+// telling its keys apart (like a SuRF-Real truncated trie), so that a forward
+// iterator Seek() with ReadOptions::iterate_upper_bound skips table files
+// (or filter partitions) with no key in [seek key, upper bound) without
+// reading index or data blocks. Range checks count as
+// (NON_)LAST_LEVEL_SEEK_FILTERED and _FILTER_MATCH statistics, like prefix
+// checks.
+//
+// max_key_prefix_len > 0 caps the length of the stored prefixes, trading
+// false positives for keys sharing that many leading bytes for less space.
+// For example, with keys made of an 8-byte session id, a 4-byte layer and
+// further bytes, 12 stores about one entry per (session, layer) and still
+// answers "does session X have any key for layers [a, b]" exactly. With no
+// cap (0), expect roughly 4 bytes per key on top of the Bloom filter.
+//
+// Range checks are used only with the default bytewise comparator and no
+// user-defined timestamps. Range filters are compatible with this version
+// and later; earlier versions treat them as if no filter was used.
+FilterPolicy* NewRangeFilterPolicy(double bloom_equivalent_bits_per_key,
+                                   size_t max_key_prefix_len = 0);
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -84,4 +84,29 @@ Status NewJemallocNodumpAllocator(
     const JemallocAllocatorOptions& options,
     std::shared_ptr<MemoryAllocator>* memory_allocator);
 
+struct NumaAllocatorOptions {
+  static const char* kName() { return "NumaAllocatorOptions"; }
+  // Expected amount of memory allocated through the allocator, typically the
+  // capacity of the block cache using it. Each size class of allocations is
+  // carved out of slabs of up to 1/64 of this per NUMA node (between 64 KiB
+  // and 2 MiB), so that the partly used slabs of the size classes in use stay
+  // small compared to the capacity. Allocations too large for eight of them
+  // to fit in a slab are mapped directly. 0 means unknown, for 2 MiB slabs.
+  size_t capacity = 0;
+};
+
+// Generate memory allocator which places each allocation in memory bound to
+// the NUMA node of the calling thread, using a separate arena per node. Pair
+// with LRUCacheOptions::numa_aware so that block cache entries are both held
+// and indexed on the node of the threads reading them. Allocations are
+// rounded up by at most a quarter of their size (for sizes above 64 bytes),
+// and memory is returned to the system as whole slabs of an allocation size
+// become free.
+//
+// Returns NotSupported if RocksDB is not built with NUMA support or NUMA is
+// not available on the system.
+Status NewNumaMemoryAllocator(
+    const NumaAllocatorOptions& options,
+    std::shared_ptr<MemoryAllocator>* memory_allocator);
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -40,7 +40,9 @@
 
 #include <memory>
 #include <stdexcept>
+#include <string>
 #include <unordered_set>
+#include <vector>
 
 #include "rocksdb/customizable.h"
 #include "rocksdb/slice.h"
@@ -452,4 +454,45 @@ MemTableRepFactory* NewHashLinkListRepFactory(
     bool if_log_bucket_dist_when_flash = true,
     uint32_t threshold_use_skiplist = 256);
 
+struct RangePartitionedSkipListRepOptions {
+  static const char* kName() { return "RangePartitionedSkipListRepOptions"; }
+
+  // User keys (including the timestamp, if any) at which to split the key
+  // space: partition i holds the user keys in
+  // [partition_boundaries[i-1], partition_boundaries[i]). If empty, the
+  // boundaries are learned instead (see num_learned_partitions).
+  std::vector<std::string> partition_boundaries;
+
+  // If partition_boundaries is empty, each memtable samples the keys inserted
+  // into it, and when it becomes immutable derives boundaries splitting the
+  // samples into this many partitions of about equal size. Memtables created
+  // afterwards by the same factory use these boundaries. (The first memtable
+  // has a single partition.) Values <= 1 disable partitioning.
+  size_t num_learned_partitions = 16;
+
+  // If non-zero, each memtable keeps a lock-free hash index (rounded up to a
+  // power of two buckets, 8 bytes each) from user key to the newest entry for
+  // that key, so that point lookups take O(1) expected cache misses instead of
+  // a skip list search. Size it at or above the expected number of distinct
+  // keys per memtable; once the index cannot place a key, lookups of keys
+  // absent from the index fall back to searching the skip list. The index is
+  // allocated from the memtable arena when the memtable is created, so it
+  // counts toward write_buffer_size and should be well below it.
+  //
+  // REQUIRES: if non-zero, the user comparator considers keys equal only if
+  // their bytes are equal, and does not use user-defined timestamps.
+  size_t point_index_bucket_count = 0;
+};
+
+// EXPERIMENTAL: The factory is to create memtables that partition the key
+// space by ranges, with an independent skip list per range. Compared to the
+// default skip list, each insert searches a smaller list, and concurrent
+// inserts into different ranges do not contend on the same nodes, which helps
+// very large write buffers ingesting from many threads. Ordered iteration
+// moves across the partitions in order, and point lookups can use an
+// optional hash index. Supports concurrent memtable writes.
+MemTableRepFactory* NewRangePartitionedSkipListRepFactory(
+    const RangePartitionedSkipListRepOptions& options =
+        RangePartitionedSkipListRepOptions());
+
 }  // namespace ROCKSDB_NAMESPACE
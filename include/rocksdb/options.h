@@ -41,6 +41,7 @@ namespace ROCKSDB_NAMESPACE {
 class Cache;
 class CompactionFilter;
 class CompactionFilterFactory;
+class CompactionValueTransformer;
 class Comparator;
 class ConcurrentTaskLimiter;
 class Env;
@@ -166,6 +167,15 @@ struct ColumnFamilyOptions : public AdvancedColumnFamilyOptions {
   // Default: nullptr
   std::shared_ptr<CompactionFilterFactory> compaction_filter_factory = nullptr;
 
+  // If non-nullptr, compaction passes the values it writes to this
+  // transformer in batches, along with the output level and temperature, and
+  // writes the values it returns instead. See compaction_value_transformer.h.
+  // Flushes do not call the transformer.
+  //
+  // Default: nullptr
+  std::shared_ptr<CompactionValueTransformer> compaction_value_transformer =
+      nullptr;
+
   // -------------------
   // Parameters that affect performance
 
@@ -775,6 +785,19 @@ struct DBOptions {
   // Default: 16
   int max_file_opening_threads = 16;
 
+  // EXPERIMENTAL
+  // If positive, the DB starts a pool of this many threads, shared by all its
+  // flushes and compactions, to compress the data blocks of the block-based
+  // tables they write. This takes precedence over
+  // CompressionOptions::parallel_threads: instead of each table builder
+  // starting threads of its own, blocks from all concurrent builders are
+  // compressed by whichever pool threads are idle, so a single large flush
+  // can use all of them. Flushes while the number of L0 files is at least
+  // half of level0_slowdown_writes_trigger are served before other work.
+  //
+  // Default: 0
+  int compression_threads = 0;
+
   // Once write-ahead logs exceed this size, we will start forcing the flush of
   // column families whose memtables are backed by the oldest live WAL file
   // (i.e. the ones that are causing all the space amplification). If set to 0
@@ -896,6 +919,39 @@ struct DBOptions {
   // Dynamically changeable through SetDBOptions() API.
   uint32_t max_subcompactions = 1;
 
+  // With subcompactions, the key range of a compaction is split into up to
+  // this many ranges per subcompaction thread. The threads take the ranges in
+  // key order, each taking the next one as soon as it is done with the last,
+  // so that a few ranges much slower to compact than estimated (e.g. with
+  // skewed key or value sizes) are not left to a single straggler thread. The
+  // ranges are not made smaller than the target output file size, and each
+  // ends its output files, so larger values can mean more and smaller output
+  // files.
+  // Default: 1 (i.e. one range per subcompaction thread)
+  //
+  // Dynamically changeable through SetDBOptions() API.
+  uint32_t subcompaction_ranges_per_thread = 1;
+
+  // If true, automatic compactions into the bottommost level that do not
+  // read L0 files can be preempted, to make room for urgent background work.
+  // While writes are stalled or delayed and a flush, or a compaction of a
+  // column family whose L0 has reached level0_slowdown_writes_trigger, is
+  // waiting for a background job slot, the most recently started of those
+  // compactions is stopped. Its output files are discarded and its input
+  // files are picked for compaction again later. For an L0 compaction of the
+  // same column family, a compaction is only preempted if L0 has the higher
+  // compaction score, so it is not picked again right away. Compactions
+  // running in the Env::Priority::BOTTOM pool are never preempted. At most
+  // one compaction is being preempted at a time, and after two bottommost
+  // compactions of a column family in a row were preempted, the next one
+  // runs to completion. Preemptions are counted in the COMPACTION_PREEMPTED
+  // ticker.
+  //
+  // Default: false
+  //
+  // Dynamically changeable through SetDBOptions() API.
+  bool preempt_bottommost_compactions = false;
+
   // DEPRECATED: RocksDB automatically decides this based on the
   // value of max_background_jobs. For backwards compatibility we will set
   // `max_background_jobs = max_background_compactions + max_background_flushes`
@@ -948,6 +1004,36 @@ struct DBOptions {
   // Default: 0
   size_t recycle_log_file_num = 0;
 
+  // EXPERIMENTAL
+  // Number of WAL streams. If greater than one, the DB writes its WAL to that
+  // many WAL files at a time instead of one. Each write batch group is
+  // appended to one of the streams, chosen round-robin, so the appends and
+  // syncs of different groups go to different files and syncs can proceed in
+  // parallel. Recovery replays the records of all streams merged by sequence
+  // number.
+  //
+  // Sync writes are acknowledged once the stream records of all writes up to
+  // theirs are synced, but (as with WriteOptions::sync and multiple writers
+  // in general) may become visible to readers before that. After a crash,
+  // recovery stops at the first write missing from the streams, so the
+  // recovered writes are a prefix of the write history as with a single WAL.
+  // Under WALRecoveryMode::kAbsoluteConsistency such a gap fails recovery.
+  // Creating the WALs of each new memtable also syncs one of them and the WAL
+  // directory.
+  //
+  // The number of streams is recorded in the MANIFEST, so the DB can be
+  // reopened with any value: recovery follows the recorded number, and
+  // flushes the recovered data whenever the old or new value is greater than
+  // one, even with avoid_flush_during_recovery. Values greater than one are
+  // not supported together with enable_pipelined_write, unordered_write,
+  // two_write_queues, allow_2pc, manual_wal_flush, allow_mmap_writes,
+  // recycle_log_file_num > 0, track_and_verify_wals_in_manifest,
+  // track_and_verify_wals, WriteOptions::disableWAL, DB::GetUpdatesSince(),
+  // or secondary instances.
+  //
+  // Default: 1
+  size_t num_wal_streams = 1;
+
   // manifest file is rolled over on reaching this limit.
   // The older manifest file be deleted.
   // The default value is 1GB so that the manifest file can grow, but not
@@ -1102,6 +1188,25 @@ struct DBOptions {
   // Dynamically changeable through SetDBOptions() API.
   size_t compaction_readahead_size = 2 * 1024 * 1024;
 
+  // If true, compaction input files are read ahead with two buffers of
+  // compaction_readahead_size / 2, the second of which is filled through
+  // FSRandomAccessFile::ReadAsync() while the compaction works through the
+  // first. This overlaps input reads with merging and output writes, which
+  // helps on devices with high latency or deep queues, given a FileSystem
+  // with a real ReadAsync() implementation (e.g. PosixFileSystem with
+  // io_uring). FileSystem::Prefetch() is not used for the inputs in this mode.
+  // The input part has no effect when compaction_readahead_size is 0.
+  //
+  // Without direct I/O for compactions, compaction output files are also
+  // written by a background thread per file, with up to two buffers of
+  // writable_file_max_buffer_size in flight, so that the compaction fills
+  // the next buffer while the previous one is written.
+  //
+  // Default: false
+  //
+  // Dynamically changeable through SetDBOptions() API.
+  bool compaction_async_io = false;
+
   // This is the maximum buffer size that is used by WritableFileWriter.
   // With direct IO, we need to maintain an aligned buffer for writes.
   // We allow the buffer to grow until it's size hits the limit in buffered
@@ -1219,6 +1324,23 @@ struct DBOptions {
   // Default: false
   bool enable_pipelined_write = false;
 
+  // EXPERIMENTAL
+  // If true (requires enable_pipelined_write), the WAL writes are done by a
+  // dedicated thread instead of the leader of each batch group. Writers push
+  // themselves onto a lock-free queue, and the WAL writer thread writes the
+  // queued batches to the WAL as one group while the writers of the previous
+  // group insert into the memtable. This takes the WAL write and sync off the
+  // critical path of the writer threads, and is meant for many concurrent
+  // writers. Its throughput benefit is not established yet; compare with
+  // e.g. db_bench -benchmarks=fillrandom -enable_pipelined_write=true
+  // -enable_wal_writer_thread={false,true} -threads=N before enabling it.
+  // The thread is started at the end of DB::Open(), after recovery. Writes
+  // with WriteOptions::no_slowdown set are not queued and write the WAL
+  // themselves.
+  //
+  // Default: false
+  bool enable_wal_writer_thread = false;
+
   // Setting unordered_write to true trades higher write throughput with
   // relaxing the immutability guarantee of snapshots. This violates the
   // repeatability one expects from ::Get from a snapshot, as well as
@@ -1877,6 +1999,19 @@ struct ReadOptions {
   // comes at the expense of slightly higher CPU overhead.
   bool optimize_multiget_for_io = true;
 
+  // EXPERIMENTAL
+  //
+  // If non-null, GetEntity(), MultiGetEntity() and iterators only return the
+  // wide columns with the given names (of wide-column entities as well as of
+  // plain values, which are seen as having a default column only). Point
+  // lookups push the projection down to data blocks written with
+  // `BlockBasedTableOptions::data_block_columnar_entities`, so that only the
+  // requested columns are read from them; merge operators then see the
+  // projected base entity (with its default column, if any). The pointed-to
+  // names must remain valid for the duration of the read (for iterators,
+  // until the iterator is destroyed).
+  const std::vector<Slice>* wide_column_projection = nullptr;
+
   // *** END options relevant to point lookups (as well as scans) ***
   // *** BEGIN options only relevant to iterators or scans ***
 
@@ -2534,6 +2669,8 @@ struct CompactionServiceOptionsOverride {
   std::shared_ptr<const SliceTransform> prefix_extractor = nullptr;
   std::shared_ptr<TableFactory> table_factory;
   std::shared_ptr<SstPartitionerFactory> sst_partitioner_factory = nullptr;
+  std::shared_ptr<CompactionValueTransformer> compaction_value_transformer =
+      nullptr;
 
   // Only subsets of events are triggered in remote compaction worker, like:
   // `OnTableFileCreated`, `OnTableFileCreationStarted`,
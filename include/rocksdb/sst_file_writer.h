@@ -40,7 +40,9 @@ struct ExternalSstFileInfo {
         file_size(0),
         num_entries(0),
         num_range_del_entries(0),
-        version(0) {}
+        version(0),
+        blob_file_path(""),
+        blob_file_number(0) {}
 
   ExternalSstFileInfo(const std::string& _file_path,
                       const std::string& _smallest_key,
@@ -58,7 +60,9 @@ struct ExternalSstFileInfo {
         file_size(_file_size),
         num_entries(_num_entries),
         num_range_del_entries(0),
-        version(_version) {}
+        version(_version),
+        blob_file_path(""),
+        blob_file_number(0) {}
 
   std::string file_path;     // external sst file path
   std::string smallest_key;  // smallest user key in file
@@ -73,6 +77,9 @@ struct ExternalSstFileInfo {
   uint64_t num_entries;                 // number of entries in file
   uint64_t num_range_del_entries;  // number of range deletion entries in file
   int32_t version;                 // file version
+  // companion blob file path, empty if no value was written to a blob file
+  std::string blob_file_path;
+  uint64_t blob_file_number;  // companion blob file number, 0 if none
 };
 
 // SstFileWriter is used to create sst files that can be added to database later
@@ -113,6 +120,25 @@ class SstFileWriter {
   Status Open(const std::string& file_path,
               Temperature temp = Temperature::kUnknown);
 
+  // Same as Open(), but the values of at least `min_blob_size` bytes (of the
+  // options passed to the constructor) added with Put() are written to a
+  // companion blob file, compressed with `blob_compression_type`. The sst
+  // file references them like a DB with `enable_blob_files`, so the blob file
+  // is created in the same directory as "file_path", named after
+  // `blob_file_number`, and IngestExternalFile() ingests it along with the sst
+  // file, keeping its number.
+  //
+  // The blob file number must be reserved with DB::ReserveFileNumbers() on
+  // the DB the file is ingested into, before the file is written, or ingestion
+  // fails. Each reserved number can be used by one ingested file.
+  //
+  // The blob file records the ID of the column family passed to the
+  // constructor, or of the default column family if none, and can only be
+  // ingested into that column family.
+  Status OpenWithBlobFile(const std::string& file_path,
+                          uint64_t blob_file_number,
+                          Temperature temp = Temperature::kUnknown);
+
   // Add a Put key with value to currently opened file (deprecated)
   // REQUIRES: user_key is after any previously added point (Put/Merge/Delete)
   //           key according to the comparator.
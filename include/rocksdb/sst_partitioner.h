@@ -16,6 +16,7 @@
 namespace ROCKSDB_NAMESPACE {
 
 class Slice;
+class SliceTransform;
 
 enum PartitionerResult : char {
   // Partitioner does not require to create new file
@@ -62,6 +63,11 @@ class SstPartitioner {
   virtual bool CanDoTrivialMove(const Slice& smallest_user_key,
                                 const Slice& largest_user_key) = 0;
 
+  // Whether the blob files written by compaction should also be split at the
+  // partition boundaries, so that each blob file only holds values of keys
+  // in one partition, like the SST files referencing it.
+  virtual bool PartitionBlobFiles() const { return false; }
+
   // Context information of a compaction run
   struct Context {
     // Does this compaction run include all data files
@@ -139,4 +145,58 @@ class SstPartitionerFixedPrefixFactory : public SstPartitionerFactory {
 std::shared_ptr<SstPartitionerFactory> NewSstPartitionerFixedPrefixFactory(
     size_t prefix_len);
 
+/*
+ * Prefix partitioner. It splits the output SST files, and the blob files
+ * written along with them, when the prefix extracted by a SliceTransform
+ * changes. Keys outside the domain of the prefix extractor are treated as
+ * having an empty prefix. With each prefix in its own files, all the data of
+ * a prefix (e.g. a session id) can be dropped without compaction by
+ * DeleteRangeByDroppingFiles().
+ */
+class SstPartitionerPrefix : public SstPartitioner {
+ public:
+  explicit SstPartitionerPrefix(const SliceTransform* prefix_extractor)
+      : prefix_extractor_(prefix_extractor) {}
+
+  ~SstPartitionerPrefix() override {}
+
+  const char* Name() const override { return "SstPartitionerPrefix"; }
+
+  PartitionerResult ShouldPartition(const PartitionerRequest& request) override;
+
+  bool CanDoTrivialMove(const Slice& smallest_user_key,
+                        const Slice& largest_user_key) override;
+
+  bool PartitionBlobFiles() const override { return true; }
+
+ private:
+  Slice GetPrefix(const Slice& user_key) const;
+
+  const SliceTransform* prefix_extractor_;
+};
+
+/*
+ * Factory for prefix partitioner.
+ */
+class SstPartitionerPrefixFactory : public SstPartitionerFactory {
+ public:
+  explicit SstPartitionerPrefixFactory(
+      std::shared_ptr<const SliceTransform> prefix_extractor);
+
+  ~SstPartitionerPrefixFactory() override {}
+
+  static const char* kClassName() { return "SstPartitionerPrefixFactory"; }
+  const char* Name() const override { return kClassName(); }
+
+  // Returns nullptr, i.e. no partitioning, without a prefix extractor
+  std::unique_ptr<SstPartitioner> CreatePartitioner(
+      const SstPartitioner::Context& /* context */) const override;
+
+ private:
+  std::shared_ptr<const SliceTransform> prefix_extractor_;
+};
+
+std::shared_ptr<SstPartitionerFactory> NewSstPartitionerPrefixFactory(
+    std::shared_ptr<const SliceTransform> prefix_extractor);
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -542,6 +542,10 @@ enum Tickers : uint32_t {
   // TransactionOptions::large_txn_commit_optimize_threshold.
   NUMBER_WBWI_INGEST,
 
+  // Number of bottommost compactions stopped to make room for flushes and L0
+  // compactions (see DBOptions::preempt_bottommost_compactions)
+  COMPACTION_PREEMPTED,
+
   TICKER_ENUM_MAX
 };
 
@@ -231,6 +231,19 @@ struct BlockBasedTableOptions {
   // overflowing block cache.
   MetadataCacheOptions metadata_cache_options;
 
+  // If non-zero, the filter and index blocks (the top-level ones when
+  // partitioned) of the block-based tables most frequently accessed by reads
+  // are pinned in the block cache, in addition to any pinning by tier in
+  // `metadata_cache_options`, up to this many bytes of block cache charge.
+  // Access frequency is tracked per table with exponential decay, so pinning
+  // follows the working set as it moves, unpinning tables as they go cold.
+  // Pinning never causes I/O, as only blocks already in the block cache are
+  // pinned.
+  //
+  // Note `cache_index_and_filter_blocks` must be true for this option to have
+  // any effect.
+  size_t adaptive_metadata_pinning_budget = 0;
+
   // The index type that will be used for this table.
   enum IndexType : char {
     // A space efficient index block that is optimized for
@@ -258,6 +271,19 @@ struct BlockBasedTableOptions {
     // Makes the index significantly bigger (2x or more), especially when keys
     // are long.
     kBinarySearchWithFirstKey = 0x03,
+
+    // EXPERIMENTAL
+    // Like kBinarySearch, but a piecewise-linear model mapping keys to index
+    // entries is trained when the table is built and stored alongside the
+    // index. Seeks use the model to narrow the binary search over the index
+    // block to a small window around the predicted entry, falling back to a
+    // full binary search if the prediction turns out to be wrong. Works best
+    // for fixed-width keys assigned in (close to) increasing order, e.g.
+    // big-endian encoded ids. The model is only built for
+    // BytewiseComparator() without user-defined timestamps; otherwise this
+    // behaves like kBinarySearch. Tables written with this index type cannot
+    // be read by older versions of RocksDB.
+    kLearnedIndex = 0x04,
   };
 
   IndexType index_type = kBinarySearch;
@@ -274,6 +300,33 @@ struct BlockBasedTableOptions {
   // kDataBlockBinaryAndHash.
   double data_block_hash_table_util_ratio = 0.75;
 
+  // EXPERIMENTAL
+  // If true, data blocks store the first 8 bytes of each restart key's user
+  // key in a fixed-width array after the restart array. Seeks search this
+  // array (with SIMD where available) to narrow the binary search to the
+  // restart intervals whose keys share the target's 8 byte prefix, avoiding
+  // key decoding and comparator calls for the rest. Costs 8 bytes per restart
+  // point. Only takes effect with BytewiseComparator() and no user-defined
+  // timestamps. Requires block_size <= 64KiB; any larger data block (e.g.
+  // holding a single large value) is written without the prefixes and
+  // searched by plain binary search. Data blocks written with this option
+  // cannot be read by older versions of RocksDB.
+  bool data_block_restart_key_prefixes = false;
+
+  // EXPERIMENTAL
+  // If true, data blocks store the wide-column entities they contain column
+  // by column: the values of each column are kept contiguously along with
+  // their offsets, and each entity entry only references its position. Reads
+  // with `ReadOptions::wide_column_projection` then only touch the requested
+  // columns of an entity, which avoids decoding (and copying) large columns
+  // when small ones are needed. Full entities (e.g. for iterators and
+  // compactions) are reassembled on every access, into memory owned by the
+  // reader rather than by the cached block. Blocks are still
+  // compressed as a whole. Only applies to blocks no larger than 64KiB after
+  // the transformation; others stay row-oriented. Data blocks written with
+  // this option cannot be read by older versions of RocksDB.
+  bool data_block_columnar_entities = false;
+
   // Option hash_index_allow_collision is now deleted.
   // It will behave as if hash_index_allow_collision=true.
 
@@ -561,6 +614,9 @@ struct BlockBasedTableOptions {
   // misplaced within or between files is as likely to fail checksum
   // verification as random corruption. Also checksum-protects SST footer.
   // Can be read by RocksDB versions >= 8.6.0.
+  // 7 -- Data blocks can be compressed after a pre-compression transform
+  // (see CompressionOptions::pre_compression_transform), which is recorded in
+  // the block trailer. Required for using such a transform.
   //
   // Using the default setting of format_version is strongly recommended, so
   // that available enhancements are adopted eventually and automatically. The
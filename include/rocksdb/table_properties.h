@@ -76,6 +76,8 @@ struct TablePropertiesNames {
   static const std::string kTailStartOffset;
   static const std::string kUserDefinedTimestampsPersisted;
   static const std::string kKeyLargestSeqno;
+  static const std::string kCompressionDictId;
+  static const std::string kDataBlockCompressionCounts;
 };
 
 // `TablePropertiesCollector` provides the mechanism for users to collect
@@ -303,6 +305,11 @@ struct TableProperties {
   // table is empty).
   uint64_t key_largest_seqno = UINT64_MAX;
 
+  // A hash of the compression dictionary of the data blocks, identifying
+  // dictionaries shared by files (see CompressionOptions::use_shared_dict).
+  // 0 means no dictionary (or unknown).
+  uint64_t compression_dict_id = 0;
+
   // DB identity
   // db_id is an identifier generated the first time the DB is created
   // If DB identity is unset or unassigned, `db_id` will be an empty string.
@@ -353,6 +360,11 @@ struct TableProperties {
   // Sequence number to time mapping, delta encoded.
   std::string seqno_to_time_mapping;
 
+  // The number of data blocks stored with each compression type, as in
+  // "LZ4=12;NoCompression=3;ZSTD=40;". Only recorded with adaptive compression
+  // (see CompressionOptions::adaptive_compression_budget_pct).
+  std::string data_block_compression_counts;
+
   // user collected properties
   UserCollectedProperties user_collected_properties;
   UserCollectedProperties readable_properties;
@@ -0,0 +1,55 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+// A CompactionService running compactions in local worker processes, so that
+// they do not compete with the DB process for its threads and page cache.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rocksdb/options.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+struct LocalCompactionServiceOptions {
+  // Path to the worker executable, normally the `compaction_worker` tool.
+  // It is run as
+  //   <worker_path> <worker_args>... --db=<db> --column_family=<cf>
+  //       --input_file=<file> --output_dir=<dir> --result_file=<file>
+  // and is expected to run DB::OpenAndCompact() on the input file, write the
+  // result to the result file, and exit with 0 on success.
+  std::string worker_path;
+
+  // Extra arguments passed to the worker ahead of the ones above, e.g.
+  // `--options=<options to override>` for `compaction_worker`.
+  std::vector<std::string> worker_args;
+
+  // Directory under which each job gets a directory for its input, result
+  // and output files. Must be on the same file system as the DB, as the
+  // output files are renamed into the DB on installation. Required.
+  std::string work_dir;
+
+  // Nice value the workers run at, where permitted. 0 keeps the nice value
+  // of the DB process.
+  int nice_value = 10;
+
+  // If not empty, a cgroup (v2) directory the workers are moved into, e.g.
+  // to cap their CPU usage with `cpu.max`. The DB process needs write access
+  // to its `cgroup.procs`.
+  std::string cgroup_path;
+};
+
+// Returns a CompactionService running each compaction in a freshly spawned
+// worker process. Compactions the workers fail to run without reporting a
+// result (e.g. the worker could not be started, or crashed) fall back to
+// running in the DB process. CancelAllBackgroundWork() kills the running
+// workers. Not supported on Windows, where nullptr is returned.
+std::shared_ptr<CompactionService> NewLocalCompactionService(
+    const LocalCompactionServiceOptions& options);
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -176,6 +176,11 @@ class StackableDB : public DB {
     return db_->IngestExternalFiles(args);
   }
 
+  Status ReserveFileNumbers(uint64_t num,
+                            uint64_t* first_file_number) override {
+    return db_->ReserveFileNumbers(num, first_file_number);
+  }
+
   using DB::CreateColumnFamilyWithImport;
   Status CreateColumnFamilyWithImport(
       const ColumnFamilyOptions& options, const std::string& column_family_name,
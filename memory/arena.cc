@@ -20,6 +20,26 @@
 
 namespace ROCKSDB_NAMESPACE {
 
+namespace {
+// Fault in all pages of a block that has not been handed out yet
+void PrefaultBlock(char* block, size_t size) {
+#ifdef MADV_POPULATE_WRITE
+  // madvise needs a page-aligned start. The pages at either end hold part of
+  // the block, so they are mapped and writable.
+  uintptr_t start = reinterpret_cast<uintptr_t>(block) & ~(port::kPageSize - 1);
+  size_t len = reinterpret_cast<uintptr_t>(block) + size - start;
+  if (madvise(reinterpret_cast<void*>(start), len, MADV_POPULATE_WRITE) == 0) {
+    return;
+  }
+  // Fall back on kernels without MADV_POPULATE_WRITE (before Linux 5.14)
+#endif  // MADV_POPULATE_WRITE
+  // The contents are not meaningful yet, so simply write one byte per page
+  for (size_t i = 0; i < size; i += port::kPageSize) {
+    static_cast<volatile char*>(block)[i] = 0;
+  }
+}
+}  // namespace
+
 size_t Arena::OptimizeBlockSize(size_t block_size) {
   // Make sure block_size is in optimal range
   block_size = std::max(Arena::kMinBlockSize, block_size);
@@ -33,8 +53,11 @@ size_t Arena::OptimizeBlockSize(size_t block_size) {
   return block_size;
 }
 
-Arena::Arena(size_t block_size, AllocTracker* tracker, size_t huge_page_size)
-    : kBlockSize(OptimizeBlockSize(block_size)), tracker_(tracker) {
+Arena::Arena(size_t block_size, AllocTracker* tracker, size_t huge_page_size,
+             bool transparent_huge_pages, bool prefault)
+    : kBlockSize(OptimizeBlockSize(block_size)),
+      prefault_(prefault),
+      tracker_(tracker) {
   assert(kBlockSize >= kMinBlockSize && kBlockSize <= kMaxBlockSize &&
          kBlockSize % kAlignUnit == 0);
   TEST_SYNC_POINT_CALLBACK("Arena::Arena:0", const_cast<size_t*>(&kBlockSize));
@@ -48,9 +71,22 @@ Arena::Arena(size_t block_size, AllocTracker* tracker, size_t huge_page_size)
       hugetlb_size_ = ((kBlockSize - 1U) / hugetlb_size_ + 1U) * hugetlb_size_;
     }
   }
+  if (MemMapping::kTransparentHugePageSupported && transparent_huge_pages &&
+      kBlockSize >= MemMapping::kTransparentHugePageSize) {
+    constexpr size_t kHuge = MemMapping::kTransparentHugePageSize;
+    thp_block_size_ = ((kBlockSize - 1U) / kHuge + 1U) * kHuge;
+  }
   if (tracker_ != nullptr) {
     tracker_->Allocate(kInlineSize);
   }
+  if (prefault_) {
+    // Skip the inline block so that the first allocations land in memory that
+    // is already faulted in.
+    size_t size = 0;
+    aligned_alloc_ptr_ = AllocateRegularBlock(&size);
+    unaligned_alloc_ptr_ = aligned_alloc_ptr_ + size;
+    alloc_bytes_remaining_ = size;
+  }
 }
 
 Arena::~Arena() {
@@ -70,15 +106,7 @@ char* Arena::AllocateFallback(size_t bytes, bool aligned) {
 
   // We waste the remaining space in the current block.
   size_t size = 0;
-  char* block_head = nullptr;
-  if (MemMapping::kHugePageSupported && hugetlb_size_ > 0) {
-    size = hugetlb_size_;
-    block_head = AllocateFromHugePage(size);
-  }
-  if (!block_head) {
-    size = kBlockSize;
-    block_head = AllocateNewBlock(size);
-  }
+  char* block_head = AllocateRegularBlock(&size);
   alloc_bytes_remaining_ = size - bytes;
 
   if (aligned) {
@@ -92,8 +120,29 @@ char* Arena::AllocateFallback(size_t bytes, bool aligned) {
   }
 }
 
-char* Arena::AllocateFromHugePage(size_t bytes) {
-  MemMapping mm = MemMapping::AllocateHuge(bytes);
+char* Arena::AllocateRegularBlock(size_t* size) {
+  char* block_head = nullptr;
+  if (MemMapping::kHugePageSupported && hugetlb_size_ > 0) {
+    *size = hugetlb_size_;
+    block_head = AllocateFromHugePage(*size);
+  }
+  if (!block_head && thp_block_size_ > 0) {
+    *size = thp_block_size_;
+    block_head = AllocateFromHugePage(*size, /*transparent*/ true);
+  }
+  if (!block_head) {
+    *size = kBlockSize;
+    block_head = AllocateNewBlock(*size);
+  }
+  if (prefault_) {
+    PrefaultBlock(block_head, *size);
+  }
+  return block_head;
+}
+
+char* Arena::AllocateFromHugePage(size_t bytes, bool transparent) {
+  MemMapping mm = transparent ? MemMapping::AllocateTransparentHuge(bytes)
+                              : MemMapping::AllocateHuge(bytes);
   auto addr = static_cast<char*>(mm.Get());
   if (addr) {
     huge_blocks_.push_back(std::move(mm));
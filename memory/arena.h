@@ -39,8 +39,17 @@ class Arena : public Allocator {
   // huge_page_size: if 0, don't use huge page TLB. If > 0 (should set to the
   // supported hugepage size of the system), block allocation will try huge
   // page TLB first. If allocation fails, will fall back to normal case.
+  // transparent_huge_pages: if true, and the block size is at least
+  // MemMapping::kTransparentHugePageSize, blocks are mmap'd aligned to huge
+  // pages with MADV_HUGEPAGE instead of taken from malloc, and their size is
+  // rounded up to a multiple of the huge page size. Used when huge page TLB
+  // is not configured or fails.
+  // prefault: if true, every block is faulted in when it is allocated, and
+  // the first block is allocated in the constructor, so that allocations
+  // (and the first writes to them) do not take page faults.
   explicit Arena(size_t block_size = kMinBlockSize,
-                 AllocTracker* tracker = nullptr, size_t huge_page_size = 0);
+                 AllocTracker* tracker = nullptr, size_t huge_page_size = 0,
+                 bool transparent_huge_pages = false, bool prefault = false);
   ~Arena();
 
   char* Allocate(size_t bytes) override;
@@ -93,7 +102,7 @@ class Arena : public Allocator {
   const size_t kBlockSize;
   // Allocated memory blocks
   std::deque<std::unique_ptr<char[]>> blocks_;
-  // Huge page allocations
+  // Huge page allocations, including transparent huge page blocks
   std::deque<MemMapping> huge_blocks_;
   size_t irregular_block_num = 0;
 
@@ -108,9 +117,14 @@ class Arena : public Allocator {
   size_t alloc_bytes_remaining_ = 0;
 
   size_t hugetlb_size_ = 0;
+  // Size of regular blocks backed by transparent huge pages, or 0 if not used
+  size_t thp_block_size_ = 0;
+  const bool prefault_;
 
-  char* AllocateFromHugePage(size_t bytes);
+  char* AllocateFromHugePage(size_t bytes, bool transparent = false);
   char* AllocateFallback(size_t bytes, bool aligned);
+  // Allocates a block of the regular size, returned in *size
+  char* AllocateRegularBlock(size_t* size);
   char* AllocateNewBlock(size_t block_bytes);
 
   // Bytes of memory in blocks allocated so far
@@ -9,6 +9,8 @@
 
 #include "memory/arena.h"
 
+#include <algorithm>
+
 #ifndef OS_WIN
 #include <sys/resource.h>
 #endif
@@ -308,6 +310,68 @@ TEST_F(ArenaTest, UnmappedAllocation) {
   }
 }
 
+TEST(MmapTest, AllocateTransparentHuge) {
+  constexpr size_t kHuge = MemMapping::kTransparentHugePageSize;
+  constexpr size_t len = 2 * kHuge;
+  MemMapping mm = MemMapping::AllocateTransparentHuge(len);
+  char* p = static_cast<char*>(mm.Get());
+  ASSERT_NE(p, nullptr);
+  ASSERT_EQ(mm.Length(), len);
+  if (MemMapping::kTransparentHugePageSupported) {
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(p) % kHuge, 0);
+  }
+  for (size_t i = 0; i < len; i += port::kPageSize) {
+    ASSERT_EQ(p[i], 0);
+    p[i] = 1;
+  }
+  ASSERT_EQ(p[len - port::kPageSize], 1);
+}
+
+TEST_F(ArenaTest, TransparentHugePages) {
+  constexpr size_t kHuge = MemMapping::kTransparentHugePageSize;
+  // Rounded up to a multiple of the huge page size
+  constexpr size_t kBlockSize = kHuge + kHuge / 2;
+  Arena arena(kBlockSize, nullptr, 0 /* huge_page_size */,
+              true /* transparent_huge_pages */);
+  char* p = arena.AllocateAligned(Arena::kInlineSize + 1);
+  ASSERT_NE(p, nullptr);
+  p[0] = 1;
+  if (MemMapping::kTransparentHugePageSupported) {
+    ASSERT_EQ(arena.MemoryAllocatedBytes(), Arena::kInlineSize + 2 * kHuge);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(p) % kHuge, 0);
+  }
+
+  // Too small for huge pages, so a regular block is used
+  Arena small_arena(kHuge / 2, nullptr, 0 /* huge_page_size */,
+                    true /* transparent_huge_pages */);
+  small_arena.Allocate(Arena::kInlineSize + 1);
+  ASSERT_TRUE(
+      CheckMemoryAllocated(small_arena.MemoryAllocatedBytes(),
+                           Arena::kInlineSize + small_arena.BlockSize()));
+}
+
+TEST_F(ArenaTest, Prefault) {
+  constexpr size_t kBlockSize = 1U << 20;
+  Arena arena(kBlockSize, nullptr, 0 /* huge_page_size */,
+              false /* transparent_huge_pages */, true /* prefault */);
+  // The first block is allocated up front
+  ASSERT_FALSE(arena.IsInInlineBlock());
+  ASSERT_TRUE(CheckMemoryAllocated(arena.MemoryAllocatedBytes(),
+                                   Arena::kInlineSize + kBlockSize));
+
+  // Start counting page faults
+  PopMinorPageFaultCount();
+
+  for (size_t i = 0; i < kBlockSize / 1024 - 1; ++i) {
+    char* p = arena.Allocate(1024);
+    std::fill(p, p + 1024, static_cast<char>(i));
+  }
+
+  // The pages were already faulted in
+  size_t faults = PopMinorPageFaultCount();
+  ASSERT_LT(faults, kBlockSize / 4 / port::kPageSize);
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -27,10 +27,18 @@ const size_t kMaxShardBlockSize = size_t{128 * 1024};
 }  // namespace
 
 ConcurrentArena::ConcurrentArena(size_t block_size, AllocTracker* tracker,
-                                 size_t huge_page_size)
+                                 size_t huge_page_size,
+                                 bool transparent_huge_pages, bool prefault)
     : shard_block_size_(std::min(kMaxShardBlockSize, block_size / 8)),
       shards_(),
-      arena_(block_size, tracker, huge_page_size) {
+      arena_(block_size, tracker, huge_page_size, transparent_huge_pages,
+             prefault) {
+  if (port::NumNumaNodes() > 1) {
+    shard_numa_nodes_.reset(new int[shards_.Size()]);
+    for (size_t i = 0; i < shards_.Size(); ++i) {
+      shard_numa_nodes_[i] = port::NumaNodeOfCpu(static_cast<int>(i));
+    }
+  }
   Fixup();
 }
 
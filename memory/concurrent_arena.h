@@ -16,6 +16,7 @@
 #include "memory/arena.h"
 #include "port/lang.h"
 #include "port/likely.h"
+#include "port/port.h"
 #include "util/core_local.h"
 #include "util/mutexlock.h"
 #include "util/thread_local.h"
@@ -41,13 +42,16 @@ class Logger;
 // shard blocks are allocated from the underlying main arena.
 class ConcurrentArena : public Allocator {
  public:
-  // block_size and huge_page_size are the same as for Arena (and are
-  // in fact just passed to the constructor of arena_.  The core-local
-  // shards compute their shard_block_size as a fraction of block_size
-  // that varies according to the hardware concurrency level.
+  // block_size, huge_page_size, transparent_huge_pages and prefault are the
+  // same as for Arena (and are in fact just passed to the constructor of
+  // arena_.  The core-local shards compute their shard_block_size as a
+  // fraction of block_size that varies according to the hardware concurrency
+  // level.
   explicit ConcurrentArena(size_t block_size = Arena::kMinBlockSize,
                            AllocTracker* tracker = nullptr,
-                           size_t huge_page_size = 0);
+                           size_t huge_page_size = 0,
+                           bool transparent_huge_pages = false,
+                           bool prefault = false);
 
   char* Allocate(size_t bytes) override {
     return AllocateImpl(bytes, false /*force_arena*/,
@@ -106,6 +110,10 @@ class ConcurrentArena : public Allocator {
 
   CoreLocalArray<Shard> shards_;
 
+  // NUMA node of the core owning each shard, or nullptr on single node
+  // systems
+  std::unique_ptr<int[]> shard_numa_nodes_;
+
   Arena arena_;
   mutable SpinMutex arena_mutex_;
   std::atomic<size_t> arena_allocated_and_unused_;
@@ -148,9 +156,11 @@ class ConcurrentArena : public Allocator {
     }
 
     // pick a shard from which to allocate
-    Shard* s = shards_.AccessAtCore(cpu & (shards_.Size() - 1));
+    size_t shard_index = cpu & (shards_.Size() - 1);
+    Shard* s = shards_.AccessAtCore(shard_index);
     if (!s->mutex.try_lock()) {
       s = Repick();
+      shard_index = tls_cpuid & (shards_.Size() - 1);
       s->mutex.lock();
     }
     std::unique_lock<SpinMutex> lock(s->mutex, std::adopt_lock);
@@ -184,6 +194,15 @@ class ConcurrentArena : public Allocator {
                   : shard_block_size_;
       s->free_begin_ = arena_.AllocateAligned(avail);
       Fixup();
+
+      // Threads keep their shard until they see contention, even if they
+      // have since migrated to another core. Reloads are rare enough to check
+      // for a move to another NUMA node here, so that a thread switches to a
+      // shard whose memory and cache lines are local to it.
+      if (UNLIKELY(shard_numa_nodes_ != nullptr) &&
+          shard_numa_nodes_[shard_index] != port::NumaNodeOfCpu()) {
+        Repick();
+      }
     }
     s->allocated_and_unused_.store(avail - bytes, std::memory_order_relaxed);
 
@@ -8,6 +8,7 @@
 
 #include "memory/jemalloc_nodump_allocator.h"
 #include "memory/memkind_kmem_allocator.h"
+#include "memory/numa_memory_allocator.h"
 #include "rocksdb/cache.h"
 #include "rocksdb/convenience.h"
 #include "rocksdb/db.h"
@@ -209,6 +210,47 @@ TEST_F(CreateMemoryAllocatorTest, NewJemallocNodumpAllocator) {
   ASSERT_EQ(opts->limit_tcache_size, jopts.limit_tcache_size);
 }
 
+TEST_F(CreateMemoryAllocatorTest, NewNumaMemoryAllocator) {
+  std::shared_ptr<MemoryAllocator> allocator;
+  NumaAllocatorOptions nopts;
+  // Small slabs, so that only allocations up to a few KiB come from slabs
+  nopts.capacity = 4 << 20;
+  ASSERT_NOK(NewNumaMemoryAllocator(nopts, nullptr));
+  Status s = NewNumaMemoryAllocator(nopts, &allocator);
+  std::string msg;
+  if (!NumaMemoryAllocator::IsSupported(&msg)) {
+    ASSERT_TRUE(s.IsNotSupported());
+    ROCKSDB_GTEST_BYPASS("NUMA not supported");
+    return;
+  }
+  ASSERT_OK(s);
+  ASSERT_NE(allocator, nullptr);
+  auto opts = allocator->GetOptions<NumaAllocatorOptions>();
+  ASSERT_NE(opts, nullptr);
+  ASSERT_EQ(opts->capacity, nopts.capacity);
+
+  // Mix of small (size class) and large (directly mapped) allocations,
+  // including reuse of freed blocks
+  std::vector<std::pair<char*, size_t>> blocks;
+  for (size_t size : {1U, 48U, 4000U, 4096U, 70000U, 300000U, 4000U, 48U}) {
+    char* p = static_cast<char*>(allocator->Allocate(size));
+    ASSERT_NE(p, nullptr);
+    ASSERT_GE(allocator->UsableSize(p, size), size);
+    // Fine-grained size classes, not including the allocation header
+    ASSERT_LE(allocator->UsableSize(p, size),
+              std::max<size_t>(size * 5 / 4, 64));
+    memset(p, 0xab, size);
+    blocks.emplace_back(p, size);
+    if (blocks.size() % 3 == 0) {
+      allocator->Deallocate(blocks.front().first);
+      blocks.erase(blocks.begin());
+    }
+  }
+  for (auto& block : blocks) {
+    allocator->Deallocate(block.first);
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(DefaultMemoryAllocator, MemoryAllocatorTest,
                         ::testing::Values(std::make_tuple(
                             DefaultMemoryAllocator::kClassName(), true)));
@@ -219,6 +261,13 @@ INSTANTIATE_TEST_CASE_P(
                                       MemkindKmemAllocator::IsSupported())));
 #endif  // MEMKIND
 
+#ifdef NUMA
+INSTANTIATE_TEST_CASE_P(
+    NumaMemoryAllocator, MemoryAllocatorTest,
+    ::testing::Values(std::make_tuple(NumaMemoryAllocator::kClassName(),
+                                      NumaMemoryAllocator::IsSupported())));
+#endif  // NUMA
+
 #ifdef ROCKSDB_JEMALLOC
 INSTANTIATE_TEST_CASE_P(
     JemallocNodumpAllocator, MemoryAllocatorTest,
@@ -0,0 +1,305 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "memory/numa_memory_allocator.h"
+
+#ifdef NUMA
+#include <numa.h>
+#endif  // NUMA
+
+#include <algorithm>
+#include <new>
+
+#include "rocksdb/utilities/options_type.h"
+#include "util/math.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+static std::unordered_map<std::string, OptionTypeInfo> numa_type_info = {
+    {"capacity",
+     {offsetof(struct NumaAllocatorOptions, capacity), OptionType::kSizeT,
+      OptionVerificationType::kNormal, OptionTypeFlags::kNone}},
+};
+
+#ifdef NUMA
+namespace {
+// Precedes every allocation handed out, keeping the payload 16-byte aligned
+struct AllocationHeader {
+  // The slab of the block, or the total mapped size for allocations mapped
+  // directly
+  uint64_t slab_or_size;
+  // Size class index, or kLargeAllocation for allocations mapped directly
+  uint64_t size_class;
+};
+static_assert(sizeof(AllocationHeader) == 16);
+constexpr uint64_t kLargeAllocation = UINT64_MAX;
+
+AllocationHeader* HeaderOf(void* p) {
+  return static_cast<AllocationHeader*>(p) - 1;
+}
+}  // namespace
+
+NumaMemoryAllocator::NumaMemoryAllocator(const NumaAllocatorOptions& options)
+    : options_(options) {
+  RegisterOptions(&options_, &numa_type_info);
+  int num_nodes = IsSupported() ? port::NumNumaNodes() : 1;
+  for (int i = 0; i < num_nodes; ++i) {
+    arenas_.emplace_back(new NodeArena());
+  }
+  ComputeSlabSize();
+}
+
+NumaMemoryAllocator::~NumaMemoryAllocator() {
+  for (auto& arena : arenas_) {
+    for (Slab* slab = arena->all_slabs; slab != nullptr;) {
+      Slab* next = slab->all_next;
+      numa_free(slab, slab->map_size);
+      slab = next;
+    }
+    if (arena->spare != nullptr) {
+      numa_free(arena->spare, arena->spare->map_size);
+    }
+  }
+}
+
+int NumaMemoryAllocator::SizeClassOf(size_t size) {
+  assert(size <= (size_t{1} << kMaxClassShift));
+  if (size <= (size_t{1} << kMinClassShift)) {
+    return 0;
+  }
+  // size is in (2^k, 2^(k+1)], and the two bits below the top bit of size - 1
+  // select one of four classes in that range
+  int k = FloorLog2(size - 1);
+  int step = static_cast<int>((size - 1) >> (k - 2)) & 3;
+  return 1 + (k - kMinClassShift) * 4 + step;
+}
+
+size_t NumaMemoryAllocator::ClassSize(int size_class) {
+  if (size_class == 0) {
+    return size_t{1} << kMinClassShift;
+  }
+  int k = kMinClassShift + (size_class - 1) / 4;
+  int step = (size_class - 1) % 4;
+  return (size_t{1} << k) + (static_cast<size_t>(step + 1) << (k - 2));
+}
+
+size_t NumaMemoryAllocator::BlockSize(int size_class) {
+  return sizeof(AllocationHeader) + ClassSize(size_class);
+}
+
+void NumaMemoryAllocator::ComputeSlabSize() {
+  slab_size_ = kMaxSlabSize;
+  if (options_.capacity > 0) {
+    size_t per_node = options_.capacity / static_cast<size_t>(NumNodes());
+    slab_size_ = std::clamp(per_node / kSlabsPerNodeCapacity, kMinSlabSize,
+                            kMaxSlabSize);
+  }
+  // Largest size class with kMinBlocksPerSlab blocks per slab
+  size_t max_block_size = (slab_size_ - kSlabHeaderSize) / kMinBlocksPerSlab;
+  max_class_size_ = 0;
+  for (int size_class = 0; size_class < kNumClasses &&
+                           BlockSize(size_class) <= max_block_size;
+       ++size_class) {
+    max_class_size_ = ClassSize(size_class);
+  }
+}
+
+void* NumaMemoryAllocator::AllocateOnNode(int node, size_t total_size) {
+  void* mem = numa_alloc_onnode(total_size, node);
+  if (mem == nullptr) {
+    throw std::bad_alloc();
+  }
+  return mem;
+}
+
+void NumaMemoryAllocator::MakeAvailable(NodeArena& arena, Slab* slab) {
+  assert(!slab->available);
+  Slab*& head = arena.available[slab->size_class];
+  slab->prev = nullptr;
+  slab->next = head;
+  if (head != nullptr) {
+    head->prev = slab;
+  }
+  head = slab;
+  slab->available = true;
+}
+
+void NumaMemoryAllocator::MakeUnavailable(NodeArena& arena, Slab* slab) {
+  assert(slab->available);
+  if (slab->prev != nullptr) {
+    slab->prev->next = slab->next;
+  } else {
+    arena.available[slab->size_class] = slab->next;
+  }
+  if (slab->next != nullptr) {
+    slab->next->prev = slab->prev;
+  }
+  slab->prev = slab->next = nullptr;
+  slab->available = false;
+}
+
+NumaMemoryAllocator::Slab* NumaMemoryAllocator::NewSlab(NodeArena& arena,
+                                                        int node,
+                                                        int size_class) {
+  size_t map_size = slab_size_;
+  char* mem;
+  if (arena.spare != nullptr && arena.spare->map_size == map_size) {
+    mem = reinterpret_cast<char*>(arena.spare);
+    arena.spare = nullptr;
+  } else {
+    mem = static_cast<char*>(AllocateOnNode(node, map_size));
+  }
+  Slab* slab = new (mem) Slab();
+  slab->bump_ptr = mem + kSlabHeaderSize;
+  slab->end = mem + map_size;
+  slab->map_size = map_size;
+  slab->node = static_cast<uint32_t>(node);
+  slab->size_class = static_cast<uint32_t>(size_class);
+  slab->all_next = arena.all_slabs;
+  if (arena.all_slabs != nullptr) {
+    arena.all_slabs->all_prev = slab;
+  }
+  arena.all_slabs = slab;
+  MakeAvailable(arena, slab);
+  return slab;
+}
+
+void NumaMemoryAllocator::ReleaseSlab(NodeArena& arena, Slab* slab) {
+  assert(slab->num_allocated == 0);
+  MakeUnavailable(arena, slab);
+  if (slab->all_prev != nullptr) {
+    slab->all_prev->all_next = slab->all_next;
+  } else {
+    arena.all_slabs = slab->all_next;
+  }
+  if (slab->all_next != nullptr) {
+    slab->all_next->all_prev = slab->all_prev;
+  }
+  if (arena.spare == nullptr) {
+    arena.spare = slab;
+  } else {
+    numa_free(slab, slab->map_size);
+  }
+}
+
+void* NumaMemoryAllocator::Allocate(size_t size) {
+  int node = port::NumaNodeOfCpu();
+  if (node >= NumNodes()) {
+    node = 0;
+  }
+  AllocationHeader* header;
+  if (size > max_class_size_) {
+    size_t total_size = sizeof(AllocationHeader) + size;
+    header = static_cast<AllocationHeader*>(AllocateOnNode(node, total_size));
+    header->slab_or_size = total_size;
+    header->size_class = kLargeAllocation;
+    return header + 1;
+  }
+  int size_class = SizeClassOf(size);
+  size_t block_size = BlockSize(size_class);
+  NodeArena& arena = *arenas_[node];
+  MutexLock l(&arena.mutex);
+  Slab* slab = arena.available[size_class];
+  if (slab == nullptr) {
+    slab = NewSlab(arena, node, size_class);
+  }
+  if (slab->free_list != nullptr) {
+    header = reinterpret_cast<AllocationHeader*>(slab->free_list);
+    slab->free_list = slab->free_list->next;
+  } else {
+    header = reinterpret_cast<AllocationHeader*>(slab->bump_ptr);
+    slab->bump_ptr += block_size;
+  }
+  ++slab->num_allocated;
+  if (slab->free_list == nullptr &&
+      static_cast<size_t>(slab->end - slab->bump_ptr) < block_size) {
+    MakeUnavailable(arena, slab);
+  }
+  header->slab_or_size = reinterpret_cast<uintptr_t>(slab);
+  header->size_class = static_cast<uint64_t>(size_class);
+  return header + 1;
+}
+
+void NumaMemoryAllocator::Deallocate(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+  AllocationHeader* header = HeaderOf(p);
+  if (header->size_class == kLargeAllocation) {
+    numa_free(header, header->slab_or_size);
+    return;
+  }
+  Slab* slab = reinterpret_cast<Slab*>(header->slab_or_size);
+  NodeArena& arena = *arenas_[slab->node];
+  FreeBlock* block = reinterpret_cast<FreeBlock*>(header);
+  MutexLock l(&arena.mutex);
+  block->next = slab->free_list;
+  slab->free_list = block;
+  --slab->num_allocated;
+  if (!slab->available) {
+    MakeAvailable(arena, slab);
+  }
+  if (slab->num_allocated == 0) {
+    ReleaseSlab(arena, slab);
+  }
+}
+
+size_t NumaMemoryAllocator::UsableSize(void* p,
+                                       size_t /*allocation_size*/) const {
+  AllocationHeader* header = HeaderOf(p);
+  if (header->size_class == kLargeAllocation) {
+    return header->slab_or_size - sizeof(AllocationHeader);
+  }
+  return ClassSize(static_cast<int>(header->size_class));
+}
+#else
+NumaMemoryAllocator::NumaMemoryAllocator(const NumaAllocatorOptions& options)
+    : options_(options) {
+  RegisterOptions(&options_, &numa_type_info);
+}
+NumaMemoryAllocator::~NumaMemoryAllocator() = default;
+#endif  // NUMA
+
+bool NumaMemoryAllocator::IsSupported(std::string* msg) {
+#ifdef NUMA
+  if (numa_available() < 0) {
+    *msg = "NUMA is not available on this system";
+    return false;
+  }
+  return true;
+#else
+  *msg = "Not compiled with NUMA";
+  return false;
+#endif  // NUMA
+}
+
+Status NumaMemoryAllocator::PrepareOptions(const ConfigOptions& options) {
+  std::string message;
+  if (!IsSupported(&message)) {
+    return Status::NotSupported(message);
+  }
+#ifdef NUMA
+  // The capacity may have been configured after construction
+  ComputeSlabSize();
+#endif  // NUMA
+  return MemoryAllocator::PrepareOptions(options);
+}
+
+Status NewNumaMemoryAllocator(
+    const NumaAllocatorOptions& options,
+    std::shared_ptr<MemoryAllocator>* memory_allocator) {
+  if (memory_allocator == nullptr) {
+    return Status::InvalidArgument("memory_allocator must be non-null.");
+  }
+  std::string msg;
+  if (!NumaMemoryAllocator::IsSupported(&msg)) {
+    return Status::NotSupported(msg);
+  }
+  memory_allocator->reset(new NumaMemoryAllocator(options));
+  return Status::OK();
+}
+
+}  // namespace ROCKSDB_NAMESPACE
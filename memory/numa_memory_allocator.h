@@ -0,0 +1,119 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "port/port.h"
+#include "rocksdb/memory_allocator.h"
+#include "utilities/memory_allocators.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A MemoryAllocator that places each allocation in memory bound to the NUMA
+// node of the calling thread. Allocations of up to an eighth of the slab size
+// (see NumaAllocatorOptions::capacity) are rounded up to one of four size
+// classes per power of two and carved out of node-bound slabs holding a
+// single size class; freed blocks are reused within their slab, and a slab is
+// returned to the OS once it is empty (except for one spare slab per node,
+// which any size class can take over). Larger allocations are mapped directly
+// on the node. Memory freed from another node goes back to the slab it was
+// allocated from.
+class NumaMemoryAllocator : public BaseMemoryAllocator {
+ public:
+  explicit NumaMemoryAllocator(const NumaAllocatorOptions& options);
+  ~NumaMemoryAllocator() override;
+
+  static const char* kClassName() { return "NumaMemoryAllocator"; }
+  const char* Name() const override { return kClassName(); }
+  static bool IsSupported() {
+    std::string unused;
+    return IsSupported(&unused);
+  }
+  static bool IsSupported(std::string* msg);
+  Status PrepareOptions(const ConfigOptions& options) override;
+
+#ifdef NUMA
+  void* Allocate(size_t size) override;
+  void Deallocate(void* p) override;
+  size_t UsableSize(void* p, size_t allocation_size) const override;
+
+ private:
+  // Payload size classes: 2^kMinClassShift bytes, then four classes in each
+  // (2^k, 2^(k+1)] up to 2^kMaxClassShift bytes. The per-allocation header
+  // comes on top of the class size.
+  static constexpr int kMinClassShift = 6;
+  static constexpr int kMaxClassShift = 18;
+  static constexpr int kNumClasses = 1 + (kMaxClassShift - kMinClassShift) * 4;
+  // All slabs have the same size, a 1/kSlabsPerNodeCapacity share of the
+  // capacity per node, within [kMinSlabSize, kMaxSlabSize]. Size classes
+  // with fewer than kMinBlocksPerSlab blocks per slab are not used.
+  static constexpr size_t kMinSlabSize = size_t{64} << 10;
+  static constexpr size_t kMaxSlabSize = size_t{2} << 20;
+  static constexpr size_t kSlabsPerNodeCapacity = 64;
+  static constexpr size_t kMinBlocksPerSlab = 8;
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  // At the start of each slab
+  struct Slab {
+    // Within the list of slabs of the class with free blocks
+    Slab* prev = nullptr;
+    Slab* next = nullptr;
+    bool available = false;
+    // Within the list of all slabs of the node
+    Slab* all_prev = nullptr;
+    Slab* all_next = nullptr;
+    FreeBlock* free_list = nullptr;
+    // Never handed out space
+    char* bump_ptr = nullptr;
+    char* end = nullptr;
+    size_t map_size = 0;
+    uint32_t node = 0;
+    uint32_t size_class = 0;
+    size_t num_allocated = 0;
+  };
+  // Keeps the blocks following the slab header 16-byte aligned
+  static constexpr size_t kSlabHeaderSize = (sizeof(Slab) + 63) & ~size_t{63};
+
+  struct ALIGN_AS(CACHE_LINE_SIZE) NodeArena {
+    port::Mutex mutex;
+    // Per size class, the slabs with free blocks
+    std::array<Slab*, kNumClasses> available{};
+    // Slabs in use
+    Slab* all_slabs = nullptr;
+    // An empty slab kept to avoid remapping when usage hovers around a slab
+    // boundary
+    Slab* spare = nullptr;
+  };
+
+  static int SizeClassOf(size_t size);
+  static size_t ClassSize(int size_class);
+  static size_t BlockSize(int size_class);
+
+  // Sets slab_size_ and max_class_size_ from options_
+  void ComputeSlabSize();
+  void* AllocateOnNode(int node, size_t total_size);
+  // REQUIRES: arena.mutex held
+  Slab* NewSlab(NodeArena& arena, int node, int size_class);
+  void ReleaseSlab(NodeArena& arena, Slab* slab);
+  static void MakeAvailable(NodeArena& arena, Slab* slab);
+  static void MakeUnavailable(NodeArena& arena, Slab* slab);
+  int NumNodes() const { return static_cast<int>(arenas_.size()); }
+
+  size_t slab_size_ = kMaxSlabSize;
+  // Largest allocation carved out of slabs
+  size_t max_class_size_ = 0;
+  std::vector<std::unique_ptr<NodeArena>> arenas_;
+#endif  // NUMA
+  NumaAllocatorOptions options_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
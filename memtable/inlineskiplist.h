@@ -199,6 +199,10 @@ class InlineSkipList {
     // Final state of iterator is Valid() iff list is not empty.
     void SeekToLast();
 
+    // Position at the node holding key, which must have been allocated by
+    // AllocateKey() and inserted into the list.
+    void SetToKey(const char* key);
+
    private:
     const InlineSkipList* list_;
     Node* node_;
@@ -496,6 +500,11 @@ inline void InlineSkipList<Comparator>::Iterator::SeekToLast() {
   }
 }
 
+template <class Comparator>
+inline void InlineSkipList<Comparator>::Iterator::SetToKey(const char* key) {
+  node_ = reinterpret_cast<Node*>(const_cast<char*>(key)) - 1;
+}
+
 template <class Comparator>
 int InlineSkipList<Comparator>::RandomHeight() {
   auto rnd = Random::GetTLSInstance();
@@ -15,7 +15,16 @@ int main() {
 }
 #else
 
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif  // __linux__
+
 #include <atomic>
+#include <cerrno>
+#include <cstring>
 #include <iostream>
 #include <memory>
 #include <thread>
@@ -63,7 +72,9 @@ DEFINE_string(memtablerep, "skiplist",
               "\tvector              -- backed by an std::vector\n"
               "\thashskiplist        -- backed by a hash skip list\n"
               "\thashlinklist        -- backed by a hash linked list\n"
-              "\tcuckoo              -- backed by a cuckoo hash table");
+              "\tcuckoo              -- backed by a cuckoo hash table\n"
+              "\trange_partitioned_skip_list -- backed by one skip list per "
+              "key range");
 
 DEFINE_int64(bucket_count, 1000000,
              "bucket_count parameter to pass into NewHashSkiplistRepFactory or "
@@ -122,6 +133,21 @@ DEFINE_int64(seed, 0,
              "Seed base for random number generators. "
              "When 0 it is deterministic.");
 
+/* Arena settings */
+DEFINE_int64(arena_block_size, ROCKSDB_NAMESPACE::Arena::kMinBlockSize,
+             "Block size of the arena the memtablerep allocates from");
+
+DEFINE_bool(arena_transparent_huge_pages, false,
+            "Back arena blocks of at least 2MB with transparent huge pages");
+
+DEFINE_bool(arena_prefault, false,
+            "Fault in arena blocks when they are allocated");
+
+DEFINE_bool(report_tlb_misses, false,
+            "Report data TLB load and store misses of each benchmark, using "
+            "Linux perf events. Needs a kernel.perf_event_paranoid setting "
+            "that allows counting user space events of the process.");
+
 namespace ROCKSDB_NAMESPACE {
 
 namespace {
@@ -405,6 +431,102 @@ class SeqConcurrentReadBenchmarkThread : public SeqReadBenchmarkThread {
   std::atomic_int* threads_done_;
 };
 
+// Counts data TLB misses in user space, by this thread and by the threads it
+// starts while counting
+class TlbMissCounter {
+ public:
+  TlbMissCounter() {
+    fds_[0] = Open(0 /* PERF_COUNT_HW_CACHE_OP_READ */);
+    fds_[1] = Open(1 /* PERF_COUNT_HW_CACHE_OP_WRITE */);
+  }
+
+  ~TlbMissCounter() {
+#ifdef __linux__
+    for (int fd : fds_) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+#endif  // __linux__
+  }
+
+  void Start() {
+#ifdef __linux__
+    for (int fd : fds_) {
+      if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+#endif  // __linux__
+  }
+
+  // Must be called after the counted threads have been joined, so that their
+  // counts have been folded into ours
+  void StopAndReport(uint64_t num_ops) {
+    static const char* const kNames[] = {"load", "store"};
+    for (int i = 0; i < 2; ++i) {
+      uint64_t misses = 0;
+      if (!Read(fds_[i], &misses)) {
+        std::cout << "dTLB " << kNames[i] << " misses: unavailable"
+                  << std::endl;
+        continue;
+      }
+      std::cout << "dTLB " << kNames[i] << " misses: " << misses;
+      if (num_ops > 0) {
+        std::cout << " (" << static_cast<double>(misses) / num_ops
+                  << " per op)";
+      }
+      std::cout << std::endl;
+    }
+  }
+
+ private:
+  int fds_[2];
+
+  static int Open(int op) {
+#ifdef __linux__
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB | (op << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    int fd = static_cast<int>(syscall(__NR_perf_event_open, &attr,
+                                      0 /* pid */, -1 /* cpu */,
+                                      -1 /* group_fd */, 0 /* flags */));
+    if (fd < 0) {
+      std::cout << "WARNING: failed to open dTLB miss counter: "
+                << strerror(errno) << std::endl;
+    }
+    return fd;
+#else
+    (void)op;
+    std::cout << "WARNING: dTLB miss counters are only supported on Linux"
+              << std::endl;
+    return -1;
+#endif  // __linux__
+  }
+
+  static bool Read(int fd, uint64_t* value) {
+#ifdef __linux__
+    if (fd < 0) {
+      return false;
+    }
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    return read(fd, value, sizeof(*value)) == sizeof(*value);
+#else
+    (void)fd;
+    (void)value;
+    return false;
+#endif  // __linux__
+  }
+};
+
 class Benchmark {
  public:
   explicit Benchmark(MemTableRep* table, KeyGenerator* key_gen,
@@ -421,11 +543,23 @@ class Benchmark {
     uint64_t bytes_written = 0;
     uint64_t bytes_read = 0;
     uint64_t read_hits = 0;
+    std::unique_ptr<TlbMissCounter> tlb_misses;
+    if (FLAGS_report_tlb_misses) {
+      tlb_misses.reset(new TlbMissCounter());
+      tlb_misses->Start();
+    }
     StopWatchNano timer(SystemClock::Default().get(), true);
     RunThreads(&threads, &bytes_written, &bytes_read, true, &read_hits);
     auto elapsed_time = static_cast<double>(timer.ElapsedNanos() / 1000);
     std::cout << "Elapsed time: " << static_cast<int>(elapsed_time) << " us"
               << std::endl;
+    if (tlb_misses) {
+      // At most one thread writes, the others read
+      uint32_t num_readers =
+          num_write_ops_per_thread_ > 0 ? num_threads_ - 1 : num_threads_;
+      tlb_misses->StopAndReport(num_write_ops_per_thread_ +
+                                num_read_ops_per_thread_ * num_readers);
+    }
 
     if (bytes_written > 0) {
       auto MiB_written = static_cast<double>(bytes_written) / (1 << 20);
@@ -614,7 +748,10 @@ int main(int argc, char** argv) {
   ROCKSDB_NAMESPACE::InternalKeyComparator internal_key_comp(
       ROCKSDB_NAMESPACE::BytewiseComparator());
   ROCKSDB_NAMESPACE::MemTable::KeyComparator key_comp(internal_key_comp);
-  ROCKSDB_NAMESPACE::Arena arena;
+  ROCKSDB_NAMESPACE::Arena arena(
+      static_cast<size_t>(FLAGS_arena_block_size), nullptr /* tracker */,
+      0 /* huge_page_size */, FLAGS_arena_transparent_huge_pages,
+      FLAGS_arena_prefault);
   ROCKSDB_NAMESPACE::WriteBufferManager wb(FLAGS_write_buffer_size);
   uint64_t sequence;
   auto createMemtableRep = [&] {
@@ -0,0 +1,597 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+// A memtable representation that partitions the key space into ranges, each
+// held by an independent InlineSkipList. Boundaries are either configured up
+// front or learned from samples of the keys inserted into previous memtables
+// of the same factory. Since partitions hold disjoint, ordered key ranges,
+// ordered iteration simply moves from one partition to the next. An optional
+// lock-free hash index from user key to the newest entry of that key serves
+// point lookups without a skip list search.
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "db/dbformat.h"
+#include "db/memtable.h"
+#include "memory/arena.h"
+#include "memtable/inlineskiplist.h"
+#include "port/port.h"
+#include "rocksdb/memtablerep.h"
+#include "rocksdb/utilities/options_type.h"
+#include "util/coding.h"
+#include "util/hash.h"
+#include "util/mutexlock.h"
+#include "util/random.h"
+
+namespace ROCKSDB_NAMESPACE {
+namespace {
+
+using PartitionList = InlineSkipList<const MemTableRep::KeyComparator&>;
+
+// Boundaries learned by the memtables of one factory, handed on to the
+// memtables created after them.
+struct LearnedBoundaries {
+  port::Mutex mutex;
+  // Internal keys, see MakeBoundary()
+  std::vector<std::string> boundaries;
+};
+
+// A boundary is the smallest internal key for a user key, so that all
+// versions of a user key fall into the same partition.
+std::string MakeBoundary(const Slice& user_key) {
+  std::string boundary(user_key.data(), user_key.size());
+  PutFixed64(&boundary,
+             PackSequenceAndType(kMaxSequenceNumber, kValueTypeForSeek));
+  return boundary;
+}
+
+class RangePartitionedSkipListRep : public MemTableRep {
+ public:
+  RangePartitionedSkipListRep(
+      const MemTableRep::KeyComparator& compare, Allocator* allocator,
+      std::vector<std::string> boundaries,
+      std::shared_ptr<LearnedBoundaries> learned, size_t num_learned_partitions,
+      size_t point_index_bucket_count)
+      : MemTableRep(allocator),
+        cmp_(compare),
+        boundaries_(std::move(boundaries)),
+        learned_(std::move(learned)),
+        num_learned_partitions_(num_learned_partitions) {
+    partitions_.reserve(boundaries_.size() + 1);
+    for (size_t i = 0; i <= boundaries_.size(); ++i) {
+      partitions_.emplace_back(new PartitionList(cmp_, allocator));
+    }
+    if (point_index_bucket_count > 0) {
+      // Round up to a power of two
+      size_t num_buckets = 1;
+      while (num_buckets < point_index_bucket_count) {
+        num_buckets <<= 1;
+      }
+      char* mem = allocator->AllocateAligned(sizeof(std::atomic<const char*>) *
+                                             num_buckets);
+      point_index_ = reinterpret_cast<std::atomic<const char*>*>(mem);
+      for (size_t i = 0; i < num_buckets; ++i) {
+        new (&point_index_[i]) std::atomic<const char*>(nullptr);
+      }
+      point_index_mask_ = num_buckets - 1;
+    }
+    fixed_memory_usage_ =
+        partitions_.capacity() * sizeof(partitions_[0]) +
+        partitions_.size() * sizeof(PartitionList) +
+        boundaries_.capacity() * sizeof(std::string);
+    for (const auto& boundary : boundaries_) {
+      fixed_memory_usage_ += boundary.capacity();
+    }
+  }
+
+  KeyHandle Allocate(const size_t len, char** buf) override {
+    // All partitions share the allocator and skip list parameters, so a node
+    // allocated through any of them can be inserted into any other.
+    *buf = partitions_[0]->AllocateKey(len);
+    return static_cast<KeyHandle>(*buf);
+  }
+
+  void Insert(KeyHandle handle) override { InsertKey(handle); }
+
+  bool InsertKey(KeyHandle handle) override {
+    const char* key = static_cast<char*>(handle);
+    if (!PartitionFor(key)->Insert(key)) {
+      return false;
+    }
+    OnInserted(key);
+    return true;
+  }
+
+  void InsertConcurrently(KeyHandle handle) override {
+    InsertKeyConcurrently(handle);
+  }
+
+  bool InsertKeyConcurrently(KeyHandle handle) override {
+    const char* key = static_cast<char*>(handle);
+    if (!PartitionFor(key)->InsertConcurrently(key)) {
+      return false;
+    }
+    OnInserted(key);
+    return true;
+  }
+
+  bool InsertKeyWithHint(KeyHandle handle, void** /*hint*/) override {
+    return InsertKey(handle);
+  }
+
+  bool InsertKeyWithHintConcurrently(KeyHandle handle,
+                                     void** /*hint*/) override {
+    return InsertKeyConcurrently(handle);
+  }
+
+  bool Contains(const char* key) const override {
+    return PartitionFor(key)->Contains(key);
+  }
+
+  void MarkReadOnly() override { LearnBoundaries(); }
+
+  size_t ApproximateMemoryUsage() override {
+    // Skip list nodes and the point index are allocated through the
+    // allocator and already counted there. Report what lives on the heap.
+    return fixed_memory_usage_ +
+           samples_memory_usage_.load(std::memory_order_relaxed);
+  }
+
+  void Get(const LookupKey& k, void* callback_args,
+           bool (*callback_func)(void* arg, const char* entry)) override {
+    if (point_index_ != nullptr) {
+      const char* newest = nullptr;
+      if (PointIndexLookup(k.user_key(), &newest)) {
+        if (newest == nullptr) {
+          // No version of the user key in this memtable
+          return;
+        }
+        // Versions of a user key are never split across partitions
+        PartitionList::Iterator iter(PartitionFor(newest));
+        iter.SetToKey(newest);
+        // Skip versions newer than the lookup sequence number
+        while (iter.Valid() && cmp_(iter.key(), k.internal_key()) < 0) {
+          iter.Next();
+        }
+        for (; iter.Valid() && callback_func(callback_args, iter.key());
+             iter.Next()) {
+        }
+        return;
+      }
+    }
+    Iterator iter(this);
+    Slice dummy_slice;
+    for (iter.Seek(dummy_slice, k.memtable_key().data());
+         iter.Valid() && callback_func(callback_args, iter.key());
+         iter.Next()) {
+    }
+  }
+
+  Status GetAndValidate(const LookupKey& k, void* callback_args,
+                        bool (*callback_func)(void* arg, const char* entry),
+                        bool allow_data_in_errors) override {
+    Iterator iter(this);
+    Slice dummy_slice;
+    Status status = iter.SeekAndValidate(dummy_slice, k.memtable_key().data(),
+                                         allow_data_in_errors);
+    for (; iter.Valid() && status.ok() &&
+           callback_func(callback_args, iter.key());
+         status = iter.NextAndValidate(allow_data_in_errors)) {
+    }
+    return status;
+  }
+
+  uint64_t ApproximateNumEntries(const Slice& start_ikey,
+                                 const Slice& end_ikey) override {
+    uint64_t count = 0;
+    for (auto& partition : partitions_) {
+      count += partition->ApproximateNumEntries(start_ikey, end_ikey);
+    }
+    return count;
+  }
+
+  void UniqueRandomSample(const uint64_t num_entries,
+                          const uint64_t target_sample_size,
+                          std::unordered_set<const char*>* entries) override {
+    entries->clear();
+    assert(target_sample_size > 0);
+    assert(num_entries > 0);
+    // Add each entry with probability
+    // num_samples_left / (num_entries - counter)
+    Random* rnd = Random::GetTLSInstance();
+    Iterator iter(this);
+    iter.SeekToFirst();
+    uint64_t counter = 0, num_samples_left = target_sample_size;
+    for (; iter.Valid() && num_samples_left > 0 && counter < num_entries;
+         iter.Next(), counter++) {
+      if (rnd->Next() % (num_entries - counter) < num_samples_left) {
+        entries->insert(iter.key());
+        num_samples_left--;
+      }
+    }
+  }
+
+  ~RangePartitionedSkipListRep() override = default;
+
+  // Iterates over the partitions in order, which together hold the keys in
+  // order since their ranges are disjoint.
+  class Iterator : public MemTableRep::Iterator {
+   public:
+    explicit Iterator(const RangePartitionedSkipListRep* rep)
+        : rep_(rep), iter_(rep->partitions_[0].get()) {}
+
+    ~Iterator() override = default;
+
+    bool Valid() const override { return iter_.Valid(); }
+
+    const char* key() const override {
+      assert(Valid());
+      return iter_.key();
+    }
+
+    void Next() override {
+      assert(Valid());
+      iter_.Next();
+      SkipEmptyPartitionsForward();
+    }
+
+    Status NextAndValidate(bool allow_data_in_errors) override {
+      assert(Valid());
+      Status s = iter_.NextAndValidate(allow_data_in_errors);
+      if (s.ok()) {
+        SkipEmptyPartitionsForward();
+      }
+      return s;
+    }
+
+    void Prev() override {
+      assert(Valid());
+      iter_.Prev();
+      SkipEmptyPartitionsBackward();
+    }
+
+    Status PrevAndValidate(bool allow_data_in_errors) override {
+      assert(Valid());
+      Status s = iter_.PrevAndValidate(allow_data_in_errors);
+      if (s.ok()) {
+        SkipEmptyPartitionsBackward();
+      }
+      return s;
+    }
+
+    void Seek(const Slice& user_key, const char* memtable_key) override {
+      const char* target = memtable_key != nullptr
+                               ? memtable_key
+                               : EncodeKey(&tmp_, user_key);
+      SetPartition(rep_->PartitionIndexFor(target));
+      iter_.Seek(target);
+      SkipEmptyPartitionsForward();
+    }
+
+    Status SeekAndValidate(const Slice& user_key, const char* memtable_key,
+                           bool allow_data_in_errors) override {
+      const char* target = memtable_key != nullptr
+                               ? memtable_key
+                               : EncodeKey(&tmp_, user_key);
+      SetPartition(rep_->PartitionIndexFor(target));
+      Status s = iter_.SeekAndValidate(target, allow_data_in_errors);
+      if (s.ok()) {
+        SkipEmptyPartitionsForward();
+      }
+      return s;
+    }
+
+    void SeekForPrev(const Slice& user_key, const char* memtable_key) override {
+      const char* target = memtable_key != nullptr
+                               ? memtable_key
+                               : EncodeKey(&tmp_, user_key);
+      SetPartition(rep_->PartitionIndexFor(target));
+      iter_.SeekForPrev(target);
+      SkipEmptyPartitionsBackward();
+    }
+
+    void RandomSeek() override {
+      SetPartition(static_cast<size_t>(Random::GetTLSInstance()->Uniform(
+          static_cast<int>(rep_->partitions_.size()))));
+      iter_.RandomSeek();
+      SkipEmptyPartitionsForward();
+    }
+
+    void SeekToFirst() override {
+      SetPartition(0);
+      iter_.SeekToFirst();
+      SkipEmptyPartitionsForward();
+    }
+
+    void SeekToLast() override {
+      SetPartition(rep_->partitions_.size() - 1);
+      iter_.SeekToLast();
+      SkipEmptyPartitionsBackward();
+    }
+
+   private:
+    void SetPartition(size_t index) {
+      partition_ = index;
+      iter_.SetList(rep_->partitions_[index].get());
+    }
+
+    void SkipEmptyPartitionsForward() {
+      while (!iter_.Valid() && partition_ + 1 < rep_->partitions_.size()) {
+        SetPartition(partition_ + 1);
+        iter_.SeekToFirst();
+      }
+    }
+
+    void SkipEmptyPartitionsBackward() {
+      while (!iter_.Valid() && partition_ > 0) {
+        SetPartition(partition_ - 1);
+        iter_.SeekToLast();
+      }
+    }
+
+    const RangePartitionedSkipListRep* const rep_;
+    PartitionList::Iterator iter_;
+    size_t partition_ = 0;
+    std::string tmp_;  // For passing to EncodeKey
+  };
+
+  MemTableRep::Iterator* GetIterator(Arena* arena = nullptr) override {
+    void* mem = arena ? arena->AllocateAligned(sizeof(Iterator))
+                      : operator new(sizeof(Iterator));
+    return new (mem) Iterator(this);
+  }
+
+ private:
+  // Linear probing stops after this many buckets. An insert that finds no
+  // slot marks the index as incomplete, after which lookups not found in the
+  // index fall back on a skip list search.
+  static constexpr size_t kMaxProbes = 16;
+  // One in this many inserted keys is sampled for learning boundaries
+  static constexpr int kSampleOneIn = 256;
+  static constexpr size_t kMaxSamples = 4096;
+
+  size_t PartitionIndexFor(const char* key) const {
+    // First boundary greater than key
+    auto it = std::upper_bound(
+        boundaries_.begin(), boundaries_.end(), key,
+        [this](const char* k, const std::string& boundary) {
+          return cmp_(k, Slice(boundary)) < 0;
+        });
+    return static_cast<size_t>(it - boundaries_.begin());
+  }
+
+  PartitionList* PartitionFor(const char* key) const {
+    return partitions_[PartitionIndexFor(key)].get();
+  }
+
+  void OnInserted(const char* key) {
+    if (point_index_ != nullptr) {
+      PointIndexInsert(key);
+    }
+    if (num_learned_partitions_ > 1 &&
+        Random::GetTLSInstance()->OneIn(kSampleOneIn)) {
+      Slice internal_key = cmp_.decode_key(key);
+      MutexLock l(&samples_mutex_);
+      std::string sample;
+      PutLengthPrefixedSlice(&sample, internal_key);
+      samples_bytes_ += sample.size();
+      if (samples_.size() < kMaxSamples) {
+        samples_.push_back(std::move(sample));
+      } else {
+        std::string& replaced =
+            samples_[Random::GetTLSInstance()->Uniform(kMaxSamples)];
+        samples_bytes_ -= replaced.size();
+        replaced = std::move(sample);
+      }
+      samples_memory_usage_.store(
+          samples_.capacity() * sizeof(std::string) + samples_bytes_,
+          std::memory_order_relaxed);
+    }
+  }
+
+  // Publishes boundaries splitting the sampled keys into
+  // num_learned_partitions_ ranges of about equal size, for use by the
+  // memtables created after this one.
+  void LearnBoundaries() {
+    if (num_learned_partitions_ <= 1) {
+      return;
+    }
+    std::vector<std::string> samples;
+    {
+      MutexLock l(&samples_mutex_);
+      samples.swap(samples_);
+      samples_bytes_ = 0;
+      samples_memory_usage_.store(0, std::memory_order_relaxed);
+    }
+    if (samples.size() < num_learned_partitions_) {
+      return;
+    }
+    std::sort(samples.begin(), samples.end(),
+              [this](const std::string& a, const std::string& b) {
+                return cmp_(a.data(), b.data()) < 0;
+              });
+    std::vector<std::string> boundaries;
+    for (size_t i = 1; i < num_learned_partitions_; ++i) {
+      const std::string& sample =
+          samples[i * samples.size() / num_learned_partitions_];
+      std::string boundary =
+          MakeBoundary(ExtractUserKey(GetLengthPrefixedSlice(sample.data())));
+      if (!boundaries.empty()) {
+        std::string encoded;
+        PutLengthPrefixedSlice(&encoded, boundary);
+        if (cmp_(encoded.data(), Slice(boundaries.back())) <= 0) {
+          // Duplicate user key; skip to keep partitions non-empty
+          continue;
+        }
+      }
+      boundaries.push_back(std::move(boundary));
+    }
+    MutexLock l(&learned_->mutex);
+    learned_->boundaries = std::move(boundaries);
+  }
+
+  size_t PointIndexBucket(const Slice& user_key) const {
+    return static_cast<size_t>(GetSliceHash64(user_key)) & point_index_mask_;
+  }
+
+  void PointIndexInsert(const char* key) {
+    Slice internal_key = cmp_.decode_key(key);
+    Slice user_key = ExtractUserKey(internal_key);
+    SequenceNumber seq = GetInternalKeySeqno(internal_key);
+    size_t bucket = PointIndexBucket(user_key);
+    for (size_t probe = 0; probe < kMaxProbes; ++probe) {
+      auto& slot = point_index_[(bucket + probe) & point_index_mask_];
+      const char* existing = slot.load(std::memory_order_acquire);
+      for (;;) {
+        if (existing == nullptr) {
+          if (slot.compare_exchange_weak(existing, key,
+                                         std::memory_order_acq_rel)) {
+            return;
+          }
+          // Lost a race; `existing` now holds the winner
+          continue;
+        }
+        Slice existing_ikey = cmp_.decode_key(existing);
+        if (ExtractUserKey(existing_ikey) != user_key) {
+          break;
+        }
+        // Same user key: keep the newest version
+        if (GetInternalKeySeqno(existing_ikey) >= seq ||
+            slot.compare_exchange_weak(existing, key,
+                                       std::memory_order_acq_rel)) {
+          return;
+        }
+      }
+    }
+    point_index_incomplete_.store(true, std::memory_order_release);
+  }
+
+  // Returns false if the index cannot answer the lookup. Otherwise returns
+  // true with *newest set to the newest entry for user_key, or nullptr if
+  // there is none.
+  bool PointIndexLookup(const Slice& user_key, const char** newest) const {
+    size_t bucket = PointIndexBucket(user_key);
+    for (size_t probe = 0; probe < kMaxProbes; ++probe) {
+      const char* entry = point_index_[(bucket + probe) & point_index_mask_]
+                              .load(std::memory_order_acquire);
+      if (entry == nullptr) {
+        break;
+      }
+      if (ExtractUserKey(cmp_.decode_key(entry)) == user_key) {
+        *newest = entry;
+        return true;
+      }
+    }
+    *newest = nullptr;
+    return !point_index_incomplete_.load(std::memory_order_acquire);
+  }
+
+  const MemTableRep::KeyComparator& cmp_;
+  // Internal keys; partition i holds keys in [boundaries_[i-1], boundaries_[i])
+  const std::vector<std::string> boundaries_;
+  std::vector<std::unique_ptr<PartitionList>> partitions_;
+
+  std::atomic<const char*>* point_index_ = nullptr;
+  size_t point_index_mask_ = 0;
+  std::atomic<bool> point_index_incomplete_{false};
+
+  std::shared_ptr<LearnedBoundaries> learned_;
+  const size_t num_learned_partitions_;
+  port::Mutex samples_mutex_;
+  // Length-prefixed internal keys, comparable with cmp_
+  std::vector<std::string> samples_;
+  size_t samples_bytes_ = 0;
+
+  // Heap memory not allocated through the allocator, reported by
+  // ApproximateMemoryUsage()
+  size_t fixed_memory_usage_ = 0;
+  // Updated under samples_mutex_, read without it on the write path
+  std::atomic<size_t> samples_memory_usage_{0};
+};
+
+std::unordered_map<std::string, OptionTypeInfo>
+    range_partitioned_skiplist_info = {
+        {"partition_boundaries",
+         OptionTypeInfo::Vector<std::string>(
+             offsetof(struct RangePartitionedSkipListRepOptions,
+                      partition_boundaries),
+             OptionVerificationType::kNormal, OptionTypeFlags::kNone,
+             {0, OptionType::kString})},
+        {"num_learned_partitions",
+         {offsetof(struct RangePartitionedSkipListRepOptions,
+                   num_learned_partitions),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"point_index_bucket_count",
+         {offsetof(struct RangePartitionedSkipListRepOptions,
+                   point_index_bucket_count),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+};
+
+class RangePartitionedSkipListRepFactory : public MemTableRepFactory {
+ public:
+  explicit RangePartitionedSkipListRepFactory(
+      const RangePartitionedSkipListRepOptions& options)
+      : options_(options), learned_(std::make_shared<LearnedBoundaries>()) {
+    RegisterOptions(&options_, &range_partitioned_skiplist_info);
+  }
+
+  using MemTableRepFactory::CreateMemTableRep;
+  MemTableRep* CreateMemTableRep(const MemTableRep::KeyComparator& compare,
+                                 Allocator* allocator,
+                                 const SliceTransform* /*transform*/,
+                                 Logger* /*logger*/) override {
+    std::vector<std::string> boundaries;
+    size_t num_learned_partitions = 0;
+    if (!options_.partition_boundaries.empty()) {
+      for (const auto& user_key : options_.partition_boundaries) {
+        boundaries.push_back(MakeBoundary(user_key));
+      }
+      std::sort(boundaries.begin(), boundaries.end(),
+                [&compare](const std::string& a, const std::string& b) {
+                  std::string encoded;
+                  PutLengthPrefixedSlice(&encoded, a);
+                  return compare(encoded.data(), Slice(b)) < 0;
+                });
+    } else {
+      num_learned_partitions = options_.num_learned_partitions;
+      MutexLock l(&learned_->mutex);
+      boundaries = learned_->boundaries;
+    }
+    return new RangePartitionedSkipListRep(
+        compare, allocator, std::move(boundaries), learned_,
+        num_learned_partitions, options_.point_index_bucket_count);
+  }
+
+  static const char* kClassName() {
+    return "RangePartitionedSkipListRepFactory";
+  }
+  static const char* kNickName() { return "range_partitioned_skip_list"; }
+
+  const char* Name() const override { return kClassName(); }
+  const char* NickName() const override { return kNickName(); }
+
+  bool IsInsertConcurrentlySupported() const override { return true; }
+
+  bool CanHandleDuplicatedKey() const override { return true; }
+
+ private:
+  RangePartitionedSkipListRepOptions options_;
+  std::shared_ptr<LearnedBoundaries> learned_;
+};
+
+}  // namespace
+
+MemTableRepFactory* NewRangePartitionedSkipListRepFactory(
+    const RangePartitionedSkipListRepOptions& options) {
+  return new RangePartitionedSkipListRepFactory(options);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -1060,11 +1060,15 @@ void GenerateRandomKVs(std::vector<std::string>* keys,
 
 // TODO: move it to different files, as it's testing an internal API
 static void DataBlockSeek(benchmark::State& state) {
+  bool restart_key_prefixes = state.range(0);
   Random rnd(301);
   Options options = Options();
 
   BlockBuilder builder(16, true, false,
-                       BlockBasedTableOptions::kDataBlockBinarySearch);
+                       BlockBasedTableOptions::kDataBlockBinarySearch,
+                       0.75 /* data_block_hash_table_util_ratio */,
+                       0 /* ts_sz */, true /* persist_user_defined_timestamps */,
+                       false /* is_user_key */, restart_key_prefixes);
 
   int num_records = 500;
   std::vector<std::string> keys;
@@ -1083,6 +1087,10 @@ static void DataBlockSeek(benchmark::State& state) {
   BlockContents contents;
   contents.data = rawblock;
   Block reader(std::move(contents));
+  if (reader.HasRestartKeyPrefixes() != restart_key_prefixes) {
+    state.SkipWithError("unexpected block format");
+    return;
+  }
 
   SetPerfLevel(kEnableTime);
   uint64_t total = 0;
@@ -1104,7 +1112,14 @@ static void DataBlockSeek(benchmark::State& state) {
       static_cast<double>(total), benchmark::Counter::kAvgIterations);
 }
 
-BENCHMARK(DataBlockSeek)->Iterations(1000000);
+static void DataBlockSeekArguments(benchmark::internal::Benchmark* b) {
+  for (bool restart_key_prefixes : {false, true}) {
+    b->Args({restart_key_prefixes});
+  }
+  b->ArgNames({"restart_key_prefixes"});
+}
+
+BENCHMARK(DataBlockSeek)->Iterations(1000000)->Apply(DataBlockSeekArguments);
 
 static void IteratorSeek(benchmark::State& state) {
   auto compaction_style = static_cast<CompactionStyle>(state.range(0));
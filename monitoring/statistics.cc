@@ -273,6 +273,7 @@ const std::vector<std::pair<Tickers, std::string>> TickersNameMap = {
     {FILE_READ_CORRUPTION_RETRY_SUCCESS_COUNT,
      "rocksdb.file.read.corruption.retry.success.count"},
     {NUMBER_WBWI_INGEST, "rocksdb.number.wbwi.ingest"},
+    {COMPACTION_PREEMPTED, "rocksdb.compaction.preempted"},
 };
 
 const std::vector<std::pair<Histograms, std::string>> HistogramsNameMap = {
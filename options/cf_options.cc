@@ -19,6 +19,7 @@
 #include "port/port.h"
 #include "rocksdb/advanced_cache.h"
 #include "rocksdb/compaction_filter.h"
+#include "rocksdb/compaction_value_transformer.h"
 #include "rocksdb/concurrent_task_limiter.h"
 #include "rocksdb/configurable.h"
 #include "rocksdb/convenience.h"
@@ -263,6 +264,23 @@ static std::unordered_map<std::string, OptionTypeInfo>
         {"checksum",
          {offsetof(struct CompressionOptions, checksum), OptionType::kBoolean,
           OptionVerificationType::kNormal, OptionTypeFlags::kMutable}},
+        {"adaptive_compression_budget_pct",
+         {offsetof(struct CompressionOptions, adaptive_compression_budget_pct),
+          OptionType::kUInt32T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
+        {"pre_compression_transform",
+         OptionTypeInfo::Enum<PreCompressionTransform>(
+             offsetof(struct CompressionOptions, pre_compression_transform),
+             &pre_compression_transform_string_map,
+             OptionTypeFlags::kMutable)},
+        {"pre_compression_element_size",
+         {offsetof(struct CompressionOptions, pre_compression_element_size),
+          OptionType::kUInt32T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
+        {"use_shared_dict",
+         {offsetof(struct CompressionOptions, use_shared_dict),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
 };
 
 static std::unordered_map<std::string, OptionTypeInfo>
@@ -309,6 +327,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
           OptionTypeFlags::kMutable}},
         {"trivial_copy_buffer_size",
          {offsetof(struct CompactionOptionsFIFO, trivial_copy_buffer_size),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
+        {"min_reads_to_retain",
+         {offsetof(struct CompactionOptionsFIFO, min_reads_to_retain),
           OptionType::kUInt64T, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}}};
 
@@ -466,6 +488,15 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct MutableCFOptions, memtable_huge_page_size),
           OptionType::kSizeT, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"memtable_use_transparent_huge_pages",
+         {offsetof(struct MutableCFOptions,
+                   memtable_use_transparent_huge_pages),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
+        {"memtable_prefault_arena",
+         {offsetof(struct MutableCFOptions, memtable_prefault_arena),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
         {"memtable_prefix_bloom_huge_page_tlb_size",
          {0, OptionType::kSizeT, OptionVerificationType::kDeprecated,
           OptionTypeFlags::kMutable}},
@@ -746,6 +777,11 @@ static std::unordered_map<std::string, OptionTypeInfo>
                    level_compaction_dynamic_level_bytes),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"level_compaction_l0_tiering_ratio",
+         {offsetof(struct ImmutableCFOptions,
+                   level_compaction_l0_tiering_ratio),
+          OptionType::kDouble, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"level_compaction_dynamic_file_size",
          {0, OptionType::kBoolean, OptionVerificationType::kDeprecated,
           OptionTypeFlags::kNone}},
@@ -875,6 +911,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          OptionTypeInfo::AsCustomSharedPtr<SstPartitionerFactory>(
              offsetof(struct ImmutableCFOptions, sst_partitioner_factory),
              OptionVerificationType::kByName, OptionTypeFlags::kAllowNull)},
+        {"compaction_value_transformer",
+         OptionTypeInfo::AsCustomSharedPtr<CompactionValueTransformer>(
+             offsetof(struct ImmutableCFOptions, compaction_value_transformer),
+             OptionVerificationType::kByName, OptionTypeFlags::kAllowNull)},
         {"blob_cache",
          {offsetof(struct ImmutableCFOptions, blob_cache), OptionType::kUnknown,
           OptionVerificationType::kNormal,
@@ -1016,6 +1056,8 @@ ImmutableCFOptions::ImmutableCFOptions(const ColumnFamilyOptions& cf_options)
       bloom_locality(cf_options.bloom_locality),
       level_compaction_dynamic_level_bytes(
           cf_options.level_compaction_dynamic_level_bytes),
+      level_compaction_l0_tiering_ratio(
+          cf_options.level_compaction_l0_tiering_ratio),
       num_levels(cf_options.num_levels),
       optimize_filters_for_hits(cf_options.optimize_filters_for_hits),
       force_consistency_checks(cf_options.force_consistency_checks),
@@ -1026,6 +1068,7 @@ ImmutableCFOptions::ImmutableCFOptions(const ColumnFamilyOptions& cf_options)
       cf_paths(cf_options.cf_paths),
       compaction_thread_limiter(cf_options.compaction_thread_limiter),
       sst_partitioner_factory(cf_options.sst_partitioner_factory),
+      compaction_value_transformer(cf_options.compaction_value_transformer),
       blob_cache(cf_options.blob_cache),
       persist_user_defined_timestamps(
           cf_options.persist_user_defined_timestamps) {}
@@ -1124,6 +1167,10 @@ void MutableCFOptions::Dump(Logger* log) const {
   ROCKS_LOG_INFO(log,
                  "                  memtable_huge_page_size: %" ROCKSDB_PRIszt,
                  memtable_huge_page_size);
+  ROCKS_LOG_INFO(log, "      memtable_use_transparent_huge_pages: %d",
+                 memtable_use_transparent_huge_pages);
+  ROCKS_LOG_INFO(log, "                  memtable_prefault_arena: %d",
+                 memtable_prefault_arena);
   ROCKS_LOG_INFO(log,
                  "                    max_successive_merges: %" ROCKSDB_PRIszt,
                  max_successive_merges);
@@ -1230,6 +1277,8 @@ void MutableCFOptions::Dump(Logger* log) const {
                  compaction_options_fifo.max_table_files_size);
   ROCKS_LOG_INFO(log, "compaction_options_fifo.allow_compaction : %d",
                  compaction_options_fifo.allow_compaction);
+  ROCKS_LOG_INFO(log, "compaction_options_fifo.min_reads_to_retain : %" PRIu64,
+                 compaction_options_fifo.min_reads_to_retain);
 
   // Blob file related options
   ROCKS_LOG_INFO(log, "                        enable_blob_files: %s",
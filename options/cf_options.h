@@ -60,6 +60,8 @@ struct ImmutableCFOptions {
 
   bool level_compaction_dynamic_level_bytes;
 
+  double level_compaction_l0_tiering_ratio;
+
   int num_levels;
 
   bool optimize_filters_for_hits;
@@ -79,6 +81,8 @@ struct ImmutableCFOptions {
 
   std::shared_ptr<SstPartitionerFactory> sst_partitioner_factory;
 
+  std::shared_ptr<CompactionValueTransformer> compaction_value_transformer;
+
   std::shared_ptr<Cache> blob_cache;
 
   bool persist_user_defined_timestamps;
@@ -111,6 +115,9 @@ struct MutableCFOptions {
             options.memtable_prefix_bloom_size_ratio),
         memtable_whole_key_filtering(options.memtable_whole_key_filtering),
         memtable_huge_page_size(options.memtable_huge_page_size),
+        memtable_use_transparent_huge_pages(
+            options.memtable_use_transparent_huge_pages),
+        memtable_prefault_arena(options.memtable_prefault_arena),
         max_successive_merges(options.max_successive_merges),
         strict_max_successive_merges(options.strict_max_successive_merges),
         inplace_update_num_locks(options.inplace_update_num_locks),
@@ -188,6 +195,8 @@ struct MutableCFOptions {
         memtable_prefix_bloom_size_ratio(0),
         memtable_whole_key_filtering(false),
         memtable_huge_page_size(0),
+        memtable_use_transparent_huge_pages(false),
+        memtable_prefault_arena(false),
         max_successive_merges(0),
         strict_max_successive_merges(false),
         inplace_update_num_locks(0),
@@ -266,6 +275,8 @@ struct MutableCFOptions {
   double memtable_prefix_bloom_size_ratio;
   bool memtable_whole_key_filtering;
   size_t memtable_huge_page_size;
+  bool memtable_use_transparent_huge_pages;
+  bool memtable_prefault_arena;
   size_t max_successive_merges;
   bool strict_max_successive_merges;
   size_t inplace_update_num_locks;
@@ -18,6 +18,7 @@
 #include "options/options_helper.h"
 #include "rocksdb/cache.h"
 #include "rocksdb/compaction_filter.h"
+#include "rocksdb/compaction_value_transformer.h"
 #include "rocksdb/comparator.h"
 #include "rocksdb/env.h"
 #include "rocksdb/filter_policy.h"
@@ -53,6 +54,9 @@ AdvancedColumnFamilyOptions::AdvancedColumnFamilyOptions(const Options& options)
           options.memtable_prefix_bloom_size_ratio),
       memtable_whole_key_filtering(options.memtable_whole_key_filtering),
       memtable_huge_page_size(options.memtable_huge_page_size),
+      memtable_use_transparent_huge_pages(
+          options.memtable_use_transparent_huge_pages),
+      memtable_prefault_arena(options.memtable_prefault_arena),
       memtable_insert_with_hint_prefix_extractor(
           options.memtable_insert_with_hint_prefix_extractor),
       bloom_locality(options.bloom_locality),
@@ -65,6 +69,8 @@ AdvancedColumnFamilyOptions::AdvancedColumnFamilyOptions(const Options& options)
       target_file_size_multiplier(options.target_file_size_multiplier),
       level_compaction_dynamic_level_bytes(
           options.level_compaction_dynamic_level_bytes),
+      level_compaction_l0_tiering_ratio(
+          options.level_compaction_l0_tiering_ratio),
       max_bytes_for_level_multiplier(options.max_bytes_for_level_multiplier),
       max_bytes_for_level_multiplier_additional(
           options.max_bytes_for_level_multiplier_additional),
@@ -157,6 +163,10 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
   ROCKS_LOG_HEADER(
       log, " Options.sst_partitioner_factory: %s",
       sst_partitioner_factory ? sst_partitioner_factory->Name() : "None");
+  ROCKS_LOG_HEADER(log, "    Options.compaction_value_transformer: %s",
+                   compaction_value_transformer
+                       ? compaction_value_transformer->Name()
+                       : "None");
   ROCKS_LOG_HEADER(log, "        Options.memtable_factory: %s",
                    memtable_factory->Name());
   ROCKS_LOG_HEADER(log, "           Options.table_factory: %s",
@@ -274,6 +284,8 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
                    max_bytes_for_level_base);
   ROCKS_LOG_HEADER(log, "Options.level_compaction_dynamic_level_bytes: %d",
                    level_compaction_dynamic_level_bytes);
+  ROCKS_LOG_HEADER(log, "   Options.level_compaction_l0_tiering_ratio: %f",
+                   level_compaction_l0_tiering_ratio);
   ROCKS_LOG_HEADER(log, "         Options.max_bytes_for_level_multiplier: %f",
                    max_bytes_for_level_multiplier);
   for (size_t i = 0; i < max_bytes_for_level_multiplier_additional.size();
@@ -363,6 +375,9 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
       compaction_options_fifo.max_table_files_size);
   ROCKS_LOG_HEADER(log, "Options.compaction_options_fifo.allow_compaction: %d",
                    compaction_options_fifo.allow_compaction);
+  ROCKS_LOG_HEADER(
+      log, "Options.compaction_options_fifo.min_reads_to_retain: %" PRIu64,
+      compaction_options_fifo.min_reads_to_retain);
   std::ostringstream collector_info;
   for (const auto& collector_factory : table_properties_collector_factories) {
     collector_info << collector_factory->ToString() << ';';
@@ -385,6 +400,10 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
 
   ROCKS_LOG_HEADER(log, "  Options.memtable_huge_page_size: %" ROCKSDB_PRIszt,
                    memtable_huge_page_size);
+  ROCKS_LOG_HEADER(log, "  Options.memtable_use_transparent_huge_pages: %d",
+                   memtable_use_transparent_huge_pages);
+  ROCKS_LOG_HEADER(log, "  Options.memtable_prefault_arena: %d",
+                   memtable_prefault_arena);
   ROCKS_LOG_HEADER(log, "                          Options.bloom_locality: %d",
                    bloom_locality);
 
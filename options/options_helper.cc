@@ -82,6 +82,7 @@ void BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.max_open_files = mutable_db_options.max_open_files;
   options.max_file_opening_threads =
       immutable_db_options.max_file_opening_threads;
+  options.compression_threads = immutable_db_options.compression_threads;
   options.max_total_wal_size = mutable_db_options.max_total_wal_size;
   options.statistics = immutable_db_options.statistics;
   options.use_fsync = immutable_db_options.use_fsync;
@@ -94,11 +95,16 @@ void BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.max_background_compactions =
       mutable_db_options.max_background_compactions;
   options.max_subcompactions = mutable_db_options.max_subcompactions;
+  options.subcompaction_ranges_per_thread =
+      mutable_db_options.subcompaction_ranges_per_thread;
+  options.preempt_bottommost_compactions =
+      mutable_db_options.preempt_bottommost_compactions;
   options.max_background_flushes = mutable_db_options.max_background_flushes;
   options.max_log_file_size = immutable_db_options.max_log_file_size;
   options.log_file_time_to_roll = immutable_db_options.log_file_time_to_roll;
   options.keep_log_file_num = immutable_db_options.keep_log_file_num;
   options.recycle_log_file_num = immutable_db_options.recycle_log_file_num;
+  options.num_wal_streams = immutable_db_options.num_wal_streams;
   options.max_manifest_file_size = immutable_db_options.max_manifest_file_size;
   options.table_cache_numshardbits =
       immutable_db_options.table_cache_numshardbits;
@@ -124,6 +130,7 @@ void BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.write_buffer_manager = immutable_db_options.write_buffer_manager;
   options.compaction_readahead_size =
       mutable_db_options.compaction_readahead_size;
+  options.compaction_async_io = mutable_db_options.compaction_async_io;
   options.writable_file_max_buffer_size =
       mutable_db_options.writable_file_max_buffer_size;
   options.use_adaptive_mutex = immutable_db_options.use_adaptive_mutex;
@@ -134,6 +141,8 @@ void BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.enable_thread_tracking = immutable_db_options.enable_thread_tracking;
   options.delayed_write_rate = mutable_db_options.delayed_write_rate;
   options.enable_pipelined_write = immutable_db_options.enable_pipelined_write;
+  options.enable_wal_writer_thread =
+      immutable_db_options.enable_wal_writer_thread;
   options.unordered_write = immutable_db_options.unordered_write;
   options.allow_concurrent_memtable_write =
       immutable_db_options.allow_concurrent_memtable_write;
@@ -221,6 +230,9 @@ void UpdateColumnFamilyOptions(const MutableCFOptions& moptions,
       moptions.memtable_prefix_bloom_size_ratio;
   cf_opts->memtable_whole_key_filtering = moptions.memtable_whole_key_filtering;
   cf_opts->memtable_huge_page_size = moptions.memtable_huge_page_size;
+  cf_opts->memtable_use_transparent_huge_pages =
+      moptions.memtable_use_transparent_huge_pages;
+  cf_opts->memtable_prefault_arena = moptions.memtable_prefault_arena;
   cf_opts->max_successive_merges = moptions.max_successive_merges;
   cf_opts->strict_max_successive_merges = moptions.strict_max_successive_merges;
   cf_opts->inplace_update_num_locks = moptions.inplace_update_num_locks;
@@ -314,6 +326,7 @@ void UpdateColumnFamilyOptions(const ImmutableCFOptions& ioptions,
   cf_opts->merge_operator = ioptions.merge_operator;
   cf_opts->compaction_filter = ioptions.compaction_filter;
   cf_opts->compaction_filter_factory = ioptions.compaction_filter_factory;
+  cf_opts->compaction_value_transformer = ioptions.compaction_value_transformer;
   cf_opts->min_write_buffer_number_to_merge =
       ioptions.min_write_buffer_number_to_merge;
   cf_opts->max_write_buffer_size_to_maintain =
@@ -326,6 +339,8 @@ void UpdateColumnFamilyOptions(const ImmutableCFOptions& ioptions,
   cf_opts->bloom_locality = ioptions.bloom_locality;
   cf_opts->level_compaction_dynamic_level_bytes =
       ioptions.level_compaction_dynamic_level_bytes;
+  cf_opts->level_compaction_l0_tiering_ratio =
+      ioptions.level_compaction_l0_tiering_ratio;
   cf_opts->num_levels = ioptions.num_levels;
   cf_opts->optimize_filters_for_hits = ioptions.optimize_filters_for_hits;
   cf_opts->force_consistency_checks = ioptions.force_consistency_checks;
@@ -846,6 +861,13 @@ std::unordered_map<std::string, PrepopulateBlobCache>
         {"kDisable", PrepopulateBlobCache::kDisable},
         {"kFlushOnly", PrepopulateBlobCache::kFlushOnly}};
 
+std::unordered_map<std::string, PreCompressionTransform>
+    OptionsHelper::pre_compression_transform_string_map = {
+        {"kNone", PreCompressionTransform::kNone},
+        {"kByteShuffle", PreCompressionTransform::kByteShuffle},
+        {"kBitShuffle", PreCompressionTransform::kBitShuffle},
+        {"kXorDelta", PreCompressionTransform::kXorDelta}};
+
 Status OptionTypeInfo::NextToken(const std::string& opts, char delimiter,
                                  size_t pos, size_t* end, std::string* token) {
   while (pos < opts.size() && isspace(opts[pos])) {
@@ -85,6 +85,8 @@ struct OptionsHelper {
       compression_type_string_map;
   static std::unordered_map<std::string, PrepopulateBlobCache>
       prepopulate_blob_cache_string_map;
+  static std::unordered_map<std::string, PreCompressionTransform>
+      pre_compression_transform_string_map;
   static std::unordered_map<std::string, CompactionStopStyle>
       compaction_stop_style_string_map;
   static std::unordered_map<std::string, EncodingType> encoding_type_string_map;
@@ -115,5 +117,7 @@ static auto& compaction_pri_string_map =
 static auto& temperature_string_map = OptionsHelper::temperature_string_map;
 static auto& prepopulate_blob_cache_string_map =
     OptionsHelper::prepopulate_blob_cache_string_map;
+static auto& pre_compression_transform_string_map =
+    OptionsHelper::pre_compression_transform_string_map;
 
 }  // namespace ROCKSDB_NAMESPACE
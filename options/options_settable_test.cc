@@ -177,12 +177,15 @@ TEST_F(OptionsSettableTest, BlockBasedTableOptionsAllFieldsSettable) {
       "metadata_cache_options={top_level_index_pinning=kFallback;"
       "partition_pinning=kAll;"
       "unpartitioned_pinning=kFlushedAndSimilar;};"
+      "adaptive_metadata_pinning_budget=1048576;"
       "pin_l0_filter_and_index_blocks_in_cache=1;"
       "pin_top_level_index_and_filter=1;"
       "index_type=kHashSearch;"
       "data_block_index_type=kDataBlockBinaryAndHash;"
       "index_shortening=kNoShortening;"
       "data_block_hash_table_util_ratio=0.75;"
+      "data_block_restart_key_prefixes=false;"
+      "data_block_columnar_entities=false;"
       "checksum=kxxHash;no_block_cache=1;"
       "block_cache=1M;block_cache_compressed=1k;block_size=1024;"
       "block_size_deviation=8;block_restart_interval=4; "
@@ -239,6 +242,8 @@ TEST_F(OptionsSettableTest, TablePropertiesAllFieldsSettable) {
        sizeof(std::string)},
       {offsetof(struct TableProperties, seqno_to_time_mapping),
        sizeof(std::string)},
+      {offsetof(struct TableProperties, data_block_compression_counts),
+       sizeof(std::string)},
       {offsetof(struct TableProperties, user_collected_properties),
        sizeof(UserCollectedProperties)},
       {offsetof(struct TableProperties, readable_properties),
@@ -276,7 +281,8 @@ TEST_F(OptionsSettableTest, TablePropertiesAllFieldsSettable) {
       "size=0;data_size=100;merge_operator_name=;index_partitions=0;file_"
       "creation_time=0;raw_value_size=0;index_size=200;user_collected_"
       "properties={757365725F6B6579=757365725F76616C7565;};tail_start_offset=0;"
-      "seqno_to_time_mapping=;raw_key_size=0;slow_compression_estimated_data_"
+      "seqno_to_time_mapping=;data_block_compression_counts=;raw_key_size=0;"
+      "slow_compression_estimated_data_"
       "size=0;filter_size=0;orig_file_number=3;num_deletions=0;num_range_"
       "deletions=0;format_version=0;comparator_name="
       "636F6D70617261746F725F6E616D65;num_filter_entries=0;db_id="
@@ -286,7 +292,8 @@ TEST_F(OptionsSettableTest, TablePropertiesAllFieldsSettable) {
       "0;column_family_"
       "name=64656661756C74;user_defined_timestamps_persisted=1;num_entries=100;"
       "external_sst_file_global_seqno_offset=0;num_merge_operands=0;index_key_"
-      "is_user_key=0;key_largest_seqno=18446744073709551615;",
+      "is_user_key=0;key_largest_seqno=18446744073709551615;"
+      "compression_dict_id=0;",
       new_tp));
 
   // All bytes are set from the parse
@@ -389,15 +396,19 @@ TEST_F(OptionsSettableTest, DBOptionsAllFieldsSettable) {
                              "wal_dir=path/to/wal_dir;"
                              "db_write_buffer_size=2587;"
                              "max_subcompactions=64330;"
+                             "subcompaction_ranges_per_thread=7;"
+                             "preempt_bottommost_compactions=true;"
                              "table_cache_numshardbits=28;"
                              "max_open_files=72;"
                              "max_file_opening_threads=35;"
+                             "compression_threads=3;"
                              "max_background_jobs=8;"
                              "max_background_compactions=33;"
                              "use_fsync=true;"
                              "use_adaptive_mutex=false;"
                              "max_total_wal_size=4295005604;"
                              "compaction_readahead_size=0;"
+                             "compaction_async_io=false;"
                              "keep_log_file_num=4890;"
                              "skip_stats_update_on_db_open=false;"
                              "skip_checking_sst_file_sizes_on_db_open=false;"
@@ -415,6 +426,7 @@ TEST_F(OptionsSettableTest, DBOptionsAllFieldsSettable) {
                              "strict_bytes_per_sync=true;"
                              "enable_thread_tracking=false;"
                              "recycle_log_file_num=0;"
+                             "num_wal_streams=1;"
                              "create_missing_column_families=true;"
                              "log_file_time_to_roll=3097;"
                              "max_background_flushes=35;"
@@ -434,6 +446,7 @@ TEST_F(OptionsSettableTest, DBOptionsAllFieldsSettable) {
                              "max_log_file_size=4607;"
                              "advise_random_on_open=true;"
                              "enable_pipelined_write=false;"
+                             "enable_wal_writer_thread=false;"
                              "unordered_write=false;"
                              "allow_concurrent_memtable_write=true;"
                              "wal_recovery_mode=kPointInTimeRecovery;"
@@ -530,6 +543,8 @@ TEST_F(OptionsSettableTest, ColumnFamilyOptionsAllFieldsSettable) {
        sizeof(const CompactionFilter*)},
       {offsetof(struct ColumnFamilyOptions, compaction_filter_factory),
        sizeof(std::shared_ptr<CompactionFilterFactory>)},
+      {offsetof(struct ColumnFamilyOptions, compaction_value_transformer),
+       sizeof(std::shared_ptr<CompactionValueTransformer>)},
       {offsetof(struct ColumnFamilyOptions, compression_manager),
        sizeof(std::shared_ptr<CompressionManager>)},
       {offsetof(struct ColumnFamilyOptions, prefix_extractor),
@@ -599,6 +614,8 @@ TEST_F(OptionsSettableTest, ColumnFamilyOptionsAllFieldsSettable) {
       "bloom_locality=8016;"
       "target_file_size_base=4294976376;"
       "memtable_huge_page_size=2557;"
+      "memtable_use_transparent_huge_pages=true;"
+      "memtable_prefault_arena=false;"
       "max_successive_merges=5497;"
       "strict_max_successive_merges=true;"
       "max_sequential_skip_in_iterations=4294971408;"
@@ -615,11 +632,15 @@ TEST_F(OptionsSettableTest, ColumnFamilyOptionsAllFieldsSettable) {
       "compression_opts={max_dict_buffer_bytes=5;use_zstd_dict_trainer=true;"
       "enabled=false;parallel_threads=6;zstd_max_train_bytes=7;strategy=8;max_"
       "dict_bytes=9;level=10;window_bits=11;max_compressed_bytes_per_kb=987;"
-      "checksum=true};"
+      "checksum=true;adaptive_compression_budget_pct=50;"
+      "pre_compression_transform=kByteShuffle;pre_compression_element_size=2;"
+      "use_shared_dict=true};"
       "bottommost_compression_opts={max_dict_buffer_bytes=4;use_zstd_dict_"
       "trainer=true;enabled=true;parallel_threads=5;zstd_max_train_bytes=6;"
       "strategy=7;max_dict_bytes=8;level=9;window_bits=10;max_compressed_bytes_"
-      "per_kb=876;checksum=true};"
+      "per_kb=876;checksum=true;adaptive_compression_budget_pct=40;"
+      "pre_compression_transform=kXorDelta;pre_compression_element_size=8;"
+      "use_shared_dict=false};"
       "bottommost_compression=kDisableCompressionOption;"
       "compression_manager=BuiltinV2;"
       "level0_stop_writes_trigger=33;"
@@ -640,6 +661,7 @@ TEST_F(OptionsSettableTest, ColumnFamilyOptionsAllFieldsSettable) {
       "experimental_mempurge_threshold=0.0001;"
       "optimize_filters_for_hits=false;"
       "level_compaction_dynamic_level_bytes=false;"
+      "level_compaction_l0_tiering_ratio=4;"
       "level_compaction_dynamic_file_size=true;"
       "inplace_update_support=false;"
       "compaction_style=kCompactionStyleFIFO;"
@@ -1103,6 +1103,17 @@ TEST_F(OptionsTest, GetBlockBasedTableOptionsFromString) {
   EXPECT_EQ(rfp->GetMillibitsPerKey(), 6789);
   EXPECT_EQ(rfp->GetBloomBeforeLevel(), 5);
 
+  // Range filter policy
+  ASSERT_OK(GetBlockBasedTableOptionsFromString(
+      config_options, table_opt, "filter_policy=rangefilter:8.5:12;",
+      &new_opt));
+  ASSERT_TRUE(new_opt.filter_policy != nullptr);
+  auto rgfp =
+      dynamic_cast<const RangeFilterPolicy*>(new_opt.filter_policy.get());
+  EXPECT_EQ(rgfp->GetMillibitsPerKey(), 8500);
+  EXPECT_EQ(rgfp->GetMaxKeyPrefixLen(), 12);
+  EXPECT_EQ(rgfp->GetId(), "rangefilter:8.5:12");
+
   // Check block cache options are overwritten when specified
   // in new format as a struct.
   ASSERT_OK(GetBlockBasedTableOptionsFromString(
@@ -2163,6 +2174,28 @@ TEST_F(OptionsTest, SstPartitionerTest) {
   ASSERT_OK(RocksDBOptionsParser::VerifyCFOptions(cfg_opts, cf_opts, new_opt));
   ASSERT_TRUE(cf_opts.sst_partitioner_factory->AreEquivalent(
       cfg_opts, new_opt.sst_partitioner_factory.get(), &mismatch));
+
+  ASSERT_OK(GetColumnFamilyOptionsFromString(
+      cfg_opts, ColumnFamilyOptions(),
+      std::string("sst_partitioner_factory={id=") +
+          SstPartitionerPrefixFactory::kClassName() +
+          "; prefix_extractor=rocksdb.FixedPrefix.4;}",
+      &cf_opts));
+  ASSERT_NE(cf_opts.sst_partitioner_factory, nullptr);
+  ASSERT_STREQ(cf_opts.sst_partitioner_factory->Name(),
+               SstPartitionerPrefixFactory::kClassName());
+  std::unique_ptr<SstPartitioner> partitioner =
+      cf_opts.sst_partitioner_factory->CreatePartitioner(
+          SstPartitioner::Context());
+  ASSERT_NE(partitioner, nullptr);
+  ASSERT_TRUE(partitioner->PartitionBlobFiles());
+  ASSERT_TRUE(partitioner->CanDoTrivialMove("aaaa1", "aaaa9"));
+  ASSERT_FALSE(partitioner->CanDoTrivialMove("aaaa1", "aaab1"));
+  ASSERT_OK(GetStringFromColumnFamilyOptions(cfg_opts, cf_opts, &opts_str));
+  ASSERT_OK(
+      GetColumnFamilyOptionsFromString(cfg_opts, cf_opts, opts_str, &new_opt));
+  ASSERT_TRUE(cf_opts.sst_partitioner_factory->AreEquivalent(
+      cfg_opts, new_opt.sst_partitioner_factory.get(), &mismatch));
 }
 
 TEST_F(OptionsTest, FileChecksumGenFactoryTest) {
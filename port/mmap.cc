@@ -91,6 +91,44 @@ MemMapping MemMapping::AllocateHuge(size_t length) {
   return AllocateAnonymous(length, /*huge*/ true);
 }
 
+MemMapping MemMapping::AllocateTransparentHuge(size_t length) {
+#ifdef MADV_HUGEPAGE
+  if (length == 0) {
+    return AllocateAnonymous(length, /*huge*/ false);
+  }
+  // Over-allocate so that the usable range can start on a huge page
+  // boundary, because only aligned ranges can be backed by huge pages
+  MemMapping mm =
+      AllocateAnonymous(length + kTransparentHugePageSize, /*huge*/ false);
+  if (mm.addr_ == nullptr) {
+    return mm;
+  }
+  const uintptr_t start = reinterpret_cast<uintptr_t>(mm.addr_);
+  const uintptr_t aligned = (start + kTransparentHugePageSize - 1) &
+                            ~uintptr_t{kTransparentHugePageSize - 1};
+  const size_t head = aligned - start;
+  const size_t tail = kTransparentHugePageSize - head;
+  if (head > 0) {
+    auto status = munmap(mm.addr_, head);
+    assert(status == 0);
+    (void)status;
+  }
+  if (tail > 0) {
+    auto status = munmap(reinterpret_cast<char*>(aligned) + length, tail);
+    assert(status == 0);
+    (void)status;
+  }
+  mm.addr_ = reinterpret_cast<void*>(aligned);
+  mm.length_ = length;
+  // Only advisory. If THP is disabled on the system, the memory is still
+  // usable with normal pages.
+  (void)madvise(mm.addr_, length, MADV_HUGEPAGE);
+  return mm;
+#else
+  return AllocateAnonymous(length, /*huge*/ false);
+#endif  // MADV_HUGEPAGE
+}
+
 MemMapping MemMapping::AllocateLazyZeroed(size_t length) {
   return AllocateAnonymous(length, /*huge*/ false);
 }
@@ -30,9 +30,25 @@ class MemMapping {
       false;
 #endif
 
+  static constexpr bool kTransparentHugePageSupported =
+#ifdef MADV_HUGEPAGE
+      true;
+#else
+      false;
+#endif
+  // The (PMD) size of a transparent huge page on common configurations
+  static constexpr size_t kTransparentHugePageSize = size_t{2} << 20;
+
   // Allocate memory requesting to be backed by huge pages
   static MemMapping AllocateHuge(size_t length);
 
+  // Allocate memory that is aligned to kTransparentHugePageSize and advised
+  // to be backed by transparent huge pages (MADV_HUGEPAGE) as it is faulted
+  // in. Unlike AllocateHuge, this needs no reserved huge pages, and the
+  // kernel silently falls back to normal pages when huge pages are not
+  // available. Like AllocateLazyZeroed, the memory is zero-initialized.
+  static MemMapping AllocateTransparentHuge(size_t length);
+
   // Allocate memory that is only lazily mapped to resident memory and
   // guaranteed to be zero-initialized. Note that some platforms like
   // Linux allow memory over-commit, where only the used portion of memory
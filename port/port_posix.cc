@@ -15,11 +15,15 @@
 #if defined(__i386__) || defined(__x86_64__)
 #include <cpuid.h>
 #endif
+#ifdef NUMA
+#include <numa.h>
+#endif
 #include <sched.h>
 #include <sys/resource.h>
 #include <sys/time.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <csignal>
 #include <cstdio>
@@ -198,6 +202,39 @@ int PhysicalCoreID() {
 #endif
 }
 
+int NumNumaNodes() {
+#ifdef NUMA
+  static const int num_nodes = []() {
+    if (numa_available() < 0) {
+      return 1;
+    }
+    return std::max(numa_max_node() + 1, 1);
+  }();
+  return num_nodes;
+#else
+  return 1;
+#endif
+}
+
+int NumaNodeOfCpu(int cpu) {
+#ifdef NUMA
+  if (NumNumaNodes() <= 1) {
+    return 0;
+  }
+  if (cpu < 0) {
+    cpu = PhysicalCoreID();
+    if (cpu < 0) {
+      return 0;
+    }
+  }
+  int node = numa_node_of_cpu(cpu);
+  return node < 0 ? 0 : node;
+#else
+  (void)cpu;
+  return 0;
+#endif
+}
+
 void InitOnce(OnceType* once, void (*initializer)()) {
   PthreadCall("once", pthread_once(once, initializer));
 }
@@ -181,6 +181,14 @@ static inline void AsmVolatilePause() {
 // Returns -1 if not available on this platform
 int PhysicalCoreID();
 
+// Number of NUMA nodes on this host. Always 1 unless built with NUMA support
+// (-DNUMA) and libnuma reports multiple nodes.
+int NumNumaNodes();
+
+// NUMA node of the given CPU, or of the CPU the calling thread is currently
+// running on if cpu < 0. Returns 0 if not available.
+int NumaNodeOfCpu(int cpu = -1);
+
 using OnceType = pthread_once_t;
 #define LEVELDB_ONCE_INIT PTHREAD_ONCE_INIT
 void InitOnce(OnceType* once, void (*initializer)());
@@ -255,6 +255,10 @@ static inline void AsmVolatilePause() {
 
 int PhysicalCoreID();
 
+// NUMA placement is not implemented on Windows; these report a single node.
+inline int NumNumaNodes() { return 1; }
+inline int NumaNodeOfCpu(int /*cpu*/ = -1) { return 0; }
+
 // For Thread Local Storage abstraction
 using pthread_key_t = DWORD;
 
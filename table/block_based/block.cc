@@ -21,7 +21,10 @@
 #include "port/stack_trace.h"
 #include "rocksdb/comparator.h"
 #include "table/block_based/block_prefix_index.h"
+#include "table/block_based/columnar_entity_block.h"
 #include "table/block_based/data_block_footer.h"
+#include "table/block_based/learned_index.h"
+#include "table/block_based/restart_key_prefix.h"
 #include "table/format.h"
 #include "util/coding.h"
 
@@ -285,20 +288,42 @@ void DataBlockIter::PrevImpl() {
     if (raw_key_.IsKeyPinned()) {
       // The key is not delta encoded
       prev_entries_.emplace_back(current_, current_key.data(), 0,
-                                 current_key.size(), value());
+                                 current_key.size(), raw_value());
     } else {
       // The key is delta encoded, cache decoded key in buffer
       size_t new_key_offset = prev_entries_keys_buff_.size();
       prev_entries_keys_buff_.append(current_key.data(), current_key.size());
 
       prev_entries_.emplace_back(current_, nullptr, new_key_offset,
-                                 current_key.size(), value());
+                                 current_key.size(), raw_value());
     }
     // Loop until end of current entry hits the start of original entry
   } while (NextEntryOffset() < original);
   prev_entries_idx_ = static_cast<int32_t>(prev_entries_.size()) - 1;
 }
 
+Slice DataBlockIter::ColumnarEntityValue() const {
+  Slice stub = raw_value();
+  uint32_t ordinal = 0;
+  if (!GetVarint32(&stub, &ordinal)) {
+    // Not a valid entity, so that reading it reports the corruption.
+    return Slice();
+  }
+  if (assembled_value_offset_ != current_) {
+    assembled_value_.clear();
+    Status s = wide_column_projection_ == nullptr
+                   ? columnar_entity_section_->GetEntity(ordinal,
+                                                         &assembled_value_)
+                   : columnar_entity_section_->GetProjectedEntity(
+                         ordinal, *wide_column_projection_, &assembled_value_);
+    if (!s.ok()) {
+      assembled_value_.clear();
+    }
+    assembled_value_offset_ = current_;
+  }
+  return assembled_value_;
+}
+
 void DataBlockIter::SeekImpl(const Slice& target) {
   Slice seek_key = target;
   PERF_TIMER_GUARD(block_seek_nanos);
@@ -307,7 +332,9 @@ void DataBlockIter::SeekImpl(const Slice& target) {
   }
   uint32_t index = 0;
   bool skip_linear_scan = false;
-  bool ok = BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan);
+  bool ok = restart_key_prefixes_ != nullptr
+                ? RestartKeyPrefixSeek(seek_key, &index, &skip_linear_scan)
+                : BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan);
 
   if (!ok) {
     return;
@@ -315,6 +342,27 @@ void DataBlockIter::SeekImpl(const Slice& target) {
   FindKeyAfterBinarySeek(seek_key, index, skip_linear_scan);
 }
 
+bool DataBlockIter::RestartKeyPrefixSeek(const Slice& target, uint32_t* index,
+                                         bool* skip_linear_scan) {
+  assert(restart_key_prefixes_);
+  if (restarts_ == 0) {
+    // See BinarySeek()
+    return false;
+  }
+  // Restart keys with a smaller (larger) prefix than the target's are smaller
+  // (larger) than the target, so only those with an equal prefix need to be
+  // binary searched. If there are none, this finds the result without
+  // comparing any keys.
+  const uint64_t target_prefix = RestartKeyPrefix(ExtractUserKey(target));
+  const uint32_t num_less = CountRestartKeyPrefixesBelow(
+      restart_key_prefixes_, num_restarts_, target_prefix, /*or_equal=*/false);
+  const uint32_t num_less_or_equal = CountRestartKeyPrefixesBelow(
+      restart_key_prefixes_, num_restarts_, target_prefix, /*or_equal=*/true);
+  return BinarySeekInRange<DecodeKey>(
+      target, static_cast<int64_t>(num_less) - 1,
+      static_cast<int64_t>(num_less_or_equal) - 1, index, skip_linear_scan);
+}
+
 void MetaBlockIter::SeekImpl(const Slice& target) {
   Slice seek_key = target;
   PERF_TIMER_GUARD(block_seek_nanos);
@@ -494,6 +542,14 @@ void IndexBlockIter::SeekImpl(const Slice& target) {
     // restart interval must be one when hash search is enabled so the binary
     // search simply lands at the right place.
     skip_linear_scan = true;
+  } else if (learned_index_) {
+    if (value_delta_encoded_) {
+      ok = LearnedSeek<DecodeKeyV4>(seek_key, ExtractUserKey(target), &index,
+                                    &skip_linear_scan);
+    } else {
+      ok = LearnedSeek<DecodeKey>(seek_key, ExtractUserKey(target), &index,
+                                  &skip_linear_scan);
+    }
   } else if (value_delta_encoded_) {
     ok = BinarySeek<DecodeKeyV4>(seek_key, &index, &skip_linear_scan);
   } else {
@@ -514,7 +570,9 @@ void DataBlockIter::SeekForPrevImpl(const Slice& target) {
   }
   uint32_t index = 0;
   bool skip_linear_scan = false;
-  bool ok = BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan);
+  bool ok = restart_key_prefixes_ != nullptr
+                ? RestartKeyPrefixSeek(seek_key, &index, &skip_linear_scan)
+                : BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan);
 
   if (!ok) {
     return;
@@ -693,8 +751,9 @@ bool DataBlockIter::ParseNextDataKey(bool* is_shared) {
       // If we are reading a file with a global sequence number we should
       // expect that all encoded sequence numbers are zeros and any value
       // type is kTypeValue, kTypeMerge, kTypeDeletion,
-      // kTypeDeletionWithTimestamp, kTypeRangeDeletion, or
-      // kTypeWideColumnEntity.
+      // kTypeDeletionWithTimestamp, kTypeRangeDeletion,
+      // kTypeWideColumnEntity, or kTypeBlobIndex (for files written with a
+      // companion blob file).
       uint64_t packed = ExtractInternalKeyFooter(raw_key_.GetKey());
       SequenceNumber seqno;
       ValueType value_type;
@@ -704,7 +763,8 @@ bool DataBlockIter::ParseNextDataKey(bool* is_shared) {
              value_type == ValueType::kTypeDeletion ||
              value_type == ValueType::kTypeDeletionWithTimestamp ||
              value_type == ValueType::kTypeRangeDeletion ||
-             value_type == ValueType::kTypeWideColumnEntity);
+             value_type == ValueType::kTypeWideColumnEntity ||
+             value_type == ValueType::kTypeBlobIndex);
       assert(seqno == 0);
     }
 #endif  // NDEBUG
@@ -761,7 +821,8 @@ void IndexBlockIter::DecodeCurrentValue(bool is_shared) {
            value_type == ValueType::kTypeMerge ||
            value_type == ValueType::kTypeDeletion ||
            value_type == ValueType::kTypeRangeDeletion ||
-           value_type == ValueType::kTypeWideColumnEntity);
+           value_type == ValueType::kTypeWideColumnEntity ||
+           value_type == ValueType::kTypeBlobIndex);
 
     first_internal_key.UpdateInternalKey(global_seqno_state_->global_seqno,
                                          value_type);
@@ -837,7 +898,17 @@ bool BlockIter<TValue>::BinarySeek(const Slice& target, uint32_t* index,
     // key accesses.
     return false;
   }
+  return BinarySeekInRange<DecodeKeyFunc>(target, -1, num_restarts_ - 1, index,
+                                          skip_linear_scan);
+}
 
+template <class TValue>
+template <typename DecodeKeyFunc>
+bool BlockIter<TValue>::BinarySeekInRange(const Slice& target, int64_t left,
+                                          int64_t right, uint32_t* index,
+                                          bool* skip_linear_scan) {
+  assert(left >= -1 && left <= right);
+  assert(right < static_cast<int64_t>(num_restarts_));
   *skip_linear_scan = false;
   // Loop invariants:
   // - Restart key at index `left` is less than or equal to the target key. The
@@ -845,7 +916,6 @@ bool BlockIter<TValue>::BinarySeek(const Slice& target, uint32_t* index,
   //   keys.
   // - Any restart keys after index `right` are strictly greater than the target
   //   key.
-  int64_t left = -1, right = num_restarts_ - 1;
   while (left != right) {
     // The `mid` is computed by rounding up so it lands in (`left`, `right`].
     int64_t mid = left + (right - left + 1) / 2;
@@ -885,6 +955,49 @@ bool BlockIter<TValue>::BinarySeek(const Slice& target, uint32_t* index,
   return true;
 }
 
+template <typename DecodeKeyFunc>
+bool IndexBlockIter::LearnedSeek(const Slice& seek_key, const Slice& user_key,
+                                 uint32_t* index, bool* skip_linear_scan) {
+  assert(learned_index_);
+  if (restarts_ == 0 || learned_index_->num_restarts() != num_restarts_) {
+    // Either an empty index block (see BinarySeek()) or a model that was not
+    // trained on this block.
+    return BinarySeek<DecodeKeyFunc>(seek_key, index, skip_linear_scan);
+  }
+  uint32_t lo = 0;
+  uint32_t hi = 0;
+  learned_index_->PredictRange(user_key, &lo, &hi);
+  TEST_SYNC_POINT("IndexBlockIter::LearnedSeek:Predicted");
+  assert(lo <= hi && hi < num_restarts_);
+
+  // Verify the window brackets the result: the restart key at `lo` must not
+  // be greater than the target and the one after `hi` must be greater.
+  int64_t left = -1;
+  if (lo > 0) {
+    int cmp = CompareBlockKey(lo, seek_key);
+    if (!status_.ok()) {
+      return false;
+    }
+    if (cmp > 0) {
+      TEST_SYNC_POINT("IndexBlockIter::LearnedSeek:Fallback");
+      return BinarySeek<DecodeKeyFunc>(seek_key, index, skip_linear_scan);
+    }
+    left = lo;
+  }
+  if (hi + 1 < num_restarts_) {
+    int cmp = CompareBlockKey(hi + 1, seek_key);
+    if (!status_.ok()) {
+      return false;
+    }
+    if (cmp <= 0) {
+      TEST_SYNC_POINT("IndexBlockIter::LearnedSeek:Fallback");
+      return BinarySeek<DecodeKeyFunc>(seek_key, index, skip_linear_scan);
+    }
+  }
+  return BinarySeekInRange<DecodeKeyFunc>(seek_key, left, hi, index,
+                                          skip_linear_scan);
+}
+
 // Compare target key and the block key of the block of `block_index`.
 // Return -1 if error.
 int IndexBlockIter::CompareBlockKey(uint32_t block_index, const Slice& target) {
@@ -1050,6 +1163,35 @@ BlockBasedTableOptions::DataBlockIndexType Block::IndexType() const {
   return index_type;
 }
 
+bool Block::HasColumnarEntities() const {
+  assert(size_ >= 2 * sizeof(uint32_t));
+  if (size_ > kMaxBlockSizeSupportedByHashIndex) {
+    // The check is for the same reason as that in NumRestarts()
+    return false;
+  }
+  uint32_t block_footer = DecodeFixed32(data_ + size_ - sizeof(uint32_t));
+  bool has_columnar_entities = false;
+  UnPackIndexTypeAndNumRestarts(block_footer, /*index_type=*/nullptr,
+                                /*num_restarts=*/nullptr,
+                                /*has_restart_key_prefixes=*/nullptr,
+                                &has_columnar_entities);
+  return has_columnar_entities;
+}
+
+bool Block::HasRestartKeyPrefixes() const {
+  assert(size_ >= 2 * sizeof(uint32_t));
+  if (size_ > kMaxBlockSizeSupportedByHashIndex) {
+    // The check is for the same reason as that in NumRestarts()
+    return false;
+  }
+  uint32_t block_footer = DecodeFixed32(data_ + size_ - sizeof(uint32_t));
+  bool has_restart_key_prefixes = false;
+  UnPackIndexTypeAndNumRestarts(block_footer, /*index_type=*/nullptr,
+                                /*num_restarts=*/nullptr,
+                                &has_restart_key_prefixes);
+  return has_restart_key_prefixes;
+}
+
 Block::~Block() {
   // This sync point can be re-enabled if RocksDB can control the
   // initialization order of any/all static options created by the user.
@@ -1105,6 +1247,32 @@ Block::Block(BlockContents&& contents, size_t read_amp_bytes_per_bit,
       default:
         size_ = 0;  // Error marker
     }
+    if (size_ != 0 && HasColumnarEntities()) {
+      // The column section sits between the restart array (and the restart
+      // key prefixes) and the hash index.
+      uint32_t section_size = 0;
+      const Status s = ColumnarEntitySection::Create(
+          Slice(data_, restart_offset_ + num_restarts_ * sizeof(uint32_t)),
+          &section_size, &columnar_entity_section_);
+      if (!s.ok() || section_size > restart_offset_) {
+        columnar_entity_section_.reset();
+        size_ = 0;
+      } else {
+        restart_offset_ -= section_size;
+      }
+    }
+    if (size_ != 0 && HasRestartKeyPrefixes()) {
+      // The restart key prefixes follow the restart array, which therefore
+      // starts that much earlier.
+      const size_t prefixes_size = size_t{num_restarts_} * sizeof(uint64_t);
+      if (prefixes_size > restart_offset_) {
+        size_ = 0;
+      } else {
+        restart_offset_ -= static_cast<uint32_t>(prefixes_size);
+        restart_key_prefixes_ =
+            data_ + restart_offset_ + num_restarts_ * sizeof(uint32_t);
+      }
+    }
   }
   if (read_amp_bytes_per_bit != 0 && statistics && size_ != 0) {
     read_amp_bitmap_.reset(new BlockReadAmpBitmap(
@@ -1141,7 +1309,7 @@ void Block::InitializeDataBlockProtectionInfo(uint8_t protection_bytes_per_key,
       iter->SeekToFirst();
       while (iter->Valid()) {
         GenerateKVChecksum(kv_checksum_ + i, protection_bytes_per_key,
-                           iter->key(), iter->value());
+                           iter->key(), iter->raw_value());
         iter->Next();
         i += protection_bytes_per_key;
       }
@@ -1279,7 +1447,8 @@ DataBlockIter* Block::NewDataIterator(const Comparator* raw_ucmp,
         read_amp_bitmap_.get(), block_contents_pinned,
         user_defined_timestamps_persisted,
         data_block_hash_index_.Valid() ? &data_block_hash_index_ : nullptr,
-        protection_bytes_per_key_, kv_checksum_, block_restart_interval_);
+        protection_bytes_per_key_, kv_checksum_, block_restart_interval_,
+        restart_key_prefixes_, columnar_entity_section_.get());
     if (read_amp_bitmap_) {
       if (read_amp_bitmap_->GetStatistics() != stats) {
         // DB changed the Statistics pointer, we need to notify read_amp_bitmap_
@@ -1296,7 +1465,7 @@ IndexBlockIter* Block::NewIndexIterator(
     IndexBlockIter* iter, Statistics* /*stats*/, bool total_order_seek,
     bool have_first_key, bool key_includes_seq, bool value_is_full,
     bool block_contents_pinned, bool user_defined_timestamps_persisted,
-    BlockPrefixIndex* prefix_index) {
+    BlockPrefixIndex* prefix_index, const LearnedIndexModel* learned_index) {
   IndexBlockIter* ret_iter;
   if (iter != nullptr) {
     ret_iter = iter;
@@ -1316,8 +1485,8 @@ IndexBlockIter* Block::NewIndexIterator(
         total_order_seek ? nullptr : prefix_index;
     ret_iter->Initialize(
         raw_ucmp, data_, restart_offset_, num_restarts_, global_seqno,
-        prefix_index_ptr, have_first_key, key_includes_seq, value_is_full,
-        block_contents_pinned, user_defined_timestamps_persisted,
+        prefix_index_ptr, learned_index, have_first_key, key_includes_seq,
+        value_is_full, block_contents_pinned, user_defined_timestamps_persisted,
         protection_bytes_per_key_, kv_checksum_, block_restart_interval_);
   }
 
@@ -1335,6 +1504,9 @@ size_t Block::ApproximateMemoryUsage() const {
     usage += read_amp_bitmap_->ApproximateMemoryUsage();
   }
   usage += checksum_size_;
+  if (columnar_entity_section_) {
+    usage += columnar_entity_section_->ApproximateMemoryUsage();
+  }
   return usage;
 }
 
@@ -11,6 +11,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -37,8 +38,10 @@ template <class TValue>
 class BlockIter;
 class DataBlockIter;
 class IndexBlockIter;
+class LearnedIndexModel;
 class MetaBlockIter;
 class BlockPrefixIndex;
+class ColumnarEntitySection;
 
 // BlockReadAmpBitmap is a bitmap that map the ROCKSDB_NAMESPACE::Block data
 // bytes to a bitmap with ratio bytes_per_bit. Whenever we access a range of
@@ -172,6 +175,13 @@ class Block {
 
   BlockBasedTableOptions::DataBlockIndexType IndexType() const;
 
+  // Whether the block stores restart key prefixes (see restart_key_prefix.h).
+  bool HasRestartKeyPrefixes() const;
+
+  // Whether the block stores its wide-column entities in a column section
+  // (see columnar_entity_block.h).
+  bool HasColumnarEntities() const;
+
   // raw_ucmp is a raw (i.e., not wrapped by `UserComparatorWrapper`) user key
   // comparator.
   //
@@ -227,6 +237,10 @@ class Block {
   // If `prefix_index` is not nullptr this block will do hash lookup for the key
   // prefix. If total_order_seek is true, prefix_index_ is ignored.
   //
+  // If `learned_index` is not nullptr, seeks will binary search only the
+  // window of restart points predicted by the model, falling back to a full
+  // binary search if the window does not contain the target.
+  //
   // `have_first_key` controls whether IndexValue will contain
   // first_internal_key. It affects data serialization format, so the same value
   // have_first_key must be used when writing and reading index.
@@ -239,7 +253,8 @@ class Block {
       bool have_first_key, bool key_includes_seq, bool value_is_full,
       bool block_contents_pinned = false,
       bool user_defined_timestamps_persisted = true,
-      BlockPrefixIndex* prefix_index = nullptr);
+      BlockPrefixIndex* prefix_index = nullptr,
+      const LearnedIndexModel* learned_index = nullptr);
 
   // Report an approximation of how much memory has been used.
   size_t ApproximateMemoryUsage() const;
@@ -288,6 +303,9 @@ class Block {
   uint32_t block_restart_interval_{0};
   uint8_t protection_bytes_per_key_{0};
   DataBlockHashIndex data_block_hash_index_;
+  // Start of the restart key prefixes array, or nullptr if the block has none
+  const char* restart_key_prefixes_{nullptr};
+  std::unique_ptr<ColumnarEntitySection> columnar_entity_section_;
 };
 
 // A `BlockIter` iterates over the entries in a `Block`'s data buffer. The
@@ -669,6 +687,15 @@ class BlockIter : public InternalIteratorBase<TValue> {
   inline bool BinarySeek(const Slice& target, uint32_t* index,
                          bool* is_index_key_result);
 
+  // Like BinarySeek(), but only considers restart points in [`left`, `right`].
+  // REQUIRES: `left` is -1 or its restart key is less than or equal to
+  // `target`, and the restart key at `right + 1` (if any) is strictly greater
+  // than `target`.
+  template <typename DecodeKeyFunc>
+  inline bool BinarySeekInRange(const Slice& target, int64_t left,
+                                int64_t right, uint32_t* index,
+                                bool* is_index_key_result);
+
   // Find the first key in restart interval `index` that is >= `target`.
   // If there is no such key, iterator is positioned at the first key in
   // restart interval `index + 1`.
@@ -694,7 +721,9 @@ class DataBlockIter final : public BlockIter<Slice> {
                   bool user_defined_timestamps_persisted,
                   DataBlockHashIndex* data_block_hash_index,
                   uint8_t protection_bytes_per_key, const char* kv_checksum,
-                  uint32_t block_restart_interval) {
+                  uint32_t block_restart_interval,
+                  const char* restart_key_prefixes,
+                  const ColumnarEntitySection* columnar_entity_section) {
     InitializeBase(raw_ucmp, data, restarts, num_restarts, global_seqno,
                    block_contents_pinned, user_defined_timestamps_persisted,
                    protection_bytes_per_key, kv_checksum,
@@ -703,9 +732,22 @@ class DataBlockIter final : public BlockIter<Slice> {
     read_amp_bitmap_ = read_amp_bitmap;
     last_bitmap_offset_ = current_ + 1;
     data_block_hash_index_ = data_block_hash_index;
+    restart_key_prefixes_ = restart_key_prefixes;
+    columnar_entity_section_ = columnar_entity_section;
+    assembled_value_offset_ = kNoAssembledValue;
   }
 
   Slice value() const override {
+    assert(Valid());
+    if (columnar_entity_section_ != nullptr && IsEntity()) {
+      return ColumnarEntityValue();
+    }
+    return raw_value();
+  }
+
+  // The value as stored in the block. For wide-column entities of blocks with
+  // a column section, this is a reference into that section.
+  Slice raw_value() const {
     assert(Valid());
     if (read_amp_bitmap_ && current_ < restarts_ &&
         current_ != last_bitmap_offset_) {
@@ -716,6 +758,24 @@ class DataBlockIter final : public BlockIter<Slice> {
     return value_;
   }
 
+  // Only return the given columns (and the default column) of wide-column
+  // entities, if the block stores them in a column section. Other values are
+  // returned as is. `projection` must outlive the iterator or the next call.
+  void SetWideColumnProjection(const std::vector<Slice>* projection) {
+    wide_column_projection_ = projection;
+    assembled_value_offset_ = kNoAssembledValue;
+  }
+
+  // Whether value() returns an entity assembled from the column section,
+  // which is backed by the iterator rather than by the block.
+  bool IsValueAssembled() const {
+    return columnar_entity_section_ != nullptr && Valid() && IsEntity();
+  }
+
+  bool IsValuePinned() const override {
+    return BlockIter<Slice>::IsValuePinned() && !IsValueAssembled();
+  }
+
   // Returns if `target` may exist.
   inline bool SeekForGet(const Slice& target) {
 #ifndef NDEBUG
@@ -779,8 +839,30 @@ class DataBlockIter final : public BlockIter<Slice> {
   int32_t prev_entries_idx_ = -1;
 
   DataBlockHashIndex* data_block_hash_index_;
+  // Restart key prefixes of the block, or nullptr if it has none.
+  const char* restart_key_prefixes_ = nullptr;
+  // Column section of the block, or nullptr if it has none.
+  const ColumnarEntitySection* columnar_entity_section_ = nullptr;
+  const std::vector<Slice>* wide_column_projection_ = nullptr;
+  // The entity (or its projection) at `assembled_value_offset_`, assembled
+  // from the column section. It is kept by the iterator rather than the
+  // block, so that memory not charged to the block cache does not grow with
+  // reads.
+  static constexpr uint32_t kNoAssembledValue =
+      std::numeric_limits<uint32_t>::max();
+  mutable std::string assembled_value_;
+  mutable uint32_t assembled_value_offset_ = kNoAssembledValue;
+
+  bool IsEntity() const {
+    return ExtractValueType(raw_key_.GetKey()) == kTypeWideColumnEntity;
+  }
+  Slice ColumnarEntityValue() const;
 
   bool SeekForGetImpl(const Slice& target);
+  // Like BinarySeek(), but first narrows the search to the restart points
+  // whose key prefix equals the target's using the restart key prefixes.
+  bool RestartKeyPrefixSeek(const Slice& target, uint32_t* index,
+                            bool* skip_linear_scan);
 };
 
 // Iterator over MetaBlocks.  MetaBlocks are similar to Data Blocks and
@@ -825,7 +907,8 @@ class MetaBlockIter final : public BlockIter<Slice> {
 
 class IndexBlockIter final : public BlockIter<IndexValue> {
  public:
-  IndexBlockIter() : BlockIter(), prefix_index_(nullptr) {}
+  IndexBlockIter()
+      : BlockIter(), prefix_index_(nullptr), learned_index_(nullptr) {}
 
   // key_includes_seq, default true, means that the keys are in internal key
   // format.
@@ -834,8 +917,9 @@ class IndexBlockIter final : public BlockIter<IndexValue> {
   void Initialize(const Comparator* raw_ucmp, const char* data,
                   uint32_t restarts, uint32_t num_restarts,
                   SequenceNumber global_seqno, BlockPrefixIndex* prefix_index,
-                  bool have_first_key, bool key_includes_seq,
-                  bool value_is_full, bool block_contents_pinned,
+                  const LearnedIndexModel* learned_index, bool have_first_key,
+                  bool key_includes_seq, bool value_is_full,
+                  bool block_contents_pinned,
                   bool user_defined_timestamps_persisted,
                   uint8_t protection_bytes_per_key, const char* kv_checksum,
                   uint32_t block_restart_interval) {
@@ -845,6 +929,7 @@ class IndexBlockIter final : public BlockIter<IndexValue> {
                    kv_checksum, block_restart_interval);
     raw_key_.SetIsUserKey(!key_includes_seq);
     prefix_index_ = prefix_index;
+    learned_index_ = learned_index;
     value_delta_encoded_ = !value_is_full;
     have_first_key_ = have_first_key;
     if (have_first_key_ && global_seqno != kDisableGlobalSequenceNumber) {
@@ -914,6 +999,7 @@ class IndexBlockIter final : public BlockIter<IndexValue> {
   bool value_delta_encoded_;
   bool have_first_key_;  // value includes first_internal_key
   BlockPrefixIndex* prefix_index_;
+  const LearnedIndexModel* learned_index_;
   // Whether the value is delta encoded. In that case the value is assumed to be
   // BlockHandle. The first value in each restart interval is the full encoded
   // BlockHandle; the restart of encoded size part of the BlockHandle. The
@@ -952,6 +1038,12 @@ class IndexBlockIter final : public BlockIter<IndexValue> {
                             uint32_t left, uint32_t right, uint32_t* index,
                             bool* prefix_may_exist);
   inline int CompareBlockKey(uint32_t block_index, const Slice& target);
+  // Narrows the binary search for `seek_key` to the restart points predicted
+  // by `learned_index_` for `user_key`. Falls back to a full binary search if
+  // the predicted window does not contain the seek result.
+  template <typename DecodeKeyFunc>
+  bool LearnedSeek(const Slice& seek_key, const Slice& user_key,
+                   uint32_t* index, bool* skip_linear_scan);
 
   inline bool ParseNextIndexKey();
 
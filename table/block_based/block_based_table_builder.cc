@@ -49,8 +49,12 @@
 #include "table/format.h"
 #include "table/meta_blocks.h"
 #include "table/table_builder.h"
+#include "util/adaptive_compressor.h"
 #include "util/coding.h"
 #include "util/compression.h"
+#include "util/compression_dict_registry.h"
+#include "util/compression_thread_pool.h"
+#include "util/hash.h"
 #include "util/stop_watch.h"
 #include "util/string_util.h"
 #include "util/work_queue.h"
@@ -277,6 +281,11 @@ struct BlockBasedTableBuilder::ParallelCompressionRep {
   using CompressQueue = WorkQueue<BlockRep*>;
   CompressQueue compress_queue;
   std::vector<port::Thread> compress_thread_pool;
+  // Used instead of compress_queue and compress_thread_pool with a
+  // CompressionThreadPool shared by the DB. compress_pool_fn compresses a
+  // block with the working area of the given pool thread.
+  std::function<void(BlockRep*, size_t)> compress_pool_fn;
+  std::unique_ptr<CompressionThreadPool::Queue> compress_pool_queue;
 
   // Write queue will pass references to BlockRep::slot in block_rep_buf,
   // and those references are always valid before the corresponding
@@ -440,7 +449,11 @@ struct BlockBasedTableBuilder::ParallelCompressionRep {
     if (!write_queue.push(&block_rep->slot)) {
       return;
     }
-    if (!compress_queue.push(block_rep)) {
+    if (compress_pool_queue) {
+      compress_pool_queue->Submit([this, block_rep](size_t thread_index) {
+        compress_pool_fn(block_rep, thread_index);
+      });
+    } else if (!compress_queue.push(block_rep)) {
       return;
     }
 
@@ -531,9 +544,17 @@ struct BlockBasedTableBuilder::Rep {
   std::atomic<uint64_t> sampled_input_data_bytes;
   std::atomic<uint64_t> sampled_output_slow_data_bytes;
   std::atomic<uint64_t> sampled_output_fast_data_bytes;
+  // Shared by the DB for compressing data blocks in parallel; takes
+  // precedence over compression_opts.parallel_threads.
+  CompressionThreadPool* compression_pool;
+  bool compression_urgent;
   uint32_t compression_parallel_threads;
   int max_compressed_bytes_per_kb;
   size_t max_dict_sample_bytes = 0;
+  // Applied to data blocks before compressing them without a dictionary
+  // (format_version >= 7 and the built-in compressions only)
+  PreCompressionTransform data_block_transform = PreCompressionTransform::kNone;
+  size_t data_block_transform_element_size = 1;
 
   // *** Compressors & decompressors - Yes, it seems like a lot here but ***
   // *** these are distinct fields to minimize extra conditionals and    ***
@@ -543,6 +564,15 @@ struct BlockBasedTableBuilder::Rep {
   std::unique_ptr<Compressor> basic_compressor;
   // A compressor using dictionary compression (when applicable)
   std::unique_ptr<Compressor> compressor_with_dict;
+  // Choosing the compression of each data block, with
+  // compression_opts.adaptive_compression_budget_pct
+  std::unique_ptr<Compressor> adaptive_compressor;
+  // With compression_opts.use_shared_dict, where dictionaries are shared
+  // with the other tables of the column family using the same compression
+  // config
+  CompressionDictRegistry::Slot* compression_dict_slot = nullptr;
+  // The shared dictionary (and compressor) used for data blocks, if any
+  std::shared_ptr<const CompressionDictRegistry::Dict> shared_dict;
   // Once configured/determined, points to one of the above Compressors to
   // use on data blocks.
   Compressor* data_block_compressor = nullptr;
@@ -568,6 +598,10 @@ struct BlockBasedTableBuilder::Rep {
 
   size_t data_begin_offset = 0;
 
+  // Number of data blocks written with each compression type, recorded with
+  // adaptive_compressor
+  std::map<CompressionType, uint64_t> data_block_compression_counts;
+
   TableProperties props;
 
   // States of the builder.
@@ -629,7 +663,7 @@ struct BlockBasedTableBuilder::Rep {
   void set_offset(uint64_t o) { offset.store(o, std::memory_order_relaxed); }
 
   bool IsParallelCompressionEnabled() const {
-    return compression_parallel_threads > 1;
+    return compression_pool != nullptr || compression_parallel_threads > 1;
   }
 
   Status GetStatus() {
@@ -720,7 +754,14 @@ struct BlockBasedTableBuilder::Rep {
                        ? BlockBasedTableOptions::kDataBlockBinarySearch
                        : table_options.data_block_index_type,
                    table_options.data_block_hash_table_util_ratio, ts_sz,
-                   persist_user_defined_timestamps),
+                   persist_user_defined_timestamps, false /* is_user_key */,
+                   // Restart key prefixes order like the keys only for a
+                   // bytewise ordering of user keys without timestamps.
+                   table_options.data_block_restart_key_prefixes &&
+                       ts_sz == 0 &&
+                       Slice(tbo.internal_comparator.user_comparator()
+                                 ->Name()) == BytewiseComparator()->Name(),
+                   table_options.data_block_columnar_entities),
         range_del_block(
             1 /* block_restart_interval */, true /* use_delta_encoding */,
             false /* use_value_delta_encoding */,
@@ -734,7 +775,14 @@ struct BlockBasedTableBuilder::Rep {
         sampled_input_data_bytes(0),
         sampled_output_slow_data_bytes(0),
         sampled_output_fast_data_bytes(0),
-        compression_parallel_threads(tbo.compression_opts.parallel_threads),
+        compression_pool(tbo.compression_type == kNoCompression
+                             ? nullptr
+                             : tbo.compression_pool),
+        compression_urgent(tbo.compression_urgent),
+        compression_parallel_threads(
+            compression_pool != nullptr
+                ? static_cast<uint32_t>(compression_pool->NumThreads())
+                : tbo.compression_opts.parallel_threads),
         max_compressed_bytes_per_kb(
             tbo.compression_opts.max_compressed_bytes_per_kb),
         data_block_working_areas(compression_parallel_threads),
@@ -786,13 +834,29 @@ struct BlockBasedTableBuilder::Rep {
 
     basic_compressor = mgr->GetCompressorForSST(
         filter_context, tbo.compression_opts, tbo.compression_type);
+    if (basic_compressor && tbo.moptions.compression_manager == nullptr &&
+        FormatVersionSupportsPreCompressionTransform(
+            table_opt.format_version) &&
+        IsSupportedPreCompressionElementSize(
+            tbo.compression_opts.pre_compression_element_size)) {
+      data_block_transform = tbo.compression_opts.pre_compression_transform;
+      data_block_transform_element_size =
+          tbo.compression_opts.pre_compression_element_size;
+    }
     if (basic_compressor) {
       if (table_options.enable_index_compression) {
         basic_working_area.compress = basic_compressor->ObtainWorkingArea();
       }
       max_dict_sample_bytes = basic_compressor->GetMaxSampleSizeIfWantDict(
           CacheEntryRole::kDataBlock);
-      if (max_dict_sample_bytes > 0) {
+      if (max_dict_sample_bytes > 0 && tbo.compression_opts.use_shared_dict &&
+          tbo.compression_dict_registry != nullptr) {
+        compression_dict_slot = tbo.compression_dict_registry->GetSlot(
+            std::string(mgr->Name()) + ";" + props.compression_name + ";" +
+            props.compression_options);
+        shared_dict = compression_dict_slot->GetDict();
+      }
+      if (max_dict_sample_bytes > 0 && compression_dict_slot == nullptr) {
         state = State::kBuffered;
         if (tbo.target_file_size == 0) {
           buffer_limit = tbo.compression_opts.max_dict_buffer_bytes;
@@ -803,8 +867,29 @@ struct BlockBasedTableBuilder::Rep {
                                   tbo.compression_opts.max_dict_buffer_bytes);
         }
       } else {
-        // No distinct data block compressor using dictionary
-        data_block_compressor = basic_compressor.get();
+        // No dictionary trained for this table
+        data_block_compressor = shared_dict != nullptr
+                                    ? shared_dict->compressor.get()
+                                    : basic_compressor.get();
+        if (max_dict_sample_bytes == 0 &&
+            tbo.compression_opts.adaptive_compression_budget_pct > 0) {
+          const CompressionType fast_type =
+              LZ4_Supported()      ? kLZ4Compression
+              : Snappy_Supported() ? kSnappyCompression
+                                   : kNoCompression;
+          std::unique_ptr<Compressor> fast_compressor;
+          if (fast_type != tbo.compression_type) {
+            CompressionOptions fast_opts;
+            fast_opts.max_compressed_bytes_per_kb = max_compressed_bytes_per_kb;
+            fast_compressor = mgr->GetCompressor(fast_opts, fast_type);
+          }
+          adaptive_compressor = std::make_unique<AdaptiveCompressor>(
+              mgr->GetCompressorForSST(filter_context, tbo.compression_opts,
+                                       tbo.compression_type),
+              std::move(fast_compressor), max_compressed_bytes_per_kb,
+              tbo.compression_opts.adaptive_compression_budget_pct);
+          data_block_compressor = adaptive_compressor.get();
+        }
         for (uint32_t i = 0; i < compression_parallel_threads; i++) {
           data_block_working_areas[i].compress =
               data_block_compressor->ObtainWorkingArea();
@@ -821,11 +906,24 @@ struct BlockBasedTableBuilder::Rep {
               verify_decompressor->ObtainWorkingArea(tbo.compression_type);
         }
         if (state == State::kUnbuffered) {
+          data_block_verify_decompressor = verify_decompressor.get();
+          if (shared_dict != nullptr) {
+            Status s = verify_decompressor->MaybeCloneForDict(
+                shared_dict->compressor->GetSerializedDict(),
+                &verify_decompressor_with_dict);
+            if (verify_decompressor_with_dict) {
+              data_block_verify_decompressor =
+                  verify_decompressor_with_dict.get();
+            } else {
+              assert(!s.ok());
+              SetStatus(s);
+            }
+          }
           for (uint32_t i = 0; i < compression_parallel_threads; i++) {
             data_block_working_areas[i].verify =
-                verify_decompressor->ObtainWorkingArea(tbo.compression_type);
+                data_block_verify_decompressor->ObtainWorkingArea(
+                    tbo.compression_type);
           }
-          data_block_verify_decompressor = verify_decompressor.get();
         }
       }
     }
@@ -1214,6 +1312,10 @@ void BlockBasedTableBuilder::Flush() {
         0 /*block_compressed_bytes_slow*/, 0 /*block_compressed_bytes_fast*/);
   }
 
+  if (r->compression_dict_slot != nullptr) {
+    r->compression_dict_slot->MaybeAddSample(uncompressed_block_data,
+                                             r->max_dict_sample_bytes);
+  }
   if (rep_->state == Rep::State::kBuffered) {
     std::string uncompressed_block_holder;
     uncompressed_block_holder.reserve(rep_->table_options.block_size);
@@ -1304,9 +1406,29 @@ void BlockBasedTableBuilder::CompressAndVerifyBlock(
           r->ioptions.clock,
           ShouldReportDetailedTime(r->ioptions.env, r->ioptions.stats));
 
-      *out_status =
-          compressor->CompressBlock(uncompressed_block_data, compressed_output,
-                                    &type, &working_area.compress);
+      // A data block may be transformed before compression, which the
+      // compression type records. Not with a dictionary, because it is
+      // sampled from untransformed blocks.
+      std::string transformed;
+      Slice to_compress = uncompressed_block_data;
+      if (is_data_block &&
+          r->data_block_transform != PreCompressionTransform::kNone &&
+          compressor->GetSerializedDict().empty()) {
+        transformed.resize(uncompressed_block_data.size());
+        ApplyPreCompressionTransform(
+            r->data_block_transform, r->data_block_transform_element_size,
+            uncompressed_block_data.data(), uncompressed_block_data.size(),
+            transformed.data());
+        to_compress = transformed;
+      }
+      *out_status = compressor->CompressBlock(to_compress, compressed_output,
+                                              &type, &working_area.compress);
+      if (type != kNoCompression && !transformed.empty()) {
+        assert(type <= kZSTD);
+        type = MakeTransformedCompressionType(
+            type, r->data_block_transform,
+            r->data_block_transform_element_size);
+      }
 
       // Post-condition of Compressor::CompressBlock
       assert(type == kNoCompression || out_status->ok());
@@ -1468,6 +1590,10 @@ void BlockBasedTableBuilder::WriteMaybeCompressedBlock(
     }
   }
 
+  if (is_data_block && r->adaptive_compressor) {
+    ++r->data_block_compression_counts[comp_type];
+  }
+
   r->pre_compression_size +=
       uncompressed_block_data->size() + kBlockTrailerSize;
   r->set_offset(r->get_offset() + block_contents.size() + kBlockTrailerSize);
@@ -1568,17 +1694,37 @@ void BlockBasedTableBuilder::BGWorkWriteMaybeCompressedBlock() {
 void BlockBasedTableBuilder::StartParallelCompression() {
   rep_->pc_rep.reset(
       new ParallelCompressionRep(rep_->compression_parallel_threads));
-  rep_->pc_rep->compress_thread_pool.reserve(
-      rep_->compression_parallel_threads);
-  for (uint32_t i = 0; i < rep_->compression_parallel_threads; i++) {
-    rep_->pc_rep->compress_thread_pool.emplace_back(
-        [this, i] { BGWorkCompression(rep_->data_block_working_areas[i]); });
+  if (rep_->compression_pool != nullptr) {
+    rep_->pc_rep->compress_pool_queue =
+        rep_->compression_pool->NewQueue(rep_->compression_urgent);
+    rep_->pc_rep->compress_pool_fn =
+        [this](ParallelCompressionRep::BlockRep* block_rep,
+               size_t thread_index) {
+          // Same as BGWorkCompression, for one block
+          if (ok()) {
+            CompressAndVerifyBlock(
+                block_rep->uncompressed, true, /* is_data_block*/
+                rep_->data_block_working_areas[thread_index],
+                &block_rep->compressed, &block_rep->compression_type,
+                &block_rep->status);
+          }
+          block_rep->slot.Fill(block_rep);
+        };
+  } else {
+    rep_->pc_rep->compress_thread_pool.reserve(
+        rep_->compression_parallel_threads);
+    for (uint32_t i = 0; i < rep_->compression_parallel_threads; i++) {
+      rep_->pc_rep->compress_thread_pool.emplace_back(
+          [this, i] { BGWorkCompression(rep_->data_block_working_areas[i]); });
+    }
   }
   rep_->pc_rep->write_thread.reset(
       new port::Thread([this] { BGWorkWriteMaybeCompressedBlock(); }));
 }
 
 void BlockBasedTableBuilder::StopParallelCompression() {
+  // Waits for the blocks submitted to the pool
+  rep_->pc_rep->compress_pool_queue.reset();
   rep_->pc_rep->compress_queue.finish();
   for (auto& thread : rep_->pc_rep->compress_thread_pool) {
     thread.join();
@@ -1817,6 +1963,10 @@ void BlockBasedTableBuilder::WritePropertiesBlock(
     }
     rep_->props.user_defined_timestamps_persisted =
         rep_->persist_user_defined_timestamps;
+    for (const auto& [type, count] : rep_->data_block_compression_counts) {
+      rep_->props.data_block_compression_counts +=
+          CompressionTypeToString(type) + "=" + std::to_string(count) + ";";
+    }
 
     assert(IsEmpty() || rep_->props.key_largest_seqno != UINT64_MAX);
     // Add basic properties
@@ -1861,8 +2011,12 @@ void BlockBasedTableBuilder::WriteCompressionDictBlock(
   Slice compression_dict;
   if (rep_->compressor_with_dict) {
     compression_dict = rep_->compressor_with_dict->GetSerializedDict();
+  } else if (rep_->shared_dict) {
+    compression_dict = rep_->shared_dict->compressor->GetSerializedDict();
   }
   if (!compression_dict.empty()) {
+    rep_->props.compression_dict_id =
+        Hash64(compression_dict.data(), compression_dict.size());
     BlockHandle compression_dict_block_handle;
     if (ok()) {
       WriteMaybeCompressedBlock(compression_dict, kNoCompression,
@@ -2157,6 +2311,13 @@ Status BlockBasedTableBuilder::Finish() {
     // Let io_status supersede ok status (otherwise status takes precedennce)
     ret_status = ios;
   }
+  if (ret_status.ok() && r->compression_dict_slot != nullptr &&
+      r->basic_decompressor != nullptr) {
+    // Any new shared dictionary is trained here, by a background job that
+    // has finished writing its table.
+    r->compression_dict_slot->MaybeTrain(*r->basic_compressor,
+                                         *r->basic_decompressor);
+  }
   return ret_status;
 }
 
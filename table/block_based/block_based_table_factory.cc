@@ -28,6 +28,8 @@
 #include "rocksdb/utilities/options_type.h"
 #include "table/block_based/block_based_table_builder.h"
 #include "table/block_based/block_based_table_reader.h"
+#include "table/block_based/data_block_hash_index.h"
+#include "table/block_based/metadata_pinning_manager.h"
 #include "table/format.h"
 #include "util/mutexlock.h"
 #include "util/string_util.h"
@@ -180,7 +182,8 @@ static std::unordered_map<std::string, BlockBasedTableOptions::IndexType>
         {"kTwoLevelIndexSearch",
          BlockBasedTableOptions::IndexType::kTwoLevelIndexSearch},
         {"kBinarySearchWithFirstKey",
-         BlockBasedTableOptions::IndexType::kBinarySearchWithFirstKey}};
+         BlockBasedTableOptions::IndexType::kBinarySearchWithFirstKey},
+        {"kLearnedIndex", BlockBasedTableOptions::IndexType::kLearnedIndex}};
 
 static std::unordered_map<std::string,
                           BlockBasedTableOptions::DataBlockIndexType>
@@ -273,6 +276,14 @@ static struct BlockBasedTableTypeInfo {
          {offsetof(struct BlockBasedTableOptions,
                    data_block_hash_table_util_ratio),
           OptionType::kDouble, OptionVerificationType::kNormal}},
+        {"data_block_restart_key_prefixes",
+         {offsetof(struct BlockBasedTableOptions,
+                   data_block_restart_key_prefixes),
+          OptionType::kBoolean, OptionVerificationType::kNormal}},
+        {"data_block_columnar_entities",
+         {offsetof(struct BlockBasedTableOptions,
+                   data_block_columnar_entities),
+          OptionType::kBoolean, OptionVerificationType::kNormal}},
         {"checksum",
          {offsetof(struct BlockBasedTableOptions, checksum),
           OptionType::kChecksumType, OptionVerificationType::kNormal}},
@@ -366,6 +377,10 @@ static struct BlockBasedTableTypeInfo {
              kOptNameMetadataCacheOpts, &metadata_cache_options_type_info,
              offsetof(struct BlockBasedTableOptions, metadata_cache_options),
              OptionVerificationType::kNormal, OptionTypeFlags::kNone)},
+        {"adaptive_metadata_pinning_budget",
+         {offsetof(struct BlockBasedTableOptions,
+                   adaptive_metadata_pinning_budget),
+          OptionType::kSizeT, OptionVerificationType::kNormal}},
         {"block_cache",
          {offsetof(struct BlockBasedTableOptions, block_cache),
           OptionType::kUnknown, OptionVerificationType::kNormal,
@@ -481,6 +496,17 @@ void BlockBasedTableFactory::InitializeOptions() {
       table_options_.format_version = kMinSupportedFormatVersion;
     }
   }
+
+  const size_t pinning_budget =
+      table_options_.adaptive_metadata_pinning_budget;
+  if (table_options_.block_cache &&
+      table_options_.cache_index_and_filter_blocks && pinning_budget > 0) {
+    shared_state_->metadata_pinning_manager =
+        std::make_shared<MetadataPinningManager>(table_options_.block_cache,
+                                                 pinning_budget);
+  } else {
+    shared_state_->metadata_pinning_manager.reset();
+  }
 }
 
 Status BlockBasedTableFactory::PrepareOptions(const ConfigOptions& opts) {
@@ -578,7 +604,8 @@ Status BlockBasedTableFactory::NewTableReader(
       table_reader_options.max_file_size_for_l0_meta_pin,
       table_reader_options.cur_db_session_id, table_reader_options.cur_file_num,
       table_reader_options.unique_id,
-      table_reader_options.user_defined_timestamps_persisted);
+      table_reader_options.user_defined_timestamps_persisted,
+      shared_state_->metadata_pinning_manager);
 }
 
 TableBuilder* BlockBasedTableFactory::NewTableBuilder(
@@ -613,6 +640,15 @@ Status BlockBasedTableFactory::ValidateOptions(
         "Unsupported BlockBasedTable format_version. Please check "
         "include/rocksdb/table.h for more info");
   }
+  for (const CompressionOptions* opts :
+       {&cf_opts.compression_opts, &cf_opts.bottommost_compression_opts}) {
+    if (opts->pre_compression_transform != PreCompressionTransform::kNone &&
+        !FormatVersionSupportsPreCompressionTransform(
+            table_options_.format_version)) {
+      return Status::InvalidArgument(
+          "pre_compression_transform requires format_version >= 7");
+    }
+  }
   if (table_options_.block_align && (cf_opts.compression != kNoCompression)) {
     return Status::InvalidArgument(
         "Enable block_align, but compression "
@@ -642,6 +678,12 @@ Status BlockBasedTableFactory::ValidateOptions(
     return Status::InvalidArgument(
         "block size exceeds maximum number (4GiB) allowed");
   }
+  if (table_options_.data_block_restart_key_prefixes &&
+      table_options_.block_size > kMaxBlockSizeSupportedByHashIndex) {
+    // Blocks this large would be written without the prefixes anyway
+    return Status::InvalidArgument(
+        "data_block_restart_key_prefixes requires block_size <= 64KiB");
+  }
   if (table_options_.data_block_index_type ==
           BlockBasedTableOptions::kDataBlockBinaryAndHash &&
       table_options_.data_block_hash_table_util_ratio <= 0) {
@@ -768,6 +810,12 @@ std::string BlockBasedTableFactory::GetPrintableOptions() const {
   snprintf(buffer, kBufferSize, "  data_block_hash_table_util_ratio: %lf\n",
            table_options_.data_block_hash_table_util_ratio);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  data_block_restart_key_prefixes: %d\n",
+           table_options_.data_block_restart_key_prefixes);
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  data_block_columnar_entities: %d\n",
+           table_options_.data_block_columnar_entities);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  checksum: %d\n", table_options_.checksum);
   ret.append(buffer);
   snprintf(buffer, kBufferSize, "  no_block_cache: %d\n",
@@ -980,6 +1028,7 @@ const std::string BlockBasedTablePropertyNames::kDecoupledPartitionedFilters =
 const std::string kHashIndexPrefixesBlock = "rocksdb.hashindex.prefixes";
 const std::string kHashIndexPrefixesMetadataBlock =
     "rocksdb.hashindex.metadata";
+const std::string kLearnedIndexModelBlock = "rocksdb.learnedindex.model";
 const std::string kPropTrue = "1";
 const std::string kPropFalse = "0";
 
@@ -25,6 +25,7 @@ struct DBOptions;
 struct EnvOptions;
 
 class BlockBasedTableBuilder;
+class MetadataPinningManager;
 class RandomAccessFileReader;
 class WritableFileWriter;
 
@@ -106,6 +107,7 @@ class BlockBasedTableFactory : public TableFactory {
   // Share some state among cloned instances
   struct SharedState {
     std::shared_ptr<CacheReservationManager> table_reader_cache_res_mgr;
+    std::shared_ptr<MetadataPinningManager> metadata_pinning_manager;
     TailPrefetchStats tail_prefetch_stats;
   };
   std::shared_ptr<SharedState> shared_state_;
@@ -113,6 +115,7 @@ class BlockBasedTableFactory : public TableFactory {
 
 extern const std::string kHashIndexPrefixesBlock;
 extern const std::string kHashIndexPrefixesMetadataBlock;
+extern const std::string kLearnedIndexModelBlock;
 extern const std::string kPropTrue;
 extern const std::string kPropFalse;
 }  // namespace ROCKSDB_NAMESPACE
@@ -70,7 +70,11 @@ void BlockBasedTableIterator::SeekImpl(const Slice* target,
   seek_stat_state_ = kNone;
   bool filter_checked = false;
   if (target &&
-      !CheckPrefixMayMatch(*target, IterDirection::kForward, &filter_checked)) {
+      (!CheckPrefixMayMatch(*target, IterDirection::kForward,
+                            &filter_checked) ||
+       (check_range_filter_ &&
+        !table_->RangeMayMatch(*target, read_options_, &lookup_context_,
+                               &filter_checked)))) {
     ResetDataIter();
     RecordTick(table_->GetStatistics(), is_last_level_
                                             ? LAST_LEVEL_SEEK_FILTERED
@@ -144,7 +148,10 @@ void BlockBasedTableIterator::SeekImpl(const Slice* target,
   } else {
     // Need to use the data block.
     if (!same_block) {
-      if (read_options_.async_io && async_prefetch) {
+      // Compactions only use async IO for readahead, as their merging
+      // iterator does not retry Seek() on Status::TryAgain
+      if (read_options_.async_io && async_prefetch &&
+          lookup_context_.caller != TableReaderCaller::kCompaction) {
         AsyncInitDataBlock(/*is_first_pass=*/true);
         if (async_read_in_progress_) {
           // Status::TryAgain indicates asynchronous request for retrieval of
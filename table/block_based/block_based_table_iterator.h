@@ -26,7 +26,7 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
       const BlockBasedTable* table, const ReadOptions& read_options,
       const InternalKeyComparator& icomp,
       std::unique_ptr<InternalIteratorBase<IndexValue>>&& index_iter,
-      bool check_filter, bool need_upper_bound_check,
+      bool check_filter, bool check_range_filter, bool need_upper_bound_check,
       const SliceTransform* prefix_extractor, TableReaderCaller caller,
       size_t compaction_readahead_size = 0, bool allow_unprepared_value = false)
       : index_iter_(std::move(index_iter)),
@@ -43,6 +43,7 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
         allow_unprepared_value_(allow_unprepared_value),
         block_iter_points_to_real_block_(false),
         check_filter_(check_filter),
+        check_range_filter_(check_range_filter),
         need_upper_bound_check_(need_upper_bound_check),
         async_read_in_progress_(false),
         is_last_level_(table->IsLastLevel()) {}
@@ -132,6 +133,15 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
       seek_stat_state_ = kDataBlockReadSinceLastSeek;
     }
 
+    if (block_iter_.IsValueAssembled() && pinned_iters_mgr_ &&
+        pinned_iters_mgr_->PinningEnabled()) {
+      // An entity assembled from a column section only lives until block_iter_
+      // moves, so the pinned copy is released along with the pinned blocks
+      const Slice assembled = block_iter_.value();
+      std::string* pinned = new std::string(assembled.data(), assembled.size());
+      pinned_iters_mgr_->RegisterCleanup(&DeletePinnedValue, pinned, nullptr);
+      return *pinned;
+    }
     return block_iter_.value();
   }
   Status status() const override {
@@ -177,7 +187,8 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
     assert(!is_at_first_key_from_index_);
     assert(Valid());
 
-    // BlockIter::IsValuePinned() is always true. No need to check
+    // BlockIter::IsValuePinned() is always true, except for entities
+    // assembled from a column section, which value() copies while pinning
     return pinned_iters_mgr_ && pinned_iters_mgr_->PinningEnabled() &&
            block_iter_points_to_real_block_;
   }
@@ -229,6 +240,10 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
   std::unique_ptr<InternalIteratorBase<IndexValue>> index_iter_;
 
  private:
+  static void DeletePinnedValue(void* arg1, void* /* arg2 */) {
+    delete static_cast<std::string*>(arg1);
+  }
+
   enum class IterDirection {
     kForward,
     kBackward,
@@ -321,6 +336,8 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
   // that block yet. A call to PrepareValue() will trigger loading the block.
   bool is_at_first_key_from_index_ = false;
   bool check_filter_;
+  // Whether to check [seek key, iterate_upper_bound) against range filters
+  bool check_range_filter_;
   // TODO(Zhongyi): pick a better name
   bool need_upper_bound_check_;
 
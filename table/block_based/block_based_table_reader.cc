@@ -56,6 +56,8 @@
 #include "table/block_based/filter_policy_internal.h"
 #include "table/block_based/full_filter_block.h"
 #include "table/block_based/hash_index_reader.h"
+#include "table/block_based/learned_index_reader.h"
+#include "table/block_based/metadata_pinning_manager.h"
 #include "table/block_based/partitioned_filter_block.h"
 #include "table/block_based/partitioned_index_reader.h"
 #include "table/block_fetcher.h"
@@ -134,8 +136,12 @@ namespace ROCKSDB_NAMESPACE {
 extern const uint64_t kBlockBasedTableMagicNumber;
 extern const std::string kHashIndexPrefixesBlock;
 extern const std::string kHashIndexPrefixesMetadataBlock;
+extern const std::string kLearnedIndexModelBlock;
 
 BlockBasedTable::~BlockBasedTable() {
+  if (rep_->metadata_pinning_manager) {
+    rep_->metadata_pinning_manager->Unregister(this);
+  }
   auto ua = rep_->uncache_aggressiveness.LoadRelaxed();
   // NOTE: there is an undiagnosed incompatibility with mmap reads,
   // where attempting to read the index below can result in bus error.
@@ -636,7 +642,8 @@ Status BlockBasedTable::Open(
     BlockCacheTracer* const block_cache_tracer,
     size_t max_file_size_for_l0_meta_pin, const std::string& cur_db_session_id,
     uint64_t cur_file_num, UniqueId64x2 expected_unique_id,
-    const bool user_defined_timestamps_persisted) {
+    const bool user_defined_timestamps_persisted,
+    std::shared_ptr<MetadataPinningManager> metadata_pinning_manager) {
   table_reader->reset();
 
   Status s;
@@ -885,6 +892,11 @@ Status BlockBasedTable::Open(
     }
   }
 
+  if (s.ok() && metadata_pinning_manager) {
+    rep->metadata_pinning_manager = std::move(metadata_pinning_manager);
+    rep->metadata_pinning_manager->Register(new_table.get());
+  }
+
   if (s.ok()) {
     *table_reader = std::move(new_table);
   }
@@ -1031,6 +1043,16 @@ Status BlockBasedTable::ReadPropertiesBlock(
     rep_->prefix_filtering &= IsFeatureSupported(
         *(rep_->table_properties),
         BlockBasedTablePropertyNames::kPrefixFiltering, rep_->ioptions.logger);
+    // Range filters hold every key only with whole key filtering, and are
+    // ordered bytewise on user keys without timestamps.
+    const Comparator* const user_comparator =
+        rep_->internal_comparator.user_comparator();
+    rep_->range_filtering =
+        rep_->whole_key_filtering &&
+        rep_->table_properties->filter_policy_name ==
+            RangeFilterPolicy::kClassName() &&
+        user_comparator->timestamp_size() == 0 &&
+        Slice(user_comparator->Name()) == BytewiseComparator()->Name();
 
     rep_->index_key_includes_seq =
         rep_->table_properties->index_key_is_user_key == 0;
@@ -2023,6 +2045,22 @@ bool BlockBasedTable::PrefixRangeMayMatch(
   return may_match;
 }
 
+bool BlockBasedTable::RangeMayMatch(const Slice& internal_key,
+                                    const ReadOptions& read_options,
+                                    BlockCacheLookupContext* lookup_context,
+                                    bool* filter_checked) const {
+  FilterBlockReader* const filter = rep_->filter.get();
+  if (!rep_->range_filtering || filter == nullptr ||
+      read_options.iterate_upper_bound == nullptr) {
+    return true;
+  }
+  *filter_checked = true;
+  return filter->RangeMayMatch(ExtractUserKey(internal_key),
+                               *read_options.iterate_upper_bound,
+                               &internal_key, /*get_context=*/nullptr,
+                               lookup_context, read_options);
+}
+
 bool BlockBasedTable::PrefixExtractorChanged(
     const SliceTransform* prefix_extractor) const {
   if (prefix_extractor == nullptr) {
@@ -2047,6 +2085,9 @@ InternalIterator* BlockBasedTable::NewIterator(
     Arena* arena, bool skip_filters, TableReaderCaller caller,
     size_t compaction_readahead_size, bool allow_unprepared_value) {
   BlockCacheLookupContext lookup_context{caller};
+  if (caller == TableReaderCaller::kUserIterator) {
+    RecordMetadataAccess();
+  }
   bool need_upper_bound_check =
       read_options.auto_prefix_mode || PrefixExtractorChanged(prefix_extractor);
   std::unique_ptr<InternalIteratorBase<IndexValue>> index_iter(NewIndexIterator(
@@ -2061,8 +2102,9 @@ InternalIterator* BlockBasedTable::NewIterator(
             (!read_options.total_order_seek || read_options.auto_prefix_mode ||
              read_options.prefix_same_as_start) &&
             prefix_extractor != nullptr,
-        need_upper_bound_check, prefix_extractor, caller,
-        compaction_readahead_size, allow_unprepared_value);
+        !skip_filters && rep_->range_filtering, need_upper_bound_check,
+        prefix_extractor, caller, compaction_readahead_size,
+        allow_unprepared_value);
   } else {
     auto* mem = arena->AllocateAligned(sizeof(BlockBasedTableIterator));
     return new (mem) BlockBasedTableIterator(
@@ -2071,8 +2113,9 @@ InternalIterator* BlockBasedTable::NewIterator(
             (!read_options.total_order_seek || read_options.auto_prefix_mode ||
              read_options.prefix_same_as_start) &&
             prefix_extractor != nullptr,
-        need_upper_bound_check, prefix_extractor, caller,
-        compaction_readahead_size, allow_unprepared_value);
+        !skip_filters && rep_->range_filtering, need_upper_bound_check,
+        prefix_extractor, caller, compaction_readahead_size,
+        allow_unprepared_value);
   }
 }
 
@@ -2276,6 +2319,7 @@ Status BlockBasedTable::Get(const ReadOptions& read_options, const Slice& key,
   assert(key.size() >= 8);  // key must be internal key
   assert(get_context != nullptr);
   Status s;
+  RecordMetadataAccess();
 
   FilterBlockReader* const filter =
       !skip_filters ? rep_->filter.get() : nullptr;
@@ -2358,6 +2402,10 @@ Status BlockBasedTable::Get(const ReadOptions& read_options, const Slice& key,
         break;
       }
 
+      // Values recorded for the row cache must not depend on the projection.
+      if (!get_context->HasReplayLog()) {
+        biter.SetWideColumnProjection(read_options.wide_column_projection);
+      }
       bool may_exist = biter.SeekForGet(key);
       // If user-specified timestamp is supported, we cannot end the search
       // just because hash index lookup indicates the key+ts does not exist.
@@ -2639,6 +2687,10 @@ BlockType BlockBasedTable::GetBlockTypeForMetaBlockByName(
     return BlockType::kHashIndexMetadata;
   }
 
+  if (meta_block_name == kLearnedIndexModelBlock) {
+    return BlockType::kLearnedIndexModel;
+  }
+
   if (meta_block_name == kIndexBlockName) {
     return BlockType::kIndex;
   }
@@ -2698,6 +2750,15 @@ Status BlockBasedTable::VerifyChecksumInMetaBlocks(
   return s;
 }
 
+void BlockBasedTable::RecordMetadataAccess() const {
+  if (rep_->metadata_pinning_manager) {
+    const uint64_t accesses = rep_->metadata_accesses.FetchAddRelaxed(1) + 1;
+    if (accesses % MetadataPinningManager::kAccessBatch == 0) {
+      rep_->metadata_pinning_manager->OnAccessBatch();
+    }
+  }
+}
+
 bool BlockBasedTable::EraseFromCache(const BlockHandle& handle) const {
   assert(rep_ != nullptr);
 
@@ -2806,6 +2867,11 @@ Status BlockBasedTable::CreateIndexReader(
                                        index_reader);
       }
     }
+    case BlockBasedTableOptions::kLearnedIndex: {
+      return LearnedIndexReader::Create(this, ro, prefetch_buffer, meta_iter,
+                                        use_cache, prefetch, pin,
+                                        lookup_context, index_reader);
+    }
     default: {
       std::string error_message =
           "Unrecognized index type: " + std::to_string(rep_->index_type);
@@ -46,6 +46,7 @@ class FullFilterBlockReader;
 class Footer;
 class InternalKeyComparator;
 class Iterator;
+class MetadataPinningManager;
 class FSRandomAccessFile;
 class TableCache;
 class TableReader;
@@ -115,7 +116,9 @@ class BlockBasedTable : public TableReader {
       size_t max_file_size_for_l0_meta_pin = 0,
       const std::string& cur_db_session_id = "", uint64_t cur_file_num = 0,
       UniqueId64x2 expected_unique_id = {},
-      const bool user_defined_timestamps_persisted = true);
+      const bool user_defined_timestamps_persisted = true,
+      std::shared_ptr<MetadataPinningManager> metadata_pinning_manager =
+          nullptr);
 
   bool PrefixRangeMayMatch(const Slice& internal_key,
                            const ReadOptions& read_options,
@@ -124,6 +127,12 @@ class BlockBasedTable : public TableReader {
                            BlockCacheLookupContext* lookup_context,
                            bool* filter_checked) const;
 
+  // Returns false if the table has a range filter (see NewRangeFilterPolicy)
+  // showing no key in [user key of internal_key, iterate_upper_bound).
+  bool RangeMayMatch(const Slice& internal_key, const ReadOptions& read_options,
+                     BlockCacheLookupContext* lookup_context,
+                     bool* filter_checked) const;
+
   // Returns a new iterator over the table contents.
   // The result of NewIterator() is initially invalid (caller must
   // call one of the Seek methods on the iterator before using it).
@@ -187,6 +196,10 @@ class BlockBasedTable : public TableReader {
 
   bool EraseFromCache(const BlockHandle& handle) const;
 
+  // Counts a user read accessing the filter and index, for adaptive pinning
+  // (see MetadataPinningManager)
+  void RecordMetadataAccess() const;
+
   bool TEST_BlockInCache(const BlockHandle& handle) const;
 
   // Returns true if the block for the specified key is in cache.
@@ -623,6 +636,8 @@ struct BlockBasedTable::Rep {
   BlockBasedTableOptions::IndexType index_type;
   bool whole_key_filtering;
   bool prefix_filtering;
+  // Whether the filter can answer RangeMayMatch queries
+  bool range_filtering = false;
   std::shared_ptr<const SliceTransform> table_prefix_extractor;
 
   std::shared_ptr<FragmentedRangeTombstoneList> fragmented_range_dels;
@@ -688,6 +703,12 @@ struct BlockBasedTable::Rep {
   std::unique_ptr<CacheReservationManager::CacheReservationHandle>
       table_reader_cache_res_handle = nullptr;
 
+  // For BlockBasedTableOptions::adaptive_metadata_pinning_budget, the manager
+  // this table is registered with (if any) and its count of accesses to the
+  // filter and index
+  std::shared_ptr<MetadataPinningManager> metadata_pinning_manager;
+  RelaxedAtomic<uint64_t> metadata_accesses{0};
+
   SequenceNumber get_global_seqno(BlockType block_type) const {
     return (block_type == BlockType::kFilterPartitionIndex ||
             block_type == BlockType::kCompressionDictionary)
@@ -364,6 +364,7 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::MultiGet)
     assert(false);
     CO_RETURN;  // Nothing to do
   }
+  RecordMetadataAccess();
 
   FilterBlockReader* const filter =
       !skip_filters ? rep_->filter.get() : nullptr;
@@ -728,6 +729,10 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::MultiGet)
           value_pinner = nullptr;
         }
 
+        // Values recorded for the row cache must not depend on the projection.
+        biter->SetWideColumnProjection(
+            get_context->HasReplayLog() ? nullptr
+                                        : read_options.wide_column_projection);
         bool may_exist = biter->SeekForGet(key);
         if (!may_exist) {
           // HashSeek cannot find the key this block and the the iter is not
@@ -747,9 +752,11 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::MultiGet)
             break;
           }
           Status read_status;
+          // Assembled values are backed by the iterator, not the block.
           bool ret = get_context->SaveValue(
               parsed_key, biter->value(), &matched, &read_status,
-              value_pinner ? value_pinner : nullptr);
+              value_pinner && !biter->IsValueAssembled() ? value_pinner
+                                                         : nullptr);
           if (!read_status.ok()) {
             s = read_status;
             break;
@@ -30,6 +30,12 @@
 //     restarts: uint32[num_restarts]
 //     num_restarts: uint32
 // restarts[i] contains the offset within the block of the ith restart point.
+//
+// Data blocks may additionally store a fixed64 prefix of each restart key
+// after the restart array, flagged in the packed num_restarts footer (see
+// restart_key_prefix.h), their wide-column entities in a column section (see
+// columnar_entity_block.h), as well as a hash index (see
+// data_block_hash_index.h).
 
 #include "table/block_based/block_builder.h"
 
@@ -38,7 +44,9 @@
 
 #include "db/dbformat.h"
 #include "rocksdb/comparator.h"
+#include "table/block_based/columnar_entity_block.h"
 #include "table/block_based/data_block_footer.h"
+#include "table/block_based/restart_key_prefix.h"
 #include "util/coding.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -48,12 +56,15 @@ BlockBuilder::BlockBuilder(
     bool use_value_delta_encoding,
     BlockBasedTableOptions::DataBlockIndexType index_type,
     double data_block_hash_table_util_ratio, size_t ts_sz,
-    bool persist_user_defined_timestamps, bool is_user_key)
+    bool persist_user_defined_timestamps, bool is_user_key,
+    bool use_restart_key_prefixes, bool use_columnar_entities)
     : block_restart_interval_(block_restart_interval),
       use_delta_encoding_(use_delta_encoding),
       use_value_delta_encoding_(use_value_delta_encoding),
       strip_ts_sz_(persist_user_defined_timestamps ? 0 : ts_sz),
       is_user_key_(is_user_key),
+      use_restart_key_prefixes_(use_restart_key_prefixes),
+      use_columnar_entities_(use_columnar_entities),
       restarts_(1, 0),  // First restart point is at offset 0
       counter_(0),
       finished_(false) {
@@ -68,14 +79,24 @@ BlockBuilder::BlockBuilder(
       assert(0);
   }
   assert(block_restart_interval_ >= 1);
-  estimate_ = sizeof(uint32_t) + sizeof(uint32_t);
+  // Restart key prefixes are taken from the user key of internal keys.
+  assert(!use_restart_key_prefixes_ || !is_user_key_);
+  // Entities are recognized by the value type of internal keys.
+  assert(!use_columnar_entities_ ||
+         (!is_user_key_ && !use_value_delta_encoding_));
+  estimate_ = sizeof(uint32_t) + sizeof(uint32_t) +
+              (use_restart_key_prefixes_ ? sizeof(uint64_t) : 0);
 }
 
 void BlockBuilder::Reset() {
   buffer_.clear();
   restarts_.resize(1);  // First restart point is at offset 0
   assert(restarts_[0] == 0);
-  estimate_ = sizeof(uint32_t) + sizeof(uint32_t);
+  restart_key_prefixes_.clear();
+  entity_offsets_.clear();
+  columnar_entity_section_.clear();
+  estimate_ = sizeof(uint32_t) + sizeof(uint32_t) +
+              (use_restart_key_prefixes_ ? sizeof(uint64_t) : 0);
   counter_ = 0;
   finished_ = false;
   last_key_.clear();
@@ -110,6 +131,9 @@ size_t BlockBuilder::EstimateSizeAfterKV(const Slice& key,
 
   if (counter_ >= block_restart_interval_) {
     estimate += sizeof(uint32_t);  // a new restart entry.
+    if (use_restart_key_prefixes_) {
+      estimate += sizeof(uint64_t);  // and its key prefix.
+    }
   }
 
   estimate += sizeof(int32_t);  // varint for shared prefix length.
@@ -123,13 +147,91 @@ size_t BlockBuilder::EstimateSizeAfterKV(const Slice& key,
   return estimate;
 }
 
+bool BlockBuilder::BuildColumnarEntities() {
+  ColumnarEntitySectionBuilder section_builder;
+  std::string rewritten;
+  rewritten.reserve(buffer_.size());
+  std::vector<uint32_t> restarts(restarts_.size());
+  size_t restart_index = 0;
+  // Entries are copied as is, except that entity values are replaced by their
+  // ordinal; restart points move along with the entries.
+  size_t copied = 0;
+  auto translate_restarts = [&](size_t limit) {
+    for (; restart_index < restarts_.size() &&
+           restarts_[restart_index] <= limit;
+         ++restart_index) {
+      restarts[restart_index] = static_cast<uint32_t>(
+          restarts_[restart_index] + rewritten.size() - copied);
+    }
+  };
+  const char* const limit = buffer_.data() + buffer_.size();
+  for (size_t ordinal = 0; ordinal < entity_offsets_.size(); ++ordinal) {
+    const uint32_t offset = entity_offsets_[ordinal];
+    uint32_t shared = 0;
+    uint32_t non_shared = 0;
+    uint32_t value_length = 0;
+    const char* p = buffer_.data() + offset;
+    p = GetVarint32Ptr(p, limit, &shared);
+    p = GetVarint32Ptr(p, limit, &non_shared);
+    p = GetVarint32Ptr(p, limit, &value_length);
+    assert(p != nullptr);
+    const Slice key_delta(p, non_shared);
+    const Slice value(p + non_shared, value_length);
+    if (!section_builder.Add(value)) {
+      return false;
+    }
+    translate_restarts(offset);
+    rewritten.append(buffer_.data() + copied, offset - copied);
+    const uint32_t stub = static_cast<uint32_t>(ordinal);
+    PutVarint32Varint32Varint32(&rewritten, shared, non_shared,
+                                static_cast<uint32_t>(VarintLength(stub)));
+    rewritten.append(key_delta.data(), key_delta.size());
+    PutVarint32(&rewritten, stub);
+    copied = value.data() + value.size() - buffer_.data();
+  }
+  translate_restarts(buffer_.size());
+  rewritten.append(buffer_.data() + copied, buffer_.size() - copied);
+
+  std::string section;
+  section_builder.Finish(&section);
+  const size_t old_estimate = estimate_;
+  estimate_ = estimate_ - buffer_.size() + rewritten.size() + section.size();
+  if (CurrentSizeEstimate() > kMaxBlockSizeSupportedByHashIndex) {
+    estimate_ = old_estimate;
+    return false;
+  }
+  buffer_.swap(rewritten);
+  restarts_.swap(restarts);
+  columnar_entity_section_.swap(section);
+  return true;
+}
+
 Slice BlockBuilder::Finish() {
+  // Like the other flags in the footer, the column section is only possible
+  // for blocks of at most 64KiB.
+  const bool has_columnar_entities =
+      !entity_offsets_.empty() && BuildColumnarEntities();
+
   // Append restart array
   for (size_t i = 0; i < restarts_.size(); i++) {
     PutFixed32(&buffer_, restarts_[i]);
   }
 
   uint32_t num_restarts = static_cast<uint32_t>(restarts_.size());
+  // Like the hash index, the restart key prefixes are flagged in the footer,
+  // which is only interpreted that way for blocks of at most 64KiB.
+  bool has_restart_key_prefixes = false;
+  if (use_restart_key_prefixes_ &&
+      CurrentSizeEstimate() <= kMaxBlockSizeSupportedByHashIndex) {
+    assert(restart_key_prefixes_.size() == num_restarts * sizeof(uint64_t));
+    buffer_.append(restart_key_prefixes_);
+    has_restart_key_prefixes = true;
+  }
+
+  if (has_columnar_entities) {
+    buffer_.append(columnar_entity_section_);
+  }
+
   BlockBasedTableOptions::DataBlockIndexType index_type =
       BlockBasedTableOptions::kDataBlockBinarySearch;
   if (data_block_hash_index_builder_.Valid() &&
@@ -138,8 +240,11 @@ Slice BlockBuilder::Finish() {
     index_type = BlockBasedTableOptions::kDataBlockBinaryAndHash;
   }
 
-  // footer is a packed format of data_block_index_type and num_restarts
-  uint32_t block_footer = PackIndexTypeAndNumRestarts(index_type, num_restarts);
+  // footer is a packed format of data_block_index_type, the restart key
+  // prefixes and columnar entities flags and num_restarts
+  uint32_t block_footer = PackIndexTypeAndNumRestarts(
+      index_type, num_restarts, has_restart_key_prefixes,
+      has_columnar_entities);
 
   PutFixed32(&buffer_, block_footer);
   finished_ = true;
@@ -205,7 +310,8 @@ inline void BlockBuilder::AddWithLastKeyImpl(const Slice& key,
   if (counter_ >= block_restart_interval_) {
     // Restart compression
     restarts_.push_back(static_cast<uint32_t>(buffer_size));
-    estimate_ += sizeof(uint32_t);
+    estimate_ += sizeof(uint32_t) +
+                 (use_restart_key_prefixes_ ? sizeof(uint64_t) : 0);
     counter_ = 0;
   } else if (use_delta_encoding_) {
     // See how much sharing to do with previous string
@@ -214,6 +320,16 @@ inline void BlockBuilder::AddWithLastKeyImpl(const Slice& key,
 
   const size_t non_shared = key_to_persist.size() - shared;
 
+  if (use_columnar_entities_ &&
+      ExtractValueType(key) == kTypeWideColumnEntity) {
+    entity_offsets_.push_back(static_cast<uint32_t>(buffer_size));
+  }
+
+  if (use_restart_key_prefixes_ && counter_ == 0) {
+    PutFixed64(&restart_key_prefixes_,
+               RestartKeyPrefix(ExtractUserKey(key_to_persist)));
+  }
+
   if (use_value_delta_encoding_) {
     // Add "<shared><non_shared>" to buffer_
     PutVarint32Varint32(&buffer_, static_cast<uint32_t>(shared),
@@ -31,7 +31,9 @@ class BlockBuilder {
                         double data_block_hash_table_util_ratio = 0.75,
                         size_t ts_sz = 0,
                         bool persist_user_defined_timestamps = true,
-                        bool is_user_key = false);
+                        bool is_user_key = false,
+                        bool use_restart_key_prefixes = false,
+                        bool use_columnar_entities = false);
 
   // Reset the contents as if the BlockBuilder was just constructed.
   void Reset();
@@ -89,6 +91,10 @@ class BlockBuilder {
   inline const Slice MaybeStripTimestampFromKey(std::string* key_buf,
                                                 const Slice& key);
 
+  // Moves the wide-column entities of the block into a column section if the
+  // block still qualifies for footer flags afterwards. Returns whether it did.
+  bool BuildColumnarEntities();
+
   const int block_restart_interval_;
   // TODO(myabandeh): put it into a separate IndexBlockBuilder
   const bool use_delta_encoding_;
@@ -112,9 +118,18 @@ class BlockBuilder {
   // index block for partitioned index blocks. In summary, this only applies to
   // block whose key are real user keys or internal keys created from user keys.
   const bool is_user_key_;
+  // Whether to store the restart key prefixes (see restart_key_prefix.h).
+  // Only for data blocks with keys ordered bytewise on their user key.
+  const bool use_restart_key_prefixes_;
+  // Whether to store wide-column entities in a column section (see
+  // columnar_entity_block.h). Only for data blocks.
+  const bool use_columnar_entities_;
 
   std::string buffer_;              // Destination buffer
   std::vector<uint32_t> restarts_;  // Restart points
+  std::string restart_key_prefixes_;  // fixed64 prefix per restart point
+  std::vector<uint32_t> entity_offsets_;  // Entries holding entities
+  std::string columnar_entity_section_;
   size_t estimate_;
   int counter_;    // Number of entries emitted since restart
   bool finished_;  // Has Finish() been called?
@@ -17,6 +17,7 @@
 #include "db/db_test_util.h"
 #include "db/dbformat.h"
 #include "db/memtable.h"
+#include "db/wide/wide_column_serialization.h"
 #include "db/write_batch_internal.h"
 #include "rocksdb/db.h"
 #include "rocksdb/env.h"
@@ -286,6 +287,255 @@ TEST_P(BlockTest, IndexHashWithSharedPrefix) {
                      shouldPersistUDT());
 }
 
+TEST_P(BlockTest, RestartKeyPrefixes) {
+  if (isUDTEnabled()) {
+    ROCKSDB_GTEST_SKIP("Restart key prefixes require no timestamps");
+    return;
+  }
+  Random rnd(303);
+  // Short keys exercise the zero padding of prefixes and the small alphabet
+  // makes many restart keys share their 8 byte prefix.
+  auto random_user_key = [&rnd]() {
+    static const char kAlphabet[] = {'\0', 'a', 'b', '\xff'};
+    std::string k(rnd.Uniform(13), '\0');
+    for (auto &c : k) {
+      c = kAlphabet[rnd.Uniform(4)];
+    }
+    return k;
+  };
+  std::set<std::string> user_keys;
+  while (user_keys.size() < 400) {
+    user_keys.insert(random_user_key());
+  }
+
+  for (int restart_interval : {1, 4, 16}) {
+    BlockBuilder plain_builder(
+        restart_interval, keyUseDeltaEncoding(),
+        false /* use_value_delta_encoding */, dataBlockIndexType());
+    BlockBuilder prefix_builder(
+        restart_interval, keyUseDeltaEncoding(),
+        false /* use_value_delta_encoding */, dataBlockIndexType(),
+        0.75 /* data_block_hash_table_util_ratio */, 0 /* ts_sz */,
+        true /* persist_user_defined_timestamps */, false /* is_user_key */,
+        true /* use_restart_key_prefixes */);
+    for (const auto &user_key : user_keys) {
+      std::string key = user_key;
+      AppendInternalKeyFooter(&key, 0 /* seqno */, kTypeValue);
+      plain_builder.Add(key, user_key);
+      prefix_builder.Add(key, user_key);
+    }
+    const uint32_t num_restarts = static_cast<uint32_t>(
+        (user_keys.size() + restart_interval - 1) / restart_interval);
+    ASSERT_EQ(prefix_builder.CurrentSizeEstimate(),
+              plain_builder.CurrentSizeEstimate() +
+                  num_restarts * sizeof(uint64_t));
+    Block plain_block(BlockContents(plain_builder.Finish()));
+    Block prefix_block(BlockContents(prefix_builder.Finish()));
+    ASSERT_FALSE(plain_block.HasRestartKeyPrefixes());
+    ASSERT_TRUE(prefix_block.HasRestartKeyPrefixes());
+    ASSERT_EQ(prefix_block.NumRestarts(), num_restarts);
+    // Blocks with too many restarts fall back to binary search
+    ASSERT_EQ(prefix_block.IndexType(),
+              num_restarts > kMaxRestartSupportedByHashIndex
+                  ? BlockBasedTableOptions::kDataBlockBinarySearch
+                  : dataBlockIndexType());
+    ASSERT_EQ(prefix_block.size(),
+              plain_block.size() + num_restarts * sizeof(uint64_t));
+
+    std::unique_ptr<DataBlockIter> plain_iter(plain_block.NewDataIterator(
+        BytewiseComparator(), kDisableGlobalSequenceNumber));
+    std::unique_ptr<DataBlockIter> prefix_iter(prefix_block.NewDataIterator(
+        BytewiseComparator(), kDisableGlobalSequenceNumber));
+
+    size_t count = 0;
+    for (prefix_iter->SeekToFirst(); prefix_iter->Valid();
+         prefix_iter->Next()) {
+      ++count;
+    }
+    ASSERT_OK(prefix_iter->status());
+    ASSERT_EQ(count, user_keys.size());
+
+    std::vector<std::string> targets(user_keys.begin(), user_keys.end());
+    for (int i = 0; i < 1000; ++i) {
+      targets.push_back(random_user_key());
+    }
+    for (const auto &target : targets) {
+      std::string seek_key = target;
+      AppendInternalKeyFooter(&seek_key, kMaxSequenceNumber,
+                              kValueTypeForSeek);
+      plain_iter->Seek(seek_key);
+      prefix_iter->Seek(seek_key);
+      ASSERT_OK(prefix_iter->status());
+      ASSERT_EQ(plain_iter->Valid(), prefix_iter->Valid());
+      if (plain_iter->Valid()) {
+        ASSERT_EQ(plain_iter->key(), prefix_iter->key());
+      }
+
+      plain_iter->SeekForPrev(seek_key);
+      prefix_iter->SeekForPrev(seek_key);
+      ASSERT_OK(prefix_iter->status());
+      ASSERT_EQ(plain_iter->Valid(), prefix_iter->Valid());
+      if (plain_iter->Valid()) {
+        ASSERT_EQ(plain_iter->key(), prefix_iter->key());
+      }
+    }
+  }
+}
+
+TEST_P(BlockTest, RestartKeyPrefixesLargeBlock) {
+  if (isUDTEnabled()) {
+    ROCKSDB_GTEST_SKIP("Restart key prefixes require no timestamps");
+    return;
+  }
+  // Blocks over 64KiB fall back to plain binary search
+  BlockBuilder builder(
+      4 /* block_restart_interval */, keyUseDeltaEncoding(),
+      false /* use_value_delta_encoding */, dataBlockIndexType(),
+      0.75 /* data_block_hash_table_util_ratio */, 0 /* ts_sz */,
+      true /* persist_user_defined_timestamps */, false /* is_user_key */,
+      true /* use_restart_key_prefixes */);
+  const std::string value(kMaxBlockSizeSupportedByHashIndex, 'v');
+  std::vector<std::string> keys;
+  for (int i = 0; i < 10; ++i) {
+    keys.push_back("key" + std::to_string(i));
+    std::string key = keys.back();
+    AppendInternalKeyFooter(&key, 0 /* seqno */, kTypeValue);
+    builder.Add(key, i == 5 ? Slice(value) : Slice("small"));
+  }
+  Block block(BlockContents(builder.Finish()));
+  ASSERT_FALSE(block.HasRestartKeyPrefixes());
+  std::unique_ptr<DataBlockIter> iter(block.NewDataIterator(
+      BytewiseComparator(), kDisableGlobalSequenceNumber));
+  for (const auto &user_key : keys) {
+    std::string seek_key = user_key;
+    AppendInternalKeyFooter(&seek_key, kMaxSequenceNumber, kValueTypeForSeek);
+    iter->Seek(seek_key);
+    ASSERT_OK(iter->status());
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(ExtractUserKey(iter->key()), user_key);
+  }
+
+  // And the option is rejected with a larger block_size
+  BlockBasedTableOptions table_options;
+  table_options.data_block_restart_key_prefixes = true;
+  table_options.block_size = kMaxBlockSizeSupportedByHashIndex;
+  std::unique_ptr<TableFactory> factory(
+      NewBlockBasedTableFactory(table_options));
+  ASSERT_OK(factory->ValidateOptions(DBOptions(), ColumnFamilyOptions()));
+  table_options.block_size = kMaxBlockSizeSupportedByHashIndex + 1;
+  factory.reset(NewBlockBasedTableFactory(table_options));
+  ASSERT_TRUE(factory->ValidateOptions(DBOptions(), ColumnFamilyOptions())
+                  .IsInvalidArgument());
+}
+
+TEST_P(BlockTest, ColumnarEntities) {
+  if (isUDTEnabled()) {
+    ROCKSDB_GTEST_SKIP("Test only uses keys without timestamps");
+    return;
+  }
+  Random rnd(301);
+  for (int payload_size : {100, 2000}) {
+    // Every other key is an entity, some of them without a default column or
+    // any column at all.
+    std::vector<std::string> keys;
+    std::vector<std::string> values;
+    for (int i = 0; i < 100; ++i) {
+      std::string key = "key" + std::to_string(1000 + i);
+      std::string value;
+      if (i % 2 == 0) {
+        WideColumns columns;
+        const std::string default_value = rnd.RandomString(8);
+        const std::string meta = rnd.RandomString(i % 16);
+        const std::string payload = rnd.RandomString(payload_size);
+        if (i % 6 != 0) {
+          columns.emplace_back(kDefaultWideColumnName, default_value);
+        }
+        if (i % 10 != 0) {
+          columns.emplace_back("meta", meta);
+          columns.emplace_back("payload", payload);
+        }
+        ASSERT_OK(WideColumnSerialization::Serialize(columns, value));
+        AppendInternalKeyFooter(&key, 0 /* seqno */, kTypeWideColumnEntity);
+      } else {
+        value = rnd.RandomString(16);
+        AppendInternalKeyFooter(&key, 0 /* seqno */, kTypeValue);
+      }
+      keys.push_back(std::move(key));
+      values.push_back(std::move(value));
+    }
+
+    BlockBuilder builder(
+        4 /* block_restart_interval */, keyUseDeltaEncoding(),
+        false /* use_value_delta_encoding */, dataBlockIndexType(),
+        0.75 /* data_block_hash_table_util_ratio */, 0 /* ts_sz */,
+        true /* persist_user_defined_timestamps */, false /* is_user_key */,
+        false /* use_restart_key_prefixes */, true /* use_columnar_entities */);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      builder.Add(keys[i], values[i]);
+    }
+    // On the heap, as ApproximateMemoryUsage() expects
+    auto block = std::make_unique<Block>(BlockContents(builder.Finish()));
+    // Blocks over 64KiB stay row-oriented.
+    const bool columnar = payload_size == 100;
+    ASSERT_EQ(block->HasColumnarEntities(), columnar);
+    ASSERT_EQ(block->IndexType(),
+              columnar ? dataBlockIndexType()
+                       : BlockBasedTableOptions::kDataBlockBinarySearch);
+    block->InitializeDataBlockProtectionInfo(8 /* protection_bytes_per_key */,
+                                             BytewiseComparator());
+    ASSERT_GT(block->size(), 0);
+
+    // Reading entities does not grow the block, whose cache charge is fixed
+    const size_t block_usage = block->ApproximateMemoryUsage();
+    std::unique_ptr<DataBlockIter> iter(block->NewDataIterator(
+        BytewiseComparator(), kDisableGlobalSequenceNumber));
+    size_t i = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++i) {
+      ASSERT_EQ(iter->key(), keys[i]);
+      ASSERT_EQ(iter->value(), values[i]);
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(i, keys.size());
+    for (iter->SeekToLast(); iter->Valid(); iter->Prev()) {
+      --i;
+      ASSERT_EQ(iter->key(), keys[i]);
+      ASSERT_EQ(iter->value(), values[i]);
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(i, 0);
+    ASSERT_EQ(block->ApproximateMemoryUsage(), block_usage);
+
+    // Projections only apply to the column section and always include the
+    // default column.
+    const std::vector<Slice> projection{"meta", "missing"};
+    iter->SetWideColumnProjection(&projection);
+    for (i = 0; i < keys.size(); ++i) {
+      iter->Seek(keys[i]);
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(iter->key(), keys[i]);
+      const bool is_entity = i % 2 == 0;
+      ASSERT_EQ(iter->IsValueAssembled(), columnar && is_entity);
+      if (!iter->IsValueAssembled()) {
+        ASSERT_EQ(iter->value(), values[i]);
+        continue;
+      }
+      Slice full = values[i];
+      WideColumns expected;
+      ASSERT_OK(WideColumnSerialization::Deserialize(full, expected));
+      expected.erase(std::remove_if(expected.begin(), expected.end(),
+                                    [](const WideColumn &column) {
+                                      return column.name() == "payload";
+                                    }),
+                     expected.end());
+      Slice projected = iter->value();
+      WideColumns actual;
+      ASSERT_OK(WideColumnSerialization::Deserialize(projected, actual));
+      ASSERT_EQ(actual, expected);
+    }
+    ASSERT_OK(iter->status());
+  }
+}
+
 // Param 0: key use delta encoding
 // Param 1: user-defined timestamp test mode
 // Param 2: data block index type. User-defined timestamp feature is not
@@ -0,0 +1,186 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "table/block_based/columnar_entity_block.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "db/wide/wide_column_serialization.h"
+#include "util/coding.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+bool ColumnarEntitySectionBuilder::Add(const Slice& entity) {
+  Slice input = entity;
+  WideColumns columns;
+  if (!WideColumnSerialization::Deserialize(input, columns).ok()) {
+    return false;
+  }
+  entities_.emplace_back(std::move(columns));
+  return true;
+}
+
+void ColumnarEntitySectionBuilder::Finish(std::string* output) const {
+  const size_t start = output->size();
+  const uint32_t num_entities = static_cast<uint32_t>(entities_.size());
+
+  std::vector<Slice> names;
+  for (const auto& columns : entities_) {
+    for (const auto& column : columns) {
+      names.push_back(column.name());
+    }
+  }
+  std::sort(names.begin(), names.end(),
+            [](const Slice& lhs, const Slice& rhs) {
+              return lhs.compare(rhs) < 0;
+            });
+  names.erase(std::unique(names.begin(), names.end()), names.end());
+
+  // The columns of each entity are sorted by name, so they can be consumed
+  // in order while going through the names.
+  std::vector<size_t> next_column(num_entities, 0);
+  std::vector<std::string> presence(names.size());
+  std::vector<std::vector<uint32_t>> offsets(names.size());
+  for (size_t c = 0; c < names.size(); ++c) {
+    presence[c].assign((num_entities + 7) / 8, '\0');
+    offsets[c].reserve(num_entities + 1);
+    for (uint32_t e = 0; e < num_entities; ++e) {
+      offsets[c].push_back(static_cast<uint32_t>(output->size() - start));
+      const WideColumns& columns = entities_[e];
+      if (next_column[e] < columns.size() &&
+          columns[next_column[e]].name() == names[c]) {
+        const Slice& value = columns[next_column[e]].value();
+        output->append(value.data(), value.size());
+        presence[c][e / 8] |= static_cast<char>(1 << (e % 8));
+        ++next_column[e];
+      }
+    }
+    offsets[c].push_back(static_cast<uint32_t>(output->size() - start));
+  }
+
+  const uint32_t directory_offset =
+      static_cast<uint32_t>(output->size() - start);
+  PutVarint32(output, num_entities);
+  PutVarint32(output, static_cast<uint32_t>(names.size()));
+  for (size_t c = 0; c < names.size(); ++c) {
+    PutLengthPrefixedSlice(output, names[c]);
+    output->append(presence[c]);
+    for (uint32_t offset : offsets[c]) {
+      PutFixed32(output, offset);
+    }
+  }
+  PutFixed32(output, directory_offset);
+  PutFixed32(output, static_cast<uint32_t>(output->size() + sizeof(uint32_t) -
+                                           start));
+}
+
+Status ColumnarEntitySection::Create(
+    const Slice& contents, uint32_t* section_size,
+    std::unique_ptr<ColumnarEntitySection>* section) {
+  constexpr uint32_t kTrailerSize = 2 * sizeof(uint32_t);
+  if (contents.size() < kTrailerSize) {
+    return Status::Corruption("Truncated columnar entity section");
+  }
+  const uint32_t size =
+      DecodeFixed32(contents.data() + contents.size() - sizeof(uint32_t));
+  if (size < kTrailerSize || size > contents.size()) {
+    return Status::Corruption("Bad columnar entity section size");
+  }
+  const char* const base = contents.data() + contents.size() - size;
+  const uint32_t directory_offset = DecodeFixed32(base + size - kTrailerSize);
+  if (directory_offset > size - kTrailerSize) {
+    return Status::Corruption("Bad columnar entity directory offset");
+  }
+
+  std::unique_ptr<ColumnarEntitySection> result(new ColumnarEntitySection());
+  result->contents_ = Slice(base, size);
+  Slice input(base + directory_offset,
+              size - kTrailerSize - directory_offset);
+  uint32_t num_columns = 0;
+  if (!GetVarint32(&input, &result->num_entities_) ||
+      !GetVarint32(&input, &num_columns)) {
+    return Status::Corruption("Bad columnar entity directory");
+  }
+  // Every entity has an entry referencing it in the block.
+  if (result->num_entities_ > contents.size()) {
+    return Status::Corruption("Bad columnar entity count");
+  }
+  const size_t presence_size = (size_t{result->num_entities_} + 7) / 8;
+  const size_t offsets_size =
+      (size_t{result->num_entities_} + 1) * sizeof(uint32_t);
+  for (uint32_t c = 0; c < num_columns; ++c) {
+    Column column;
+    if (!GetLengthPrefixedSlice(&input, &column.name) ||
+        input.size() < presence_size + offsets_size) {
+      return Status::Corruption("Truncated columnar entity directory");
+    }
+    if (c > 0 && result->columns_.back().name.compare(column.name) >= 0) {
+      return Status::Corruption("Columnar entity columns out of order");
+    }
+    column.presence = input.data();
+    column.offsets = input.data() + presence_size;
+    uint32_t prev = 0;
+    for (uint32_t e = 0; e <= result->num_entities_; ++e) {
+      const uint32_t offset = DecodeFixed32(column.offsets + e * 4);
+      if (offset < prev || offset > directory_offset) {
+        return Status::Corruption("Bad columnar entity value offset");
+      }
+      prev = offset;
+    }
+    input.remove_prefix(presence_size + offsets_size);
+    result->columns_.push_back(column);
+  }
+  *section_size = size;
+  *section = std::move(result);
+  return Status::OK();
+}
+
+void ColumnarEntitySection::AppendColumn(const Column& column,
+                                         uint32_t ordinal,
+                                         WideColumns* columns) const {
+  if ((column.presence[ordinal / 8] & (1 << (ordinal % 8))) == 0) {
+    return;
+  }
+  const uint32_t begin = DecodeFixed32(column.offsets + ordinal * 4);
+  const uint32_t end = DecodeFixed32(column.offsets + (ordinal + 1) * 4);
+  columns->emplace_back(column.name,
+                        Slice(contents_.data() + begin, end - begin));
+}
+
+Status ColumnarEntitySection::GetEntity(uint32_t ordinal,
+                                        std::string* output) const {
+  if (ordinal >= num_entities_) {
+    return Status::Corruption("Bad columnar entity ordinal");
+  }
+  WideColumns columns;
+  for (const auto& column : columns_) {
+    AppendColumn(column, ordinal, &columns);
+  }
+  return WideColumnSerialization::Serialize(columns, *output);
+}
+
+Status ColumnarEntitySection::GetProjectedEntity(
+    uint32_t ordinal, const std::vector<Slice>& projection,
+    std::string* output) const {
+  if (ordinal >= num_entities_) {
+    return Status::Corruption("Bad columnar entity ordinal");
+  }
+  WideColumns columns;
+  for (const auto& column : columns_) {
+    if (column.name == kDefaultWideColumnName ||
+        std::find(projection.begin(), projection.end(), column.name) !=
+            projection.end()) {
+      AppendColumn(column, ordinal, &columns);
+    }
+  }
+  return WideColumnSerialization::Serialize(columns, *output);
+}
+
+size_t ColumnarEntitySection::ApproximateMemoryUsage() const {
+  return sizeof(ColumnarEntitySection) + columns_.capacity() * sizeof(Column);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
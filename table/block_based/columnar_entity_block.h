@@ -0,0 +1,102 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rocksdb/slice.h"
+#include "rocksdb/status.h"
+#include "rocksdb/wide_columns.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Data blocks built with `BlockBasedTableOptions::data_block_columnar_entities`
+// store the wide-column entities of the block column by column (PAX style) in
+// a section that sits between the restart key prefixes (if any) and the hash
+// index (if any):
+//
+//   [entries][restarts][prefixes][column section][hash index][footer]
+//
+// The value of each kTypeWideColumnEntity entry is then replaced by the
+// ordinal of the entity within the block (varint32). The column section has
+// the form:
+//
+//   values:            the values of the first column (in column name
+//                      order) for all entities having it, followed by those
+//                      of the second column etc.
+//   num_entities:      varint32
+//   num_columns:       varint32
+//   columns:           num_columns * (name: length prefixed slice,
+//                      presence: char[ceil(num_entities / 8)] bitmap,
+//                      offsets: fixed32[num_entities + 1])
+//   directory_offset:  fixed32, offset of num_entities
+//   section_size:      fixed32
+//
+// Offsets are relative to the start of the section; the value of column c
+// for entity e spans [offsets[e], offsets[e + 1]) if the presence bit of e
+// is set. Reading a subset of the columns of an entity thus only touches
+// those columns' values, which is what makes projections cheap when small
+// columns sit next to large ones.
+class ColumnarEntitySectionBuilder {
+ public:
+  // Adds the next entity of the block, in serialized form. The slices must
+  // remain valid until Finish(). Returns false if the entity cannot be
+  // decoded, in which case the block should stay row-oriented.
+  bool Add(const Slice& entity);
+
+  size_t num_entities() const { return entities_.size(); }
+
+  // Appends the column section to `output`.
+  void Finish(std::string* output) const;
+
+  void Reset() { entities_.clear(); }
+
+ private:
+  std::vector<WideColumns> entities_;
+};
+
+// The parsed column section of a data block. Owned by the Block.
+class ColumnarEntitySection {
+ public:
+  // Parses the column section at the end of `contents`, returning its size
+  // in `section_size`.
+  static Status Create(const Slice& contents, uint32_t* section_size,
+                       std::unique_ptr<ColumnarEntitySection>* section);
+
+  uint32_t num_entities() const { return num_entities_; }
+
+  // Serializes into `output` all columns of entity `ordinal`.
+  Status GetEntity(uint32_t ordinal, std::string* output) const;
+
+  // Serializes into `output` the columns of entity `ordinal` named in
+  // `projection`, as well as the default column if present.
+  Status GetProjectedEntity(uint32_t ordinal,
+                            const std::vector<Slice>& projection,
+                            std::string* output) const;
+
+  size_t ApproximateMemoryUsage() const;
+
+ private:
+  struct Column {
+    Slice name;
+    const char* presence;
+    const char* offsets;
+  };
+
+  ColumnarEntitySection() = default;
+
+  void AppendColumn(const Column& column, uint32_t ordinal,
+                    WideColumns* columns) const;
+
+  Slice contents_;
+  uint32_t num_entities_ = 0;
+  std::vector<Column> columns_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -13,13 +13,21 @@
 
 namespace ROCKSDB_NAMESPACE {
 
+// The footer of a block is a uint32 packing num_restarts in the low bits with
+// flags in the high bits: the MSB is set for kDataBlockBinaryAndHash, the
+// next bit is set if the block carries restart key prefixes and the one after
+// that if it carries a columnar entity section (see columnar_entity_block.h).
+// The flags are only meaningful for blocks of at most
+// kMaxBlockSizeSupportedByHashIndex bytes.
 uint32_t PackIndexTypeAndNumRestarts(
     BlockBasedTableOptions::DataBlockIndexType index_type,
-    uint32_t num_restarts);
+    uint32_t num_restarts, bool has_restart_key_prefixes = false,
+    bool has_columnar_entities = false);
 
 void UnPackIndexTypeAndNumRestarts(
     uint32_t block_footer,
     BlockBasedTableOptions::DataBlockIndexType* index_type,
-    uint32_t* num_restarts);
+    uint32_t* num_restarts, bool* has_restart_key_prefixes = nullptr,
+    bool* has_columnar_entities = nullptr);
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -174,6 +174,20 @@ class FilterBlockReader {
     }
   }
 
+  /**
+   * Returns false only if no user key (without timestamp) k with
+   * lower <= k < upper in bytewise order was added to the filter, which only
+   * range filters (see NewRangeFilterPolicy) can tell. As with KeyMayMatch,
+   * const_ikey_ptr is the InternalKey for lower.
+   */
+  virtual bool RangeMayMatch(const Slice& /*lower*/, const Slice& /*upper*/,
+                             const Slice* const /*const_ikey_ptr*/,
+                             GetContext* /*get_context*/,
+                             BlockCacheLookupContext* /*lookup_context*/,
+                             const ReadOptions& /*read_options*/) {
+    return true;
+  }
+
   virtual size_t ApproximateMemoryUsage() const = 0;
 
   // convert this object to a human readable form
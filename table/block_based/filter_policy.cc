@@ -9,6 +9,7 @@
 
 #include "rocksdb/filter_policy.h"
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <climits>
@@ -1367,6 +1368,337 @@ class AlwaysFalseFilter : public BuiltinFilterBitsReader {
   using FilterBitsReader::MayMatch;  // inherit overload
   bool HashMayMatch(const uint64_t) override { return false; }
   using BuiltinFilterBitsReader::HashMayMatch;  // inherit overload
+  bool RangeMayMatch(const Slice&, const Slice&) override { return false; }
+};
+
+// ####################### Range filter implementation ################### //
+
+// A range filter embeds a point filter and adds a "range index": for each
+// key added (in sorted order), the shortest prefix telling it apart from the
+// previous and next keys, plus kRangeSuffixBytes more, optionally capped at
+// max_key_prefix_len. These are the leaves of a SuRF-Real truncated trie,
+// stored front-coded with restart points rather than as a succinct trie.
+// Data layout:
+//
+//             0 +-----------------------------------+
+//               | Point filter (built-in, with its  |
+//               |   own metadata)                   |
+//     point_len +-----------------------------------+
+//               | Prefixes, each as varint32 shared |
+//               |   bytes, varint32 non-shared      |
+//               |   bytes, non-shared bytes         |
+//               +-----------------------------------+
+//               | fixed32 offset of every           |
+//               |   kRangeRestartInterval-th prefix |
+//               +-----------------------------------+
+//               | fixed32 number of restart points  |
+//           len +-----------------------------------+
+//               | byte -3 marker                    |
+//               | fixed32 point_len                 |
+// len_with_meta +-----------------------------------+
+//
+// A stored prefix p of key k rules out a range [lower, upper) in two ways:
+// if p sorts before lower without being a prefix of lower, then so does k;
+// and if p is not less than upper, then neither is k.
+constexpr uint32_t kRangeRestartInterval = 16;
+// Key bytes kept past the distinguishing prefix, which rule out ranges
+// sharing that prefix with a key but not the next byte
+constexpr size_t kRangeSuffixBytes = 1;
+// For estimating filter sizes
+constexpr size_t kRangeEstimatedBytesPerKey = 4;
+
+class RangeFilterBitsBuilder : public BuiltinFilterBitsBuilder {
+ public:
+  RangeFilterBitsBuilder(BuiltinFilterBitsBuilder* point_builder,
+                         size_t max_key_prefix_len)
+      : point_builder_(point_builder),
+        max_key_prefix_len_(max_key_prefix_len) {}
+
+  // No Copy allowed
+  RangeFilterBitsBuilder(const RangeFilterBitsBuilder&) = delete;
+  void operator=(const RangeFilterBitsBuilder&) = delete;
+
+  ~RangeFilterBitsBuilder() override = default;
+
+  void AddKey(const Slice& key) override {
+    point_builder_->AddKey(key);
+    AddToRangeIndex(key);
+  }
+
+  void AddKeyAndAlt(const Slice& key, const Slice& alt) override {
+    point_builder_->AddKeyAndAlt(key, alt);
+    // Prefixes of keys are redundant in the range index
+    AddToRangeIndex(key);
+  }
+
+  size_t EstimateEntriesAdded() override {
+    return point_builder_->EstimateEntriesAdded();
+  }
+
+  using FilterBitsBuilder::Finish;
+
+  Slice Finish(std::unique_ptr<const char[]>* buf) override {
+    return Finish(buf, nullptr);
+  }
+
+  Slice Finish(std::unique_ptr<const char[]>* buf, Status* status) override {
+    if (have_prev_key_) {
+      AddPrefixOfPrevKey(prev_lcp_);
+    }
+    std::unique_ptr<const char[]> point_buf;
+    Status s;
+    Slice point = point_builder_->Finish(&point_buf, &s);
+    if (status) {
+      *status = s;
+    }
+    if (!s.ok() || point.size() <= kMetadataLen) {
+      // Corrupt or no entries, either way nothing to add
+      ResetRangeIndex();
+      *buf = std::move(point_buf);
+      return point;
+    }
+
+    for (uint32_t restart : restarts_) {
+      PutFixed32(&range_index_, restart);
+    }
+    PutFixed32(&range_index_, static_cast<uint32_t>(restarts_.size()));
+
+    size_t len_with_metadata =
+        point.size() + range_index_.size() + kMetadataLen;
+    // Max size supported by implementation
+    assert(len_with_metadata <= 0xffffffffU);
+    std::unique_ptr<char[]> mutable_buf(new char[len_with_metadata]);
+    memcpy(mutable_buf.get(), point.data(), point.size());
+    memcpy(mutable_buf.get() + point.size(), range_index_.data(),
+           range_index_.size());
+    char* metadata = mutable_buf.get() + len_with_metadata - kMetadataLen;
+    // See BuiltinFilterPolicy::GetRangeBitsReader re: metadata
+    // -3 = Marker for range filter implementations
+    metadata[0] = static_cast<char>(-3);
+    EncodeFixed32(metadata + 1, static_cast<uint32_t>(point.size()));
+    ResetRangeIndex();
+
+    Slice rv(mutable_buf.get(), len_with_metadata);
+    *buf = std::move(mutable_buf);
+    return rv;
+  }
+
+  Status MaybePostVerify(const Slice& filter_content) override {
+    Slice point = filter_content;
+    size_t len = filter_content.size() - kMetadataLen;
+    if (filter_content.size() > kMetadataLen &&
+        filter_content[len] == static_cast<char>(-3)) {
+      uint32_t point_len = DecodeFixed32(filter_content.data() + len + 1);
+      if (point_len > len) {
+        return Status::Corruption("Corrupted filter content");
+      }
+      point.remove_suffix(filter_content.size() - point_len);
+    }
+    return point_builder_->MaybePostVerify(point);
+  }
+
+  size_t ApproximateNumEntries(size_t bytes) override {
+    uint64_t n = point_builder_->ApproximateNumEntries(bytes);
+    if (n == 0) {
+      return 0;
+    }
+    // Leave room for the range index
+    return static_cast<size_t>(n * bytes /
+                               (bytes + n * kRangeEstimatedBytesPerKey));
+  }
+
+  size_t CalculateSpace(size_t num_entries) override {
+    return point_builder_->CalculateSpace(num_entries) +
+           num_entries * kRangeEstimatedBytesPerKey +
+           (num_entries / kRangeRestartInterval + 2) * sizeof(uint32_t) +
+           kMetadataLen;
+  }
+
+  double EstimatedFpRate(size_t num_entries, size_t /*bytes*/) override {
+    // For point queries
+    return point_builder_->EstimatedFpRate(
+        num_entries, point_builder_->CalculateSpace(num_entries));
+  }
+
+ private:
+  void AddToRangeIndex(Slice key) {
+    if (max_key_prefix_len_ > 0 && key.size() > max_key_prefix_len_) {
+      key.remove_suffix(key.size() - max_key_prefix_len_);
+    }
+    size_t lcp = 0;
+    if (have_prev_key_) {
+      if (key.compare(prev_key_) <= 0) {
+        // A duplicate, or out of bytewise order. The latter happens with
+        // non-bytewise comparators, under which the range index is not used,
+        // and for the prefixes PartitionedFilterBlockBuilder adds at the end
+        // of a partition for prefix seek.
+        return;
+      }
+      lcp = key.difference_offset(prev_key_);
+      AddPrefixOfPrevKey(std::max(prev_lcp_, lcp));
+    }
+    prev_key_.assign(key.data(), key.size());
+    prev_lcp_ = lcp;
+    have_prev_key_ = true;
+  }
+
+  // Adds the prefix of prev_key_ telling it apart from keys sharing `lcp`
+  // leading bytes with it
+  void AddPrefixOfPrevKey(size_t lcp) {
+    Slice prefix(prev_key_.data(),
+                 std::min(prev_key_.size(), lcp + 1 + kRangeSuffixBytes));
+    size_t shared = 0;
+    if (num_prefixes_ % kRangeRestartInterval == 0) {
+      restarts_.push_back(static_cast<uint32_t>(range_index_.size()));
+    } else {
+      shared = prefix.difference_offset(last_prefix_);
+    }
+    PutVarint32Varint32(&range_index_, static_cast<uint32_t>(shared),
+                        static_cast<uint32_t>(prefix.size() - shared));
+    range_index_.append(prefix.data() + shared, prefix.size() - shared);
+    last_prefix_.assign(prefix.data(), prefix.size());
+    ++num_prefixes_;
+  }
+
+  void ResetRangeIndex() {
+    have_prev_key_ = false;
+    prev_key_.clear();
+    prev_lcp_ = 0;
+    last_prefix_.clear();
+    range_index_.clear();
+    restarts_.clear();
+    num_prefixes_ = 0;
+  }
+
+  std::unique_ptr<BuiltinFilterBitsBuilder> point_builder_;
+  const size_t max_key_prefix_len_;
+  // The last key added (truncated), whose prefix is added to the range index
+  // along with the next key
+  bool have_prev_key_ = false;
+  std::string prev_key_;
+  // Bytes prev_key_ shares with the key before it
+  size_t prev_lcp_ = 0;
+  std::string last_prefix_;
+  std::string range_index_;
+  std::vector<uint32_t> restarts_;
+  size_t num_prefixes_ = 0;
+};
+
+class RangeFilterBitsReader : public BuiltinFilterBitsReader {
+ public:
+  RangeFilterBitsReader(BuiltinFilterBitsReader* point_reader,
+                        const char* prefixes, uint32_t prefixes_len,
+                        const char* restarts, uint32_t num_restarts)
+      : point_reader_(point_reader),
+        prefixes_(prefixes),
+        prefixes_len_(prefixes_len),
+        restarts_(restarts),
+        num_restarts_(num_restarts) {}
+
+  // No Copy allowed
+  RangeFilterBitsReader(const RangeFilterBitsReader&) = delete;
+  void operator=(const RangeFilterBitsReader&) = delete;
+
+  ~RangeFilterBitsReader() override = default;
+
+  bool MayMatch(const Slice& key) override {
+    return point_reader_->MayMatch(key);
+  }
+
+  void MayMatch(int num_keys, Slice** keys, bool* may_match) override {
+    point_reader_->MayMatch(num_keys, keys, may_match);
+  }
+
+  bool HashMayMatch(const uint64_t h) override {
+    return point_reader_->HashMayMatch(h);
+  }
+
+  bool RangeMayMatch(const Slice& lower, const Slice& upper) override {
+    if (lower.compare(upper) >= 0 || num_restarts_ == 0) {
+      return false;
+    }
+    // Find a restart point whose prefix rules out lower. The keys are
+    // sorted, so any prefix ruling out lower comes before the key found
+    // below, even where binary search over prefixes is thrown off by a
+    // prefix of lower itself.
+    uint32_t left = 0;
+    uint32_t right = num_restarts_ - 1;
+    while (left < right) {
+      uint32_t mid = (left + right + 1) / 2;
+      Slice prefix;
+      if (!GetRestartPrefix(mid, &prefix)) {
+        return true;  // Corrupt
+      }
+      if (AllBelow(prefix, lower)) {
+        left = mid;
+      } else {
+        right = mid - 1;
+      }
+    }
+    // Scan for the first prefix not ruling out lower, which belongs to the
+    // smallest key >= lower if any
+    uint32_t offset = DecodeFixed32(restarts_ + left * sizeof(uint32_t));
+    if (offset > prefixes_len_) {
+      return true;  // Corrupt
+    }
+    const char* p = prefixes_ + offset;
+    const char* limit = prefixes_ + prefixes_len_;
+    std::string prefix;
+    while (p < limit) {
+      uint32_t shared = 0;
+      uint32_t non_shared = 0;
+      p = GetVarint32Ptr(p, limit, &shared);
+      if (p != nullptr) {
+        p = GetVarint32Ptr(p, limit, &non_shared);
+      }
+      if (p == nullptr || shared > prefix.size() ||
+          non_shared > static_cast<size_t>(limit - p)) {
+        return true;  // Corrupt
+      }
+      prefix.resize(shared);
+      prefix.append(p, non_shared);
+      p += non_shared;
+      if (!AllBelow(prefix, lower)) {
+        return Slice(prefix).compare(upper) < 0;
+      }
+    }
+    return false;
+  }
+
+ private:
+  // Whether every key starting with `prefix` sorts before `lower`
+  static bool AllBelow(const Slice& prefix, const Slice& lower) {
+    size_t n = prefix.difference_offset(lower);
+    return n < prefix.size() && n < lower.size() &&
+           static_cast<unsigned char>(prefix[n]) <
+               static_cast<unsigned char>(lower[n]);
+  }
+
+  bool GetRestartPrefix(uint32_t restart, Slice* prefix) const {
+    uint32_t offset = DecodeFixed32(restarts_ + restart * sizeof(uint32_t));
+    if (offset > prefixes_len_) {
+      return false;
+    }
+    const char* limit = prefixes_ + prefixes_len_;
+    uint32_t shared = 0;
+    uint32_t non_shared = 0;
+    const char* p = GetVarint32Ptr(prefixes_ + offset, limit, &shared);
+    if (p != nullptr) {
+      p = GetVarint32Ptr(p, limit, &non_shared);
+    }
+    if (p == nullptr || shared != 0 ||
+        non_shared > static_cast<size_t>(limit - p)) {
+      return false;
+    }
+    *prefix = Slice(p, non_shared);
+    return true;
+  }
+
+  std::unique_ptr<BuiltinFilterBitsReader> point_reader_;
+  const char* prefixes_;
+  const uint32_t prefixes_len_;
+  const char* restarts_;
+  const uint32_t num_restarts_;
 };
 
 Status XXPH3FilterBitsBuilder::MaybePostVerify(const Slice& filter_content) {
@@ -1679,6 +2011,9 @@ BuiltinFilterBitsReader* BuiltinFilterPolicy::GetBuiltinFilterBitsReader(
       case -2:
         // Marker for Ribbon implementations
         return GetRibbonBitsReader(contents);
+      case -3:
+        // Marker for range filter implementations
+        return GetRangeBitsReader(contents);
       default:
         // Reserved (treat as zero probes, always FP, for now)
         return new AlwaysTrueFilter();
@@ -1810,6 +2145,44 @@ BuiltinFilterBitsReader* BuiltinFilterPolicy::GetBloomBitsReader(
   return new AlwaysTrueFilter();
 }
 
+// For range filter implementations
+BuiltinFilterBitsReader* BuiltinFilterPolicy::GetRangeBitsReader(
+    const Slice& contents) {
+  uint32_t len_with_meta = static_cast<uint32_t>(contents.size());
+  uint32_t len = len_with_meta - kMetadataLen;
+
+  assert(len > 0);  // precondition
+
+  // Range filter data (see RangeFilterBitsBuilder):
+  //             0 +-----------------------------------+
+  //               | Point filter                      |
+  //     point_len +-----------------------------------+
+  //               | Range index                       |
+  //           len +-----------------------------------+
+  //               | char{-3} byte -> range filter     |
+  //         len+1 +-----------------------------------+
+  //               | four bytes for point_len          |
+  // len_with_meta +-----------------------------------+
+  uint32_t point_len = DecodeFixed32(contents.data() + len + 1);
+  if (point_len > len || len - point_len < sizeof(uint32_t)) {
+    // Invalid
+    // Treat as zero probes (always FP) for now.
+    return new AlwaysTrueFilter();
+  }
+  const char* range_index = contents.data() + point_len;
+  uint32_t range_index_len = len - point_len - sizeof(uint32_t);
+  uint32_t num_restarts = DecodeFixed32(range_index + range_index_len);
+  if (num_restarts > range_index_len / sizeof(uint32_t)) {
+    // Invalid
+    return new AlwaysTrueFilter();
+  }
+  uint32_t prefixes_len =
+      range_index_len - num_restarts * static_cast<uint32_t>(sizeof(uint32_t));
+  return new RangeFilterBitsReader(
+      GetBuiltinFilterBitsReader(Slice(contents.data(), point_len)),
+      range_index, prefixes_len, range_index + prefixes_len, num_restarts);
+}
+
 const FilterPolicy* NewBloomFilterPolicy(double bits_per_key,
                                          bool /*use_block_based_builder*/) {
   // NOTE: use_block_based_builder now ignored so block-based filter is no
@@ -1889,6 +2262,46 @@ FilterPolicy* NewRibbonFilterPolicy(double bloom_equivalent_bits_per_key,
                                 bloom_before_level);
 }
 
+RangeFilterPolicy::RangeFilterPolicy(double bloom_equivalent_bits_per_key,
+                                     size_t max_key_prefix_len)
+    : BloomLikeFilterPolicy(bloom_equivalent_bits_per_key),
+      max_key_prefix_len_(max_key_prefix_len) {
+  static const std::unordered_map<std::string, OptionTypeInfo> type_info = {
+      {"max_key_prefix_len",
+       {offsetof(class RangeFilterPolicy, max_key_prefix_len_),
+        OptionType::kSizeT, OptionVerificationType::kNormal,
+        OptionTypeFlags::kNone}},
+  };
+  RegisterOptions(this, &type_info);
+}
+
+FilterBitsBuilder* RangeFilterPolicy::GetBuilderWithContext(
+    const FilterBuildingContext& context) const {
+  if (GetMillibitsPerKey() == 0) {
+    // "No filter" special case
+    return nullptr;
+  }
+  return new RangeFilterBitsBuilder(
+      static_cast<BuiltinFilterBitsBuilder*>(
+          GetFastLocalBloomBuilderWithContext(context)),
+      max_key_prefix_len_);
+}
+
+const char* RangeFilterPolicy::kClassName() { return "rangefilter"; }
+const char* RangeFilterPolicy::kNickName() { return "rocksdb.RangeFilter"; }
+const char* RangeFilterPolicy::kName() { return "RangeFilterPolicy"; }
+
+std::string RangeFilterPolicy::GetId() const {
+  return BloomLikeFilterPolicy::GetId() + ":" +
+         std::to_string(max_key_prefix_len_);
+}
+
+FilterPolicy* NewRangeFilterPolicy(double bloom_equivalent_bits_per_key,
+                                   size_t max_key_prefix_len) {
+  return new RangeFilterPolicy(bloom_equivalent_bits_per_key,
+                               max_key_prefix_len);
+}
+
 FilterBuildingContext::FilterBuildingContext(
     const BlockBasedTableOptions& _table_options)
     : table_options(_table_options) {}
@@ -1991,6 +2404,28 @@ static int RegisterBuiltinFilterPolicies(ObjectLibrary& library,
         guard->reset(NewRibbonFilterPolicy(bits_per_key, bloom_before_level));
         return guard->get();
       });
+  library.AddFactory<const FilterPolicy>(
+      FilterPatternEntryWithBits(RangeFilterPolicy::kClassName())
+          .AnotherName(RangeFilterPolicy::kNickName()),
+      [](const std::string& uri, std::unique_ptr<const FilterPolicy>* guard,
+         std::string* /* errmsg */) {
+        const std::vector<std::string> vals = StringSplit(uri, ':');
+        double bits_per_key = ParseDouble(vals[1]);
+        guard->reset(NewRangeFilterPolicy(bits_per_key));
+        return guard->get();
+      });
+  library.AddFactory<const FilterPolicy>(
+      FilterPatternEntryWithBits(RangeFilterPolicy::kClassName())
+          .AnotherName(RangeFilterPolicy::kNickName())
+          .AddNumber(":", true),
+      [](const std::string& uri, std::unique_ptr<const FilterPolicy>* guard,
+         std::string* /* errmsg */) {
+        const std::vector<std::string> vals = StringSplit(uri, ':');
+        double bits_per_key = ParseDouble(vals[1]);
+        size_t max_key_prefix_len = ParseSizeT(vals[2]);
+        guard->reset(NewRangeFilterPolicy(bits_per_key, max_key_prefix_len));
+        return guard->get();
+      });
   library.AddFactory<const FilterPolicy>(
       FilterPatternEntryWithBits(test::LegacyBloomFilterPolicy::kClassName()),
       [](const std::string& uri, std::unique_ptr<const FilterPolicy>* guard,
@@ -107,6 +107,13 @@ class FilterBitsReader {
       may_match[i] = MayMatch(*keys[i]);
     }
   }
+
+  // Check if any entry e with lower <= e < upper (in bytewise order) may
+  // have been added to the filter. Only range filters (see
+  // NewRangeFilterPolicy) can rule out a range.
+  virtual bool RangeMayMatch(const Slice& /*lower*/, const Slice& /*upper*/) {
+    return true;
+  }
 };
 
 // Exposes any extra information needed for testing built-in
@@ -168,6 +175,9 @@ class BuiltinFilterPolicy : public FilterPolicy {
 
   // For Ribbon filter implementation(s)
   static BuiltinFilterBitsReader* GetRibbonBitsReader(const Slice& contents);
+
+  // For range filter implementation(s)
+  static BuiltinFilterBitsReader* GetRangeBitsReader(const Slice& contents);
 };
 
 // A "read only" filter policy used for backward compatibility with old
@@ -308,6 +318,32 @@ class RibbonFilterPolicy : public BloomLikeFilterPolicy {
   std::atomic<int> bloom_before_level_;
 };
 
+// For NewRangeFilterPolicy
+//
+// This is a user-facing policy for filters answering range queries as well
+// as point queries. The filters embed a FastLocalBloom filter for point
+// queries.
+class RangeFilterPolicy : public BloomLikeFilterPolicy {
+ public:
+  RangeFilterPolicy(double bloom_equivalent_bits_per_key,
+                    size_t max_key_prefix_len);
+
+  FilterBitsBuilder* GetBuilderWithContext(
+      const FilterBuildingContext&) const override;
+
+  size_t GetMaxKeyPrefixLen() const { return max_key_prefix_len_; }
+
+  static const char* kClassName();
+  const char* Name() const override { return kClassName(); }
+  static const char* kNickName();
+  const char* NickName() const override { return kNickName(); }
+  static const char* kName();
+  std::string GetId() const override;
+
+ private:
+  size_t max_key_prefix_len_;
+};
+
 // For testing only, but always constructable with internal names
 namespace test {
 
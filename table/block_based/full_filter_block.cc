@@ -137,6 +137,28 @@ bool FullFilterBlockReader::MayMatch(const Slice& entry,
   return true;
 }
 
+bool FullFilterBlockReader::RangeMayMatch(
+    const Slice& lower, const Slice& upper,
+    const Slice* const /*const_ikey_ptr*/, GetContext* get_context,
+    BlockCacheLookupContext* lookup_context, const ReadOptions& read_options) {
+  CachableEntry<ParsedFullFilterBlock> filter_block;
+
+  const Status s = GetOrReadFilterBlock(get_context, lookup_context,
+                                        &filter_block, read_options);
+  if (!s.ok()) {
+    IGNORE_STATUS_IF_ERROR(s);
+    return true;
+  }
+
+  assert(filter_block.GetValue());
+
+  FilterBitsReader* const filter_bits_reader =
+      filter_block.GetValue()->filter_bits_reader();
+
+  return filter_bits_reader == nullptr ||
+         filter_bits_reader->RangeMayMatch(lower, upper);
+}
+
 void FullFilterBlockReader::KeysMayMatch(
     MultiGetRange* range, BlockCacheLookupContext* lookup_context,
     const ReadOptions& read_options) {
@@ -120,6 +120,12 @@ class FullFilterBlockReader
                         const SliceTransform* prefix_extractor,
                         BlockCacheLookupContext* lookup_context,
                         const ReadOptions& read_options) override;
+
+  bool RangeMayMatch(const Slice& lower, const Slice& upper,
+                     const Slice* const const_ikey_ptr, GetContext* get_context,
+                     BlockCacheLookupContext* lookup_context,
+                     const ReadOptions& read_options) override;
+
   size_t ApproximateMemoryUsage() const override;
 
  private:
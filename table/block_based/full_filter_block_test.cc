@@ -17,6 +17,7 @@
 #include "test_util/testutil.h"
 #include "util/coding.h"
 #include "util/hash.h"
+#include "util/random.h"
 #include "util/string_util.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -323,6 +324,109 @@ TEST_F(FullFilterBlockTest, SingleChunk) {
                                   /*lookup_context=*/nullptr, ReadOptions()));
 }
 
+class RangeFilterBlockTest : public mock::MockBlockBasedTableTester,
+                             public testing::TestWithParam<size_t> {
+ public:
+  RangeFilterBlockTest()
+      : mock::MockBlockBasedTableTester(
+            NewRangeFilterPolicy(10, /*max_key_prefix_len=*/GetParam())) {}
+
+  bool RangeMayMatch(FullFilterBlockReader& reader, const Slice& lower,
+                     const Slice& upper) {
+    return reader.RangeMayMatch(lower, upper, /*const_ikey_ptr=*/nullptr,
+                                /*get_context=*/nullptr,
+                                /*lookup_context=*/nullptr, ReadOptions());
+  }
+};
+
+TEST_P(RangeFilterBlockTest, SingleChunk) {
+  FullFilterBlockBuilder builder(nullptr, true, GetBuilder());
+  builder.Add("apple");
+  builder.Add("banana");
+  builder.Add("cherry");
+  Slice slice;
+  ASSERT_OK(builder.Finish(BlockHandle(), &slice));
+
+  CachableEntry<ParsedFullFilterBlock> block(
+      new ParsedFullFilterBlock(table_options_.filter_policy.get(),
+                                BlockContents(slice)),
+      nullptr /* cache */, nullptr /* cache_handle */, true /* own_value */);
+
+  FullFilterBlockReader reader(table_.get(), std::move(block));
+  ASSERT_TRUE(reader.KeyMayMatch("banana",
+                                 /*const_ikey_ptr=*/nullptr,
+                                 /*get_context=*/nullptr,
+                                 /*lookup_context=*/nullptr, ReadOptions()));
+  ASSERT_FALSE(reader.KeyMayMatch("missing",
+                                  /*const_ikey_ptr=*/nullptr,
+                                  /*get_context=*/nullptr,
+                                  /*lookup_context=*/nullptr, ReadOptions()));
+
+  ASSERT_TRUE(RangeMayMatch(reader, "apple", "apple0"));
+  ASSERT_TRUE(RangeMayMatch(reader, "b", "c"));
+  ASSERT_TRUE(RangeMayMatch(reader, "ch", "ci"));
+  ASSERT_TRUE(RangeMayMatch(reader, "", "zzz"));
+  // Between keys
+  ASSERT_FALSE(RangeMayMatch(reader, "bb", "c"));
+  ASSERT_FALSE(RangeMayMatch(reader, "c", "cg"));
+  // Before and after all keys
+  ASSERT_FALSE(RangeMayMatch(reader, "", "a"));
+  ASSERT_FALSE(RangeMayMatch(reader, "d", "z"));
+  // Empty range
+  ASSERT_FALSE(RangeMayMatch(reader, "b", "a"));
+}
+
+TEST_P(RangeFilterBlockTest, NoFalseNegatives) {
+  // Short keys over a small alphabet, sharing prefixes of various lengths
+  Random rnd(301);
+  auto random_string = [&rnd]() {
+    std::string s;
+    int len = 1 + rnd.Uniform(6);
+    for (int i = 0; i < len; ++i) {
+      s.push_back(static_cast<char>('a' + rnd.Uniform(6)));
+    }
+    return s;
+  };
+  std::set<std::string> keys;
+  while (keys.size() < 1000) {
+    keys.insert(random_string());
+  }
+
+  FullFilterBlockBuilder builder(nullptr, true, GetBuilder());
+  for (const auto& key : keys) {
+    builder.Add(key);
+  }
+  Slice slice;
+  ASSERT_OK(builder.Finish(BlockHandle(), &slice));
+
+  CachableEntry<ParsedFullFilterBlock> block(
+      new ParsedFullFilterBlock(table_options_.filter_policy.get(),
+                                BlockContents(slice)),
+      nullptr /* cache */, nullptr /* cache_handle */, true /* own_value */);
+  FullFilterBlockReader reader(table_.get(), std::move(block));
+
+  int num_empty = 0;
+  int num_ruled_out = 0;
+  for (int i = 0; i < 10000; ++i) {
+    std::string lower = random_string();
+    std::string upper = lower;
+    upper.back() = static_cast<char>(upper.back() + 1 + rnd.Uniform(2));
+    bool may_match = RangeMayMatch(reader, lower, upper);
+    auto it = keys.lower_bound(lower);
+    if (it != keys.end() && *it < upper) {
+      ASSERT_TRUE(may_match) << lower << " " << upper;
+    } else {
+      ++num_empty;
+      num_ruled_out += may_match ? 0 : 1;
+    }
+  }
+  ASSERT_GT(num_empty, 0);
+  ASSERT_GT(num_ruled_out, 0);
+}
+
+INSTANTIATE_TEST_CASE_P(RangeFilterBlockTest, RangeFilterBlockTest,
+                        ::testing::Values(size_t{0}, size_t{3}));
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -18,6 +18,7 @@
 #include "rocksdb/comparator.h"
 #include "table/block_based/block_based_table_factory.h"
 #include "table/block_based/block_builder.h"
+#include "table/block_based/learned_index.h"
 #include "table/format.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -436,6 +437,75 @@ class HashIndexBuilder : public IndexBuilder {
   uint64_t current_restart_index_ = 0;
 };
 
+// LearnedIndexBuilder contains a binary-searchable primary index and a
+// metablock holding a LearnedIndexModel trained on the keys of the primary
+// index's restart points. See learned_index.h for the model format.
+class LearnedIndexBuilder : public IndexBuilder {
+ public:
+  LearnedIndexBuilder(
+      const InternalKeyComparator* comparator, int index_block_restart_interval,
+      int format_version, bool use_value_delta_encoding,
+      BlockBasedTableOptions::IndexShorteningMode shortening_mode, size_t ts_sz,
+      const bool persist_user_defined_timestamps)
+      : IndexBuilder(comparator, ts_sz, persist_user_defined_timestamps),
+        primary_index_builder_(comparator, index_block_restart_interval,
+                               format_version, use_value_delta_encoding,
+                               shortening_mode, /* include_first_key */ false,
+                               ts_sz, persist_user_defined_timestamps),
+        model_builder_(static_cast<uint32_t>(index_block_restart_interval),
+                       kLearnedIndexEpsilon),
+        // The key projection used by the model only preserves order for
+        // plain bytewise ordered keys.
+        build_model_(ts_sz == 0 &&
+                     Slice(comparator->user_comparator()->Name()) ==
+                         BytewiseComparator()->Name()) {}
+
+  Slice AddIndexEntry(const Slice& last_key_in_current_block,
+                      const Slice* first_key_in_next_block,
+                      const BlockHandle& block_handle,
+                      std::string* separator_scratch) override {
+    Slice separator = primary_index_builder_.AddIndexEntry(
+        last_key_in_current_block, first_key_in_next_block, block_handle,
+        separator_scratch);
+    if (build_model_) {
+      model_builder_.AddIndexKey(ExtractUserKey(separator));
+    }
+    return separator;
+  }
+
+  Status Finish(IndexBlocks* index_blocks,
+                const BlockHandle& last_partition_block_handle) override {
+    Status s = primary_index_builder_.Finish(index_blocks,
+                                             last_partition_block_handle);
+    if (s.ok() && build_model_) {
+      model_block_ = model_builder_.Finish();
+      if (!model_block_.empty()) {
+        index_blocks->meta_blocks.insert(
+            {kLearnedIndexModelBlock.c_str(), model_block_});
+      }
+    }
+    return s;
+  }
+
+  size_t IndexSize() const override {
+    return primary_index_builder_.IndexSize() + model_block_.size();
+  }
+
+  bool seperator_is_key_plus_seq() override {
+    return primary_index_builder_.seperator_is_key_plus_seq();
+  }
+
+ private:
+  // Maximum distance, in restart points, between the predicted and the actual
+  // position of a trained key.
+  static constexpr uint32_t kLearnedIndexEpsilon = 4;
+
+  ShortenedIndexBuilder primary_index_builder_;
+  LearnedIndexModelBuilder model_builder_;
+  const bool build_model_;
+  Slice model_block_;
+};
+
 /**
  * IndexBuilder for two-level indexing. Internally it creates a new index for
  * each partition and Finish then in order when Finish is called on it
@@ -0,0 +1,207 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "table/block_based/learned_index.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+#include "util/coding.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+uint64_t EncodeDouble(double d) {
+  uint64_t bits;
+  static_assert(sizeof(bits) == sizeof(d), "");
+  memcpy(&bits, &d, sizeof(bits));
+  return bits;
+}
+
+double DecodeDouble(uint64_t bits) {
+  double d;
+  memcpy(&d, &bits, sizeof(d));
+  return d;
+}
+}  // namespace
+
+uint64_t LearnedIndexModel::ProjectKey(const Slice& common_prefix,
+                                       const Slice& user_key) {
+  // Keys sorting before (after) every key with the common prefix are mapped
+  // to the smallest (largest) value so that the projection stays monotonic.
+  const size_t n = std::min(common_prefix.size(), user_key.size());
+  const int cmp = memcmp(user_key.data(), common_prefix.data(), n);
+  if (cmp < 0 || (cmp == 0 && user_key.size() < common_prefix.size())) {
+    return 0;
+  }
+  if (cmp > 0) {
+    return std::numeric_limits<uint64_t>::max();
+  }
+  uint64_t result = 0;
+  for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+    result <<= 8;
+    const size_t pos = common_prefix.size() + i;
+    if (pos < user_key.size()) {
+      result |= static_cast<unsigned char>(user_key[pos]);
+    }
+  }
+  return result;
+}
+
+Status LearnedIndexModel::Create(const Slice& contents,
+                                 std::unique_ptr<LearnedIndexModel>* model) {
+  Slice input = contents;
+  std::unique_ptr<LearnedIndexModel> result(new LearnedIndexModel());
+  Slice common_prefix;
+  uint32_t num_segments = 0;
+  if (!GetVarint32(&input, &result->epsilon_) ||
+      !GetVarint32(&input, &result->num_restarts_) ||
+      !GetLengthPrefixedSlice(&input, &common_prefix) ||
+      !GetVarint32(&input, &num_segments)) {
+    return Status::Corruption("Bad learned index model header");
+  }
+  if (result->num_restarts_ == 0 || num_segments == 0 ||
+      num_segments > result->num_restarts_) {
+    return Status::Corruption("Bad learned index model segment count");
+  }
+  result->common_prefix_ = common_prefix.ToString();
+  result->segments_.reserve(num_segments);
+  for (uint32_t i = 0; i < num_segments; ++i) {
+    Segment segment;
+    uint64_t slope_bits = 0;
+    if (!GetFixed64(&input, &segment.first_key) ||
+        !GetFixed64(&input, &slope_bits) ||
+        !GetVarint32(&input, &segment.first_restart)) {
+      return Status::Corruption("Truncated learned index model");
+    }
+    segment.slope = DecodeDouble(slope_bits);
+    if (segment.first_restart >= result->num_restarts_ ||
+        !(segment.slope >= 0.0) ||
+        (i > 0 && segment.first_key <= result->segments_.back().first_key)) {
+      return Status::Corruption("Bad learned index model segment");
+    }
+    result->segments_.push_back(segment);
+  }
+  *model = std::move(result);
+  return Status::OK();
+}
+
+void LearnedIndexModel::PredictRange(const Slice& user_key, uint32_t* left,
+                                     uint32_t* right) const {
+  assert(!segments_.empty());
+  const uint64_t x = ProjectKey(common_prefix_, user_key);
+  // Find the last segment starting at or before `x`.
+  auto it = std::upper_bound(
+      segments_.begin(), segments_.end(), x,
+      [](uint64_t k, const Segment& segment) { return k < segment.first_key; });
+  if (it != segments_.begin()) {
+    --it;
+  }
+  double pos = it->first_restart;
+  if (x > it->first_key) {
+    pos += it->slope * static_cast<double>(x - it->first_key);
+  }
+  const uint32_t last = num_restarts_ - 1;
+  // Restart keys from the next segment on project to values greater than
+  // `x`, so they cannot be the result; don't extrapolate past them.
+  uint32_t limit = last;
+  if (it + 1 != segments_.end() && (it + 1)->first_restart > 0) {
+    limit = (it + 1)->first_restart - 1;
+  }
+  const uint32_t predicted =
+      pos >= limit ? limit : static_cast<uint32_t>(pos + 0.5);
+  // One extra restart on each side accounts for rounding and for targets
+  // falling between two trained keys.
+  const uint32_t slack = epsilon_ + 1;
+  *left = predicted > slack ? predicted - slack : 0;
+  *right = last - predicted > slack ? predicted + slack : last;
+}
+
+void LearnedIndexModelBuilder::AddIndexKey(const Slice& user_key) {
+  if (num_index_keys_ % restart_interval_ == 0) {
+    restart_keys_.emplace_back(user_key.data(), user_key.size());
+  }
+  ++num_index_keys_;
+}
+
+Slice LearnedIndexModelBuilder::Finish() {
+  buffer_.clear();
+  if (restart_keys_.empty() ||
+      restart_keys_.size() > std::numeric_limits<uint32_t>::max()) {
+    return Slice();
+  }
+
+  // Index keys are sorted, so the prefix shared by the first and the last
+  // one is shared by all of them.
+  const std::string& first = restart_keys_.front();
+  const std::string& last = restart_keys_.back();
+  size_t prefix_len = 0;
+  while (prefix_len < first.size() && prefix_len < last.size() &&
+         first[prefix_len] == last[prefix_len]) {
+    ++prefix_len;
+  }
+  const Slice common_prefix(first.data(), prefix_len);
+
+  // Project the restart keys. Keys that collide after projection (e.g. they
+  // only differ past the 8 bytes considered, or the same user key spans
+  // several entries) keep the first restart index; seeks to them rely on the
+  // window check in IndexBlockIter.
+  std::vector<uint64_t> xs;
+  std::vector<uint32_t> ys;
+  xs.reserve(restart_keys_.size());
+  ys.reserve(restart_keys_.size());
+  for (size_t i = 0; i < restart_keys_.size(); ++i) {
+    const uint64_t x =
+        LearnedIndexModel::ProjectKey(common_prefix, restart_keys_[i]);
+    if (!xs.empty() && x == xs.back()) {
+      continue;
+    }
+    xs.push_back(x);
+    ys.push_back(static_cast<uint32_t>(i));
+  }
+
+  // Greedily grow each segment while a line through its first point can stay
+  // within `epsilon_` of all points added so far (shrinking cone).
+  const double eps = epsilon_;
+  std::vector<LearnedIndexModel::Segment> segments;
+  size_t start = 0;
+  while (start < xs.size()) {
+    double slope_lo = 0.0;
+    double slope_hi = std::numeric_limits<double>::max();
+    size_t end = start + 1;
+    for (; end < xs.size(); ++end) {
+      const double dx = static_cast<double>(xs[end] - xs[start]);
+      const double dy = static_cast<double>(ys[end] - ys[start]);
+      const double lo = std::max(slope_lo, (dy - eps) / dx);
+      const double hi = std::min(slope_hi, (dy + eps) / dx);
+      if (lo > hi) {
+        break;
+      }
+      slope_lo = lo;
+      slope_hi = hi;
+    }
+    LearnedIndexModel::Segment segment;
+    segment.first_key = xs[start];
+    segment.slope = end == start + 1 ? 0.0 : (slope_lo + slope_hi) / 2;
+    segment.first_restart = ys[start];
+    segments.push_back(segment);
+    start = end;
+  }
+
+  PutVarint32(&buffer_, epsilon_);
+  PutVarint32(&buffer_, static_cast<uint32_t>(restart_keys_.size()));
+  PutLengthPrefixedSlice(&buffer_, common_prefix);
+  PutVarint32(&buffer_, static_cast<uint32_t>(segments.size()));
+  for (const auto& segment : segments) {
+    PutFixed64(&buffer_, segment.first_key);
+    PutFixed64(&buffer_, EncodeDouble(segment.slope));
+    PutVarint32(&buffer_, segment.first_restart);
+  }
+  return buffer_;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,104 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rocksdb/slice.h"
+#include "rocksdb/status.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A piecewise-linear model (in the spirit of the PGM-index) that maps a user
+// key to the restart index of the index block entry that covers it.
+//
+// Keys are projected onto a uint64_t by dropping the prefix shared by all
+// index keys of the table and interpreting the following 8 bytes as a
+// big-endian integer, which preserves bytewise order. The projected keys of
+// the restart points are then covered by linear segments such that, for every
+// restart point, the predicted restart index is within `epsilon` of the
+// actual one. For fixed-width keys that are assigned (close to) monotonically,
+// a handful of segments cover the whole table.
+//
+// The model is only a hint: IndexBlockIter verifies that the predicted window
+// brackets the seek target and falls back to a full binary search otherwise,
+// so a poor fit only costs performance.
+class LearnedIndexModel {
+ public:
+  // Create the model by decoding the contents of a learned index meta block
+  // as written by LearnedIndexModelBuilder.
+  static Status Create(const Slice& contents,
+                       std::unique_ptr<LearnedIndexModel>* model);
+
+  // Predict the window of restart indexes [*left, *right] expected to hold
+  // the last restart key <= `user_key`.
+  void PredictRange(const Slice& user_key, uint32_t* left,
+                    uint32_t* right) const;
+
+  // Number of restart points the model was trained on.
+  uint32_t num_restarts() const { return num_restarts_; }
+
+  size_t ApproximateMemoryUsage() const {
+    return sizeof(LearnedIndexModel) + common_prefix_.capacity() +
+           segments_.capacity() * sizeof(Segment);
+  }
+
+ private:
+  friend class LearnedIndexModelBuilder;
+
+  struct Segment {
+    uint64_t first_key;
+    double slope;
+    uint32_t first_restart;
+  };
+
+  static uint64_t ProjectKey(const Slice& common_prefix, const Slice& user_key);
+
+  LearnedIndexModel() = default;
+
+  std::string common_prefix_;
+  uint32_t epsilon_ = 0;
+  uint32_t num_restarts_ = 0;
+  std::vector<Segment> segments_;
+};
+
+// Collects the index keys of the restart points of an index block and trains
+// a LearnedIndexModel on them.
+//
+// Format of the resulting meta block:
+//   epsilon:        varint32
+//   num_restarts:   varint32
+//   common_prefix:  length prefixed slice
+//   num_segments:   varint32
+//   segments:       num_segments * (first_key: fixed64, slope: fixed64
+//                   (IEEE 754 bit pattern), first_restart: varint32)
+class LearnedIndexModelBuilder {
+ public:
+  LearnedIndexModelBuilder(uint32_t restart_interval, uint32_t epsilon)
+      : restart_interval_(restart_interval > 0 ? restart_interval : 1),
+        epsilon_(epsilon) {}
+
+  // Called for each index entry, in order, with the user key portion of the
+  // index key.
+  void AddIndexKey(const Slice& user_key);
+
+  // Train the model and return its serialized form. The returned slice is
+  // backed by this builder and remains valid until it is destroyed.
+  Slice Finish();
+
+ private:
+  const uint32_t restart_interval_;
+  const uint32_t epsilon_;
+  uint64_t num_index_keys_ = 0;
+  // User keys of the restart points.
+  std::vector<std::string> restart_keys_;
+  std::string buffer_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
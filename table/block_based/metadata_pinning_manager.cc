@@ -0,0 +1,128 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "table/block_based/metadata_pinning_manager.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "table/block_based/block_based_table_reader.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+MetadataPinningManager::MetadataPinningManager(
+    std::shared_ptr<Cache> block_cache, size_t budget)
+    : block_cache_(std::move(block_cache)), budget_(budget) {
+  assert(block_cache_);
+}
+
+MetadataPinningManager::~MetadataPinningManager() {
+  // Tables hold a reference to the manager, so all have been unregistered
+  assert(tables_.empty());
+}
+
+void MetadataPinningManager::Register(const BlockBasedTable* table) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  TableEntry& entry = tables_[table];
+  entry.last_accesses = table->get_rep()->metadata_accesses.LoadRelaxed();
+  num_tables_.StoreRelaxed(tables_.size());
+}
+
+void MetadataPinningManager::Unregister(const BlockBasedTable* table) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = tables_.find(table);
+  if (it == tables_.end()) {
+    return;
+  }
+  Unpin(&it->second);
+  tables_.erase(it);
+  num_tables_.StoreRelaxed(tables_.size());
+}
+
+void MetadataPinningManager::OnAccessBatch() {
+  uint64_t batches = batches_since_rebalance_.FetchAddRelaxed(1) + 1;
+  if (batches <
+      std::max(kMinBatchesPerRebalance, uint64_t{num_tables_.LoadRelaxed()})) {
+    return;
+  }
+  // Leave rebalancing to whoever is already at it
+  std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+  if (lock.owns_lock()) {
+    RebalanceLocked();
+  }
+}
+
+void MetadataPinningManager::Rebalance() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  RebalanceLocked();
+}
+
+void MetadataPinningManager::RebalanceLocked() {
+  batches_since_rebalance_.StoreRelaxed(0);
+
+  std::vector<std::pair<const BlockBasedTable*, TableEntry*>> by_heat;
+  by_heat.reserve(tables_.size());
+  for (auto& [table, entry] : tables_) {
+    const uint64_t accesses = table->get_rep()->metadata_accesses.LoadRelaxed();
+    entry.heat = entry.heat / 2 + (accesses - entry.last_accesses);
+    entry.last_accesses = accesses;
+    by_heat.emplace_back(table, &entry);
+  }
+  std::sort(by_heat.begin(), by_heat.end(),
+            [](const auto& a, const auto& b) {
+              return a.second->heat > b.second->heat;
+            });
+
+  size_t usage = 0;
+  for (auto& [table, entry] : by_heat) {
+    if (entry->heat == 0) {
+      Unpin(entry);
+      continue;
+    }
+    Pin(table, entry);
+    if (usage + entry->pinned_charge > budget_) {
+      // Smaller metadata of colder tables might still fit
+      Unpin(entry);
+    } else {
+      usage += entry->pinned_charge;
+    }
+  }
+  pinned_usage_.StoreRelaxed(usage);
+}
+
+void MetadataPinningManager::Pin(const BlockBasedTable* table,
+                                 TableEntry* entry) {
+  const BlockBasedTable::Rep* rep = table->get_rep();
+  const BlockHandle* handles[2] = {
+      rep->filter != nullptr ? &rep->filter_handle : nullptr,
+      &rep->index_handle};
+  for (size_t i = 0; i < entry->pinned.size(); ++i) {
+    if (entry->pinned[i] != nullptr || handles[i] == nullptr ||
+        handles[i]->IsNull()) {
+      continue;
+    }
+    // Only pin what is already in the cache, as the table's readers would
+    // have loaded it on access
+    CacheKey key = BlockBasedTable::GetCacheKey(rep->base_cache_key,
+                                                *handles[i]);
+    entry->pinned[i] = block_cache_->Lookup(key.AsSlice());
+    if (entry->pinned[i] != nullptr) {
+      entry->pinned_charge += block_cache_->GetCharge(entry->pinned[i]);
+    }
+  }
+}
+
+void MetadataPinningManager::Unpin(TableEntry* entry) {
+  for (Cache::Handle*& handle : entry->pinned) {
+    if (handle != nullptr) {
+      block_cache_->Release(handle);
+      handle = nullptr;
+    }
+  }
+  entry->pinned_charge = 0;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
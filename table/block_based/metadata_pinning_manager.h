@@ -0,0 +1,83 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "rocksdb/advanced_cache.h"
+#include "util/atomic.h"
+#include "util/hash_containers.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class BlockBasedTable;
+
+// Pins the filter and index blocks of the most frequently accessed
+// block-based tables in the block cache, up to a budget (see
+// BlockBasedTableOptions::adaptive_metadata_pinning_budget).
+//
+// Tables register on open and report accesses to their metadata. Every so
+// often (amortized over accesses, and without blocking readers) the tables
+// are ranked by an exponentially decayed access count, and the metadata
+// blocks of the hottest tables are pinned, without I/O, for as long as they
+// remain hot enough to fit in the budget. Pinned blocks stay charged to the
+// block cache as usual; they just cannot be evicted. For partitioned filters
+// and indexes, only the top-level blocks are pinned.
+class MetadataPinningManager {
+ public:
+  // Number of accesses a table reports as one batch
+  static constexpr uint64_t kAccessBatch = 64;
+  // Minimum number of access batches (across tables) between rebalancings
+  static constexpr uint64_t kMinBatchesPerRebalance = 16;
+
+  MetadataPinningManager(std::shared_ptr<Cache> block_cache, size_t budget);
+  ~MetadataPinningManager();
+
+  // No copying allowed
+  MetadataPinningManager(const MetadataPinningManager&) = delete;
+  MetadataPinningManager& operator=(const MetadataPinningManager&) = delete;
+
+  void Register(const BlockBasedTable* table);
+  // Releases anything pinned for the table. Must be called before the table
+  // is destroyed.
+  void Unregister(const BlockBasedTable* table);
+
+  // Called by a table every kAccessBatch accesses to its metadata
+  void OnAccessBatch();
+
+  // Re-ranks the registered tables and updates which are pinned
+  void Rebalance();
+
+  size_t GetPinnedUsage() const { return pinned_usage_.LoadRelaxed(); }
+
+ private:
+  struct TableEntry {
+    // The table's access count as of the last rebalancing
+    uint64_t last_accesses = 0;
+    uint64_t heat = 0;
+    // Filter and index block handles, nullptr when not pinned
+    std::array<Cache::Handle*, 2> pinned{};
+    size_t pinned_charge = 0;
+  };
+
+  void RebalanceLocked();
+  void Pin(const BlockBasedTable* table, TableEntry* entry);
+  void Unpin(TableEntry* entry);
+
+  const std::shared_ptr<Cache> block_cache_;
+  const size_t budget_;
+
+  std::mutex mutex_;
+  UnorderedMap<const BlockBasedTable*, TableEntry> tables_;
+  RelaxedAtomic<size_t> num_tables_{0};
+  RelaxedAtomic<uint64_t> batches_since_rebalance_{0};
+  RelaxedAtomic<size_t> pinned_usage_{0};
+};
+
+}  // namespace ROCKSDB_NAMESPACE
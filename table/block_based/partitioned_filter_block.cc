@@ -365,19 +365,74 @@ void PartitionedFilterBlockReader::PrefixesMayMatch(
            &FullFilterBlockReader::PrefixesMayMatch);
 }
 
-BlockHandle PartitionedFilterBlockReader::GetFilterPartitionHandle(
-    const CachableEntry<Block_kFilterPartitionIndex>& filter_block,
-    const Slice& entry) const {
+bool PartitionedFilterBlockReader::RangeMayMatch(
+    const Slice& lower, const Slice& upper, const Slice* const const_ikey_ptr,
+    GetContext* get_context, BlockCacheLookupContext* lookup_context,
+    const ReadOptions& read_options) {
+  assert(const_ikey_ptr != nullptr);
+  CachableEntry<Block_kFilterPartitionIndex> filter_block;
+  Status s = GetOrReadFilterBlock(get_context, lookup_context, &filter_block,
+                                  read_options);
+  if (UNLIKELY(!s.ok())) {
+    IGNORE_STATUS_IF_ERROR(s);
+    return true;
+  }
+
+  if (UNLIKELY(filter_block.GetValue()->size() == 0)) {
+    return true;
+  }
+
   IndexBlockIter iter;
+  NewPartitionIndexIterator(filter_block, &iter);
+  const Comparator* const user_comparator =
+      internal_comparator()->user_comparator();
+  // Check each partition overlapping the range, up to the first one ending
+  // at or past upper
+  for (iter.Seek(*const_ikey_ptr); iter.Valid(); iter.Next()) {
+    CachableEntry<ParsedFullFilterBlock> filter_partition_block;
+    s = GetFilterPartitionBlock(nullptr /* prefetch_buffer */,
+                                iter.value().handle, get_context,
+                                lookup_context, read_options,
+                                &filter_partition_block);
+    if (UNLIKELY(!s.ok())) {
+      IGNORE_STATUS_IF_ERROR(s);
+      return true;
+    }
+
+    FullFilterBlockReader filter_partition(table(),
+                                           std::move(filter_partition_block));
+    if (filter_partition.RangeMayMatch(lower, upper, const_ikey_ptr,
+                                       get_context, lookup_context,
+                                       read_options)) {
+      return true;
+    }
+    if (user_comparator->Compare(iter.user_key(), upper) >= 0) {
+      return false;
+    }
+  }
+  // No key at or after lower
+  return !iter.status().ok();
+}
+
+void PartitionedFilterBlockReader::NewPartitionIndexIterator(
+    const CachableEntry<Block_kFilterPartitionIndex>& filter_block,
+    IndexBlockIter* iter) const {
   const InternalKeyComparator* const comparator = internal_comparator();
   Statistics* kNullStats = nullptr;
   filter_block.GetValue()->NewIndexIterator(
       comparator->user_comparator(),
       table()->get_rep()->get_global_seqno(BlockType::kFilterPartitionIndex),
-      &iter, kNullStats, true /* total_order_seek */,
+      iter, kNullStats, true /* total_order_seek */,
       false /* have_first_key */, index_key_includes_seq(),
       index_value_is_full(), false /* block_contents_pinned */,
       user_defined_timestamps_persisted());
+}
+
+BlockHandle PartitionedFilterBlockReader::GetFilterPartitionHandle(
+    const CachableEntry<Block_kFilterPartitionIndex>& filter_block,
+    const Slice& entry) const {
+  IndexBlockIter iter;
+  NewPartitionIndexIterator(filter_block, &iter);
   iter.Seek(entry);
   if (UNLIKELY(!iter.Valid())) {
     // entry is larger than all the keys. However its prefix might still be
@@ -157,9 +157,17 @@ class PartitionedFilterBlockReader
                         BlockCacheLookupContext* lookup_context,
                         const ReadOptions& read_options) override;
 
+  bool RangeMayMatch(const Slice& lower, const Slice& upper,
+                     const Slice* const const_ikey_ptr, GetContext* get_context,
+                     BlockCacheLookupContext* lookup_context,
+                     const ReadOptions& read_options) override;
+
   size_t ApproximateMemoryUsage() const override;
 
  private:
+  void NewPartitionIndexIterator(
+      const CachableEntry<Block_kFilterPartitionIndex>& filter_block,
+      IndexBlockIter* iter) const;
   BlockHandle GetFilterPartitionHandle(
       const CachableEntry<Block_kFilterPartitionIndex>& filter_block,
       const Slice& entry) const;
@@ -0,0 +1,105 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "port/port.h"
+#include "rocksdb/slice.h"
+#include "util/coding.h"
+#include "util/math.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace ROCKSDB_NAMESPACE {
+
+// Data blocks built with
+// `BlockBasedTableOptions::data_block_restart_key_prefixes` store, for each
+// restart point, the first 8 bytes of the restart key's user key as an integer
+// (big-endian interpretation, zero padded), encoded as fixed64. The array sits
+// right after the restart array:
+//
+//   [entries][restarts: uint32[n]][prefixes: fixed64[n]][hash index][footer]
+//
+// Because the integers order like the (bytewise) keys they were taken from,
+// a restart key whose prefix is less (greater) than the target's prefix is
+// known to be less (greater) than the target without decoding the key.
+inline uint64_t RestartKeyPrefix(const Slice& user_key) {
+  if (user_key.size() >= sizeof(uint64_t)) {
+    uint64_t result;
+    memcpy(&result, user_key.data(), sizeof(result));
+    return port::kLittleEndian ? EndianSwapValue(result) : result;
+  }
+  uint64_t result = 0;
+  for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+    result <<= 8;
+    if (i < user_key.size()) {
+      result |= static_cast<unsigned char>(user_key[i]);
+    }
+  }
+  return result;
+}
+
+// Returns the number of leading entries of the sorted array `prefixes` (of
+// `n` fixed64 values) that are less than `target`, or less than or equal to
+// `target` if `or_equal`.
+inline uint32_t CountRestartKeyPrefixesBelow(const char* prefixes, uint32_t n,
+                                             uint64_t target, bool or_equal) {
+  // Binary search down to a window small enough to scan in a few vector
+  // compares.
+  constexpr uint32_t kScanWindow = 16;
+  uint32_t base = 0;
+  while (n > kScanWindow) {
+    const uint32_t half = n / 2;
+    const uint64_t v = DecodeFixed64(prefixes + (base + half) * sizeof(v));
+    if (v < target || (or_equal && v == target)) {
+      base += half + 1;
+      n -= half + 1;
+    } else {
+      n = half;
+    }
+  }
+  uint32_t count = base;
+  const char* p = prefixes + base * sizeof(uint64_t);
+  uint32_t i = 0;
+#ifdef __AVX2__
+  // Lanes load as the fixed64 values since x86 is little-endian. AVX2 only has
+  // a signed 64-bit compare, so flip the sign bits to compare as unsigned.
+  const __m256i sign = _mm256_set1_epi64x(static_cast<int64_t>(1ULL << 63));
+  const __m256i t = _mm256_xor_si256(
+      _mm256_set1_epi64x(static_cast<int64_t>(target)), sign);
+  for (; i + 4 <= n; i += 4) {
+    const __m256i v = _mm256_xor_si256(
+        _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(p + i * sizeof(uint64_t))),
+        sign);
+    // v < t, or NOT(v > t) for v <= t
+    const __m256i lanes = or_equal ? _mm256_cmpgt_epi64(v, t)
+                                   : _mm256_cmpgt_epi64(t, v);
+    const int mask = _mm256_movemask_pd(_mm256_castsi256_pd(lanes));
+    const int matches = BitsSetToOne(static_cast<uint32_t>(mask));
+    count += or_equal ? 4 - matches : matches;
+    if (matches != (or_equal ? 0 : 4)) {
+      // Sorted, so no later entry can match either.
+      return count;
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    const uint64_t v = DecodeFixed64(p + i * sizeof(uint64_t));
+    if (v < target || (or_equal && v == target)) {
+      ++count;
+    } else {
+      break;
+    }
+  }
+  return count;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
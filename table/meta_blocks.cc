@@ -164,9 +164,16 @@ void PropertyBlockBuilder::AddTableProperty(const TableProperties& props) {
     Add(TablePropertiesNames::kSequenceNumberTimeMapping,
         props.seqno_to_time_mapping);
   }
+  if (!props.data_block_compression_counts.empty()) {
+    Add(TablePropertiesNames::kDataBlockCompressionCounts,
+        props.data_block_compression_counts);
+  }
   if (props.key_largest_seqno != UINT64_MAX) {
     Add(TablePropertiesNames::kKeyLargestSeqno, props.key_largest_seqno);
   }
+  if (props.compression_dict_id != 0) {
+    Add(TablePropertiesNames::kCompressionDictId, props.compression_dict_id);
+  }
 }
 
 Slice PropertyBlockBuilder::Finish() {
@@ -311,6 +318,8 @@ Status ParsePropertiesBlock(
        &new_table_properties->user_defined_timestamps_persisted},
       {TablePropertiesNames::kKeyLargestSeqno,
        &new_table_properties->key_largest_seqno},
+      {TablePropertiesNames::kCompressionDictId,
+       &new_table_properties->compression_dict_id},
   };
 
   Status s;
@@ -381,6 +390,8 @@ Status ParsePropertiesBlock(
       new_table_properties->compression_options = raw_val.ToString();
     } else if (key == TablePropertiesNames::kSequenceNumberTimeMapping) {
       new_table_properties->seqno_to_time_mapping = raw_val.ToString();
+    } else if (key == TablePropertiesNames::kDataBlockCompressionCounts) {
+      new_table_properties->data_block_compression_counts = raw_val.ToString();
     } else {
       // handle user-collected properties
       new_table_properties->user_collected_properties.insert(
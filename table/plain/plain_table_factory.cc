@@ -206,6 +206,21 @@ static int RegisterBuiltinMemTableRepFactory(ObjectLibrary& library,
         }
         return guard->get();
       });
+  library.AddFactory<MemTableRepFactory>(
+      AsPattern("RangePartitionedSkipListRepFactory",
+                "range_partitioned_skip_list"),
+      [](const std::string& uri, std::unique_ptr<MemTableRepFactory>* guard,
+         std::string* /*errmsg*/) {
+        // Expecting format:
+        // range_partitioned_skip_list:<num_learned_partitions>
+        RangePartitionedSkipListRepOptions options;
+        auto colon = uri.find(':');
+        if (colon != std::string::npos) {
+          options.num_learned_partitions = ParseSizeT(uri.substr(colon + 1));
+        }
+        guard->reset(NewRangePartitionedSkipListRepFactory(options));
+        return guard->get();
+      });
   library.AddFactory<MemTableRepFactory>(
       "cuckoo",
       [](const std::string& /*uri*/,
@@ -5,12 +5,16 @@
 
 #include "rocksdb/sst_file_writer.h"
 
+#include <limits>
 #include <vector>
 
+#include "db/blob/blob_file_addition.h"
+#include "db/blob/blob_file_builder.h"
 #include "db/db_impl/db_impl.h"
 #include "db/dbformat.h"
 #include "db/wide/wide_column_serialization.h"
 #include "db/wide/wide_columns_helper.h"
+#include "file/filename.h"
 #include "file/writable_file_writer.h"
 #include "rocksdb/file_system.h"
 #include "rocksdb/table.h"
@@ -24,6 +28,8 @@ const std::string ExternalSstFilePropertyNames::kVersion =
     "rocksdb.external_sst_file.version";
 const std::string ExternalSstFilePropertyNames::kGlobalSeqno =
     "rocksdb.external_sst_file.global_seqno";
+const std::string ExternalSstFilePropertyNames::kBlobFileAddition =
+    "rocksdb.external_sst_file.blob_file_addition";
 
 const size_t kFadviseTrigger = 1024 * 1024;  // 1MB
 
@@ -72,6 +78,49 @@ struct SstFileWriter::Rep {
   uint64_t next_file_number = 1;
   size_t ts_sz;
   bool strip_timestamp;
+  // Set by OpenWithBlobFile(). The options outlive the builder, which refers
+  // to them.
+  std::unique_ptr<ImmutableOptions> blob_ioptions;
+  std::unique_ptr<MutableCFOptions> blob_mutable_cf_options;
+  FileOptions blob_file_options;
+  std::unique_ptr<BlobFileBuilder> blob_file_builder;
+  std::vector<std::string> blob_file_paths;
+  std::vector<BlobFileAddition> blob_file_additions;
+  std::string blob_index;
+  // Read by SstFileWriterPropertiesCollector
+  std::string encoded_blob_file_addition;
+
+  Status FinishBlobFile() {
+    if (!blob_file_builder) {
+      return Status::OK();
+    }
+    Status s = blob_file_builder->Finish();
+    blob_file_builder.reset();
+    if (s.ok() && !blob_file_additions.empty()) {
+      // A single blob file per sst file, see OpenWithBlobFile()
+      assert(blob_file_additions.size() == 1);
+      const BlobFileAddition& addition = blob_file_additions.front();
+      addition.EncodeTo(&encoded_blob_file_addition);
+      file_info.blob_file_path = blob_file_paths.front();
+      file_info.blob_file_number = addition.GetBlobFileNumber();
+    }
+    return s;
+  }
+
+  void AbandonBlobFile(const Status& s) {
+    if (blob_file_builder) {
+      blob_file_builder->Abandon(s);
+      blob_file_builder.reset();
+    }
+    for (const std::string& path : blob_file_paths) {
+      ioptions.env->DeleteFile(path).PermitUncheckedError();
+    }
+    blob_file_paths.clear();
+    blob_file_additions.clear();
+    encoded_blob_file_addition.clear();
+    file_info.blob_file_path.clear();
+    file_info.blob_file_number = 0;
+  }
 
   Status AddImpl(const Slice& user_key, const Slice& value,
                  ValueType value_type) {
@@ -109,11 +158,24 @@ struct SstFileWriter::Rep {
            value_type == kTypeDeletionWithTimestamp ||
            value_type == kTypeWideColumnEntity);
 
+    Slice value_to_add = value;
+    if (blob_file_builder && value_type == kTypeValue) {
+      blob_index.clear();
+      Status s = blob_file_builder->Add(user_key, value, &blob_index);
+      if (!s.ok()) {
+        return s;
+      }
+      if (!blob_index.empty()) {
+        value_type = kTypeBlobIndex;
+        value_to_add = blob_index;
+      }
+    }
+
     constexpr SequenceNumber sequence_number = 0;
 
     ikey.Set(user_key, sequence_number, value_type);
 
-    builder->Add(ikey.Encode(), value);
+    builder->Add(ikey.Encode(), value_to_add);
 
     // update file info
     file_info.num_entries++;
@@ -323,6 +385,7 @@ SstFileWriter::~SstFileWriter() {
     // User did not call Finish() or Finish() failed, we need to
     // abandon the builder.
     rep_->builder->Abandon();
+    rep_->AbandonBlobFile(Status::Incomplete("SstFileWriter not finished"));
   }
 }
 
@@ -363,8 +426,9 @@ Status SstFileWriter::Open(const std::string& file_path, Temperature temp) {
 
   // SstFileWriter properties collector to add SstFileWriter version.
   internal_tbl_prop_coll_factories.emplace_back(
-      new SstFileWriterPropertiesCollectorFactory(2 /* version */,
-                                                  0 /* global_seqno*/));
+      new SstFileWriterPropertiesCollectorFactory(
+          2 /* version */, 0 /* global_seqno*/,
+          &r->encoded_blob_file_addition));
 
   // User collector factories
   auto user_collector_factories =
@@ -421,6 +485,50 @@ Status SstFileWriter::Open(const std::string& file_path, Temperature temp) {
   r->file_info = ExternalSstFileInfo();
   r->file_info.file_path = file_path;
   r->file_info.version = 2;
+  r->blob_file_builder.reset();
+  r->blob_file_paths.clear();
+  r->blob_file_additions.clear();
+  r->encoded_blob_file_addition.clear();
+  return s;
+}
+
+Status SstFileWriter::OpenWithBlobFile(const std::string& file_path,
+                                       uint64_t blob_file_number,
+                                       Temperature temp) {
+  if (blob_file_number == kInvalidBlobFileNumber) {
+    return Status::InvalidArgument("Invalid blob file number");
+  }
+  Status s = Open(file_path, temp);
+  if (!s.ok()) {
+    return s;
+  }
+
+  Rep* r = rep_.get();
+  // The blob file goes next to the sst file
+  const size_t dir_end = file_path.find_last_of('/');
+  std::string dir =
+      dir_end == std::string::npos ? "." : file_path.substr(0, dir_end);
+  r->blob_ioptions.reset(new ImmutableOptions(r->ioptions));
+  r->blob_ioptions->cf_paths = {DbPath(dir, 0)};
+  r->blob_mutable_cf_options.reset(
+      new MutableCFOptions(r->mutable_cf_options));
+  // The sst file references a single blob file, with the given number
+  r->blob_mutable_cf_options->blob_file_size =
+      std::numeric_limits<uint64_t>::max();
+  r->blob_mutable_cf_options->prepopulate_blob_cache =
+      PrepopulateBlobCache::kDisable;
+  r->blob_file_options = FileOptions(r->env_options);
+  r->blob_file_options.temperature = temp;
+  const uint32_t cf_id = r->cfh != nullptr ? r->cfh->GetID() : 0;
+  r->blob_file_builder.reset(new BlobFileBuilder(
+      [blob_file_number]() { return blob_file_number; },
+      r->ioptions.env->GetFileSystem().get(), r->blob_ioptions.get(),
+      r->blob_mutable_cf_options.get(), &r->blob_file_options,
+      &r->write_options, "SST Writer" /* db_id */, r->db_session_id,
+      0 /* job_id */, cf_id, r->column_family_name,
+      Env::WLTH_NOT_SET /* write_hint */, nullptr /* io_tracer */,
+      nullptr /* blob_callback */, BlobFileCreationReason::kFlush,
+      &r->blob_file_paths, &r->blob_file_additions));
   return s;
 }
 
@@ -475,7 +583,13 @@ Status SstFileWriter::Finish(ExternalSstFileInfo* file_info) {
     return Status::InvalidArgument("Cannot create sst file with no entries");
   }
 
-  Status s = r->builder->Finish();
+  // The blob file is finished first, as the table properties record it
+  Status s = r->FinishBlobFile();
+  if (s.ok()) {
+    s = r->builder->Finish();
+  } else {
+    r->builder->Abandon();
+  }
   r->file_info.file_size = r->builder->FileSize();
 
   IOOptions opts;
@@ -496,6 +610,7 @@ Status SstFileWriter::Finish(ExternalSstFileInfo* file_info) {
   }
   if (!s.ok()) {
     r->ioptions.env->DeleteFile(r->file_info.file_path);
+    r->AbandonBlobFile(s);
   }
 
   if (file_info != nullptr) {
@@ -19,15 +19,21 @@ struct ExternalSstFilePropertyNames {
   static const std::string kVersion;
   // value of this property is a fixed uint64 number.
   static const std::string kGlobalSeqno;
+  // value of this property is an encoded BlobFileAddition of the companion
+  // blob file. Only present if the file references a blob file.
+  static const std::string kBlobFileAddition;
 };
 
 // PropertiesCollector used to add properties specific to tables
 // generated by SstFileWriter
 class SstFileWriterPropertiesCollector : public InternalTblPropColl {
  public:
-  explicit SstFileWriterPropertiesCollector(int32_t version,
-                                            SequenceNumber global_seqno)
-      : version_(version), global_seqno_(global_seqno) {}
+  explicit SstFileWriterPropertiesCollector(
+      int32_t version, SequenceNumber global_seqno,
+      const std::string* blob_file_addition = nullptr)
+      : version_(version),
+        global_seqno_(global_seqno),
+        blob_file_addition_(blob_file_addition) {}
 
   Status InternalAdd(const Slice& /*key*/, const Slice& /*value*/,
                      uint64_t /*file_size*/) override {
@@ -55,6 +61,12 @@ class SstFileWriterPropertiesCollector : public InternalTblPropColl {
     PutFixed64(&seqno_val, static_cast<uint64_t>(global_seqno_));
     properties->insert({ExternalSstFilePropertyNames::kGlobalSeqno, seqno_val});
 
+    // Companion blob file
+    if (blob_file_addition_ != nullptr && !blob_file_addition_->empty()) {
+      properties->insert({ExternalSstFilePropertyNames::kBlobFileAddition,
+                          *blob_file_addition_});
+    }
+
     return Status::OK();
   }
 
@@ -69,20 +81,26 @@ class SstFileWriterPropertiesCollector : public InternalTblPropColl {
  private:
   int32_t version_;
   SequenceNumber global_seqno_;
+  // Set once the blob file is finished, before the table is
+  const std::string* blob_file_addition_;
 };
 
 class SstFileWriterPropertiesCollectorFactory
     : public InternalTblPropCollFactory {
  public:
-  explicit SstFileWriterPropertiesCollectorFactory(int32_t version,
-                                                   SequenceNumber global_seqno)
-      : version_(version), global_seqno_(global_seqno) {}
+  explicit SstFileWriterPropertiesCollectorFactory(
+      int32_t version, SequenceNumber global_seqno,
+      const std::string* blob_file_addition = nullptr)
+      : version_(version),
+        global_seqno_(global_seqno),
+        blob_file_addition_(blob_file_addition) {}
 
   InternalTblPropColl* CreateInternalTblPropColl(
       uint32_t /*column_family_id*/, int /* level_at_creation */,
       int /* num_levels */,
       SequenceNumber /* last_level_inclusive_max_seqno_threshold */) override {
-    return new SstFileWriterPropertiesCollector(version_, global_seqno_);
+    return new SstFileWriterPropertiesCollector(version_, global_seqno_,
+                                                blob_file_addition_);
   }
 
   const char* Name() const override {
@@ -92,6 +110,7 @@ class SstFileWriterPropertiesCollectorFactory
  private:
   int32_t version_;
   SequenceNumber global_seqno_;
+  const std::string* blob_file_addition_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
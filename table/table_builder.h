@@ -27,6 +27,8 @@
 
 namespace ROCKSDB_NAMESPACE {
 
+class CompressionDictRegistry;
+class CompressionThreadPool;
 class Slice;
 class Status;
 
@@ -163,6 +165,18 @@ struct TableBuilderOptions : public TablePropertiesCollectorFactory::Context {
   // in the table options of the ioptions.table_factory
   bool skip_filters = false;
   const uint64_t cur_file_num;
+
+  // When set, BlockBasedTableBuilder compresses data blocks in parallel with
+  // the threads of this pool, shared by the flushes and compactions of the
+  // DB, instead of compression_opts.parallel_threads threads of its own.
+  CompressionThreadPool* compression_pool = nullptr;
+  // Whether the pool should serve this table before others, e.g. for a flush
+  // holding up writes.
+  bool compression_urgent = false;
+  // When set and compression_opts.use_shared_dict, BlockBasedTableBuilder
+  // uses (and samples data for) dictionaries shared through this registry,
+  // rather than training one for the table.
+  CompressionDictRegistry* compression_dict_registry = nullptr;
 };
 
 // TableBuilder provides the interface used to build a Table
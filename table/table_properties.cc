@@ -116,6 +116,10 @@ std::string TableProperties::ToString(const std::string& prop_delim,
                  prop_delim, kv_delim);
   AppendProperty(result, "largest sequence number in file", key_largest_seqno,
                  prop_delim, kv_delim);
+  if (compression_dict_id != 0) {
+    AppendProperty(result, "compression dictionary ID", compression_dict_id,
+                   prop_delim, kv_delim);
+  }
 
   AppendProperty(
       result, "merge operator name",
@@ -137,6 +141,11 @@ std::string TableProperties::ToString(const std::string& prop_delim,
       compression_options.empty() ? std::string("N/A") : compression_options,
       prop_delim, kv_delim);
 
+  if (!data_block_compression_counts.empty()) {
+    AppendProperty(result, "data block compression counts",
+                   data_block_compression_counts, prop_delim, kv_delim);
+  }
+
   AppendProperty(result, "creation time", creation_time, prop_delim, kv_delim);
 
   AppendProperty(result, "time stamp of earliest key", oldest_key_time,
@@ -240,7 +249,8 @@ std::size_t TableProperties::ApproximateMemoryUsage() const {
       column_family_name.size() + filter_policy_name.size() +
       comparator_name.size() + merge_operator_name.size() +
       prefix_extractor_name.size() + property_collectors_names.size() +
-      compression_name.size() + compression_options.size();
+      compression_name.size() + compression_options.size() +
+      data_block_compression_counts.size();
   usage += string_props_mem_usage;
 
   for (auto iter = user_collected_properties.begin();
@@ -320,6 +330,10 @@ const std::string TablePropertiesNames::kUserDefinedTimestampsPersisted =
     "rocksdb.user.defined.timestamps.persisted";
 const std::string TablePropertiesNames::kKeyLargestSeqno =
     "rocksdb.key.largest.seqno";
+const std::string TablePropertiesNames::kCompressionDictId =
+    "rocksdb.compression.dict.id";
+const std::string TablePropertiesNames::kDataBlockCompressionCounts =
+    "rocksdb.data.block.compression.counts";
 
 static std::unordered_map<std::string, OptionTypeInfo>
     table_properties_type_info = {
@@ -434,6 +448,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct TableProperties, key_largest_seqno),
           OptionType::kUInt64T, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"compression_dict_id",
+         {offsetof(struct TableProperties, compression_dict_id),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"db_id",
          {offsetof(struct TableProperties, db_id), OptionType::kEncodedString}},
         {"db_session_id",
@@ -469,6 +487,9 @@ static std::unordered_map<std::string, OptionTypeInfo>
         {"seqno_to_time_mapping",
          {offsetof(struct TableProperties, seqno_to_time_mapping),
           OptionType::kEncodedString}},
+        {"data_block_compression_counts",
+         {offsetof(struct TableProperties, data_block_compression_counts),
+          OptionType::kEncodedString}},
         {"user_collected_properties",
          OptionTypeInfo::StringMap(
              offsetof(struct TableProperties, user_collected_properties),
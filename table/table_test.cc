@@ -72,6 +72,8 @@
 #include "test_util/testutil.h"
 #include "util/coding_lean.h"
 #include "util/compression.h"
+#include "util/compression_dict_registry.h"
+#include "util/compression_thread_pool.h"
 #include "util/file_checksum_helper.h"
 #include "util/random.h"
 #include "util/string_util.h"
@@ -381,13 +383,15 @@ class TableConstructor : public Constructor {
     std::string column_family_name;
     const ReadOptions read_options;
     const WriteOptions write_options;
-    builder.reset(moptions.table_factory->NewTableBuilder(
-        TableBuilderOptions(
-            ioptions, moptions, read_options, write_options,
-            internal_comparator, &internal_tbl_prop_coll_factories,
-            options.compression, options.compression_opts, kUnknownColumnFamily,
-            column_family_name, level_, kUnknownNewestKeyTime),
-        file_writer_.get()));
+    TableBuilderOptions tbo(
+        ioptions, moptions, read_options, write_options, internal_comparator,
+        &internal_tbl_prop_coll_factories, options.compression,
+        options.compression_opts, kUnknownColumnFamily, column_family_name,
+        level_, kUnknownNewestKeyTime);
+    tbo.compression_pool = compression_pool_;
+    tbo.compression_dict_registry = compression_dict_registry_;
+    builder.reset(
+        moptions.table_factory->NewTableBuilder(tbo, file_writer_.get()));
 
     for (const auto& kv : kv_map) {
       if (convert_to_internal_key_) {
@@ -470,6 +474,9 @@ class TableConstructor : public Constructor {
 
   BlockCacheTracer block_cache_tracer_;
   Env* env_;
+  // Passed on to the table builder, see TableBuilderOptions
+  CompressionThreadPool* compression_pool_ = nullptr;
+  CompressionDictRegistry* compression_dict_registry_ = nullptr;
 
  private:
   void Reset() {
@@ -2663,6 +2670,101 @@ TEST_P(BlockBasedTableTest, HashIndexTest) {
   IndexTest(table_options);
 }
 
+TEST_P(BlockBasedTableTest, LearnedIndexTest) {
+  BlockBasedTableOptions table_options = GetBlockBasedTableOptions();
+  table_options.index_type = BlockBasedTableOptions::kLearnedIndex;
+  IndexTest(table_options);
+}
+
+TEST_P(BlockBasedTableTest, LearnedIndexSeek) {
+  // Fixed-width keys: a common prefix followed by a big-endian id. The ids
+  // jump half way through so the model needs more than one segment.
+  auto make_key = [](uint64_t id) {
+    std::string key = "session-0001";
+    for (int shift = 56; shift >= 0; shift -= 8) {
+      key.push_back(static_cast<char>((id >> shift) & 0xff));
+    }
+    return key;
+  };
+  std::vector<uint64_t> ids;
+  for (uint64_t i = 0; i < 2000; ++i) {
+    ids.push_back(i < 1000 ? i * 4 : (uint64_t{1} << 40) + i * 4);
+  }
+
+  for (int restart_interval : {1, 4}) {
+    BlockBasedTableOptions table_options = GetBlockBasedTableOptions();
+    table_options.index_type = BlockBasedTableOptions::kLearnedIndex;
+    table_options.block_size = 256;
+    table_options.index_block_restart_interval = restart_interval;
+    Options options;
+    options.compression = kNoCompression;
+    options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+    // The seeks below use kValueTypeForSeek targets, which need the real
+    // internal key ordering rather than the plain bytewise one.
+    InternalKeyComparator ikc(options.comparator);
+
+    TableConstructor c(BytewiseComparator(),
+                       true /* convert_to_internal_key */);
+    for (uint64_t id : ids) {
+      c.Add(make_key(id), std::string(32, 'v'));
+    }
+    std::vector<std::string> keys;
+    stl_wrappers::KVMap kvmap;
+    const ImmutableOptions ioptions(options);
+    const MutableCFOptions moptions(options);
+    c.Finish(options, ioptions, moptions, table_options, ikc, &keys, &kvmap);
+    ASSERT_GT(c.GetTableReader()->GetTableProperties()->num_data_blocks,
+              100u);
+
+    std::atomic<int> predicted{0};
+    std::atomic<int> fallbacks{0};
+    SyncPoint::GetInstance()->SetCallBack(
+        "IndexBlockIter::LearnedSeek:Predicted",
+        [&](void* /*arg*/) { predicted++; });
+    SyncPoint::GetInstance()->SetCallBack(
+        "IndexBlockIter::LearnedSeek:Fallback",
+        [&](void* /*arg*/) { fallbacks++; });
+    SyncPoint::GetInstance()->EnableProcessing();
+
+    ReadOptions read_options;
+    std::unique_ptr<InternalIterator> iter(c.GetTableReader()->NewIterator(
+        read_options, moptions.prefix_extractor.get(), /*arena=*/nullptr,
+        /*skip_filters=*/false, TableReaderCaller::kUncategorized));
+    auto check_seek = [&](const std::string& user_key) {
+      InternalKey target(user_key, kMaxSequenceNumber, kValueTypeForSeek);
+      iter->Seek(target.Encode());
+      ASSERT_OK(iter->status());
+      auto expected = std::lower_bound(ids.begin(), ids.end(), user_key,
+                                       [&](uint64_t id, const std::string& k) {
+                                         return make_key(id) < k;
+                                       });
+      if (expected == ids.end()) {
+        ASSERT_FALSE(iter->Valid());
+      } else {
+        ASSERT_TRUE(iter->Valid());
+        ASSERT_EQ(make_key(*expected), ExtractUserKey(iter->key()).ToString());
+      }
+    };
+    for (uint64_t id : ids) {
+      check_seek(make_key(id));
+      check_seek(make_key(id + 1));
+    }
+    check_seek("session-0000");
+    check_seek("session-0001");
+    check_seek("session-0002");
+    check_seek(make_key(uint64_t{1} << 39));
+
+    // Most seeks must be served from the predicted window.
+    ASSERT_GT(predicted.load(), 0);
+    ASSERT_LT(fallbacks.load(), predicted.load() / 10);
+
+    SyncPoint::GetInstance()->DisableProcessing();
+    SyncPoint::GetInstance()->ClearAllCallBacks();
+    iter.reset();
+    c.ResetTableReader();
+  }
+}
+
 TEST_P(BlockBasedTableTest, PartitionIndexTest) {
   const int max_index_keys = 5;
   const int est_max_index_key_value_size = 32;
@@ -5769,6 +5871,249 @@ TEST_P(BlockBasedTableTest, CompressionRatioThreshold) {
   }
 }
 
+TEST_P(BlockBasedTableTest, SharedCompressionThreadPool) {
+  BlockBasedTableOptions table_options = GetBlockBasedTableOptions();
+  table_options.block_size = 256;
+  Options options;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  ImmutableOptions ioptions(options);
+  MutableCFOptions moptions(options);
+  CompressionThreadPool pool(3);
+
+  for (CompressionType type : GetSupportedCompressions()) {
+    if (type == kNoCompression) {
+      continue;
+    }
+    SCOPED_TRACE("Compression type: " + std::to_string(type));
+    options.compression = type;
+
+    TableConstructor with_pool(BytewiseComparator(),
+                               true /* convert_to_internal_key_ */);
+    with_pool.compression_pool_ = &pool;
+    TableConstructor without_pool(BytewiseComparator(),
+                                  true /* convert_to_internal_key_ */);
+    Random rnd(301);
+    for (int i = 0; i < 2000; i++) {
+      std::string key = "key" + std::to_string(100000 + i);
+      std::string value = rnd.RandomString(20) + std::string(80, 'v');
+      with_pool.Add(key, value);
+      without_pool.Add(key, value);
+    }
+    std::vector<std::string> keys;
+    stl_wrappers::KVMap kvmap;
+    with_pool.Finish(options, ioptions, moptions, table_options,
+                     GetPlainInternalComparator(options.comparator), &keys,
+                     &kvmap);
+    without_pool.Finish(options, ioptions, moptions, table_options,
+                        GetPlainInternalComparator(options.comparator), &keys,
+                        &kvmap);
+
+    // The blocks compressed by the pool threads, in whatever order, are
+    // written in order
+    ASSERT_EQ(without_pool.TEST_GetSink()->contents(),
+              with_pool.TEST_GetSink()->contents());
+    auto props = with_pool.GetTableReader()->GetTableProperties();
+    ASSERT_GT(props->num_data_blocks, 100);
+    ASSERT_LT(props->data_size,
+              (props->raw_key_size + props->raw_value_size) * 3 / 4);
+  }
+}
+
+TEST_P(BlockBasedTableTest, AdaptiveCompression) {
+  if (!ZSTD_Supported()) {
+    ROCKSDB_GTEST_SKIP("Test requires ZSTD support");
+    return;
+  }
+  BlockBasedTableOptions table_options = GetBlockBasedTableOptions();
+  table_options.block_size = 1000;
+  Options options;
+  options.compression = kZSTD;
+  options.compression_opts.adaptive_compression_budget_pct = 50;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  ImmutableOptions ioptions(options);
+  MutableCFOptions moptions(options);
+
+  // Alternate runs of incompressible and compressible values, so that data
+  // blocks are mostly one or the other.
+  TableConstructor c(BytewiseComparator(), true /* convert_to_internal_key_ */);
+  Random rnd(301);
+  for (int i = 0; i < 400; i++) {
+    c.Add("key" + std::to_string(1000 + i),
+          (i / 20) % 2 == 0 ? rnd.RandomBinaryString(200)
+                            : std::string(200, 'a' + i % 26));
+  }
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+  c.Finish(options, ioptions, moptions, table_options,
+           GetPlainInternalComparator(options.comparator), &keys, &kvmap);
+
+  auto props = c.GetTableReader()->GetTableProperties();
+  std::map<std::string, uint64_t> counts;
+  for (const auto& entry :
+       StringSplit(props->data_block_compression_counts, ';')) {
+    if (entry.empty()) {
+      continue;
+    }
+    const size_t eq = entry.find('=');
+    ASSERT_NE(eq, std::string::npos) << entry;
+    counts[entry.substr(0, eq)] = ParseUint64(entry.substr(eq + 1));
+  }
+  uint64_t total = 0;
+  for (const auto& [_, count] : counts) {
+    total += count;
+  }
+  ASSERT_EQ(props->num_data_blocks, total);
+
+  // Incompressible blocks are not compressed, and at most half of the others
+  // (plus one for mixed blocks) are compressed with ZSTD
+  const uint64_t fast = counts["LZ4"] + counts["Snappy"];
+  ASSERT_GT(counts["NoCompression"], 0);
+  ASSERT_GT(counts["ZSTD"], 0);
+  ASSERT_LE(counts["ZSTD"], fast + 2);
+  if (LZ4_Supported()) {
+    ASSERT_GT(counts["LZ4"], 0);
+  }
+  // About half the data is compressible
+  ASSERT_LT(props->data_size,
+            (props->raw_key_size + props->raw_value_size) * 3 / 4);
+}
+
+TEST_P(BlockBasedTableTest, PreCompressionTransform) {
+  // Slowly varying floats, which compress poorly as is. Value sizes are not
+  // multiples of the element size.
+  std::vector<std::string> values;
+  for (int i = 0; i < 20; i++) {
+    std::vector<float> floats(i % 2 == 0 ? 1001 : 2001);
+    for (size_t j = 0; j < floats.size(); j++) {
+      floats[j] = 1000.0f + static_cast<float>(i * 2000 + j) / 64;
+    }
+    values.emplace_back(reinterpret_cast<const char*>(floats.data()),
+                        floats.size() * sizeof(float) - 1);
+  }
+
+  for (CompressionType type : GetSupportedCompressions()) {
+    if (type == kNoCompression) {
+      continue;
+    }
+    for (uint32_t format_version : {6, 7}) {
+      uint64_t untransformed_data_size = 0;
+      for (auto transform : {PreCompressionTransform::kNone,
+                             PreCompressionTransform::kByteShuffle,
+                             PreCompressionTransform::kBitShuffle,
+                             PreCompressionTransform::kXorDelta}) {
+        SCOPED_TRACE("Compression type: " + std::to_string(type) +
+                     " format_version " + std::to_string(format_version) +
+                     " transform " +
+                     std::to_string(static_cast<int>(transform)));
+        BlockBasedTableOptions table_options = GetBlockBasedTableOptions();
+        table_options.format_version = format_version;
+        Options options;
+        options.compression = type;
+        options.compression_opts.pre_compression_transform = transform;
+        options.compression_opts.pre_compression_element_size = 4;
+        options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+        ImmutableOptions ioptions(options);
+        MutableCFOptions moptions(options);
+
+        TableConstructor c(BytewiseComparator(),
+                           true /* convert_to_internal_key_ */);
+        for (size_t i = 0; i < values.size(); i++) {
+          c.Add("key" + std::to_string(100 + i), values[i]);
+        }
+        std::vector<std::string> keys;
+        stl_wrappers::KVMap kvmap;
+        c.Finish(options, ioptions, moptions, table_options,
+                 GetPlainInternalComparator(options.comparator), &keys,
+                 &kvmap);
+        const uint64_t data_size =
+            c.GetTableReader()->GetTableProperties()->data_size;
+        if (transform == PreCompressionTransform::kNone) {
+          untransformed_data_size = data_size;
+        } else if (format_version >= 7) {
+          ASSERT_LT(data_size, untransformed_data_size);
+        } else {
+          // Not supported by the format, so not applied
+          ASSERT_EQ(data_size, untransformed_data_size);
+        }
+
+        // The transform is recorded with each block, so reading does not
+        // depend on the options
+        std::unique_ptr<InternalIterator> iter(c.NewIterator(nullptr));
+        size_t i = 0;
+        for (iter->SeekToFirst(); iter->Valid(); iter->Next(), i++) {
+          ASSERT_EQ(values[i], iter->value().ToString());
+        }
+        ASSERT_OK(iter->status());
+        ASSERT_EQ(values.size(), i);
+      }
+    }
+  }
+}
+
+TEST_P(BlockBasedTableTest, SharedCompressionDict) {
+  if (!ZSTD_Supported()) {
+    ROCKSDB_GTEST_SKIP("Test requires ZSTD support");
+    return;
+  }
+  BlockBasedTableOptions table_options = GetBlockBasedTableOptions();
+  table_options.block_size = 1024;
+  table_options.verify_compression = true;
+  Options options;
+  options.compression = kZSTD;
+  options.compression_opts.max_dict_bytes = 4096;
+  options.compression_opts.use_shared_dict = true;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  ImmutableOptions ioptions(options);
+  MutableCFOptions moptions(options);
+  CompressionDictRegistry registry;
+
+  // Builds a table of similar values with the given registry, returning its
+  // properties after checking its contents
+  auto build = [&](int file, CompressionDictRegistry* dict_registry) {
+    TableConstructor c(BytewiseComparator(),
+                       true /* convert_to_internal_key_ */);
+    c.compression_dict_registry_ = dict_registry;
+    Random rnd(301 + file);
+    for (int i = 0; i < 100; i++) {
+      c.Add("key" + std::to_string(file * 1000 + i),
+            "value" + std::to_string(i % 7) + rnd.RandomString(8) +
+                std::string(40, 'a' + i % 5));
+    }
+    std::vector<std::string> keys;
+    stl_wrappers::KVMap kvmap;
+    c.Finish(options, ioptions, moptions, table_options,
+             GetPlainInternalComparator(options.comparator), &keys, &kvmap);
+    // Each file stores its dictionary, so it is read without the registry
+    std::unique_ptr<InternalIterator> iter(c.NewIterator(nullptr));
+    auto expected = kvmap.begin();
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++expected) {
+      EXPECT_EQ(expected->second, iter->value().ToString());
+    }
+    EXPECT_OK(iter->status());
+    EXPECT_TRUE(expected == kvmap.end());
+    return *c.GetTableReader()->GetTableProperties();
+  };
+
+  // The first file trains the shared dictionary, which the next ones use
+  // without training their own
+  TableProperties first = build(0, &registry);
+  ASSERT_EQ(0, first.compression_dict_id);
+  ASSERT_GT(registry.ApproximateMemoryUsage(), 0);
+  TableProperties second = build(1, &registry);
+  ASSERT_NE(0, second.compression_dict_id);
+  TableProperties third = build(2, &registry);
+  ASSERT_EQ(second.compression_dict_id, third.compression_dict_id);
+
+  // The dictionary shrinks the small blocks compared to compressing each on
+  // its own
+  options.compression_opts.max_dict_bytes = 0;
+  options.compression_opts.use_shared_dict = false;
+  TableProperties no_dict = build(1, nullptr);
+  ASSERT_EQ(0, no_dict.compression_dict_id);
+  ASSERT_EQ(second.num_data_blocks, no_dict.num_data_blocks);
+  ASSERT_LT(second.data_size, no_dict.data_size);
+}
+
 TEST_P(BlockBasedTableTest, PropertiesMetaBlockLast) {
   // The properties meta-block should come at the end since we always need to
   // read it when opening a file, unlike index/filter/other meta-blocks, which
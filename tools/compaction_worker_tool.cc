@@ -0,0 +1,168 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "rocksdb/compaction_worker_tool.h"
+
+#include <signal.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "rocksdb/convenience.h"
+#include "rocksdb/db.h"
+#include "rocksdb/env.h"
+#include "rocksdb/utilities/options_util.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+std::atomic<bool> canceled{false};
+
+extern "C" void HandleTermination(int /*sig*/) {
+  canceled.store(true, std::memory_order_release);
+}
+
+void PrintHelp() {
+  fprintf(stderr, R"(compaction_worker --db=<db> --input_file=<file>
+    --output_dir=<dir> --result_file=<file> [--column_family=<cf>]
+    [--options=<options to override>]
+
+Runs a compaction scheduled through a CompactionService, such as the one
+returned by NewLocalCompactionService(), with DB::OpenAndCompact().
+
+    --db=<db>
+      Path of the DB the compaction is scheduled for
+
+    --column_family=<cf>
+      Column family of the compaction, default "default". Its comparator,
+      merge operator, table factory, etc. are loaded from the DB's latest
+      OPTIONS file, so these need to be built in or registered.
+
+    --input_file=<file>
+      File holding the serialized compaction input
+
+    --output_dir=<dir>
+      Directory for the output files
+
+    --result_file=<file>
+      File to write the serialized compaction result to
+
+    --options=<options to override>
+      e.g. "max_subcompactions=1;compression=kZSTD"
+
+Exits with 0 on success. SIGTERM cancels the compaction.
+)");
+}
+
+bool GetArg(const char* arg, const char* name, std::string* value) {
+  const size_t len = strlen(name);
+  if (strncmp(arg, name, len) != 0) {
+    return false;
+  }
+  *value = arg + len;
+  return true;
+}
+
+}  // namespace
+
+int CompactionWorkerTool::Run(int argc, char const* const* argv) {
+  std::string db_path;
+  std::string cf_name = kDefaultColumnFamilyName;
+  std::string input_file;
+  std::string output_dir;
+  std::string result_file;
+  std::string options_str;
+  for (int i = 1; i < argc; i++) {
+    if (GetArg(argv[i], "--db=", &db_path) ||
+        GetArg(argv[i], "--column_family=", &cf_name) ||
+        GetArg(argv[i], "--input_file=", &input_file) ||
+        GetArg(argv[i], "--output_dir=", &output_dir) ||
+        GetArg(argv[i], "--result_file=", &result_file) ||
+        GetArg(argv[i], "--options=", &options_str)) {
+      continue;
+    }
+    if (strcmp(argv[i], "--help") != 0) {
+      fprintf(stderr, "Unrecognized argument '%s'\n\n", argv[i]);
+    }
+    PrintHelp();
+    return 1;
+  }
+  if (db_path.empty() || input_file.empty() || output_dir.empty() ||
+      result_file.empty()) {
+    PrintHelp();
+    return 1;
+  }
+
+  signal(SIGTERM, HandleTermination);
+  signal(SIGINT, HandleTermination);
+
+  Env* env = Env::Default();
+  std::string input;
+  Status s = ReadFileToString(env, input_file, &input);
+
+  // The DB's objects that cannot be overridden by name
+  CompactionServiceOptionsOverride override_options;
+  ConfigOptions config_options;
+  config_options.env = env;
+  config_options.ignore_unknown_options = true;
+  DBOptions db_options;
+  std::vector<ColumnFamilyDescriptor> cf_descs;
+  if (s.ok()) {
+    s = LoadLatestOptions(config_options, db_path, &db_options, &cf_descs);
+  }
+  if (s.ok()) {
+    s = Status::InvalidArgument("Column family not found: " + cf_name);
+    for (const ColumnFamilyDescriptor& cf : cf_descs) {
+      if (cf.name == cf_name) {
+        const ColumnFamilyOptions& cf_options = cf.options;
+        override_options.comparator = cf_options.comparator;
+        override_options.merge_operator = cf_options.merge_operator;
+        override_options.compaction_filter = cf_options.compaction_filter;
+        override_options.compaction_filter_factory =
+            cf_options.compaction_filter_factory;
+        override_options.prefix_extractor = cf_options.prefix_extractor;
+        override_options.table_factory = cf_options.table_factory;
+        override_options.sst_partitioner_factory =
+            cf_options.sst_partitioner_factory;
+        override_options.compaction_value_transformer =
+            cf_options.compaction_value_transformer;
+        override_options.table_properties_collector_factories =
+            cf_options.table_properties_collector_factories;
+        s = Status::OK();
+        break;
+      }
+    }
+  }
+  if (s.ok() && !options_str.empty()) {
+    s = StringToMap(options_str, &override_options.options_map);
+  }
+
+  std::string result;
+  if (s.ok()) {
+    OpenAndCompactOptions open_and_compact_options;
+    open_and_compact_options.canceled = &canceled;
+    s = DB::OpenAndCompact(open_and_compact_options, db_path, output_dir,
+                           input, &result, override_options);
+  }
+  if (!result.empty()) {
+    // Carries the status of the compaction
+    Status write_status = WriteStringToFile(env, result, result_file,
+                                            true /* should_sync */);
+    if (s.ok()) {
+      s = write_status;
+    }
+  }
+  if (!s.ok()) {
+    fprintf(stderr, "%s\n", s.ToString().c_str());
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
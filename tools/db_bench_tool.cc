@@ -503,6 +503,16 @@ DEFINE_uint64(subcompactions, 1,
 static const bool FLAGS_subcompactions_dummy __attribute__((__unused__)) =
     RegisterFlagValidator(&FLAGS_subcompactions, &ValidateUint32Range);
 
+DEFINE_uint32(subcompaction_ranges_per_thread,
+              ROCKSDB_NAMESPACE::Options().subcompaction_ranges_per_thread,
+              "Number of key ranges per subcompaction thread to split "
+              "compactions into, taken by the threads as they become free.");
+
+DEFINE_bool(preempt_bottommost_compactions,
+            ROCKSDB_NAMESPACE::Options().preempt_bottommost_compactions,
+            "Preempt bottommost compactions for urgent flushes and L0 "
+            "compactions during write stalls.");
+
 DEFINE_int32(max_background_flushes,
              ROCKSDB_NAMESPACE::Options().max_background_flushes,
              "The maximum number of concurrent background flushes"
@@ -646,6 +656,10 @@ DEFINE_bool(partition_index, false, "Partition index blocks");
 
 DEFINE_bool(index_with_first_key, false, "Include first key in the index");
 
+DEFINE_bool(use_learned_index, false,
+            "Use a learned model over the index block (kLearnedIndex) to "
+            "narrow index binary search");
+
 DEFINE_bool(
     optimize_filters_for_memory,
     ROCKSDB_NAMESPACE::BlockBasedTableOptions().optimize_filters_for_memory,
@@ -726,6 +740,14 @@ DEFINE_double(data_block_hash_table_util_ratio, 0.75,
               "This is only valid if use_data_block_hash_index is "
               "set to true");
 
+DEFINE_bool(data_block_restart_key_prefixes, false,
+            "Store 8-byte restart key prefixes in data blocks to narrow "
+            "seeks within a block. This is valid if only we use BlockTable");
+
+DEFINE_bool(data_block_columnar_entities, false,
+            "Store wide-column entities column by column in data blocks. "
+            "This is valid if only we use BlockTable");
+
 DEFINE_int64(compressed_cache_size, -1,
              "Number of bytes to use as a cache of compressed data.");
 
@@ -742,10 +764,19 @@ DEFINE_int32(file_opening_threads,
              "If open_files is set to -1, this option set the number of "
              "threads that will be used to open files during DB::Open()");
 
+DEFINE_int32(compression_threads,
+             ROCKSDB_NAMESPACE::Options().compression_threads,
+             "Number of threads shared by flushes and compactions to compress "
+             "data blocks in parallel");
+
 DEFINE_uint64(compaction_readahead_size,
               ROCKSDB_NAMESPACE::Options().compaction_readahead_size,
               "Compaction readahead size");
 
+DEFINE_bool(compaction_async_io,
+            ROCKSDB_NAMESPACE::Options().compaction_async_io,
+            "Read ahead compaction inputs with async IO");
+
 DEFINE_int32(log_readahead_size, 0, "WAL and manifest readahead size");
 
 DEFINE_int32(writable_file_max_buffer_size, 1024 * 1024,
@@ -765,6 +796,14 @@ DEFINE_bool(memtable_whole_key_filtering, false,
 DEFINE_bool(memtable_use_huge_page, false,
             "Try to use huge page in memtables.");
 
+DEFINE_bool(memtable_use_transparent_huge_pages,
+            ROCKSDB_NAMESPACE::Options().memtable_use_transparent_huge_pages,
+            "Advise transparent huge pages for memtable arena blocks.");
+
+DEFINE_bool(memtable_prefault_arena,
+            ROCKSDB_NAMESPACE::Options().memtable_prefault_arena,
+            "Fault in memtable arena blocks when they are allocated.");
+
 DEFINE_bool(whole_key_filtering,
             ROCKSDB_NAMESPACE::BlockBasedTableOptions().whole_key_filtering,
             "Use whole keys (in addition to prefixes) in SST bloom filter.");
@@ -845,6 +884,10 @@ DEFINE_bool(disable_wal, false, "If true, do not write WAL for write.");
 DEFINE_bool(manual_wal_flush, false,
             "If true, buffer WAL until buffer is full or a manual FlushWAL().");
 
+DEFINE_uint64(num_wal_streams,
+              ROCKSDB_NAMESPACE::Options().num_wal_streams,
+              "Number of WAL files written (and synced) in parallel.");
+
 DEFINE_string(wal_compression, "none",
               "Algorithm to use for WAL compression. none to disable.");
 static enum ROCKSDB_NAMESPACE::CompressionType FLAGS_wal_compression_e =
@@ -872,6 +915,11 @@ DEFINE_uint64(max_bytes_for_level_base,
 DEFINE_bool(level_compaction_dynamic_level_bytes, false,
             "Whether level size base is dynamic");
 
+DEFINE_double(level_compaction_l0_tiering_ratio,
+              ROCKSDB_NAMESPACE::Options().level_compaction_l0_tiering_ratio,
+              "If positive, merge L0 key ranges overlapping more than this "
+              "many times their size in the base level within L0");
+
 DEFINE_double(max_bytes_for_level_multiplier, 10,
               "A multiplier to compute max bytes for level-N (N >= 2)");
 
@@ -1383,6 +1431,23 @@ DEFINE_bool(compression_use_zstd_dict_trainer,
             "If true, use ZSTD_TrainDictionary() to create dictionary, else"
             "use ZSTD_FinalizeDictionary() to create dictionary");
 
+DEFINE_bool(compression_use_shared_dict,
+            ROCKSDB_NAMESPACE::CompressionOptions().use_shared_dict,
+            "If true, table files share dictionaries trained in the "
+            "background from sampled data blocks, instead of each training "
+            "its own");
+
+DEFINE_int32(compression_pre_transform, 0,
+             "PreCompressionTransform applied to blocks before compressing "
+             "them: 0 = none, 1 = byte shuffle, 2 = bit shuffle, 3 = XOR "
+             "delta");
+
+DEFINE_uint32(compression_pre_transform_element_size,
+              ROCKSDB_NAMESPACE::CompressionOptions()
+                  .pre_compression_element_size,
+              "Size in bytes of the elements transformed with "
+              "--compression_pre_transform");
+
 static bool ValidateTableCacheNumshardbits(const char* flagname,
                                            int32_t value) {
   if (0 >= value || value >= 20) {
@@ -1464,6 +1529,9 @@ DEFINE_uint64(delayed_write_rate, 8388608u,
 DEFINE_bool(enable_pipelined_write, true,
             "Allow WAL and memtable writes to be pipelined");
 
+DEFINE_bool(enable_wal_writer_thread, false,
+            "Write the WAL from a dedicated thread with pipelined writes");
+
 DEFINE_bool(
     unordered_write, false,
     "Enable the unordered write feature, which provides higher throughput but "
@@ -4252,6 +4320,12 @@ class Benchmark {
         FLAGS_compression_max_dict_buffer_bytes;
     options.compression_opts.use_zstd_dict_trainer =
         FLAGS_compression_use_zstd_dict_trainer;
+    options.compression_opts.use_shared_dict =
+        FLAGS_compression_use_shared_dict;
+    options.compression_opts.pre_compression_transform =
+        static_cast<PreCompressionTransform>(FLAGS_compression_pre_transform);
+    options.compression_opts.pre_compression_element_size =
+        FLAGS_compression_pre_transform_element_size;
 
     options.max_open_files = FLAGS_open_files;
     if (FLAGS_cost_write_buffer_to_cache || FLAGS_db_write_buffer_size != 0) {
@@ -4268,6 +4342,10 @@ class Benchmark {
     options.max_background_jobs = FLAGS_max_background_jobs;
     options.max_background_compactions = FLAGS_max_background_compactions;
     options.max_subcompactions = static_cast<uint32_t>(FLAGS_subcompactions);
+    options.subcompaction_ranges_per_thread =
+        FLAGS_subcompaction_ranges_per_thread;
+    options.preempt_bottommost_compactions =
+        FLAGS_preempt_bottommost_compactions;
     options.max_background_flushes = FLAGS_max_background_flushes;
     options.compaction_style = FLAGS_compaction_style_e;
     options.compaction_pri = FLAGS_compaction_pri_e;
@@ -4277,6 +4355,7 @@ class Benchmark {
     options.use_direct_io_for_flush_and_compaction =
         FLAGS_use_direct_io_for_flush_and_compaction;
     options.manual_wal_flush = FLAGS_manual_wal_flush;
+    options.num_wal_streams = static_cast<size_t>(FLAGS_num_wal_streams);
     options.wal_compression = FLAGS_wal_compression_e;
     options.ttl = FLAGS_fifo_compaction_ttl;
     options.compaction_options_fifo = CompactionOptionsFIFO(
@@ -4295,6 +4374,9 @@ class Benchmark {
       options.info_log = std::make_shared<StderrLogger>();
     }
     options.memtable_huge_page_size = FLAGS_memtable_use_huge_page ? 2048 : 0;
+    options.memtable_use_transparent_huge_pages =
+        FLAGS_memtable_use_transparent_huge_pages;
+    options.memtable_prefault_arena = FLAGS_memtable_prefault_arena;
     options.memtable_prefix_bloom_size_ratio = FLAGS_memtable_bloom_size_ratio;
     options.memtable_whole_key_filtering = FLAGS_memtable_whole_key_filtering;
     if (FLAGS_memtable_insert_with_hint_prefix_size > 0) {
@@ -4304,7 +4386,9 @@ class Benchmark {
     }
     options.bloom_locality = FLAGS_bloom_locality;
     options.max_file_opening_threads = FLAGS_file_opening_threads;
+    options.compression_threads = FLAGS_compression_threads;
     options.compaction_readahead_size = FLAGS_compaction_readahead_size;
+    options.compaction_async_io = FLAGS_compaction_async_io;
     options.log_readahead_size = FLAGS_log_readahead_size;
     options.writable_file_max_buffer_size = FLAGS_writable_file_max_buffer_size;
     options.use_fsync = FLAGS_use_fsync;
@@ -4314,6 +4398,8 @@ class Benchmark {
     options.max_bytes_for_level_base = FLAGS_max_bytes_for_level_base;
     options.level_compaction_dynamic_level_bytes =
         FLAGS_level_compaction_dynamic_level_bytes;
+    options.level_compaction_l0_tiering_ratio =
+        FLAGS_level_compaction_l0_tiering_ratio;
     options.max_bytes_for_level_multiplier =
         FLAGS_max_bytes_for_level_multiplier;
     options.uncache_aggressiveness = FLAGS_uncache_aggressiveness;
@@ -4401,6 +4487,8 @@ class Benchmark {
       } else if (FLAGS_index_with_first_key) {
         block_based_options.index_type =
             BlockBasedTableOptions::kBinarySearchWithFirstKey;
+      } else if (FLAGS_use_learned_index) {
+        block_based_options.index_type = BlockBasedTableOptions::kLearnedIndex;
       }
       BlockBasedTableOptions::IndexShorteningMode index_shortening =
           block_based_options.index_shortening;
@@ -4510,6 +4598,10 @@ class Benchmark {
       }
       block_based_options.data_block_hash_table_util_ratio =
           FLAGS_data_block_hash_table_util_ratio;
+      block_based_options.data_block_restart_key_prefixes =
+          FLAGS_data_block_restart_key_prefixes;
+      block_based_options.data_block_columnar_entities =
+          FLAGS_data_block_columnar_entities;
       if (FLAGS_read_cache_path != "") {
         Status rc_status;
 
@@ -4647,6 +4739,7 @@ class Benchmark {
     options.enable_write_thread_adaptive_yield =
         FLAGS_enable_write_thread_adaptive_yield;
     options.enable_pipelined_write = FLAGS_enable_pipelined_write;
+    options.enable_wal_writer_thread = FLAGS_enable_wal_writer_thread;
     options.unordered_write = FLAGS_unordered_write;
     options.write_thread_max_yield_usec = FLAGS_write_thread_max_yield_usec;
     options.write_thread_slow_yield_usec = FLAGS_write_thread_slow_yield_usec;
@@ -140,11 +140,16 @@ default_params = {
     "sst_file_manager_bytes_per_truncate": lambda: random.choice([0, 1048576]),
     "long_running_snapshots": lambda: random.randint(0, 1),
     "subcompactions": lambda: random.randint(1, 4),
+    "subcompaction_ranges_per_thread": lambda: random.choice([1, 1, 4]),
+    "preempt_bottommost_compactions": lambda: random.randint(0, 1),
     "target_file_size_base": lambda: random.choice([512 * 1024, 2048 * 1024]),
     "target_file_size_multiplier": 2,
     "test_batches_snapshots": random.randint(0, 1),
     "top_level_index_pinning": lambda: random.randint(0, 3),
     "unpartitioned_pinning": lambda: random.randint(0, 3),
+    "adaptive_metadata_pinning_budget": lambda: random.choice(
+        [0, 0, 1024 * 1024]
+    ),
     "use_direct_reads": lambda: random.randint(0, 1),
     "use_direct_io_for_flush_and_compaction": lambda: random.randint(0, 1),
     "use_sqfc_for_range_queries": lambda: random.choice([0, 1, 1, 1]),
@@ -202,6 +207,7 @@ default_params = {
     # that it won't recover past the WAL data hole created by this option
     "wal_bytes_per_sync": 0,
     "compaction_readahead_size": lambda: random.choice([0, 0, 1024 * 1024]),
+    "compaction_async_io": lambda: random.choice([0, 1]),
     "db_write_buffer_size": lambda: random.choice(
         [0, 0, 0, 1024 * 1024, 8 * 1024 * 1024, 128 * 1024 * 1024]
     ),
@@ -0,0 +1,131 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "util/adaptive_compressor.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace ROCKSDB_NAMESPACE {
+
+int EstimateCompressedBytesPerKb(const Slice& data) {
+  // Sample contiguous chunks rather than single bytes so that repeated
+  // sequences within a chunk can be seen.
+  constexpr size_t kChunkSize = 32;
+  constexpr size_t kMaxChunks = 32;
+  constexpr size_t kHashBits = 10;
+  if (data.size() < 4) {
+    return 1024;
+  }
+  const size_t num_chunks =
+      std::min(kMaxChunks, (data.size() + kChunkSize - 1) / kChunkSize);
+  const size_t stride = data.size() / num_chunks;
+
+  std::array<uint32_t, 256> counts{};
+  std::array<uint32_t, size_t{1} << kHashBits> seen{};
+  size_t num_sampled = 0;
+  size_t num_sequences = 0;
+  size_t num_repeats = 0;
+  for (size_t c = 0; c < num_chunks; ++c) {
+    const char* chunk = data.data() + c * stride;
+    const size_t len = std::min(kChunkSize, data.size() - c * stride);
+    for (size_t i = 0; i < len; ++i) {
+      ++counts[static_cast<unsigned char>(chunk[i])];
+    }
+    num_sampled += len;
+    for (size_t i = 0; i + 4 <= len; ++i) {
+      uint32_t v;
+      memcpy(&v, chunk + i, sizeof(v));
+      // Zero is the empty marker; such a sequence is counted as new.
+      uint32_t& slot = seen[(v * 0x9E3779B1u) >> (32 - kHashBits)];
+      num_repeats += slot == v && v != 0;
+      slot = v;
+      ++num_sequences;
+    }
+  }
+
+  double bits_per_byte = 0;
+  size_t num_distinct = 0;
+  for (uint32_t count : counts) {
+    if (count > 0) {
+      const double p = static_cast<double>(count) / num_sampled;
+      bits_per_byte -= p * std::log2(p);
+      ++num_distinct;
+    }
+  }
+  // Miller-Madow correction of the underestimate from a small sample, which
+  // matters for (near) random data.
+  bits_per_byte += (num_distinct - 1) / (2.0 * num_sampled * std::log(2.0));
+  bits_per_byte = std::min(8.0, bits_per_byte);
+  const double unique_fraction =
+      num_sequences == 0
+          ? 1.0
+          : 1.0 - static_cast<double>(num_repeats) / num_sequences;
+  return static_cast<int>(bits_per_byte * 128 * unique_fraction + 0.5);
+}
+
+AdaptiveCompressor::AdaptiveCompressor(std::unique_ptr<Compressor> strong,
+                                       std::unique_ptr<Compressor> fast,
+                                       int max_compressed_bytes_per_kb,
+                                       uint32_t budget_pct)
+    : strong_(std::move(strong)),
+      fast_(std::move(fast)),
+      max_compressed_bytes_per_kb_(max_compressed_bytes_per_kb),
+      budget_pct_(budget_pct) {
+  assert(strong_ != nullptr);
+}
+
+Compressor::ManagedWorkingArea AdaptiveCompressor::ObtainWorkingArea() {
+  auto* wa = new AdaptiveWorkingArea();
+  wa->strong = strong_->ObtainWorkingArea();
+  if (fast_) {
+    wa->fast = fast_->ObtainWorkingArea();
+  }
+  return ManagedWorkingArea(wa, this);
+}
+
+void AdaptiveCompressor::ReleaseWorkingArea(WorkingArea* wa) {
+  delete static_cast<AdaptiveWorkingArea*>(wa);
+}
+
+Status AdaptiveCompressor::CompressBlock(Slice uncompressed_data,
+                                         std::string* compressed_output,
+                                         CompressionType* out_compression_type,
+                                         ManagedWorkingArea* working_area) {
+  AdaptiveWorkingArea* wa = nullptr;
+  if (working_area != nullptr && working_area->owner() == this) {
+    wa = static_cast<AdaptiveWorkingArea*>(working_area->get());
+  }
+  if (EstimateCompressedBytesPerKb(uncompressed_data) >
+      max_compressed_bytes_per_kb_) {
+    *out_compression_type = kNoCompression;
+    return Status::OK();
+  }
+  const uint64_t size = uncompressed_data.size();
+  const uint64_t total_size =
+      input_bytes_.fetch_add(size, std::memory_order_relaxed) + size;
+
+  bool use_strong = fast_ == nullptr;
+  if (!use_strong) {
+    const uint64_t strong_size =
+        strong_input_bytes_.load(std::memory_order_relaxed) + size;
+    if (strong_size * 100 <= budget_pct_ * total_size) {
+      strong_input_bytes_.fetch_add(size, std::memory_order_relaxed);
+      use_strong = true;
+    }
+  }
+  if (use_strong) {
+    return strong_->CompressBlock(uncompressed_data, compressed_output,
+                                  out_compression_type,
+                                  wa ? &wa->strong : nullptr);
+  }
+  return fast_->CompressBlock(uncompressed_data, compressed_output,
+                              out_compression_type, wa ? &wa->fast : nullptr);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,65 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "rocksdb/advanced_compression.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Estimates the size of `data` compressed, in bytes per KB of input, from
+// the byte entropy of a sample of (at most about 1KB of) it, discounted by
+// the fraction of sampled 4-byte sequences repeating earlier ones. Cheap
+// compared to compressing, but only a rough estimate.
+int EstimateCompressedBytesPerKb(const Slice& data);
+
+// A Compressor choosing the compression of each block (see
+// CompressionOptions::adaptive_compression_budget_pct):
+// * Blocks whose estimated compressed size exceeds
+//   `max_compressed_bytes_per_kb` are not compressed at all.
+// * Other blocks are compressed with `strong` as long as the bytes given to
+//   it stay within `budget_pct` percent of the bytes of all such blocks, and
+//   with `fast` otherwise (or with `strong` if `fast` is nullptr).
+// Dictionary compression is not supported.
+class AdaptiveCompressor : public Compressor {
+ public:
+  AdaptiveCompressor(std::unique_ptr<Compressor> strong,
+                     std::unique_ptr<Compressor> fast,
+                     int max_compressed_bytes_per_kb, uint32_t budget_pct);
+
+  CompressionType GetPreferredCompressionType() const override {
+    return strong_->GetPreferredCompressionType();
+  }
+
+  ManagedWorkingArea ObtainWorkingArea() override;
+
+  Status CompressBlock(Slice uncompressed_data, std::string* compressed_output,
+                       CompressionType* out_compression_type,
+                       ManagedWorkingArea* working_area) override;
+
+ protected:
+  void ReleaseWorkingArea(WorkingArea* wa) override;
+
+ private:
+  struct AdaptiveWorkingArea : public WorkingArea {
+    ManagedWorkingArea strong;
+    ManagedWorkingArea fast;
+  };
+
+  const std::unique_ptr<Compressor> strong_;
+  const std::unique_ptr<Compressor> fast_;
+  const int max_compressed_bytes_per_kb_;
+  const uint32_t budget_pct_;
+  // Bytes of the blocks to compress. Approximate, as blocks may be compressed
+  // in parallel.
+  std::atomic<uint64_t> input_bytes_{0};
+  std::atomic<uint64_t> strong_input_bytes_{0};
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -5,8 +5,13 @@
 
 #include "util/compression.h"
 
+#include <mutex>
+
 #include "options/options_helper.h"
+#include "port/lang.h"
 #include "rocksdb/convenience.h"
+#include "util/hash.h"
+#include "util/hash_containers.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -610,7 +615,7 @@ class BuiltinDecompressorV2 : public Decompressor {
 
   Status ExtractUncompressedSize(Args& args) override {
     assert(args.compression_type != kNoCompression);
-    if (args.compression_type == kSnappyCompression) {
+    if (GetBaseCompressionType(args.compression_type) == kSnappyCompression) {
       // Exception to encoding of uncompressed size
 #ifdef SNAPPY
       size_t uncompressed_length = 0;
@@ -648,9 +653,7 @@ class BuiltinDecompressorV2 : public Decompressor {
         return ZSTD_DecompressBlock(args, /*dict=*/Slice{}, this,
                                     uncompressed_output);
       default:
-        return Status::NotSupported(
-            "Compression type not supported or not built-in: " +
-            CompressionTypeToString(args.compression_type));
+        return DecompressTransformedBlock(args, uncompressed_output);
     }
   }
 
@@ -660,6 +663,35 @@ class BuiltinDecompressorV2 : public Decompressor {
   size_t ApproximateOwnedMemoryUsage() const override {
     return sizeof(BuiltinDecompressorV2);
   }
+
+ protected:
+  // For a compression type recording a PreCompressionTransform (see
+  // CompressionOptions::pre_compression_transform), decompresses with the
+  // base compression type and inverts the transform.
+  Status DecompressTransformedBlock(const Args& args,
+                                    char* uncompressed_output) {
+    if (!IsTransformedCompressionType(args.compression_type)) {
+      return Status::NotSupported(
+          "Compression type not supported or not built-in: " +
+          std::to_string(static_cast<int>(args.compression_type)));
+    }
+    size_t element_size = 0;
+    const PreCompressionTransform transform =
+        GetPreCompressionTransform(args.compression_type, &element_size);
+    if (transform > PreCompressionTransform::kXorDelta) {
+      return Status::Corruption("Unknown pre-compression transform");
+    }
+    Args base_args = args;
+    base_args.compression_type = GetBaseCompressionType(args.compression_type);
+    std::unique_ptr<char[]> transformed(new char[args.uncompressed_size]);
+    Status s = DecompressBlock(base_args, transformed.get());
+    if (s.ok()) {
+      InvertPreCompressionTransform(transform, element_size, transformed.get(),
+                                    args.uncompressed_size,
+                                    uncompressed_output);
+    }
+    return s;
+  }
 };
 
 class BuiltinDecompressorV2WithDict : public BuiltinDecompressorV2 {
@@ -687,9 +719,7 @@ class BuiltinDecompressorV2WithDict : public BuiltinDecompressorV2 {
       case kZSTD:
         return ZSTD_DecompressBlock(args, dict_, this, uncompressed_output);
       default:
-        return Status::NotSupported(
-            "Compression type not supported or not built-in: " +
-            CompressionTypeToString(args.compression_type));
+        return DecompressTransformedBlock(args, uncompressed_output);
     }
   }
 
@@ -742,6 +772,80 @@ class BuiltinDecompressorV2OptimizeZstd : public BuiltinDecompressorV2 {
                            std::unique_ptr<Decompressor>* /*out*/) override;
 };
 
+#ifdef ROCKSDB_ZSTD_DDICT
+namespace {
+// A digested ZSTD dictionary, shared by all the decompressors in the process
+// using the same dictionary, such as those of table files sharing a
+// dictionary (see CompressionOptions::use_shared_dict).
+class SharedZstdDDict {
+ public:
+  // Returns the digested form of `dict`, and whether it was newly created
+  // rather than already in use.
+  static std::shared_ptr<const SharedZstdDDict> GetOrCreate(const Slice& dict,
+                                                            bool* created) {
+    const uint64_t hash = Hash64(dict.data(), dict.size());
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.map.find(hash);
+    if (it != registry.map.end()) {
+      std::shared_ptr<const SharedZstdDDict> existing = it->second.lock();
+      if (existing != nullptr && Slice(existing->dict_) == dict) {
+        *created = false;
+        return existing;
+      }
+    }
+    std::shared_ptr<const SharedZstdDDict> ddict(
+        new SharedZstdDDict(dict, hash), [](const SharedZstdDDict* d) {
+          Registry& r = GetRegistry();
+          {
+            std::lock_guard<std::mutex> l(r.mutex);
+            auto entry = r.map.find(d->hash_);
+            // Might have been replaced since this one expired
+            if (entry != r.map.end() && entry->second.expired()) {
+              r.map.erase(entry);
+            }
+          }
+          delete d;
+        });
+    // Replaces any expired entry, or one for a colliding dictionary
+    registry.map[hash] = ddict;
+    *created = true;
+    return ddict;
+  }
+
+  ~SharedZstdDDict() {
+    size_t res = ZSTD_freeDDict(ddict_);
+    assert(res == 0);  // Last I checked they can't fail
+    (void)res;         // prevent unused var warning
+  }
+
+  ZSTD_DDict* ddict() const { return ddict_; }
+
+ private:
+  struct Registry {
+    std::mutex mutex;
+    UnorderedMap<uint64_t, std::weak_ptr<const SharedZstdDDict>> map;
+  };
+
+  static Registry& GetRegistry() {
+    STATIC_AVOID_DESTRUCTION(Registry, registry);
+    return registry;
+  }
+
+  SharedZstdDDict(const Slice& dict, uint64_t hash)
+      : dict_(dict.ToString()),
+        hash_(hash),
+        ddict_(ZSTD_createDDict_byReference(dict_.data(), dict_.size())) {
+    assert(ddict_ != nullptr);
+  }
+
+  const std::string dict_;
+  const uint64_t hash_;
+  ZSTD_DDict* const ddict_;
+};
+}  // namespace
+#endif  // ROCKSDB_ZSTD_DDICT
+
 class BuiltinDecompressorV2OptimizeZstdWithDict
     : public BuiltinDecompressorV2OptimizeZstd {
  public:
@@ -749,8 +853,8 @@ class BuiltinDecompressorV2OptimizeZstdWithDict
       :
 #ifdef ROCKSDB_ZSTD_DDICT
         dict_(dict),
-        ddict_(ZSTD_createDDict_byReference(dict.data(), dict.size())) {
-    assert(ddict_ != nullptr);
+        shared_ddict_(SharedZstdDDict::GetOrCreate(dict, &owns_ddict_)),
+        ddict_(shared_ddict_->ddict()) {
   }
 #else
         dict_(dict) {
@@ -761,20 +865,26 @@ class BuiltinDecompressorV2OptimizeZstdWithDict
     return "BuiltinDecompressorV2OptimizeZstdWithDict";
   }
 
-  ~BuiltinDecompressorV2OptimizeZstdWithDict() override {
+  const Slice& GetSerializedDict() const override { return dict_; }
+
+  bool DigestedDictSharedWithOthers() const {
 #ifdef ROCKSDB_ZSTD_DDICT
-    size_t res = ZSTD_freeDDict(ddict_);
-    assert(res == 0);  // Last I checked they can't fail
-    (void)res;         // prevent unused var warning
-#endif                 // ROCKSDB_ZSTD_DDICT
+    return shared_ddict_.use_count() > 1;
+#else
+    return false;
+#endif  // ROCKSDB_ZSTD_DDICT
   }
 
-  const Slice& GetSerializedDict() const override { return dict_; }
-
   size_t ApproximateOwnedMemoryUsage() const override {
     size_t sz = sizeof(BuiltinDecompressorV2WithDict);
 #ifdef ROCKSDB_ZSTD_DDICT
-    sz += ZSTD_sizeof_DDict(ddict_);
+    // The digested dictionary is only charged to the decompressor creating
+    // it, not to those sharing it afterwards. For shared dictionaries, that
+    // is the one held by the CompressionDictRegistry for as long as the
+    // digested dictionary lives.
+    if (owns_ddict_) {
+      sz += ZSTD_sizeof_DDict(ddict_) + dict_.size();
+    }
 #endif  // ROCKSDB_ZSTD_DDICT
     return sz;
   }
@@ -796,6 +906,8 @@ class BuiltinDecompressorV2OptimizeZstdWithDict
  protected:
   const Slice dict_;
 #ifdef ROCKSDB_ZSTD_DDICT
+  bool owns_ddict_ = false;
+  const std::shared_ptr<const SharedZstdDDict> shared_ddict_;
   ZSTD_DDict* const ddict_;
 #endif  // ROCKSDB_ZSTD_DDICT
 };
@@ -912,6 +1024,17 @@ Status CompressionManager::FindCompatibleCompressionManager(
   }
 }
 
+bool DigestedDictSharedWithOthers(const Decompressor& decompressor) {
+  // Without relying on RTTI
+  if (strcmp(decompressor.Name(),
+             "BuiltinDecompressorV2OptimizeZstdWithDict") != 0) {
+    return false;
+  }
+  return static_cast<const BuiltinDecompressorV2OptimizeZstdWithDict&>(
+             decompressor)
+      .DigestedDictSharedWithOthers();
+}
+
 const std::shared_ptr<CompressionManager>& GetBuiltinCompressionManager(
     int compression_format_version) {
   static const std::shared_ptr<CompressionManager> v1_as_base =
@@ -30,6 +30,7 @@
 #include "util/atomic.h"
 #include "util/coding.h"
 #include "util/compression_context_cache.h"
+#include "util/pre_compression_transform.h"
 #include "util/string_util.h"
 
 #ifdef SNAPPY
@@ -754,6 +755,17 @@ inline std::string CompressionTypeToString(CompressionType compression_type) {
     case kDisableCompressionOption:
       return "DisableOption";
     default:
+      if (IsTransformedCompressionType(compression_type)) {
+        size_t element_size = 0;
+        PreCompressionTransform transform =
+            GetPreCompressionTransform(compression_type, &element_size);
+        static const char* const kTransformNames[] = {
+            "", "ByteShuffle", "BitShuffle", "XorDelta", "Unknown"};
+        return CompressionTypeToString(
+                   GetBaseCompressionType(compression_type)) +
+               "+" + kTransformNames[static_cast<int>(transform)] +
+               std::to_string(element_size);
+      }
       assert(false);
       return "";
   }
@@ -843,6 +855,20 @@ inline std::string CompressionOptionsToString(
   result.append("checksum=")
       .append(std::to_string(compression_options.checksum))
       .append("; ");
+  result.append("adaptive_compression_budget_pct=")
+      .append(std::to_string(
+          compression_options.adaptive_compression_budget_pct))
+      .append("; ");
+  result.append("pre_compression_transform=")
+      .append(std::to_string(
+          static_cast<int>(compression_options.pre_compression_transform)))
+      .append("; ");
+  result.append("pre_compression_element_size=")
+      .append(std::to_string(compression_options.pre_compression_element_size))
+      .append("; ");
+  result.append("use_shared_dict=")
+      .append(std::to_string(compression_options.use_shared_dict))
+      .append("; ");
   return result;
 }
 
@@ -1807,6 +1833,12 @@ inline CacheAllocationPtr OLD_UncompressData(
 const std::shared_ptr<CompressionManager>& GetBuiltinCompressionManager(
     int compression_format_version);
 
+// For a decompressor with a dictionary (see Decompressor::MaybeCloneForDict),
+// whether its digested form of the dictionary (e.g. ZSTD_DDict), shared among
+// the decompressors in the process with the same dictionary, is also in use
+// by other decompressors.
+bool DigestedDictSharedWithOthers(const Decompressor& decompressor);
+
 // ***********************************************************************
 // END built-in implementation of customization interface
 // ***********************************************************************
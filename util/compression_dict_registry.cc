@@ -0,0 +1,131 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "util/compression_dict_registry.h"
+
+#include <algorithm>
+
+#include "rocksdb/cache.h"
+#include "util/compression.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+CompressionDictRegistry::Slot* CompressionDictRegistry::GetSlot(
+    const std::string& config) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::unique_ptr<Slot>& slot = slots_[config];
+  if (slot == nullptr) {
+    slot = std::make_unique<Slot>();
+  }
+  return slot.get();
+}
+
+size_t CompressionDictRegistry::ApproximateMemoryUsage() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t usage = 0;
+  for (const auto& entry : slots_) {
+    usage += entry.second->ApproximateMemoryUsage();
+  }
+  return usage;
+}
+
+std::shared_ptr<const CompressionDictRegistry::Dict>
+CompressionDictRegistry::Slot::GetDict() const {
+  if (!have_dict_.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  return dict_;
+}
+
+void CompressionDictRegistry::Slot::MaybeAddSample(const Slice& block,
+                                                   size_t max_sample_bytes) {
+  const uint64_t n =
+      num_blocks_offered_.fetch_add(1, std::memory_order_relaxed);
+  if (have_dict_.load(std::memory_order_relaxed) && n % kSampleInterval != 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  max_sample_bytes_ = max_sample_bytes;
+  if (samples_.sample_data.size() >= max_sample_bytes) {
+    return;
+  }
+  const size_t copy_len =
+      std::min(max_sample_bytes - samples_.sample_data.size(), block.size());
+  samples_.sample_data.append(block.data(), copy_len);
+  samples_.sample_lens.emplace_back(copy_len);
+}
+
+void CompressionDictRegistry::Slot::MaybeTrain(Compressor& compressor,
+                                               Decompressor& decompressor) {
+  Compressor::DictSampleArgs samples;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (training_ || max_sample_bytes_ == 0 ||
+        samples_.sample_data.size() < max_sample_bytes_) {
+      return;
+    }
+    samples = std::move(samples_);
+    samples_ = {};
+    training_ = true;
+  }
+
+  std::shared_ptr<Dict> dict;
+  std::unique_ptr<Compressor> trained = compressor.MaybeCloneSpecialized(
+      CacheEntryRole::kDataBlock, std::move(samples));
+  if (trained != nullptr && !trained->GetSerializedDict().empty()) {
+    dict = std::make_shared<Dict>();
+    dict->compressor = std::move(trained);
+    // Digest the dictionary before any builder or reader uses it, so that
+    // its memory is accounted here rather than to them.
+    Status s = decompressor.MaybeCloneForDict(
+        dict->compressor->GetSerializedDict(), &dict->decompressor);
+    if (!s.ok() || dict->decompressor == nullptr) {
+      dict.reset();
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  training_ = false;
+  if (dict != nullptr) {
+    if (dict_ != nullptr) {
+      retired_.push_back(std::move(dict_));
+    }
+    dict_ = std::move(dict);
+    have_dict_.store(true, std::memory_order_release);
+  }
+  PruneRetired();
+}
+
+void CompressionDictRegistry::Slot::PruneRetired() {
+  retired_.erase(
+      std::remove_if(retired_.begin(), retired_.end(),
+                     [](const std::shared_ptr<const Dict>& d) {
+                       // Not used by a builder, nor its digested form by
+                       // another decompressor
+                       return d.use_count() == 1 &&
+                              !DigestedDictSharedWithOthers(*d->decompressor);
+                     }),
+      retired_.end());
+}
+
+size_t CompressionDictRegistry::Slot::ApproximateMemoryUsage() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t usage = sizeof(Slot) + samples_.sample_data.size() +
+                 samples_.sample_lens.size() * sizeof(size_t);
+  auto add_dict = [&usage](const std::shared_ptr<const Dict>& d) {
+    usage += sizeof(Dict) + d->compressor->GetSerializedDict().size() +
+             d->decompressor->ApproximateOwnedMemoryUsage();
+  };
+  if (dict_ != nullptr) {
+    add_dict(dict_);
+  }
+  for (const auto& d : retired_) {
+    add_dict(d);
+  }
+  return usage;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,93 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "rocksdb/advanced_compression.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Compression dictionaries shared by the table files of a column family (see
+// CompressionOptions::use_shared_dict).
+//
+// Table builders offer their data blocks as samples, and a builder finishing
+// its file trains a new dictionary once enough samples are collected. Until
+// a first dictionary exists, every block offered is taken; afterwards only
+// one in kSampleInterval, so that dictionaries are retrained periodically as
+// data is written rather than for each file. Samples and dictionaries are
+// kept per compression "config" (the compression manager, type and options),
+// so that builders with different configs, such as those of bottommost
+// files, do not reset each other.
+//
+// The registry creates the digested form of each dictionary it trains (e.g.
+// ZSTD_DDict), shared with the decompressors of builders and table readers
+// using the dictionary, and accounts for it in ApproximateMemoryUsage() for
+// as long as the digested dictionary is in use.
+class CompressionDictRegistry {
+ public:
+  struct Dict {
+    // Compressor using the dictionary, usable concurrently by builders with
+    // working areas of their own
+    std::unique_ptr<Compressor> compressor;
+    // Decompressor holding the digested dictionary. Declared after
+    // `compressor`, whose serialized dictionary it references.
+    std::unique_ptr<Decompressor> decompressor;
+  };
+
+  // Dictionary and samples for one compression config
+  class Slot {
+   public:
+    // Returns the latest dictionary trained, or nullptr if none.
+    std::shared_ptr<const Dict> GetDict() const;
+
+    // Offers an uncompressed data block, with up to `max_sample_bytes` of
+    // samples wanted for training.
+    void MaybeAddSample(const Slice& block, size_t max_sample_bytes);
+
+    // Trains a new dictionary with `compressor`, which must have been created
+    // for the config of this slot, if enough samples were collected. The
+    // dictionary is digested with a clone of `decompressor`.
+    void MaybeTrain(Compressor& compressor, Decompressor& decompressor);
+
+    size_t ApproximateMemoryUsage() const;
+
+   private:
+    // Releases replaced dictionaries no longer in use. REQUIRES: mutex_ held
+    void PruneRetired();
+
+    mutable std::mutex mutex_;
+    std::shared_ptr<const Dict> dict_;
+    // Replaced dictionaries whose digested form is still in use
+    std::vector<std::shared_ptr<const Dict>> retired_;
+    Compressor::DictSampleArgs samples_;
+    size_t max_sample_bytes_ = 0;
+    bool training_ = false;
+    std::atomic<bool> have_dict_{false};
+    std::atomic<uint64_t> num_blocks_offered_{0};
+  };
+
+  static constexpr uint64_t kSampleInterval = 64;
+
+  // Returns the slot for `config`, creating it if needed. The slot lives as
+  // long as the registry.
+  Slot* GetSlot(const std::string& config);
+
+  // Memory of the dictionaries (including digested ones) and samples held
+  size_t ApproximateMemoryUsage() const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::map<std::string, std::unique_ptr<Slot>> slots_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
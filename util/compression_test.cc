@@ -0,0 +1,401 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "util/compression.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "port/stack_trace.h"
+#include "test_util/testharness.h"
+#include "util/adaptive_compressor.h"
+#include "util/coding.h"
+#include "util/compression_dict_registry.h"
+#include "util/compression_thread_pool.h"
+#include "util/pre_compression_transform.h"
+#include "util/random.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class CompressionDictRegistryTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    if (!ZSTD_Supported()) {
+      return;
+    }
+    const auto& mgr = GetBuiltinCompressionManager(2);
+    CompressionOptions opts;
+    opts.max_dict_bytes = 4096;
+    compressor_ = mgr->GetCompressor(opts, kZSTD);
+    decompressor_ = mgr->GetDecompressorOptimizeFor(kZSTD);
+    max_sample_bytes_ =
+        compressor_->GetMaxSampleSizeIfWantDict(CacheEntryRole::kDataBlock);
+  }
+
+  // Offers enough blocks to `slot` for training a dictionary, even with
+  // only one in kSampleInterval taken
+  void FillSamples(CompressionDictRegistry::Slot* slot) {
+    const size_t num_blocks = (max_sample_bytes_ / kBlockSize + 1) *
+                              CompressionDictRegistry::kSampleInterval;
+    for (size_t i = 0; i < num_blocks; i++) {
+      std::string block = rnd_.RandomString(kBlockSize / 2) +
+                          std::string(kBlockSize / 2, 'x');
+      slot->MaybeAddSample(block, max_sample_bytes_);
+    }
+  }
+
+  static constexpr size_t kBlockSize = 1024;
+  Random rnd_{301};
+  std::unique_ptr<Compressor> compressor_;
+  std::shared_ptr<Decompressor> decompressor_;
+  size_t max_sample_bytes_ = 0;
+};
+
+TEST_F(CompressionDictRegistryTest, SlotPerConfig) {
+  if (!ZSTD_Supported()) {
+    ROCKSDB_GTEST_SKIP("Test requires ZSTD support");
+    return;
+  }
+  ASSERT_GT(max_sample_bytes_, 0);
+  CompressionDictRegistry registry;
+  CompressionDictRegistry::Slot* slot_a = registry.GetSlot("a");
+  CompressionDictRegistry::Slot* slot_b = registry.GetSlot("b");
+  ASSERT_EQ(slot_a, registry.GetSlot("a"));
+  ASSERT_NE(slot_a, slot_b);
+
+  // Samples for one config are not dropped by those for another
+  FillSamples(slot_a);
+  FillSamples(slot_b);
+  slot_a->MaybeTrain(*compressor_, *decompressor_);
+  auto dict_a = slot_a->GetDict();
+  ASSERT_NE(dict_a, nullptr);
+  ASSERT_EQ(slot_b->GetDict(), nullptr);
+  slot_b->MaybeTrain(*compressor_, *decompressor_);
+  auto dict_b = slot_b->GetDict();
+  ASSERT_NE(dict_b, nullptr);
+  ASSERT_EQ(slot_a->GetDict(), dict_a);
+  ASSERT_NE(dict_a->compressor->GetSerializedDict(),
+            dict_b->compressor->GetSerializedDict());
+  ASSERT_EQ(dict_a->decompressor->GetSerializedDict(),
+            dict_a->compressor->GetSerializedDict());
+
+  // Not retrained without new samples
+  slot_a->MaybeTrain(*compressor_, *decompressor_);
+  ASSERT_EQ(slot_a->GetDict(), dict_a);
+}
+
+TEST_F(CompressionDictRegistryTest, DigestedDictCharge) {
+  if (!ZSTD_Supported()) {
+    ROCKSDB_GTEST_SKIP("Test requires ZSTD support");
+    return;
+  }
+  CompressionDictRegistry registry;
+  CompressionDictRegistry::Slot* slot = registry.GetSlot("a");
+  const size_t initial_usage = registry.ApproximateMemoryUsage();
+  FillSamples(slot);
+  slot->MaybeTrain(*compressor_, *decompressor_);
+  auto dict = slot->GetDict();
+  ASSERT_NE(dict, nullptr);
+  const Slice serialized = dict->compressor->GetSerializedDict();
+  ASSERT_GE(registry.ApproximateMemoryUsage(),
+            initial_usage + serialized.size());
+
+  // A reader with the same dictionary shares the digested dictionary
+  // without being charged for it
+  std::unique_ptr<Decompressor> reader;
+  ASSERT_OK(decompressor_->MaybeCloneForDict(serialized, &reader));
+  ASSERT_NE(reader, nullptr);
+  ASSERT_LT(reader->ApproximateOwnedMemoryUsage(),
+            dict->decompressor->ApproximateOwnedMemoryUsage());
+#ifdef ROCKSDB_ZSTD_DDICT
+  ASSERT_TRUE(DigestedDictSharedWithOthers(*dict->decompressor));
+  ASSERT_GT(dict->decompressor->ApproximateOwnedMemoryUsage(),
+            serialized.size());
+#endif  // ROCKSDB_ZSTD_DDICT
+
+  // A replaced dictionary stays accounted for while in use by the reader
+  const size_t one_dict_usage = registry.ApproximateMemoryUsage();
+  dict.reset();
+  FillSamples(slot);
+  slot->MaybeTrain(*compressor_, *decompressor_);
+  ASSERT_NE(slot->GetDict(), nullptr);
+#ifdef ROCKSDB_ZSTD_DDICT
+  ASSERT_GT(registry.ApproximateMemoryUsage(), one_dict_usage);
+#endif  // ROCKSDB_ZSTD_DDICT
+  const size_t two_dict_usage = registry.ApproximateMemoryUsage();
+
+  // And is released with the next dictionary once unused
+  reader.reset();
+  FillSamples(slot);
+  slot->MaybeTrain(*compressor_, *decompressor_);
+  ASSERT_LE(registry.ApproximateMemoryUsage(), two_dict_usage);
+  ASSERT_LT(registry.ApproximateMemoryUsage(), one_dict_usage * 2);
+}
+
+namespace {
+// Halves each block, reporting the given compression type
+class HalvingCompressor : public Compressor {
+ public:
+  explicit HalvingCompressor(CompressionType type) : type_(type) {}
+
+  Status CompressBlock(Slice uncompressed_data, std::string* compressed_output,
+                       CompressionType* out_compression_type,
+                       ManagedWorkingArea* /*working_area*/) override {
+    compressed_output->assign(uncompressed_data.data(),
+                              uncompressed_data.size() / 2);
+    *out_compression_type = type_;
+    return Status::OK();
+  }
+
+ private:
+  const CompressionType type_;
+};
+}  // namespace
+
+TEST(AdaptiveCompressorTest, EstimateCompressedBytesPerKb) {
+  Random rnd(301);
+  // Random bytes of 7 bits each
+  ASSERT_GT(EstimateCompressedBytesPerKb(rnd.RandomBinaryString(4096)), 850);
+  ASSERT_LT(EstimateCompressedBytesPerKb(std::string(4096, 'a')), 50);
+  std::string text;
+  while (text.size() < 4096) {
+    text += "key" + std::to_string(text.size() % 100) + "value";
+  }
+  const int text_estimate = EstimateCompressedBytesPerKb(text);
+  ASSERT_GT(text_estimate, 50);
+  ASSERT_LT(text_estimate, 700);
+}
+
+TEST(AdaptiveCompressorTest, ChoosesCompressionPerBlock) {
+  Random rnd(301);
+  const std::string compressible(1000, 'a');
+  for (uint32_t budget_pct : {0, 25, 100}) {
+    SCOPED_TRACE("budget_pct=" + std::to_string(budget_pct));
+    AdaptiveCompressor compressor(
+        std::make_unique<HalvingCompressor>(kZSTD),
+        std::make_unique<HalvingCompressor>(kLZ4Compression),
+        /*max_compressed_bytes_per_kb=*/800, budget_pct);
+    auto wa = compressor.ObtainWorkingArea();
+    std::map<CompressionType, int> counts;
+    for (int i = 0; i < 240; i++) {
+      // One in six blocks is incompressible
+      const std::string block =
+          i % 6 == 0 ? rnd.RandomBinaryString(1000) : compressible;
+      std::string output;
+      CompressionType type = kDisableCompressionOption;
+      ASSERT_OK(compressor.CompressBlock(block, &output, &type, &wa));
+      ++counts[type];
+      if (type != kNoCompression) {
+        ASSERT_EQ(block.size() / 2, output.size());
+      }
+    }
+    // Incompressible blocks are not given to either compressor, and the
+    // strong one gets exactly its share of the others
+    ASSERT_EQ(40, counts[kNoCompression]);
+    ASSERT_EQ(200 * budget_pct / 100, counts[kZSTD]);
+    ASSERT_EQ(200 - 200 * budget_pct / 100, counts[kLZ4Compression]);
+  }
+
+  // Without a fast compressor, the strong one takes every block
+  AdaptiveCompressor strong_only(std::make_unique<HalvingCompressor>(kZSTD),
+                                 nullptr, /*max_compressed_bytes_per_kb=*/800,
+                                 /*budget_pct=*/25);
+  std::string output;
+  CompressionType type = kDisableCompressionOption;
+  ASSERT_OK(strong_only.CompressBlock(compressible, &output, &type, nullptr));
+  ASSERT_EQ(kZSTD, type);
+}
+
+namespace {
+// Straightforward implementation of the transforms as documented
+std::string ReferenceTransform(PreCompressionTransform transform,
+                               size_t element_size, const std::string& src) {
+  const size_t num_elements = src.size() / element_size;
+  std::string dst = src;
+  for (size_t i = 0; i < num_elements; i++) {
+    for (size_t k = 0; k < element_size; k++) {
+      char c = src[i * element_size + k];
+      if (transform == PreCompressionTransform::kXorDelta && i > 0) {
+        c ^= src[(i - 1) * element_size + k];
+      }
+      dst[k * num_elements + i] = c;
+    }
+  }
+  if (transform == PreCompressionTransform::kBitShuffle) {
+    for (size_t k = 0; k < element_size; k++) {
+      char* plane = &dst[k * num_elements];
+      for (size_t g = 0; g + 16 <= num_elements; g += 16) {
+        std::string masks;
+        for (int b = 0; b < 8; b++) {
+          uint16_t mask = 0;
+          for (int j = 0; j < 16; j++) {
+            mask |= static_cast<uint16_t>(
+                ((static_cast<unsigned char>(plane[g + j]) >> b) & 1) << j);
+          }
+          PutFixed16(&masks, mask);
+        }
+        memcpy(plane + g, masks.data(), masks.size());
+      }
+    }
+  }
+  return dst;
+}
+}  // namespace
+
+TEST(PreCompressionTransformTest, Examples) {
+  const std::string src = "abcdefg";
+  std::string dst(src.size(), '\0');
+  ApplyPreCompressionTransform(PreCompressionTransform::kByteShuffle, 2,
+                               src.data(), src.size(), dst.data());
+  // The odd byte at the end is not transformed
+  ASSERT_EQ("acebdfg", dst);
+
+  const std::string deltas = std::string("\x01\x03\x03\x07", 4);
+  dst.resize(deltas.size());
+  ApplyPreCompressionTransform(PreCompressionTransform::kXorDelta, 1,
+                               deltas.data(), deltas.size(), dst.data());
+  ASSERT_EQ(std::string("\x01\x02\x00\x04", 4), dst);
+
+  // Sixteen 1s transpose to a mask of all ones for bit 0 only
+  const std::string ones(16, '\x01');
+  dst.resize(ones.size());
+  ApplyPreCompressionTransform(PreCompressionTransform::kBitShuffle, 1,
+                               ones.data(), ones.size(), dst.data());
+  ASSERT_EQ(std::string("\xff\xff") + std::string(14, '\0'), dst);
+}
+
+TEST(PreCompressionTransformTest, MatchesReference) {
+  Random rnd(301);
+  for (auto transform :
+       {PreCompressionTransform::kByteShuffle,
+        PreCompressionTransform::kBitShuffle,
+        PreCompressionTransform::kXorDelta}) {
+    for (size_t element_size : {1, 2, 4, 8}) {
+      // Lengths around the 16-element groups of the vectorized paths
+      for (size_t n : {0, 1, 7, 15, 16, 17, 63, 64, 65, 129, 255, 256, 257,
+                       1000, 1027, 4099}) {
+        SCOPED_TRACE("transform " +
+                     std::to_string(static_cast<int>(transform)) + " size " +
+                     std::to_string(element_size) + " n " + std::to_string(n));
+        const std::string src = rnd.RandomBinaryString(static_cast<int>(n));
+        std::string dst(n, '\0');
+        ApplyPreCompressionTransform(transform, element_size, src.data(), n,
+                                     dst.data());
+        ASSERT_EQ(ReferenceTransform(transform, element_size, src), dst);
+        std::string inverted(n, '\0');
+        InvertPreCompressionTransform(transform, element_size, dst.data(), n,
+                                      inverted.data());
+        ASSERT_EQ(src, inverted);
+      }
+    }
+  }
+}
+
+TEST(PreCompressionTransformTest, CompressionTypeEncoding) {
+  for (CompressionType base :
+       {kNoCompression, kSnappyCompression, kLZ4Compression, kZSTD}) {
+    ASSERT_FALSE(IsTransformedCompressionType(base));
+    ASSERT_EQ(base, GetBaseCompressionType(base));
+    for (auto transform :
+         {PreCompressionTransform::kByteShuffle,
+          PreCompressionTransform::kBitShuffle,
+          PreCompressionTransform::kXorDelta}) {
+      for (size_t element_size : {1, 2, 4, 8}) {
+        CompressionType type =
+            MakeTransformedCompressionType(base, transform, element_size);
+        ASSERT_TRUE(IsTransformedCompressionType(type));
+        ASSERT_NE(kDisableCompressionOption, type);
+        ASSERT_EQ(base, GetBaseCompressionType(type));
+        size_t decoded_size = 0;
+        ASSERT_EQ(transform, GetPreCompressionTransform(type, &decoded_size));
+        ASSERT_EQ(element_size, decoded_size);
+      }
+    }
+  }
+  ASSERT_FALSE(IsTransformedCompressionType(kDisableCompressionOption));
+}
+
+TEST(CompressionThreadPoolTest, DrainsAllQueues) {
+  const size_t kNumThreads = 3;
+  CompressionThreadPool pool(kNumThreads);
+  std::vector<std::unique_ptr<CompressionThreadPool::Queue>> queues;
+  std::vector<std::atomic<int>> num_done(4);
+  std::atomic<size_t> max_thread_index{0};
+  for (size_t q = 0; q < num_done.size(); q++) {
+    queues.push_back(pool.NewQueue(/*urgent=*/q == 0));
+  }
+  for (int i = 0; i < 100; i++) {
+    for (size_t q = 0; q < queues.size(); q++) {
+      queues[q]->Submit([&, q](size_t thread_index) {
+        size_t expected = max_thread_index.load();
+        while (thread_index > expected &&
+               !max_thread_index.compare_exchange_weak(expected,
+                                                       thread_index)) {
+        }
+        num_done[q]++;
+      });
+    }
+  }
+  for (size_t q = 0; q < queues.size(); q++) {
+    queues[q]->Drain();
+    ASSERT_EQ(100, num_done[q].load());
+  }
+  ASSERT_LT(max_thread_index.load(), kNumThreads);
+}
+
+TEST(CompressionThreadPoolTest, UrgentQueueFirst) {
+  CompressionThreadPool pool(1);
+  auto normal = pool.NewQueue(/*urgent=*/false);
+  auto urgent = pool.NewQueue(/*urgent=*/true);
+
+  // Keep the only thread busy while tasks queue up behind it
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool started = false;
+  bool released = false;
+  normal->Submit([&](size_t /*thread_index*/) {
+    std::unique_lock<std::mutex> lock(mutex);
+    started = true;
+    cv.notify_all();
+    cv.wait(lock, [&] { return released; });
+  });
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&] { return started; });
+  }
+
+  std::vector<std::string> order;
+  for (int i = 0; i < 3; i++) {
+    normal->Submit([&order, i](size_t /*thread_index*/) {
+      order.push_back("normal" + std::to_string(i));
+    });
+    urgent->Submit([&order, i](size_t /*thread_index*/) {
+      order.push_back("urgent" + std::to_string(i));
+    });
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    released = true;
+  }
+  cv.notify_all();
+  normal->Drain();
+  urgent->Drain();
+  ASSERT_EQ(order,
+            std::vector<std::string>({"urgent0", "urgent1", "urgent2",
+                                      "normal0", "normal1", "normal2"}));
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ROCKSDB_NAMESPACE::port::InstallStackTraceHandler();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,114 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "util/compression_thread_pool.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace ROCKSDB_NAMESPACE {
+
+CompressionThreadPool::Queue::~Queue() {
+  Drain();
+  std::lock_guard<std::mutex> lock(pool_->mutex_);
+  auto& queues = pool_->queues_;
+  queues.erase(std::find(queues.begin(), queues.end(), this));
+}
+
+void CompressionThreadPool::Queue::Submit(Task&& task) {
+  {
+    std::lock_guard<std::mutex> lock(pool_->mutex_);
+    tasks_.push_back(std::move(task));
+  }
+  pool_->work_cv_.notify_one();
+}
+
+void CompressionThreadPool::Queue::Drain() {
+  std::unique_lock<std::mutex> lock(pool_->mutex_);
+  pool_->drain_cv_.wait(
+      lock, [this] { return tasks_.empty() && num_running_ == 0; });
+}
+
+CompressionThreadPool::CompressionThreadPool(size_t num_threads) {
+  threads_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads_.emplace_back([this, i] { BGThread(i); });
+  }
+}
+
+CompressionThreadPool::~CompressionThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    assert(queues_.empty());
+    shutting_down_ = true;
+  }
+  work_cv_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+std::unique_ptr<CompressionThreadPool::Queue> CompressionThreadPool::NewQueue(
+    bool urgent) {
+  std::unique_ptr<Queue> queue(new Queue(this, urgent));
+  std::lock_guard<std::mutex> lock(mutex_);
+  queues_.push_back(queue.get());
+  return queue;
+}
+
+CompressionThreadPool::Queue* CompressionThreadPool::PickTask(size_t* cursor,
+                                                              Task* task) {
+  const size_t n = queues_.size();
+  Queue* picked = nullptr;
+  size_t picked_index = 0;
+  // Starting from the last served queue, take the first urgent queue with
+  // tasks, or else the first queue with tasks.
+  for (size_t i = 0; i < n; ++i) {
+    const size_t index = (*cursor + i) % n;
+    Queue* queue = queues_[index];
+    if (queue->tasks_.empty() || (picked != nullptr && !queue->urgent_)) {
+      continue;
+    }
+    picked = queue;
+    picked_index = index;
+    if (queue->urgent_) {
+      break;
+    }
+  }
+  if (picked != nullptr) {
+    *cursor = picked_index;
+    *task = std::move(picked->tasks_.front());
+    picked->tasks_.pop_front();
+    ++picked->num_running_;
+  }
+  return picked;
+}
+
+void CompressionThreadPool::BGThread(size_t thread_index) {
+  // Spread the threads over the queues to begin with.
+  size_t cursor = thread_index;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    Task task;
+    Queue* queue = PickTask(&cursor, &task);
+    if (queue == nullptr) {
+      if (shutting_down_) {
+        return;
+      }
+      work_cv_.wait(lock);
+      continue;
+    }
+    lock.unlock();
+    task(thread_index);
+    task = nullptr;
+    lock.lock();
+    --queue->num_running_;
+    if (queue->num_running_ == 0 && queue->tasks_.empty()) {
+      drain_cv_.notify_all();
+    }
+  }
+}
+
+}  // namespace ROCKSDB_NAMESPACE
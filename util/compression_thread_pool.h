@@ -0,0 +1,84 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "port/port.h"
+#include "rocksdb/rocksdb_namespace.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A pool of threads compressing the data blocks of all the block-based tables
+// built concurrently by a DB (see DBOptions::compression_threads).
+//
+// Each table builder submits its blocks through a Queue of its own. A thread
+// keeps taking tasks from the queue it last served and steals from the other
+// queues when that one runs dry, so a single large flush can keep every
+// thread busy, and concurrent builders share the threads instead of each
+// spawning its own. Urgent queues, e.g. those of flushes while writes are
+// about to stall, are served before all others. Tasks of a queue may complete
+// in any order; the builder restores the block order when writing.
+class CompressionThreadPool {
+ public:
+  // `thread_index` is the index of the pool thread running the task, in
+  // [0, NumThreads()), e.g. to select a working area for the compressor.
+  using Task = std::function<void(size_t thread_index)>;
+
+  class Queue {
+   public:
+    // Waits for the tasks submitted so far to complete.
+    ~Queue();
+
+    void Submit(Task&& task);
+
+    // Waits for the tasks submitted so far to complete.
+    void Drain();
+
+   private:
+    friend class CompressionThreadPool;
+
+    Queue(CompressionThreadPool* pool, bool urgent)
+        : pool_(pool), urgent_(urgent) {}
+
+    CompressionThreadPool* const pool_;
+    const bool urgent_;
+    // Protected by pool_->mutex_
+    std::deque<Task> tasks_;
+    size_t num_running_ = 0;
+  };
+
+  explicit CompressionThreadPool(size_t num_threads);
+
+  // REQUIRES: all queues have been destroyed.
+  ~CompressionThreadPool();
+
+  size_t NumThreads() const { return threads_.size(); }
+
+  std::unique_ptr<Queue> NewQueue(bool urgent);
+
+ private:
+  void BGThread(size_t thread_index);
+
+  // Pops the next task for the thread whose last served queue was at
+  // `*cursor`, updating it. Returns nullptr if there is none.
+  // REQUIRES: mutex_ held
+  Queue* PickTask(size_t* cursor, Task* task);
+
+  std::mutex mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable drain_cv_;
+  std::vector<Queue*> queues_;
+  bool shutting_down_ = false;
+  std::vector<port::Thread> threads_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
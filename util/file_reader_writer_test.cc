@@ -8,6 +8,7 @@
 
 #include "db/db_test_util.h"
 #include "env/mock_env.h"
+#include "file/async_writable_file.h"
 #include "file/line_file_reader.h"
 #include "file/random_access_file_reader.h"
 #include "file/read_write_util.h"
@@ -575,6 +576,88 @@ TEST_F(WritableFileWriterTest, AppendStatusReturn) {
   ASSERT_NOK(writer->Append(IOOptions(), std::string(2 * kMb, 'b')));
 }
 
+class AsyncWritableFileTest : public testing::Test {
+ protected:
+  // Records what is appended, with an error injected at one append
+  class RecordingWF : public FSWritableFile {
+   public:
+    using FSWritableFile::Append;
+    IOStatus Append(const Slice& data, const IOOptions& /*options*/,
+                    IODebugContext* /*dbg*/) override {
+      if (num_appends_++ == fail_append_) {
+        return IOStatus::IOError("Fake IO error");
+      }
+      contents_.append(data.data(), data.size());
+      return IOStatus::OK();
+    }
+    IOStatus Close(const IOOptions& /*options*/,
+                   IODebugContext* /*dbg*/) override {
+      closed_ = true;
+      return IOStatus::OK();
+    }
+    IOStatus Flush(const IOOptions& /*options*/,
+                   IODebugContext* /*dbg*/) override {
+      // Appends are done by the time the file is flushed
+      flushed_size_ = contents_.size();
+      return IOStatus::OK();
+    }
+    IOStatus Sync(const IOOptions& /*options*/,
+                  IODebugContext* /*dbg*/) override {
+      return IOStatus::OK();
+    }
+    uint64_t GetFileSize(const IOOptions& /*options*/,
+                         IODebugContext* /*dbg*/) override {
+      return contents_.size();
+    }
+
+    std::string contents_;
+    size_t flushed_size_ = 0;
+    int num_appends_ = 0;
+    int fail_append_ = -1;
+    bool closed_ = false;
+  };
+};
+
+TEST_F(AsyncWritableFileTest, AppendsInOrder) {
+  auto* recording = new RecordingWF();
+  std::unique_ptr<FSWritableFile> file = NewAsyncWritableFile(
+      std::unique_ptr<FSWritableFile>(recording), 2 /* max_buffers */);
+  Random rnd(301);
+  std::string expected;
+  for (int i = 0; i < 100; i++) {
+    std::string data = rnd.RandomString(1 + rnd.Uniform(4096));
+    expected += data;
+    ASSERT_OK(file->Append(data, IOOptions(), nullptr));
+    if (i % 10 == 9) {
+      ASSERT_OK(file->Flush(IOOptions(), nullptr));
+      ASSERT_EQ(recording->flushed_size_, expected.size());
+      ASSERT_EQ(file->GetFileSize(IOOptions(), nullptr), expected.size());
+    }
+  }
+  ASSERT_OK(file->Close(IOOptions(), nullptr));
+  ASSERT_TRUE(recording->closed_);
+  ASSERT_EQ(recording->contents_, expected);
+}
+
+TEST_F(AsyncWritableFileTest, AppendError) {
+  auto* recording = new RecordingWF();
+  recording->fail_append_ = 3;
+  std::unique_ptr<FSWritableFile> file = NewAsyncWritableFile(
+      std::unique_ptr<FSWritableFile>(recording), 2 /* max_buffers */);
+  for (int i = 0; i < 3; i++) {
+    ASSERT_OK(file->Append(std::string(100, 'a'), IOOptions(), nullptr));
+  }
+  ASSERT_OK(file->Flush(IOOptions(), nullptr));
+  // The failed append is reported by the next operation, and no later data
+  // is written
+  ASSERT_OK(file->Append(std::string(100, 'b'), IOOptions(), nullptr));
+  ASSERT_NOK(file->Flush(IOOptions(), nullptr));
+  ASSERT_NOK(file->Append(std::string(100, 'c'), IOOptions(), nullptr));
+  ASSERT_NOK(file->Close(IOOptions(), nullptr));
+  ASSERT_TRUE(recording->closed_);
+  ASSERT_EQ(recording->contents_, std::string(300, 'a'));
+}
+
 class ReadaheadRandomAccessFileTest
     : public testing::Test,
       public testing::WithParamInterface<size_t> {
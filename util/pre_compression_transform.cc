@@ -0,0 +1,312 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "util/pre_compression_transform.h"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "util/coding.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+// Byte shuffle: byte k of element i is written to dst[k * num_elements + i],
+// i.e. the output is the element_size "planes" of the k-th bytes of all
+// elements. With kXor, each element is first XORed with the previous one
+// (bytewise, which is the same as XORing the elements as integers).
+
+template <bool kXor>
+void ByteShuffleScalar(size_t element_size, const char* src,
+                       size_t num_elements, size_t begin, char* dst) {
+  for (size_t i = begin; i < num_elements; ++i) {
+    for (size_t k = 0; k < element_size; ++k) {
+      char c = src[i * element_size + k];
+      if (kXor && i > 0) {
+        c ^= src[(i - 1) * element_size + k];
+      }
+      dst[k * num_elements + i] = c;
+    }
+  }
+}
+
+#ifdef __SSE2__
+// Loads the 16 bytes at `p`, XORed with the 16 bytes `element_size` earlier
+// with kXor.
+template <bool kXor>
+inline __m128i LoadMaybeXor(const char* p, size_t element_size) {
+  __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  if (kXor) {
+    v = _mm_xor_si128(v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                             p - element_size)));
+  }
+  return v;
+}
+
+inline void Store16(char* p, __m128i v) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+}
+
+// Shuffles elements [begin, end) in groups of 16 and returns where it
+// stopped. With kXor, begin must be at least 1.
+template <bool kXor>
+size_t ByteShuffleSse2(size_t element_size, const char* src,
+                       size_t num_elements, size_t begin, char* dst) {
+  const __m128i kLowByte16 = _mm_set1_epi16(0xff);
+  const __m128i kLowByte32 = _mm_set1_epi32(0xff);
+  size_t i = begin;
+  for (; i + 16 <= num_elements; i += 16) {
+    const char* p = src + i * element_size;
+    if (element_size == 2) {
+      __m128i a = LoadMaybeXor<kXor>(p, 2);
+      __m128i b = LoadMaybeXor<kXor>(p + 16, 2);
+      Store16(dst + i, _mm_packus_epi16(_mm_and_si128(a, kLowByte16),
+                                        _mm_and_si128(b, kLowByte16)));
+      Store16(dst + num_elements + i,
+              _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)));
+    } else {
+      // Gather each 4-byte lane of the 16 elements in v[]: the whole element
+      // for size 4, or the low then high halves for size 8.
+      __m128i v[8];
+      for (size_t j = 0; j < element_size; ++j) {
+        v[j] = LoadMaybeXor<kXor>(p + 16 * j, element_size);
+      }
+      size_t num_lanes = 1;
+      if (element_size == 8) {
+        num_lanes = 2;
+        for (size_t j = 0; j < 8; j += 2) {
+          // [lo0 hi0 lo1 hi1], [lo2 hi2 lo3 hi3] => [lo0..lo3], [hi0..hi3]
+          __m128i x = _mm_shuffle_epi32(v[j], _MM_SHUFFLE(3, 1, 2, 0));
+          __m128i y = _mm_shuffle_epi32(v[j + 1], _MM_SHUFFLE(3, 1, 2, 0));
+          v[j] = _mm_unpacklo_epi64(x, y);
+          v[j + 1] = _mm_unpackhi_epi64(x, y);
+        }
+      }
+      for (size_t lane = 0; lane < num_lanes; ++lane) {
+        for (int k = 0; k < 4; ++k) {
+          const __m128i shift = _mm_cvtsi32_si128(8 * k);
+          __m128i w[4];
+          for (size_t j = 0; j < 4; ++j) {
+            w[j] = _mm_and_si128(_mm_srl_epi32(v[j * num_lanes + lane], shift),
+                                 kLowByte32);
+          }
+          __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(w[0], w[1]),
+                                           _mm_packs_epi32(w[2], w[3]));
+          Store16(dst + (lane * 4 + k) * num_elements + i, bytes);
+        }
+      }
+    }
+  }
+  return i;
+}
+
+// Unshuffles elements in groups of 16 and returns where it stopped.
+size_t ByteUnshuffleSse2(size_t element_size, const char* src,
+                         size_t num_elements, char* dst) {
+  size_t i = 0;
+  for (; i + 16 <= num_elements; i += 16) {
+    char* p = dst + i * element_size;
+    __m128i planes[8];
+    for (size_t k = 0; k < element_size; ++k) {
+      planes[k] = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(src + k * num_elements + i));
+    }
+    if (element_size == 2) {
+      Store16(p, _mm_unpacklo_epi8(planes[0], planes[1]));
+      Store16(p + 16, _mm_unpackhi_epi8(planes[0], planes[1]));
+      continue;
+    }
+    // Interleave the planes pairwise, then the resulting 16-bit pairs
+    __m128i pairs[8];
+    for (size_t k = 0; k < element_size; k += 2) {
+      pairs[k] = _mm_unpacklo_epi8(planes[k], planes[k + 1]);
+      pairs[k + 1] = _mm_unpackhi_epi8(planes[k], planes[k + 1]);
+    }
+    __m128i quads[8];
+    for (size_t k = 0; k < element_size; k += 4) {
+      quads[k] = _mm_unpacklo_epi16(pairs[k], pairs[k + 2]);
+      quads[k + 1] = _mm_unpackhi_epi16(pairs[k], pairs[k + 2]);
+      quads[k + 2] = _mm_unpacklo_epi16(pairs[k + 1], pairs[k + 3]);
+      quads[k + 3] = _mm_unpackhi_epi16(pairs[k + 1], pairs[k + 3]);
+    }
+    if (element_size == 4) {
+      for (size_t j = 0; j < 4; ++j) {
+        Store16(p + 16 * j, quads[j]);
+      }
+      continue;
+    }
+    // Element size 8: combine the quads of the low and high 4 bytes
+    for (size_t j = 0; j < 4; ++j) {
+      Store16(p + 32 * j, _mm_unpacklo_epi32(quads[j], quads[j + 4]));
+      Store16(p + 32 * j + 16, _mm_unpackhi_epi32(quads[j], quads[j + 4]));
+    }
+  }
+  return i;
+}
+#endif  // __SSE2__
+
+template <bool kXor>
+void ByteShuffle(size_t element_size, const char* src, size_t num_elements,
+                 char* dst) {
+  size_t begin = 0;
+#ifdef __SSE2__
+  if (element_size > 1) {
+    if (kXor && num_elements > 0) {
+      // The first element has no previous one to XOR with
+      for (size_t k = 0; k < element_size; ++k) {
+        dst[k * num_elements] = src[k];
+      }
+      begin = 1;
+    }
+    begin = ByteShuffleSse2<kXor>(element_size, src, num_elements, begin, dst);
+  }
+#endif  // __SSE2__
+  ByteShuffleScalar<kXor>(element_size, src, num_elements, begin, dst);
+}
+
+void ByteUnshuffle(size_t element_size, const char* src, size_t num_elements,
+                   char* dst) {
+  size_t begin = 0;
+#ifdef __SSE2__
+  if (element_size > 1) {
+    begin = ByteUnshuffleSse2(element_size, src, num_elements, dst);
+  }
+#endif  // __SSE2__
+  for (size_t i = begin; i < num_elements; ++i) {
+    for (size_t k = 0; k < element_size; ++k) {
+      dst[i * element_size + k] = src[k * num_elements + i];
+    }
+  }
+}
+
+// Bit transpose of each group of 16 bytes: bytes 2b and 2b+1 of the output
+// are the (little-endian) 16-bit mask of bit b of the 16 input bytes. Bytes
+// at the end not forming a whole group are left unchanged. In place.
+void BitTranspose16(char* data, size_t n) {
+  for (size_t g = 0; g + 16 <= n; g += 16) {
+    char* p = data + g;
+    uint16_t masks[8];
+#ifdef __SSE2__
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    for (int b = 7; b >= 0; --b) {
+      masks[b] = static_cast<uint16_t>(_mm_movemask_epi8(v));
+      v = _mm_slli_epi16(v, 1);
+    }
+#else
+    for (int b = 0; b < 8; ++b) {
+      uint16_t mask = 0;
+      for (int j = 0; j < 16; ++j) {
+        mask |= static_cast<uint16_t>(
+            ((static_cast<unsigned char>(p[j]) >> b) & 1) << j);
+      }
+      masks[b] = mask;
+    }
+#endif  // __SSE2__
+    for (int b = 0; b < 8; ++b) {
+      EncodeFixed16(p + 2 * b, masks[b]);
+    }
+  }
+}
+
+// Entry i has bit j of i as the low bit of byte j (in little-endian order)
+constexpr std::array<uint64_t, 256> MakeSpreadBitsTable() {
+  std::array<uint64_t, 256> table{};
+  for (uint64_t i = 0; i < 256; ++i) {
+    for (int j = 0; j < 8; ++j) {
+      table[i] |= ((i >> j) & 1) << (8 * j);
+    }
+  }
+  return table;
+}
+
+constexpr std::array<uint64_t, 256> kSpreadBits = MakeSpreadBitsTable();
+
+// Inverse of BitTranspose16. In place.
+void BitUntranspose16(char* data, size_t n) {
+  for (size_t g = 0; g + 16 <= n; g += 16) {
+    char* p = data + g;
+    uint64_t lo = 0;
+    uint64_t hi = 0;
+    for (int b = 0; b < 8; ++b) {
+      uint16_t mask = DecodeFixed16(p + 2 * b);
+      lo |= kSpreadBits[mask & 0xff] << b;
+      hi |= kSpreadBits[mask >> 8] << b;
+    }
+    EncodeFixed64(p, lo);
+    EncodeFixed64(p + 8, hi);
+  }
+}
+
+}  // namespace
+
+void ApplyPreCompressionTransform(PreCompressionTransform transform,
+                                  size_t element_size, const char* src,
+                                  size_t n, char* dst) {
+  assert(IsSupportedPreCompressionElementSize(element_size));
+  const size_t num_elements = n / element_size;
+  const size_t tail = num_elements * element_size;
+  switch (transform) {
+    case PreCompressionTransform::kByteShuffle:
+      ByteShuffle</*kXor=*/false>(element_size, src, num_elements, dst);
+      break;
+    case PreCompressionTransform::kBitShuffle:
+      ByteShuffle</*kXor=*/false>(element_size, src, num_elements, dst);
+      for (size_t k = 0; k < element_size; ++k) {
+        BitTranspose16(dst + k * num_elements, num_elements);
+      }
+      break;
+    case PreCompressionTransform::kXorDelta:
+      ByteShuffle</*kXor=*/true>(element_size, src, num_elements, dst);
+      break;
+    default:
+      assert(transform == PreCompressionTransform::kNone);
+      memcpy(dst, src, tail);
+      break;
+  }
+  memcpy(dst + tail, src + tail, n - tail);
+}
+
+void InvertPreCompressionTransform(PreCompressionTransform transform,
+                                   size_t element_size, const char* src,
+                                   size_t n, char* dst) {
+  assert(IsSupportedPreCompressionElementSize(element_size));
+  const size_t num_elements = n / element_size;
+  const size_t tail = num_elements * element_size;
+  switch (transform) {
+    case PreCompressionTransform::kByteShuffle:
+      ByteUnshuffle(element_size, src, num_elements, dst);
+      break;
+    case PreCompressionTransform::kBitShuffle: {
+      // Untranspose into dst before unshuffling out of place
+      std::string planes(src, tail);
+      for (size_t k = 0; k < element_size; ++k) {
+        BitUntranspose16(planes.data() + k * num_elements, num_elements);
+      }
+      ByteUnshuffle(element_size, planes.data(), num_elements, dst);
+      break;
+    }
+    case PreCompressionTransform::kXorDelta:
+      ByteUnshuffle(element_size, src, num_elements, dst);
+      for (size_t j = element_size; j < tail; ++j) {
+        dst[j] ^= dst[j - element_size];
+      }
+      break;
+    default:
+      assert(transform == PreCompressionTransform::kNone);
+      memcpy(dst, src, tail);
+      break;
+  }
+  memcpy(dst + tail, src + tail, n - tail);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
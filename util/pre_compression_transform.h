@@ -0,0 +1,83 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+// Reversible transforms of data consisting of fixed-size elements, applied
+// before compression (see CompressionOptions::pre_compression_transform).
+
+#pragma once
+
+#include <cstddef>
+
+#include "rocksdb/compression_type.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A data block (in block-based tables of format_version >= 7) or blob
+// compressed after a PreCompressionTransform is marked with a compression type
+// (in the block trailer or blob file) encoding the transform along with the
+// compression:
+//   bit 7: set
+//   bits 5-6: transform - 1
+//   bits 3-4: log2(element size)
+//   bits 0-2: the (built-in) compression type
+// This does not collide with the built-in compression types, nor with
+// kDisableCompressionOption (0xff).
+constexpr unsigned char kTransformedCompressionTypeFlag = 0x80;
+
+inline bool IsTransformedCompressionType(CompressionType type) {
+  return (type & kTransformedCompressionTypeFlag) != 0 &&
+         type != kDisableCompressionOption;
+}
+
+// REQUIRES: IsSupportedPreCompressionElementSize(element_size) and
+// base_type <= kZSTD
+inline CompressionType MakeTransformedCompressionType(
+    CompressionType base_type, PreCompressionTransform transform,
+    size_t element_size) {
+  int size_bits = 0;
+  while ((size_t{1} << size_bits) < element_size) {
+    ++size_bits;
+  }
+  return static_cast<CompressionType>(
+      kTransformedCompressionTypeFlag |
+      ((static_cast<int>(transform) - 1) << 5) | (size_bits << 3) | base_type);
+}
+
+// The compression type to decompress with, with any transform stripped
+inline CompressionType GetBaseCompressionType(CompressionType type) {
+  return IsTransformedCompressionType(type)
+             ? static_cast<CompressionType>(type & 0x7)
+             : type;
+}
+
+inline PreCompressionTransform GetPreCompressionTransform(
+    CompressionType type, size_t* element_size) {
+  if (!IsTransformedCompressionType(type)) {
+    *element_size = 1;
+    return PreCompressionTransform::kNone;
+  }
+  *element_size = size_t{1} << ((type >> 3) & 0x3);
+  return static_cast<PreCompressionTransform>(((type >> 5) & 0x3) + 1);
+}
+
+inline bool IsSupportedPreCompressionElementSize(size_t element_size) {
+  return element_size == 1 || element_size == 2 || element_size == 4 ||
+         element_size == 8;
+}
+
+// Writes the transform of the `n` bytes of `src` to `dst` (also `n` bytes),
+// which must not overlap. Bytes at the end not forming a whole element are
+// copied as they are.
+// REQUIRES: IsSupportedPreCompressionElementSize(element_size)
+void ApplyPreCompressionTransform(PreCompressionTransform transform,
+                                  size_t element_size, const char* src,
+                                  size_t n, char* dst);
+
+// Inverse of ApplyPreCompressionTransform.
+void InvertPreCompressionTransform(PreCompressionTransform transform,
+                                   size_t element_size, const char* src,
+                                   size_t n, char* dst);
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -6,6 +6,7 @@
 #include <memory>
 
 #include "rocksdb/compaction_filter.h"
+#include "rocksdb/compaction_value_transformer.h"
 #include "rocksdb/options.h"
 #include "rocksdb/utilities/customizable_util.h"
 #include "rocksdb/utilities/options_type.h"
@@ -49,4 +50,12 @@ Status CompactionFilterFactory::CreateFromString(
       LoadSharedObject<CompactionFilterFactory>(config_options, value, result);
   return status;
 }
+
+Status CompactionValueTransformer::CreateFromString(
+    const ConfigOptions& config_options, const std::string& value,
+    std::shared_ptr<CompactionValueTransformer>* result) {
+  // There are no builtin CompactionValueTransformers.
+  return LoadSharedObject<CompactionValueTransformer>(config_options, value,
+                                                      result);
+}
 }  // namespace ROCKSDB_NAMESPACE
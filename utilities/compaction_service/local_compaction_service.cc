@@ -0,0 +1,241 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "rocksdb/utilities/local_compaction_service.h"
+
+#ifndef OS_WIN
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <map>
+#include <mutex>
+
+#include "file/file_util.h"
+#include "rocksdb/env.h"
+#include "util/string_util.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+class LocalCompactionService : public CompactionService {
+ public:
+  explicit LocalCompactionService(const LocalCompactionServiceOptions& options)
+      : options_(options), env_(Env::Default()) {}
+
+  static const char* kClassName() { return "LocalCompactionService"; }
+  const char* Name() const override { return kClassName(); }
+
+  CompactionServiceScheduleResponse Schedule(
+      const CompactionServiceJobInfo& info,
+      const std::string& compaction_service_input) override {
+    if (options_.worker_path.empty() || options_.work_dir.empty()) {
+      return CompactionServiceScheduleResponse(
+          CompactionServiceJobStatus::kUseLocal);
+    }
+    // Subcompactions share the job ID of their compaction
+    const std::string job_id =
+        info.db_session_id + "-" + std::to_string(info.job_id) + "-" +
+        std::to_string(next_job_seq_.fetch_add(1, std::memory_order_relaxed));
+    Job job;
+    job.dir = options_.work_dir + "/" + job_id;
+    Status s = env_->CreateDirIfMissing(options_.work_dir);
+    if (s.ok()) {
+      s = env_->CreateDir(job.dir);
+    }
+    if (s.ok()) {
+      s = env_->CreateDir(OutputDir(job));
+    }
+    if (s.ok()) {
+      s = WriteStringToFile(env_, compaction_service_input, InputFile(job),
+                            false /* should_sync */);
+    }
+    if (s.ok()) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      s = Spawn(info, &job);
+      if (s.ok()) {
+        jobs_.emplace(job_id, job);
+      }
+    }
+    if (!s.ok()) {
+      DestroyDir(env_, job.dir).PermitUncheckedError();
+      return CompactionServiceScheduleResponse(
+          CompactionServiceJobStatus::kUseLocal);
+    }
+    return CompactionServiceScheduleResponse(
+        job_id, CompactionServiceJobStatus::kSuccess);
+  }
+
+  CompactionServiceJobStatus Wait(const std::string& scheduled_job_id,
+                                  std::string* result) override {
+    Job job;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = jobs_.find(scheduled_job_id);
+      if (it == jobs_.end()) {
+        return CompactionServiceJobStatus::kFailure;
+      }
+      job = it->second;
+    }
+
+    // Wait for the worker to exit, but leave it to be reaped below, so that
+    // CancelAwaitingJobs() cannot signal a reused PID
+    siginfo_t siginfo;
+    while (waitid(P_PID, job.pid, &siginfo, WEXITED | WNOWAIT) < 0 &&
+           errno == EINTR) {
+    }
+    bool canceled;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = jobs_.find(scheduled_job_id);
+      canceled = it->second.canceled;
+      it->second.pid = -1;
+    }
+    int wstatus = 0;
+    while (waitpid(job.pid, &wstatus, 0) < 0 && errno == EINTR) {
+    }
+
+    CompactionServiceJobStatus status;
+    if (canceled) {
+      status = CompactionServiceJobStatus::kAborted;
+    } else if (!ReadFileToString(env_, ResultFile(job), result).ok()) {
+      // Nothing to go by, so run the compaction locally instead
+      status = CompactionServiceJobStatus::kUseLocal;
+    } else if (WIFEXITED(wstatus) && WEXITSTATUS(wstatus) == 0) {
+      // Cleaned up on installation
+      return CompactionServiceJobStatus::kSuccess;
+    } else {
+      // The result carries the error
+      status = CompactionServiceJobStatus::kFailure;
+    }
+    RemoveJob(scheduled_job_id);
+    return status;
+  }
+
+  void CancelAwaitingJobs() override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [job_id, job] : jobs_) {
+      if (job.pid > 0) {
+        job.canceled = true;
+        kill(job.pid, SIGTERM);
+      }
+    }
+  }
+
+  void OnInstallation(const std::string& scheduled_job_id,
+                      CompactionServiceJobStatus /*status*/) override {
+    RemoveJob(scheduled_job_id);
+  }
+
+ private:
+  struct Job {
+    std::string dir;
+    pid_t pid = -1;
+    bool canceled = false;
+  };
+
+  static std::string InputFile(const Job& job) { return job.dir + "/input"; }
+  static std::string ResultFile(const Job& job) { return job.dir + "/result"; }
+  static std::string OutputDir(const Job& job) { return job.dir + "/output"; }
+
+  // REQUIRES: mutex_ held, so that CancelAwaitingJobs() does not miss the job
+  Status Spawn(const CompactionServiceJobInfo& info, Job* job) {
+    std::vector<std::string> args;
+    args.push_back(options_.worker_path);
+    args.insert(args.end(), options_.worker_args.begin(),
+                options_.worker_args.end());
+    args.push_back("--db=" + info.db_name);
+    args.push_back("--column_family=" + info.cf_name);
+    args.push_back("--input_file=" + InputFile(*job));
+    args.push_back("--output_dir=" + OutputDir(*job));
+    args.push_back("--result_file=" + ResultFile(*job));
+    std::vector<char*> argv;
+    for (std::string& arg : args) {
+      argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+
+    int cgroup_fd = -1;
+    if (!options_.cgroup_path.empty()) {
+      const std::string procs = options_.cgroup_path + "/cgroup.procs";
+      cgroup_fd = open(procs.c_str(), O_WRONLY | O_CLOEXEC);
+      if (cgroup_fd < 0) {
+        return Status::IOError("While opening " + procs, errnoStr(errno));
+      }
+    }
+
+    const pid_t pid = fork();
+    if (pid == 0) {
+      // Only async-signal-safe calls until exec, as the parent is
+      // multi-threaded
+      if (cgroup_fd >= 0 && write(cgroup_fd, "0", 1) != 1) {
+        _exit(127);
+      }
+      if (options_.nice_value != 0) {
+        // Best effort
+        setpriority(PRIO_PROCESS, 0, options_.nice_value);
+      }
+      execv(argv[0], argv.data());
+      _exit(127);
+    }
+    const int fork_errno = errno;
+    if (cgroup_fd >= 0) {
+      close(cgroup_fd);
+    }
+    if (pid < 0) {
+      return Status::IOError("While forking a compaction worker",
+                             errnoStr(fork_errno));
+    }
+    job->pid = pid;
+    return Status::OK();
+  }
+
+  void RemoveJob(const std::string& scheduled_job_id) {
+    std::string dir;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = jobs_.find(scheduled_job_id);
+      if (it == jobs_.end()) {
+        return;
+      }
+      dir = it->second.dir;
+      jobs_.erase(it);
+    }
+    DestroyDir(env_, dir).PermitUncheckedError();
+  }
+
+  const LocalCompactionServiceOptions options_;
+  Env* const env_;
+  std::atomic<uint64_t> next_job_seq_{0};
+  std::mutex mutex_;
+  std::map<std::string, Job> jobs_;
+};
+
+}  // namespace
+
+std::shared_ptr<CompactionService> NewLocalCompactionService(
+    const LocalCompactionServiceOptions& options) {
+  return std::make_shared<LocalCompactionService>(options);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+#else  // OS_WIN
+
+namespace ROCKSDB_NAMESPACE {
+
+std::shared_ptr<CompactionService> NewLocalCompactionService(
+    const LocalCompactionServiceOptions& /*options*/) {
+  return nullptr;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+#endif  // OS_WIN
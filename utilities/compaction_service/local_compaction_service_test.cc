@@ -0,0 +1,110 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "rocksdb/utilities/local_compaction_service.h"
+
+#include <cstring>
+
+#include "db/db_test_util.h"
+#include "file/file_util.h"
+#include "port/stack_trace.h"
+#include "rocksdb/compaction_worker_tool.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// This test binary doubles as the worker when run with this first argument
+static const char* kWorkerArg = "--compaction_worker";
+
+class LocalCompactionServiceTest : public DBTestBase {
+ public:
+  LocalCompactionServiceTest()
+      : DBTestBase("local_compaction_service_test", /*env_do_fsync=*/true),
+        work_dir_(dbname_ + "_compaction_jobs") {}
+
+  ~LocalCompactionServiceTest() override {
+    EXPECT_OK(DestroyDir(env_, work_dir_));
+  }
+
+ protected:
+  Options OptionsWithService(const std::string& worker_path) {
+    LocalCompactionServiceOptions service_options;
+    service_options.worker_path = worker_path;
+    service_options.worker_args = {kWorkerArg};
+    service_options.work_dir = work_dir_;
+    Options options = CurrentOptions();
+    options.disable_auto_compactions = true;
+    options.statistics = CreateDBStatistics();
+    options.compaction_service = NewLocalCompactionService(service_options);
+    return options;
+  }
+
+  void GenerateTestData() {
+    for (int i = 0; i < 4; i++) {
+      for (int j = 0; j < 100; j++) {
+        int key = i * 50 + j;
+        ASSERT_OK(Put(Key(key), "value" + std::to_string(i) + "_" +
+                                    std::to_string(key)));
+      }
+      ASSERT_OK(Flush());
+    }
+  }
+
+  void VerifyTestData() {
+    for (int key = 0; key < 250; key++) {
+      int i = std::min(key / 50, 3);
+      ASSERT_EQ("value" + std::to_string(i) + "_" + std::to_string(key),
+                Get(Key(key)));
+    }
+  }
+
+  const std::string work_dir_;
+};
+
+TEST_F(LocalCompactionServiceTest, CompactInWorker) {
+#ifndef OS_LINUX
+  ROCKSDB_GTEST_SKIP("Test requires /proc/self/exe");
+  return;
+#endif
+  Options options = OptionsWithService("/proc/self/exe");
+  DestroyAndReopen(options);
+  GenerateTestData();
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ("0,1", FilesPerLevel());
+  VerifyTestData();
+  ASSERT_GT(options.statistics->getTickerCount(REMOTE_COMPACT_WRITE_BYTES), 0);
+
+  // Job directories are cleaned up on installation
+  std::vector<std::string> children;
+  ASSERT_OK(env_->GetChildren(work_dir_, &children));
+  ASSERT_TRUE(children.empty());
+
+  Reopen(options);
+  VerifyTestData();
+}
+
+TEST_F(LocalCompactionServiceTest, FallbackToLocal) {
+  // The worker cannot be started
+  Options options = OptionsWithService(work_dir_ + "/no_such_worker");
+  DestroyAndReopen(options);
+  GenerateTestData();
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ("0,1", FilesPerLevel());
+  VerifyTestData();
+  ASSERT_EQ(options.statistics->getTickerCount(REMOTE_COMPACT_WRITE_BYTES), 0);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  if (argc > 1 && strcmp(argv[1], ROCKSDB_NAMESPACE::kWorkerArg) == 0) {
+    ROCKSDB_NAMESPACE::CompactionWorkerTool tool;
+    return tool.Run(argc - 1, argv + 1);
+  }
+  ROCKSDB_NAMESPACE::port::InstallStackTraceHandler();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}